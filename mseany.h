@@ -20,6 +20,9 @@
 #include <typeinfo>
 #include <type_traits>
 #include <stdexcept>
+#include <cstddef>
+#include <utility>
+#include <new>
 
 #ifdef MSE_CUSTOM_THROW_DEFINITION
 #include <iostream>
@@ -40,17 +43,28 @@ namespace mse
 		}
 };
 
-	class any final
+	/// basic_any is any with a configurable amount of inline ("small buffer") storage. Contained objects that fit in the inline
+	/// storage are stored there rather than allocated on the heap. any uses the standard amount of inline storage (2 words),
+	/// and, as N4562 requires, only stores objects inline if they have a nothrow move constructor.
+	///
+	/// If _InlineStorageRequiresNothrowMove is false, any object that fits is stored inline, so constructing or copying the
+	/// basic_any never allocates. In return, moving or swapping such a basic_any can throw (if the contained object's move (or
+	/// copy) constructor throws), and so those operations aren't declared noexcept. If one does throw, the basic_anys involved
+	/// are left in valid, but unspecified (possibly empty), states.
+	template<std::size_t _InlineStorageSize = 2 * sizeof(void*), bool _InlineStorageRequiresNothrowMove = true>
+	class basic_any final
 	{
 	public:
+		static const std::size_t sc_inline_storage_size = _InlineStorageSize;
+
 		/// Constructs an object of type any with an empty state.
-		any() :
+		basic_any() :
 			vtable(nullptr)
 		{
 		}
 
 		/// Constructs an object of type any with an equivalent state as other.
-		any(const any& rhs) :
+		basic_any(const basic_any& rhs) :
 			vtable(rhs.vtable)
 		{
 			if (!rhs.empty())
@@ -61,7 +75,7 @@ namespace mse
 
 		/// Constructs an object of type any with a state equivalent to the original state of other.
 		/// rhs is left in a valid but otherwise unspecified state.
-		any(any&& rhs) noexcept :
+		basic_any(basic_any&& rhs) noexcept(_InlineStorageRequiresNothrowMove) :
 		vtable(rhs.vtable)
 		{
 			if (!rhs.empty())
@@ -72,7 +86,7 @@ namespace mse
 		}
 
 		/// Same effect as this->clear().
-		~any()
+		~basic_any()
 		{
 			this->clear();
 		}
@@ -81,8 +95,8 @@ namespace mse
 		///
 		/// T shall satisfy the CopyConstructible requirements, otherwise the program is ill-formed.
 		/// This is because an `any` may be copy constructed into another `any` at any time, so a copy should always be allowed.
-		template<typename ValueType, typename = typename std::enable_if<!std::is_same<typename std::decay<ValueType>::type, any>::value>::type>
-		any(ValueType&& value)
+		template<typename ValueType, typename = typename std::enable_if<!std::is_same<typename std::decay<ValueType>::type, basic_any>::value>::type>
+		basic_any(ValueType&& value)
 		{
 			static_assert(std::is_copy_constructible<typename std::decay<ValueType>::type>::value,
 				"T shall satisfy the CopyConstructible requirements.");
@@ -90,9 +104,9 @@ namespace mse
 		}
 
 		/// Has the same effect as any(rhs).swap(*this). No effects if an exception is thrown.
-		any& operator=(const any& rhs)
+		basic_any& operator=(const basic_any& rhs)
 		{
-			any(rhs).swap(*this);
+			basic_any(rhs).swap(*this);
 			return *this;
 		}
 
@@ -100,9 +114,9 @@ namespace mse
 		///
 		/// The state of *this is equivalent to the original state of rhs and rhs is left in a valid
 		/// but otherwise unspecified state.
-		any& operator=(any&& rhs) noexcept
+		basic_any& operator=(basic_any&& rhs) noexcept(_InlineStorageRequiresNothrowMove)
 		{
-			any(std::move(rhs)).swap(*this);
+			basic_any(std::move(rhs)).swap(*this);
 			return *this;
 		}
 
@@ -110,12 +124,12 @@ namespace mse
 		///
 		/// T shall satisfy the CopyConstructible requirements, otherwise the program is ill-formed.
 		/// This is because an `any` may be copy constructed into another `any` at any time, so a copy should always be allowed.
-		template<typename ValueType, typename = typename std::enable_if<!std::is_same<typename std::decay<ValueType>::type, any>::value>::type>
-		any& operator=(ValueType&& value)
+		template<typename ValueType, typename = typename std::enable_if<!std::is_same<typename std::decay<ValueType>::type, basic_any>::value>::type>
+		basic_any& operator=(ValueType&& value)
 		{
 			static_assert(std::is_copy_constructible<typename std::decay<ValueType>::type>::value,
 				"T shall satisfy the CopyConstructible requirements.");
-			any(std::forward<ValueType>(value)).swap(*this);
+			basic_any(std::forward<ValueType>(value)).swap(*this);
 			return *this;
 		}
 
@@ -142,25 +156,28 @@ namespace mse
 		}
 
 		/// Exchange the states of *this and rhs.
-		void swap(any& rhs) noexcept
+		void swap(basic_any& rhs) noexcept(_InlineStorageRequiresNothrowMove)
 		{
-			if (this->vtable != rhs.vtable)
+			if ((this->vtable != rhs.vtable) || ((this->vtable != nullptr) && (this->vtable->swap == nullptr)))
 			{
-				any tmp(std::move(rhs));
+				// Each vtable pointer is only set once the move into its storage has succeeded, so that if a move throws
+				// (only possible when _InlineStorageRequiresNothrowMove is false), no basic_any is left claiming an
+				// object it doesn't hold.
+				basic_any tmp(std::move(rhs));
 
 				// move from *this to rhs.
-				rhs.vtable = this->vtable;
 				if (this->vtable != nullptr)
 				{
 					this->vtable->move(this->storage, rhs.storage);
-					//this->vtable = nullptr; -- uneeded, see below
+					rhs.vtable = this->vtable;
+					this->vtable = nullptr;
 				}
 
 				// move from tmp (previously rhs) to *this.
-				this->vtable = tmp.vtable;
 				if (tmp.vtable != nullptr)
 				{
 					tmp.vtable->move(tmp.storage, this->storage);
+					this->vtable = tmp.vtable;
 					tmp.vtable = nullptr;
 				}
 			}
@@ -184,10 +201,10 @@ namespace mse
 
 		union storage_union
 		{
-			using stack_storage_t = typename std::aligned_storage<2 * sizeof(void*), std::alignment_of<void*>::value>::type;
+			using stack_storage_t = typename std::aligned_storage<(sizeof(void*) > _InlineStorageSize) ? sizeof(void*) : _InlineStorageSize, std::alignment_of<void*>::value>::type;
 
 			void*               dynamic;
-			stack_storage_t     stack;      // 2 words for e.g. shared_ptr
+			stack_storage_t     stack;      // (by default) 2 words for e.g. shared_ptr
 		};
 
 		/// Base VTable specification.
@@ -209,10 +226,11 @@ namespace mse
 
 			/// Moves the storage from src to the yet unitialized dest union.
 			/// The state of src after this call is unspecified, caller must ensure not to use src anymore.
-			void(*move)(storage_union& src, storage_union& dest) noexcept;
+			void(*move)(storage_union& src, storage_union& dest) noexcept(_InlineStorageRequiresNothrowMove);
 
 			/// Exchanges the storage between lhs and rhs.
-			void(*swap)(storage_union& lhs, storage_union& rhs) noexcept;
+			/// Null for (inline stored) types that aren't move assignable. basic_any::swap() swaps those by moving.
+			void(*swap)(storage_union& lhs, storage_union& rhs) noexcept(_InlineStorageRequiresNothrowMove);
 
 			void* (*storage_address)(storage_union&) noexcept;
 			const void* (*const_storage_address)(const storage_union&) noexcept;
@@ -238,13 +256,13 @@ namespace mse
 				dest.dynamic = new T(*reinterpret_cast<const T*>(src.dynamic));
 			}
 
-			static void move(storage_union& src, storage_union& dest) noexcept
+			static void move(storage_union& src, storage_union& dest) noexcept(_InlineStorageRequiresNothrowMove)
 			{
 				dest.dynamic = src.dynamic;
 				src.dynamic = nullptr;
 			}
 
-			static void swap(storage_union& lhs, storage_union& rhs) noexcept
+			static void swap(storage_union& lhs, storage_union& rhs) noexcept(_InlineStorageRequiresNothrowMove)
 			{
 				// just exchage the storage pointers.
 				std::swap(lhs.dynamic, rhs.dynamic);
@@ -280,17 +298,18 @@ namespace mse
 				new (&dest.stack) T(reinterpret_cast<const T&>(src.stack));
 			}
 
-			static void move(storage_union& src, storage_union& dest) noexcept
+			static void move(storage_union& src, storage_union& dest) noexcept(_InlineStorageRequiresNothrowMove)
 			{
-				// one of the conditions for using vtable_stack is a nothrow move constructor,
-				// so this move constructor will never throw a exception.
+				// unless _InlineStorageRequiresNothrowMove is false, one of the conditions for using vtable_stack is a nothrow
+				// move constructor, so this move constructor will never throw a exception.
 				new (&dest.stack) T(std::move(reinterpret_cast<T&>(src.stack)));
 				destroy(src);
 			}
 
-			static void swap(storage_union& lhs, storage_union& rhs) noexcept
+			static void swap(storage_union& lhs, storage_union& rhs) noexcept(_InlineStorageRequiresNothrowMove)
 			{
-				std::swap(reinterpret_cast<T&>(lhs.stack), reinterpret_cast<T&>(rhs.stack));
+				using std::swap;
+				swap(reinterpret_cast<T&>(lhs.stack), reinterpret_cast<T&>(rhs.stack));
 			}
 
 			static void* storage_address(storage_union& storage) noexcept
@@ -308,30 +327,43 @@ namespace mse
 		template<typename T>
 		struct requires_allocation :
 			std::integral_constant<bool,
-			!(std::is_nothrow_move_constructible<T>::value      // N4562 ?6.3/3 [any.class]
+			!((std::is_nothrow_move_constructible<T>::value || (!_InlineStorageRequiresNothrowMove))      // N4562 ?6.3/3 [any.class]
 				&& sizeof(T) <= sizeof(storage_union::stack)
-				&& std::alignment_of<T>::value <= std::alignment_of<storage_union::stack_storage_t>::value)>
+				&& std::alignment_of<T>::value <= std::alignment_of<typename storage_union::stack_storage_t>::value)>
 		{};
 
+		/// The vtable's swap function, or null for (inline stored) types that aren't move assignable.
+		template<typename VTableType>
+		static auto swap_function(std::true_type) -> decltype(&VTableType::swap)
+		{
+			return &VTableType::swap;
+		}
+		template<typename VTableType>
+		static std::nullptr_t swap_function(std::false_type)
+		{
+			return nullptr;
+		}
+
 		/// Returns the pointer to the vtable of the type T.
 		template<typename T>
 		static vtable_type* vtable_for_type()
 		{
-			using VTableType = typename std::conditional<requires_allocation<T>::value, vtable_dynamic<T>, vtable_stack<T>>::type;
+			using VTableType = typename std::conditional<requires_allocation<T>::value, vtable_dynamic<T>, vtable_stack<T> >::type;
 			static vtable_type table = {
 				VTableType::type, VTableType::destroy,
 				VTableType::copy, VTableType::move,
-				VTableType::swap, VTableType::storage_address,
+				swap_function<VTableType>(std::integral_constant<bool, requires_allocation<T>::value || std::is_move_assignable<T>::value>()),
+				VTableType::storage_address,
 				VTableType::const_storage_address,
 			};
 			return &table;
 		}
 
 	protected:
-		template<typename T>
-		friend const T* any_cast(const any* operand) noexcept;
-		template<typename T>
-		friend T* any_cast(any* operand) noexcept;
+		template<typename T, std::size_t _InlineStorageSize2, bool _InlineStorageRequiresNothrowMove2>
+		friend const T* any_cast(const basic_any<_InlineStorageSize2, _InlineStorageRequiresNothrowMove2>* operand) noexcept;
+		template<typename T, std::size_t _InlineStorageSize2, bool _InlineStorageRequiresNothrowMove2>
+		friend T* any_cast(basic_any<_InlineStorageSize2, _InlineStorageRequiresNothrowMove2>* operand) noexcept;
 
 		/// Same effect as is_same(this->type(), t);
 		bool is_typed(const std::type_info& t) const
@@ -403,6 +435,12 @@ namespace mse
 		}
 	};
 
+	using any = basic_any<>;
+
+	template<typename T, std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline const T* any_cast(const basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>* operand) noexcept;
+	template<typename T, std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline T* any_cast(basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>* operand) noexcept;
 
 
 	namespace detail
@@ -421,8 +459,8 @@ namespace mse
 	}
 
 	/// Performs *any_cast<add_const_t<remove_reference_t<ValueType>>>(&operand), or throws bad_any_cast on failure.
-	template<typename ValueType>
-	inline ValueType any_cast(const any& operand)
+	template<typename ValueType, std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline ValueType any_cast(const basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>& operand)
 	{
 		auto p = any_cast<typename std::add_const<typename std::remove_reference<ValueType>::type>::type>(&operand);
 		if (p == nullptr) MSE_THROW(bad_any_cast());
@@ -430,8 +468,8 @@ namespace mse
 	}
 
 	/// Performs *any_cast<remove_reference_t<ValueType>>(&operand), or throws bad_any_cast on failure.
-	template<typename ValueType>
-	inline ValueType any_cast(any& operand)
+	template<typename ValueType, std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline ValueType any_cast(basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>& operand)
 	{
 		auto p = any_cast<typename std::remove_reference<ValueType>::type>(&operand);
 		if (p == nullptr) MSE_THROW(bad_any_cast());
@@ -447,8 +485,8 @@ namespace mse
 	///     std::move(*any_cast<remove_reference_t<ValueType>>(&operand)), otherwise
 	///     *any_cast<remove_reference_t<ValueType>>(&operand). Throws bad_any_cast on failure.
 	///
-	template<typename ValueType>
-	inline ValueType any_cast(any&& operand)
+	template<typename ValueType, std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline ValueType any_cast(basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>&& operand)
 	{
 #ifdef ANY_IMPL_ANY_CAST_MOVEABLE
 		// https://cplusplus.github.io/LWG/lwg-active.html#2509
@@ -466,34 +504,33 @@ namespace mse
 
 	/// If operand != nullptr && operand->type() == typeid(ValueType), a pointer to the object
 	/// contained by operand, otherwise nullptr.
-	template<typename T>
-	inline const T* any_cast(const any* operand) noexcept
+	template<typename T, std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline const T* any_cast(const basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>* operand) noexcept
 	{
 		if (operand == nullptr || !operand->is_typed(typeid(T)))
 			return nullptr;
 		else
-			return operand->cast<T>();
+			return operand->template cast<T>();
 	}
 
 	/// If operand != nullptr && operand->type() == typeid(ValueType), a pointer to the object
 	/// contained by operand, otherwise nullptr.
-	template<typename T>
-	inline T* any_cast(any* operand) noexcept
+	template<typename T, std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline T* any_cast(basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>* operand) noexcept
 	{
 		if (operand == nullptr || !operand->is_typed(typeid(T)))
 			return nullptr;
 		else
-			return operand->cast<T>();
+			return operand->template cast<T>();
 	}
 
-}
-
-namespace std
-{
-	inline void swap(mse::any& lhs, mse::any& rhs) noexcept
+	/// Found by argument dependent lookup (use "using std::swap; swap(lhs, rhs);").
+	template<std::size_t _InlineStorageSize, bool _InlineStorageRequiresNothrowMove>
+	inline void swap(basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>& lhs, basic_any<_InlineStorageSize, _InlineStorageRequiresNothrowMove>& rhs) noexcept(_InlineStorageRequiresNothrowMove)
 	{
 		lhs.swap(rhs);
 	}
+
 }
 
 #endif // MSEANY_H_
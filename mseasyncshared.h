@@ -12,11 +12,28 @@
 #include <shared_mutex>
 #include <thread>
 #include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <tuple>
+#include <future>
+#include <functional>
 #include <cassert>
 #include <stdexcept>
 #include <ctime>
 #include <ratio>
 #include <chrono>
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+#include <map>
+#include <string>
+#include <memory>
+#include <iostream>
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
 
 #if defined(MSE_SAFER_SUBSTITUTES_DISABLED) || defined(MSE_SAFERPTR_DISABLED)
 #define MSE_ASYNCSHAREDPOINTER_DISABLED
@@ -93,7 +110,7 @@ namespace mse {
 				retval = true;
 			}
 			else {
-				assert(0 == m_writelock_count);
+				assert((std::this_thread::get_id() != m_writelock_thread_id) || (0 == m_writelock_count));
 				retval = base_class::try_lock();
 				if (retval) {
 					m_writelock_thread_id = std::this_thread::get_id();
@@ -120,7 +137,7 @@ namespace mse {
 				retval = true;
 			}
 			else {
-				assert(0 == m_writelock_count);
+				assert((std::this_thread::get_id() != m_writelock_thread_id) || (0 == m_writelock_count));
 				retval = base_class::try_lock_until(_Abs_time);
 				if (retval) {
 					m_writelock_thread_id = std::this_thread::get_id();
@@ -273,6 +290,19 @@ namespace mse {
 			}
 		}
 
+		bool is_locked_by_this_thread()
+		{	// whether this thread holds the exclusive lock
+			std::lock_guard<std::mutex> lock1(m_write_mutex);
+			return ((1 <= m_writelock_count) && (std::this_thread::get_id() == m_writelock_thread_id));
+		}
+
+		bool is_shared_locked_by_this_thread()
+		{	// whether this thread holds a non-exclusive lock
+			std::lock_guard<std::mutex> lock1(m_read_mutex);
+			const auto found_it = m_thread_id_readlock_count_map.find(std::this_thread::get_id());
+			return ((m_thread_id_readlock_count_map.end() != found_it) && (1 <= (*found_it).second));
+		}
+
 		std::mutex m_write_mutex;
 		std::mutex m_read_mutex;
 
@@ -281,8 +311,953 @@ namespace mse {
 		std::unordered_map<std::thread::id, int> m_thread_id_readlock_count_map;
 	};
 
+#ifndef MSE_ASYNCSHARED_NUM_READER_STRIPES
+#define MSE_ASYNCSHARED_NUM_READER_STRIPES 16
+#endif // !MSE_ASYNCSHARED_NUM_READER_STRIPES
+
+	/* striped_recursive_shared_timed_mutex has the same interface and (recursion) semantics as recursive_shared_timed_mutex,
+	but is intended to scale better with the number of concurrent readers. Rather than a single (mutex protected) map of
+	reader thread ids, each thread keeps track of its own (recursive) read locks in thread local storage. And rather than a
+	single reader count, readers are counted in (cache line separated) "stripes", with (usually) different threads using
+	different stripes. So an uncontended (non-recursive) lock_shared() costs a (thread local) table lookup and a single
+	atomic increment (plus a load), and a recursive one doesn't touch shared state at all. The trade-offs are that each mutex is larger (a cache line per stripe),
+	and that a write lock has to check every stripe. Writers take precedence over new readers. */
+	class striped_recursive_shared_timed_mutex {
+	public:
+		striped_recursive_shared_timed_mutex() {}
+		striped_recursive_shared_timed_mutex(const striped_recursive_shared_timed_mutex&) = delete;
+		striped_recursive_shared_timed_mutex& operator=(const striped_recursive_shared_timed_mutex&) = delete;
+		~striped_recursive_shared_timed_mutex() {
+			assert(0 == m_writelock_count);
+			assert(total_reader_count() == 0);
+		}
+
+		void lock()
+		{	// lock exclusive
+			if (std::this_thread::get_id() == m_writelock_thread_id.load()) {
+				/* Only this thread could have set the owner id to its own id, so no synchronization is needed here. */
+			}
+			else {
+				m_writer_mutex.lock();
+				set_writer_pending_and_wait_for_readers_until<std::chrono::steady_clock::time_point>(nullptr);
+				m_writelock_thread_id.store(std::this_thread::get_id());
+				assert(0 == m_writelock_count);
+			}
+			m_writelock_count += 1;
+		}
+
+		bool try_lock()
+		{	// try to lock exclusive
+			if (std::this_thread::get_id() == m_writelock_thread_id.load()) {
+				m_writelock_count += 1;
+				return true;
+			}
+			if (!m_writer_mutex.try_lock()) {
+				return false;
+			}
+			m_writer_pending.store(true);
+			if (0 != total_reader_count()) {
+				clear_writer_pending();
+				m_writer_mutex.unlock();
+				return false;
+			}
+			m_writelock_thread_id.store(std::this_thread::get_id());
+			assert(0 == m_writelock_count);
+			m_writelock_count += 1;
+			return true;
+		}
+
+		template<class _Rep, class _Period>
+		bool try_lock_for(const std::chrono::duration<_Rep, _Period>& _Rel_time)
+		{	// try to lock for duration
+			return (try_lock_until(std::chrono::steady_clock::now() + _Rel_time));
+		}
+
+		template<class _Clock, class _Duration>
+		bool try_lock_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time)
+		{	// try to lock until time point
+			if (std::this_thread::get_id() == m_writelock_thread_id.load()) {
+				m_writelock_count += 1;
+				return true;
+			}
+			if (!m_writer_mutex.try_lock_until(_Abs_time)) {
+				return false;
+			}
+			if (!set_writer_pending_and_wait_for_readers_until(&_Abs_time)) {
+				m_writer_mutex.unlock();
+				return false;
+			}
+			m_writelock_thread_id.store(std::this_thread::get_id());
+			assert(0 == m_writelock_count);
+			m_writelock_count += 1;
+			return true;
+		}
+
+		void unlock()
+		{	// unlock exclusive
+			assert(std::this_thread::get_id() == m_writelock_thread_id.load());
+			assert(1 <= m_writelock_count);
+			m_writelock_count -= 1;
+			if (0 == m_writelock_count) {
+				m_writelock_thread_id.store(std::thread::id());
+				clear_writer_pending();
+				m_writer_mutex.unlock();
+			}
+		}
+
+		void lock_shared()
+		{	// lock non-exclusive
+			auto& count_ref = this_thread_readlock_count_ref();
+			if (1 <= count_ref) {
+				count_ref += 1;
+				return;
+			}
+			auto& stripe_ref = this_thread_reader_stripe_ref();
+			while (true) {
+				stripe_ref.fetch_add(1);
+				if (!m_writer_pending.load()) {
+					break;
+				}
+				back_off_reader(stripe_ref);
+				std::unique_lock<std::mutex> lock1(m_wait_mutex);
+				m_wait_cv.wait(lock1, [this]() { return !m_writer_pending.load(); });
+			}
+			count_ref = 1;
+		}
+
+		bool try_lock_shared()
+		{	// try to lock non-exclusive
+			auto& count_ref = this_thread_readlock_count_ref();
+			if (1 <= count_ref) {
+				count_ref += 1;
+				return true;
+			}
+			auto& stripe_ref = this_thread_reader_stripe_ref();
+			stripe_ref.fetch_add(1);
+			if (m_writer_pending.load()) {
+				back_off_reader(stripe_ref);
+				release_this_thread_readlock_record_if_unused();
+				return false;
+			}
+			count_ref = 1;
+			return true;
+		}
+
+		template<class _Rep, class _Period>
+		bool try_lock_shared_for(const std::chrono::duration<_Rep, _Period>& _Rel_time)
+		{	// try to lock non-exclusive for relative time
+			return (try_lock_shared_until(_Rel_time + std::chrono::steady_clock::now()));
+		}
+
+		template<class _Clock, class _Duration>
+		bool try_lock_shared_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time)
+		{	// try to lock non-exclusive until absolute time
+			auto& count_ref = this_thread_readlock_count_ref();
+			if (1 <= count_ref) {
+				count_ref += 1;
+				return true;
+			}
+			auto& stripe_ref = this_thread_reader_stripe_ref();
+			while (true) {
+				stripe_ref.fetch_add(1);
+				if (!m_writer_pending.load()) {
+					break;
+				}
+				back_off_reader(stripe_ref);
+				std::unique_lock<std::mutex> lock1(m_wait_mutex);
+				if (!m_wait_cv.wait_until(lock1, _Abs_time, [this]() { return !m_writer_pending.load(); })) {
+					lock1.unlock();
+					release_this_thread_readlock_record_if_unused();
+					return false;
+				}
+			}
+			count_ref = 1;
+			return true;
+		}
+
+		void unlock_shared()
+		{	// unlock non-exclusive
+			auto& count_ref = this_thread_readlock_count_ref();
+			assert(1 <= count_ref);
+			if (2 <= count_ref) {
+				count_ref -= 1;
+			}
+			else {
+				count_ref = 0;
+				release_this_thread_readlock_record_if_unused();
+				back_off_reader(this_thread_reader_stripe_ref());
+			}
+		}
+
+		bool is_locked_by_this_thread() const
+		{	// whether this thread holds the exclusive lock
+			return (std::this_thread::get_id() == m_writelock_thread_id.load());
+		}
+
+		bool is_shared_locked_by_this_thread() const
+		{	// whether this thread holds a non-exclusive lock
+			/* Unlike this_thread_readlock_count_ref(), this doesn't claim a record for the mutex. */
+			const auto& table_ref = this_thread_readlock_table_ref();
+			const auto& slot_ref = table_ref.m_slots[(reinterpret_cast<std::uintptr_t>(this) / sc_cache_line_size) % sc_num_thread_readlock_slots];
+			if ((this == slot_ref.m_mutex_ptr) && (0 != slot_ref.m_count)) {
+				return true;
+			}
+			if (0 != table_ref.m_num_overflow_records) {
+				for (const auto& record : this_thread_overflow_readlock_records_ref()) {
+					if (this == record.m_mutex_ptr) {
+						return (0 != record.m_count);
+					}
+				}
+			}
+			return false;
+		}
+
+	private:
+		static const size_t sc_num_reader_stripes = MSE_ASYNCSHARED_NUM_READER_STRIPES;
+		static const size_t sc_cache_line_size = 64;
+
+		struct alignas(sc_cache_line_size) CReaderStripe {
+			std::atomic<int> m_count{ 0 };
+		};
+
+		/* Each thread keeps track of the striped mutexes it currently holds read locks on, and the recursion depth of each,
+		in a small (trivially constructible, so no dynamic initialization or "first use" check) direct-mapped table indexed
+		by the mutex's address. A slot with a count of zero is free. Only when two (simultaneously) read locked mutexes map
+		to the same slot is the (dynamically allocated) overflow list used. */
+		struct CThreadReadLockRecord {
+			const striped_recursive_shared_timed_mutex* m_mutex_ptr;
+			int m_count;
+		};
+		static const size_t sc_num_thread_readlock_slots = 16;
+		struct CThreadReadLockTable {
+			CThreadReadLockRecord m_slots[sc_num_thread_readlock_slots];
+			size_t m_num_overflow_records;
+		};
+		static CThreadReadLockTable& this_thread_readlock_table_ref() {
+			thread_local CThreadReadLockTable tl_table;
+			return tl_table;
+		}
+		static std::vector<CThreadReadLockRecord>& this_thread_overflow_readlock_records_ref() {
+			thread_local std::vector<CThreadReadLockRecord> tl_records;
+			return tl_records;
+		}
+		int& this_thread_readlock_count_ref() {
+			auto& table_ref = this_thread_readlock_table_ref();
+			auto& slot_ref = table_ref.m_slots[(reinterpret_cast<std::uintptr_t>(this) / sc_cache_line_size) % sc_num_thread_readlock_slots];
+			if ((this == slot_ref.m_mutex_ptr) && (0 != slot_ref.m_count)) {
+				return slot_ref.m_count;
+			}
+			if (0 != table_ref.m_num_overflow_records) {
+				for (auto& record : this_thread_overflow_readlock_records_ref()) {
+					if (this == record.m_mutex_ptr) {
+						return record.m_count;
+					}
+				}
+			}
+			if (0 == slot_ref.m_count) {
+				slot_ref.m_mutex_ptr = this;
+				return slot_ref.m_count;
+			}
+			auto& records_ref = this_thread_overflow_readlock_records_ref();
+			records_ref.push_back(CThreadReadLockRecord{ this, 0 });
+			table_ref.m_num_overflow_records = records_ref.size();
+			return records_ref.back().m_count;
+		}
+		/* A table slot is freed just by its count reaching zero. Only overflow records need to be removed. */
+		void release_this_thread_readlock_record_if_unused() {
+			auto& table_ref = this_thread_readlock_table_ref();
+			if (0 == table_ref.m_num_overflow_records) {
+				return;
+			}
+			auto& records_ref = this_thread_overflow_readlock_records_ref();
+			auto found_it = std::find_if(records_ref.begin(), records_ref.end(), [this](const CThreadReadLockRecord& record) { return (this == record.m_mutex_ptr); });
+			if ((records_ref.end() != found_it) && (0 == (*found_it).m_count)) {
+				(*found_it) = records_ref.back();
+				records_ref.pop_back();
+				table_ref.m_num_overflow_records = records_ref.size();
+			}
+		}
+
+		static size_t this_thread_reader_stripe_index() {
+			/* Zero means "not yet assigned". Being constant initialized, the thread local needs no initialization check. */
+			thread_local size_t tl_stripe_index_plus_one = 0;
+			if (0 == tl_stripe_index_plus_one) {
+				static std::atomic<size_t> s_next_stripe_index{ 0 };
+				tl_stripe_index_plus_one = (s_next_stripe_index.fetch_add(1, std::memory_order_relaxed) % sc_num_reader_stripes) + 1;
+			}
+			return tl_stripe_index_plus_one - 1;
+		}
+		std::atomic<int>& this_thread_reader_stripe_ref() {
+			return m_reader_stripes[this_thread_reader_stripe_index()].m_count;
+		}
+
+		int total_reader_count() const {
+			int retval = 0;
+			for (const auto& stripe : m_reader_stripes) {
+				retval += stripe.m_count.load();
+			}
+			return retval;
+		}
+
+		/* A reader that's leaving, or backing off because a writer is pending, lets any waiting writer know. */
+		void back_off_reader(std::atomic<int>& stripe_ref) {
+			stripe_ref.fetch_sub(1);
+			if (m_writer_pending.load()) {
+				{
+					std::lock_guard<std::mutex> lock1(m_wait_mutex);
+				}
+				m_wait_cv.notify_all();
+			}
+		}
+		void clear_writer_pending() {
+			{
+				std::lock_guard<std::mutex> lock1(m_wait_mutex);
+				m_writer_pending.store(false);
+			}
+			m_wait_cv.notify_all();
+		}
+
+		/* Called with m_writer_mutex held. Blocks new readers, then waits for the existing ones to leave. If a time limit
+		is given and expires first, the pending state is cleared and false is returned. */
+		template<class _TTimePoint>
+		bool set_writer_pending_and_wait_for_readers_until(const _TTimePoint* abs_time_ptr) {
+			m_writer_pending.store(true);
+			if (0 == total_reader_count()) {
+				return true;
+			}
+			std::unique_lock<std::mutex> lock1(m_wait_mutex);
+			auto predicate = [this]() { return (0 == total_reader_count()); };
+			if (nullptr == abs_time_ptr) {
+				m_wait_cv.wait(lock1, predicate);
+			}
+			else if (!m_wait_cv.wait_until(lock1, *abs_time_ptr, predicate)) {
+				m_writer_pending.store(false);
+				lock1.unlock();
+				m_wait_cv.notify_all();
+				return false;
+			}
+			return true;
+		}
+
+		CReaderStripe m_reader_stripes[sc_num_reader_stripes];
+		std::atomic<bool> m_writer_pending{ false };
+
+		std::timed_mutex m_writer_mutex;
+		std::atomic<std::thread::id> m_writelock_thread_id{ std::thread::id() };
+		int m_writelock_count = 0;
+
+		std::mutex m_wait_mutex;
+		std::condition_variable m_wait_cv;
+	};
+
 	//typedef std::shared_timed_mutex async_shared_timed_mutex_type;
-	typedef recursive_shared_timed_mutex async_shared_timed_mutex_type;
+
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+	/* CAsyncSharedLockStats is a set of counters of lock acquisitions (and their wait and hold times) for one shared object,
+	split by read and write. It is updated concurrently, so the counters are atomic. */
+	class CAsyncSharedLockStats {
+	public:
+		class CLockModeStats {
+		public:
+			std::atomic<std::uint64_t> m_num_acquisitions{ 0 };
+			/* Acquisitions that couldn't be granted immediately. */
+			std::atomic<std::uint64_t> m_num_contended_acquisitions{ 0 };
+			std::atomic<std::uint64_t> m_total_wait_ns{ 0 };
+			std::atomic<std::uint64_t> m_max_wait_ns{ 0 };
+			/* Hold times are recorded for the outermost (non-recursive) lock only. */
+			std::atomic<std::uint64_t> m_total_hold_ns{ 0 };
+			std::atomic<std::uint64_t> m_max_hold_ns{ 0 };
+
+			void record_acquisition(bool contended, std::uint64_t wait_ns) {
+				m_num_acquisitions.fetch_add(1, std::memory_order_relaxed);
+				if (contended) {
+					m_num_contended_acquisitions.fetch_add(1, std::memory_order_relaxed);
+					m_total_wait_ns.fetch_add(wait_ns, std::memory_order_relaxed);
+					update_max(m_max_wait_ns, wait_ns);
+				}
+			}
+			void record_release(std::uint64_t hold_ns) {
+				m_total_hold_ns.fetch_add(hold_ns, std::memory_order_relaxed);
+				update_max(m_max_hold_ns, hold_ns);
+			}
+		private:
+			static void update_max(std::atomic<std::uint64_t>& max_ref, std::uint64_t value) {
+				auto current_max = max_ref.load(std::memory_order_relaxed);
+				while ((current_max < value) && (!max_ref.compare_exchange_weak(current_max, value, std::memory_order_relaxed))) {}
+			}
+		};
+
+		/* A non-atomic copy of the counters. */
+		class CLockModeStatsSnapshot {
+		public:
+			CLockModeStatsSnapshot() {}
+			CLockModeStatsSnapshot(const CLockModeStats& src) : m_num_acquisitions(src.m_num_acquisitions.load()), m_num_contended_acquisitions(src.m_num_contended_acquisitions.load())
+				, m_total_wait_ns(src.m_total_wait_ns.load()), m_max_wait_ns(src.m_max_wait_ns.load()), m_total_hold_ns(src.m_total_hold_ns.load()), m_max_hold_ns(src.m_max_hold_ns.load()) {}
+			CLockModeStatsSnapshot& operator+=(const CLockModeStatsSnapshot& rhs) {
+				m_num_acquisitions += rhs.m_num_acquisitions;
+				m_num_contended_acquisitions += rhs.m_num_contended_acquisitions;
+				m_total_wait_ns += rhs.m_total_wait_ns;
+				m_max_wait_ns = std::max(m_max_wait_ns, rhs.m_max_wait_ns);
+				m_total_hold_ns += rhs.m_total_hold_ns;
+				m_max_hold_ns = std::max(m_max_hold_ns, rhs.m_max_hold_ns);
+				return (*this);
+			}
+			std::uint64_t m_num_acquisitions = 0;
+			std::uint64_t m_num_contended_acquisitions = 0;
+			std::uint64_t m_total_wait_ns = 0;
+			std::uint64_t m_max_wait_ns = 0;
+			std::uint64_t m_total_hold_ns = 0;
+			std::uint64_t m_max_hold_ns = 0;
+		};
+		class CSnapshot {
+		public:
+			CLockModeStatsSnapshot m_read;
+			CLockModeStatsSnapshot m_write;
+			/* The number of objects whose stats were combined into this snapshot. */
+			size_t m_num_objects = 0;
+		};
+
+		CSnapshot snapshot() const {
+			CSnapshot retval;
+			retval.m_read = m_read;
+			retval.m_write = m_write;
+			retval.m_num_objects = 1;
+			return retval;
+		}
+
+		CLockModeStats m_read;
+		CLockModeStats m_write;
+	};
+
+	/* CAsyncSharedInstrumentationRegistry maps user supplied names to the lock stats of the shared objects given those names
+	(see mse::set_asyncshared_instrumentation_name()). Objects given the same name have their stats combined. An object is
+	listed under (at most) one name, the last one it was given. The registry keeps the stats after the objects are gone. The stats are dumped to std::cerr at program exit unless
+	MSE_ASYNCSHARED_INSTRUMENTATION1_NO_DUMP_AT_EXIT is defined. */
+	class CAsyncSharedInstrumentationRegistry {
+	public:
+		~CAsyncSharedInstrumentationRegistry() {
+#ifndef MSE_ASYNCSHARED_INSTRUMENTATION1_NO_DUMP_AT_EXIT
+			dump(std::cerr);
+#endif // !MSE_ASYNCSHARED_INSTRUMENTATION1_NO_DUMP_AT_EXIT
+		}
+		void register_stats(const std::string& name, const std::shared_ptr<const CAsyncSharedLockStats>& stats_shptr) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto found_it = m_name_by_stats_map.find(stats_shptr.get());
+			if (m_name_by_stats_map.end() != found_it) {
+				if (name == (*found_it).second) {
+					return;
+				}
+				/* The object is being renamed, so it's removed from the list of its previous name. */
+				auto stats_map_it = m_stats_map.find((*found_it).second);
+				assert(m_stats_map.end() != stats_map_it);
+				auto& stats_list_ref = (*stats_map_it).second;
+				stats_list_ref.erase(std::remove(stats_list_ref.begin(), stats_list_ref.end(), stats_shptr), stats_list_ref.end());
+				if (stats_list_ref.empty()) {
+					m_stats_map.erase(stats_map_it);
+				}
+				(*found_it).second = name;
+			}
+			else {
+				m_name_by_stats_map.emplace(stats_shptr.get(), name);
+			}
+			m_stats_map[name].push_back(stats_shptr);
+		}
+		std::map<std::string, CAsyncSharedLockStats::CSnapshot> stats_by_name() {
+			std::map<std::string, CAsyncSharedLockStats::CSnapshot> retval;
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (const auto& item : m_stats_map) {
+				auto& snapshot_ref = retval[item.first];
+				for (const auto& stats_shptr : item.second) {
+					const auto object_snapshot = (*stats_shptr).snapshot();
+					snapshot_ref.m_read += object_snapshot.m_read;
+					snapshot_ref.m_write += object_snapshot.m_write;
+					snapshot_ref.m_num_objects += 1;
+				}
+			}
+			return retval;
+		}
+		void dump(std::ostream& os) {
+			auto stats_map = stats_by_name();
+			if (stats_map.empty()) { return; }
+			os << "asyncshared lock stats (times in microseconds): \n";
+			for (const auto& item : stats_map) {
+				os << item.first << " (objects: " << item.second.m_num_objects << "): \n";
+				dump_lock_mode_stats(os, "read", item.second.m_read);
+				dump_lock_mode_stats(os, "write", item.second.m_write);
+			}
+		}
+
+	private:
+		static void dump_lock_mode_stats(std::ostream& os, const char* mode_name, const CAsyncSharedLockStats::CLockModeStatsSnapshot& stats) {
+			os << "  " << mode_name << " - acquisitions: " << stats.m_num_acquisitions << ", contended: " << stats.m_num_contended_acquisitions
+				<< ", total wait: " << (stats.m_total_wait_ns / 1000) << ", max wait: " << (stats.m_max_wait_ns / 1000)
+				<< ", total hold: " << (stats.m_total_hold_ns / 1000) << ", max hold: " << (stats.m_max_hold_ns / 1000) << " \n";
+		}
+
+		std::map<std::string, std::vector<std::shared_ptr<const CAsyncSharedLockStats>>> m_stats_map;
+		/* The name each (registered) object is listed under. (The stats are kept alive by m_stats_map.) */
+		std::map<const CAsyncSharedLockStats*, std::string> m_name_by_stats_map;
+		std::mutex m_mutex;
+	};
+	inline CAsyncSharedInstrumentationRegistry& asyncshared_instrumentation_registry() {
+		static CAsyncSharedInstrumentationRegistry s_registry;
+		return s_registry;
+	}
+
+	/* TInstrumentedSharedTimedMutex wraps a (recursive) shared timed mutex and records acquisition counts, contention, and
+	wait and hold times. */
+	template<class _TMutex>
+	class TInstrumentedSharedTimedMutex {
+	public:
+		typedef std::chrono::steady_clock clock_t;
+
+		TInstrumentedSharedTimedMutex() : m_stats_shptr(std::make_shared<CAsyncSharedLockStats>()) {}
+		TInstrumentedSharedTimedMutex(const TInstrumentedSharedTimedMutex&) = delete;
+		TInstrumentedSharedTimedMutex& operator=(const TInstrumentedSharedTimedMutex&) = delete;
+
+		void lock() {
+			if (m_mutex.try_lock()) {
+				note_write_acquired(false, clock_t::now());
+			}
+			else {
+				const auto start_time = clock_t::now();
+				m_mutex.lock();
+				note_write_acquired(true, start_time);
+			}
+		}
+		bool try_lock() {
+			bool retval = m_mutex.try_lock();
+			if (retval) {
+				note_write_acquired(false, clock_t::now());
+			}
+			return retval;
+		}
+		template<class _Rep, class _Period>
+		bool try_lock_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			return try_lock_until(std::chrono::steady_clock::now() + _Rel_time);
+		}
+		template<class _Clock, class _Duration>
+		bool try_lock_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			if (m_mutex.try_lock()) {
+				note_write_acquired(false, clock_t::now());
+				return true;
+			}
+			const auto start_time = clock_t::now();
+			bool retval = m_mutex.try_lock_until(_Abs_time);
+			if (retval) {
+				note_write_acquired(true, start_time);
+			}
+			return retval;
+		}
+		void unlock() {
+			assert(1 <= m_writelock_depth);
+			m_writelock_depth -= 1;
+			if (0 == m_writelock_depth) {
+				(*m_stats_shptr).m_write.record_release(elapsed_ns(m_writelock_acquired_time));
+			}
+			m_mutex.unlock();
+		}
+
+		void lock_shared() {
+			if (m_mutex.try_lock_shared()) {
+				note_read_acquired(false, clock_t::now());
+			}
+			else {
+				const auto start_time = clock_t::now();
+				m_mutex.lock_shared();
+				note_read_acquired(true, start_time);
+			}
+		}
+		bool try_lock_shared() {
+			bool retval = m_mutex.try_lock_shared();
+			if (retval) {
+				note_read_acquired(false, clock_t::now());
+			}
+			return retval;
+		}
+		template<class _Rep, class _Period>
+		bool try_lock_shared_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			return try_lock_shared_until(std::chrono::steady_clock::now() + _Rel_time);
+		}
+		template<class _Clock, class _Duration>
+		bool try_lock_shared_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			if (m_mutex.try_lock_shared()) {
+				note_read_acquired(false, clock_t::now());
+				return true;
+			}
+			const auto start_time = clock_t::now();
+			bool retval = m_mutex.try_lock_shared_until(_Abs_time);
+			if (retval) {
+				note_read_acquired(true, start_time);
+			}
+			return retval;
+		}
+		void unlock_shared() {
+			auto& records_ref = this_thread_readlock_records_ref();
+			auto found_it = std::find_if(records_ref.begin(), records_ref.end(), [this](const CThreadReadLockRecord& record) { return (this == record.m_mutex_ptr); });
+			assert(records_ref.end() != found_it);
+			if (records_ref.end() != found_it) {
+				(*found_it).m_depth -= 1;
+				if (0 == (*found_it).m_depth) {
+					(*m_stats_shptr).m_read.record_release(elapsed_ns((*found_it).m_acquired_time));
+					(*found_it) = records_ref.back();
+					records_ref.pop_back();
+				}
+			}
+			m_mutex.unlock_shared();
+		}
+
+		bool is_locked_by_this_thread() { return m_mutex.is_locked_by_this_thread(); }
+		bool is_shared_locked_by_this_thread() { return m_mutex.is_shared_locked_by_this_thread(); }
+
+		void set_instrumentation_name(const std::string& name) {
+			asyncshared_instrumentation_registry().register_stats(name, m_stats_shptr);
+		}
+		CAsyncSharedLockStats::CSnapshot instrumentation_stats() const {
+			return (*m_stats_shptr).snapshot();
+		}
+
+	private:
+		static std::uint64_t elapsed_ns(const clock_t::time_point& start_time) {
+			return std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - start_time).count());
+		}
+		void note_write_acquired(bool contended, const clock_t::time_point& start_time) {
+			/* Only the (exclusive) lock holder accesses these members. */
+			if (0 == m_writelock_depth) {
+				m_writelock_acquired_time = clock_t::now();
+			}
+			m_writelock_depth += 1;
+			(*m_stats_shptr).m_write.record_acquisition(contended, contended ? elapsed_ns(start_time) : 0);
+		}
+
+		/* Since read locks can be held by multiple threads at once, the (outermost) acquisition time of the read lock is
+		kept per thread. */
+		struct CThreadReadLockRecord {
+			const TInstrumentedSharedTimedMutex* m_mutex_ptr;
+			int m_depth;
+			clock_t::time_point m_acquired_time;
+		};
+		static std::vector<CThreadReadLockRecord>& this_thread_readlock_records_ref() {
+			thread_local std::vector<CThreadReadLockRecord> tl_records;
+			return tl_records;
+		}
+		void note_read_acquired(bool contended, const clock_t::time_point& start_time) {
+			auto& records_ref = this_thread_readlock_records_ref();
+			auto found_it = std::find_if(records_ref.begin(), records_ref.end(), [this](const CThreadReadLockRecord& record) { return (this == record.m_mutex_ptr); });
+			if (records_ref.end() != found_it) {
+				(*found_it).m_depth += 1;
+			}
+			else {
+				records_ref.push_back(CThreadReadLockRecord{ this, 1, clock_t::now() });
+			}
+			(*m_stats_shptr).m_read.record_acquisition(contended, contended ? elapsed_ns(start_time) : 0);
+		}
+
+		_TMutex m_mutex;
+		std::shared_ptr<CAsyncSharedLockStats> m_stats_shptr;
+		int m_writelock_depth = 0;
+		clock_t::time_point m_writelock_acquired_time;
+	};
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+
+
+	namespace impl {
+		/* CAsyncSharedLockQueue holds the asynchronous (exclusive) lock requests for an object, in the order they were made.
+		No request ever blocks a thread while waiting for the lock. When a request reaches the front of the queue, its task
+		is submitted to its executor, and (when run) just tries to obtain the lock. If that fails, the request "parks" (at the
+		front of the queue) and the task returns. The next time the lock is released, the releasing thread resubmits the
+		parked request. A request whose task was destroyed without being run is "abandoned", and removed from the queue.
+		Once the front request has failed to obtain the lock, it's "waiting", and (like a pending writer of a write-preferring
+		mutex) new synchronous acquisitions of the lock (other than recursive ones) hold off until it has obtained the lock.
+		Otherwise a continuous stream of (overlapping) synchronous lock holders could starve it indefinitely. */
+		class CAsyncSharedLockQueue {
+		public:
+			class CRequestBase;
+			typedef std::shared_ptr<CRequestBase> request_shptr_t;
+			class CRequestBase {
+			public:
+				virtual ~CRequestBase() {}
+				/* Hands a task, that will call attempt(), to the request's executor. */
+				virtual void submit(const request_shptr_t& self_shptr) = 0;
+				virtual void attempt() = 0;
+			};
+
+			CAsyncSharedLockQueue() {}
+			CAsyncSharedLockQueue(const CAsyncSharedLockQueue&) = delete;
+			~CAsyncSharedLockQueue() { delete m_state_ptr.load(); }
+
+			void enqueue(const request_shptr_t& request_shptr) {
+				request_shptr_t to_submit;
+				{
+					auto& state_ref = state();
+					std::lock_guard<std::mutex> lock1(state_ref.m_mutex);
+					state_ref.m_requests.push_back(request_shptr);
+					m_num_requests.store(state_ref.m_requests.size());
+					to_submit = take_front_for_submission(state_ref);
+				}
+				submit(to_submit);
+			}
+			/* Called by every unlock() of the mutex. Cheap when there aren't any asynchronous requests. */
+			void on_release() {
+				/* The fence keeps the load of the request count from being reordered before the (just released) lock, so
+				that a request that failed to obtain the lock can't be missed. */
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (0 != m_num_requests.load()) {
+					request_shptr_t to_submit;
+					{
+						auto& state_ref = state();
+						std::lock_guard<std::mutex> lock1(state_ref.m_mutex);
+						state_ref.m_release_count += 1;
+						to_submit = take_front_for_submission(state_ref);
+					}
+					submit(to_submit);
+				}
+			}
+			size_t release_count() {
+				auto& state_ref = state();
+				std::lock_guard<std::mutex> lock1(state_ref.m_mutex);
+				return state_ref.m_release_count;
+			}
+			/* Called by the front request once it has obtained the lock. (The next request isn't submitted until the lock is
+			released.) */
+			void on_acquired(const CRequestBase* request_ptr) {
+				auto& state_ref = state();
+				{
+					std::lock_guard<std::mutex> lock1(state_ref.m_mutex);
+					assert((!state_ref.m_requests.empty()) && (request_ptr == state_ref.m_requests.front().get()));
+					state_ref.m_requests.pop_front();
+					m_num_requests.store(state_ref.m_requests.size());
+					state_ref.m_front_submitted = false;
+					m_front_waiting.store(false);
+				}
+				state_ref.m_front_waiting_cv.notify_all();
+			}
+			/* Called by the front request when it failed to obtain the lock. Returns true if the lock has been released since
+			the given release count was obtained, in which case the request should just try again. Otherwise the request is
+			parked until the next release. */
+			bool on_failed_attempt(const CRequestBase* request_ptr, size_t release_count_before_attempt) {
+				auto& state_ref = state();
+				std::lock_guard<std::mutex> lock1(state_ref.m_mutex);
+				assert((!state_ref.m_requests.empty()) && (request_ptr == state_ref.m_requests.front().get()));
+				m_front_waiting.store(true);
+				if (release_count_before_attempt != state_ref.m_release_count) {
+					return true;
+				}
+				state_ref.m_front_submitted = false;
+				return false;
+			}
+			void on_abandoned(const CRequestBase* request_ptr) {
+				request_shptr_t to_submit;
+				request_shptr_t abandoned_shptr;
+				{
+					auto& state_ref = state();
+					std::lock_guard<std::mutex> lock1(state_ref.m_mutex);
+					assert((!state_ref.m_requests.empty()) && (request_ptr == state_ref.m_requests.front().get()));
+					/* The request is destroyed (breaking its promise) only after the state lock is released. */
+					abandoned_shptr = std::move(state_ref.m_requests.front());
+					state_ref.m_requests.pop_front();
+					m_num_requests.store(state_ref.m_requests.size());
+					state_ref.m_front_submitted = false;
+					m_front_waiting.store(false);
+					to_submit = take_front_for_submission(state_ref);
+				}
+				state().m_front_waiting_cv.notify_all();
+				submit(to_submit);
+			}
+
+			/* Whether the front request has tried, and failed, to obtain the lock (and hasn't obtained it since). Cheap. */
+			bool front_request_is_waiting() const { return m_front_waiting.load(); }
+			/* Called (without holding the lock) by synchronous lockers when the front request is waiting. */
+			void wait_while_front_request_is_waiting() {
+				auto& state_ref = state();
+				std::unique_lock<std::mutex> lock1(state_ref.m_mutex);
+				state_ref.m_front_waiting_cv.wait(lock1, [this]() { return !m_front_waiting.load(); });
+			}
+			template<class _Clock, class _Duration>
+			bool wait_while_front_request_is_waiting_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+				auto& state_ref = state();
+				std::unique_lock<std::mutex> lock1(state_ref.m_mutex);
+				return state_ref.m_front_waiting_cv.wait_until(lock1, _Abs_time, [this]() { return !m_front_waiting.load(); });
+			}
+
+		private:
+			struct CState {
+				std::mutex m_mutex;
+				std::deque<request_shptr_t> m_requests;
+				bool m_front_submitted = false;
+				size_t m_release_count = 0;
+				std::condition_variable m_front_waiting_cv;
+			};
+			/* The state is allocated when the first asynchronous request is made, so mutexes that are only ever locked
+			synchronously stay small. */
+			CState& state() {
+				auto state_ptr = m_state_ptr.load(std::memory_order_acquire);
+				if (!state_ptr) {
+					auto new_state_ptr = new CState();
+					if (m_state_ptr.compare_exchange_strong(state_ptr, new_state_ptr, std::memory_order_acq_rel)) {
+						state_ptr = new_state_ptr;
+					}
+					else {
+						delete new_state_ptr;
+					}
+				}
+				return *state_ptr;
+			}
+			static request_shptr_t take_front_for_submission(CState& state_ref) {
+				if (state_ref.m_requests.empty() || state_ref.m_front_submitted) {
+					return request_shptr_t();
+				}
+				state_ref.m_front_submitted = true;
+				return state_ref.m_requests.front();
+			}
+			/* Executors aren't called while holding the state lock, as they might run the task immediately. */
+			static void submit(const request_shptr_t& request_shptr) {
+				if (request_shptr) {
+					(*request_shptr).submit(request_shptr);
+				}
+			}
+
+			std::atomic<size_t> m_num_requests{ 0 };
+			/* Only modified while holding the state lock. */
+			std::atomic<bool> m_front_waiting{ false };
+			std::atomic<CState*> m_state_ptr{ nullptr };
+		};
+
+		/* A reference counted (and so copyable, as std::function<> requires) wrapper for a submitted task. If the executor
+		destroys the task without running it, the request is abandoned. */
+		class CAsyncSharedLockRequestDispatch {
+		public:
+			CAsyncSharedLockRequestDispatch(CAsyncSharedLockQueue& queue_ref, const CAsyncSharedLockQueue::request_shptr_t& request_shptr)
+				: m_queue_ptr(std::addressof(queue_ref)), m_request_shptr(request_shptr) {}
+			CAsyncSharedLockRequestDispatch(const CAsyncSharedLockRequestDispatch&) = delete;
+			~CAsyncSharedLockRequestDispatch() {
+				if (!m_ran) {
+					(*m_queue_ptr).on_abandoned(m_request_shptr.get());
+				}
+			}
+			void run() {
+				m_ran = true;
+				(*m_request_shptr).attempt();
+			}
+		private:
+			CAsyncSharedLockQueue* m_queue_ptr = nullptr;
+			CAsyncSharedLockQueue::request_shptr_t m_request_shptr;
+			bool m_ran = false;
+		};
+
+		/* The lock queue is part of the mutex, so that every release (including those by synchronously obtained lock
+		pointers and mse::lock_all()) passes the lock on to any asynchronous requests, and every (synchronous) acquisition
+		gives way to a waiting asynchronous request. */
+		template<class _TMutex>
+		class TAsyncSharedQueuedMutex : public _TMutex {
+		public:
+			void lock() {
+				if (m_async_lock_queue.front_request_is_waiting() && (!_TMutex::is_locked_by_this_thread())) {
+					m_async_lock_queue.wait_while_front_request_is_waiting();
+				}
+				_TMutex::lock();
+			}
+			bool try_lock() {
+				if (m_async_lock_queue.front_request_is_waiting() && (!_TMutex::is_locked_by_this_thread())) {
+					return false;
+				}
+				return _TMutex::try_lock();
+			}
+			template<class _Rep, class _Period>
+			bool try_lock_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+				return try_lock_until(std::chrono::steady_clock::now() + _Rel_time);
+			}
+			template<class _Clock, class _Duration>
+			bool try_lock_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+				if (m_async_lock_queue.front_request_is_waiting() && (!_TMutex::is_locked_by_this_thread())) {
+					if (!m_async_lock_queue.wait_while_front_request_is_waiting_until(_Abs_time)) {
+						return false;
+					}
+				}
+				return _TMutex::try_lock_until(_Abs_time);
+			}
+			void lock_shared() {
+				if (m_async_lock_queue.front_request_is_waiting() && (!_TMutex::is_shared_locked_by_this_thread())) {
+					m_async_lock_queue.wait_while_front_request_is_waiting();
+				}
+				_TMutex::lock_shared();
+			}
+			bool try_lock_shared() {
+				if (m_async_lock_queue.front_request_is_waiting() && (!_TMutex::is_shared_locked_by_this_thread())) {
+					return false;
+				}
+				return _TMutex::try_lock_shared();
+			}
+			template<class _Rep, class _Period>
+			bool try_lock_shared_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+				return try_lock_shared_until(std::chrono::steady_clock::now() + _Rel_time);
+			}
+			template<class _Clock, class _Duration>
+			bool try_lock_shared_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+				if (m_async_lock_queue.front_request_is_waiting() && (!_TMutex::is_shared_locked_by_this_thread())) {
+					if (!m_async_lock_queue.wait_while_front_request_is_waiting_until(_Abs_time)) {
+						return false;
+					}
+				}
+				return _TMutex::try_lock_shared_until(_Abs_time);
+			}
+			/* Used by the (front) asynchronous request itself, which doesn't give way to itself. */
+			bool front_request_try_lock() {
+				return _TMutex::try_lock();
+			}
+			void unlock() {
+				_TMutex::unlock();
+				m_async_lock_queue.on_release();
+			}
+			void unlock_shared() {
+				_TMutex::unlock_shared();
+				m_async_lock_queue.on_release();
+			}
+
+			CAsyncSharedLockQueue m_async_lock_queue;
+		};
+
+		/* Holds the result of an asynchronous lock request's function until the lock has been released. */
+		template<class _TResult>
+		class TAsyncSharedResultHolder {
+		public:
+			template<class _TFunction, class _TLockPointer>
+			void call(_TFunction& func, _TLockPointer& lock_ptr) { m_result.emplace(func(lock_ptr)); }
+			void set_promise_value(std::promise<_TResult>& promise_ref) { promise_ref.set_value(std::forward<_TResult>(*m_result)); }
+		private:
+			mse::optional<_TResult> m_result;
+		};
+		template<>
+		class TAsyncSharedResultHolder<void> {
+		public:
+			template<class _TFunction, class _TLockPointer>
+			void call(_TFunction& func, _TLockPointer& lock_ptr) { func(lock_ptr); }
+			void set_promise_value(std::promise<void>& promise_ref) { promise_ref.set_value(); }
+		};
+
+		template<class _TFunction, class _TLockPointer>
+		using TAsyncSharedLockFunctionResult = decltype(std::declval<typename std::decay<_TFunction>::type&>()(std::declval<_TLockPointer&>()));
+	}
+
+	namespace impl {
+		/* The mutex type used by the shared objects, given the underlying (recursive shared timed) mutex type. */
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+		template<class _TMutex> using TAsyncSharedMutex = TAsyncSharedQueuedMutex<TInstrumentedSharedTimedMutex<_TMutex> >;
+#else // MSE_ASYNCSHARED_INSTRUMENTATION1
+		template<class _TMutex> using TAsyncSharedMutex = TAsyncSharedQueuedMutex<_TMutex>;
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+	}
+
+	typedef impl::TAsyncSharedMutex<recursive_shared_timed_mutex> async_shared_timed_mutex_type;
+	/* The "ObjectThatYouAreSureHasNoUnprotectedMutables" access requesters (which take shared locks for reading) can be
+	given this as their (optional) second template parameter, to use striped_recursive_shared_timed_mutex. Worth
+	considering for objects that are read by many threads at once. (The other access requesters always lock exclusively,
+	and so wouldn't benefit.) */
+	typedef impl::TAsyncSharedMutex<striped_recursive_shared_timed_mutex> async_shared_striped_timed_mutex_type;
+
+	namespace impl {
+		class CAsyncSharedMultiLocker;
+	}
 
 	template<typename _Ty> class TAsyncSharedReadWriteAccessRequester;
 	template<typename _Ty> class TAsyncSharedReadWritePointer;
@@ -290,14 +1265,14 @@ namespace mse {
 	template<typename _Ty> class TAsyncSharedReadOnlyAccessRequester;
 	template<typename _Ty> class TAsyncSharedReadOnlyConstPointer;
 
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester;
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer;
+	template<typename _Ty, class _TMutex = async_shared_timed_mutex_type> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester;
+	template<typename _Ty, class _TMutex = async_shared_timed_mutex_type> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer;
+	template<typename _Ty, class _TMutex = async_shared_timed_mutex_type> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer;
+	template<typename _Ty, class _TMutex = async_shared_timed_mutex_type> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester;
+	template<typename _Ty, class _TMutex = async_shared_timed_mutex_type> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer;
 
 	/* TAsyncSharedObj is intended as a transparent wrapper for other classes/objects. */
-	template<typename _TROy>
+	template<typename _TROy, class _TMutex = async_shared_timed_mutex_type>
 	class TAsyncSharedObj : public _TROy {
 	public:
 		MSE_ASYNC_USING(TAsyncSharedObj, _TROy);
@@ -320,7 +1295,7 @@ namespace mse {
 			return this;
 		}
 
-		mutable async_shared_timed_mutex_type m_mutex1;
+		mutable _TMutex m_mutex1;
 
 		friend class TAsyncSharedReadWriteAccessRequester<_TROy>;
 		friend class TAsyncSharedReadWritePointer<_TROy>;
@@ -328,11 +1303,12 @@ namespace mse {
 		friend class TAsyncSharedReadOnlyAccessRequester<_TROy>;
 		friend class TAsyncSharedReadOnlyConstPointer<_TROy>;
 
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_TROy>;
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_TROy>;
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_TROy>;
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_TROy>;
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_TROy>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_TROy, _TMutex>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_TROy, _TMutex>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_TROy, _TMutex>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_TROy, _TMutex>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_TROy, _TMutex>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
 
@@ -361,21 +1337,22 @@ namespace mse {
 		}
 	private:
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
+		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::adopt_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::adopt_lock) {}
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedReadWritePointer<_Ty>& operator=(const TAsyncSharedReadWritePointer<_Ty>& _Right_cref) = delete;
@@ -393,6 +1370,7 @@ namespace mse {
 
 		friend class TAsyncSharedReadWriteAccessRequester<_Ty>;
 		friend class TAsyncSharedReadWriteConstPointer<_Ty>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
 	template<typename _Ty>
@@ -419,21 +1397,22 @@ namespace mse {
 		}
 	private:
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
+		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::adopt_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::adopt_lock) {}
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedReadWriteConstPointer<_Ty>& operator=(const TAsyncSharedReadWriteConstPointer<_Ty>& _Right_cref) = delete;
@@ -450,6 +1429,7 @@ namespace mse {
 		std::unique_lock<async_shared_timed_mutex_type> m_unique_lock;
 
 		friend class TAsyncSharedReadWriteAccessRequester<_Ty>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
 	template<typename _Ty>
@@ -510,6 +1490,26 @@ namespace mse {
 			return retval;
 		}
 
+		/* The async_*lock_ptr() functions don't block. They queue a request for the lock and return a std::future<> for
+		the result of the given function, which will be called (from another thread) with the lock pointer once the lock is
+		obtained. The lock is released when the function returns. Asynchronous requests (for the same object) are granted in
+		the order they were made. The requests are serviced by the given "executor" (a callable object accepting a
+		std::function<void()>), for example, a thread pool or an event loop's task queue. (No threads are created
+		implicitly.) The executor's tasks never block waiting for the lock, so a pool of any size (including one thread)
+		can't deadlock. When the lock isn't available, the task just returns, and the request is resubmitted to the executor
+		by whichever thread next releases the lock. (So the executor may be called from any such thread.) Once a request
+		has failed to obtain the lock, new (non-recursive) synchronous acquisitions of the lock wait until it has, so that
+		a steady stream of synchronous lock holders can't starve it. (So a thread that the executor depends on, such as an
+		event loop's own thread, shouldn't block on the object's lock while one of its requests is waiting.) */
+		template<class _TExecutor, class _TFunction>
+		auto async_writelock_ptr(_TExecutor&& executor, _TFunction&& func) -> std::future<impl::TAsyncSharedLockFunctionResult<_TFunction, TAsyncSharedReadWritePointer<_Ty>>> {
+			return async_lock_ptr<TAsyncSharedReadWritePointer<_Ty>>(std::forward<_TExecutor>(executor), std::forward<_TFunction>(func));
+		}
+		template<class _TExecutor, class _TFunction>
+		auto async_readlock_ptr(_TExecutor&& executor, _TFunction&& func) -> std::future<impl::TAsyncSharedLockFunctionResult<_TFunction, TAsyncSharedReadWriteConstPointer<_Ty>>> {
+			return async_lock_ptr<TAsyncSharedReadWriteConstPointer<_Ty>>(std::forward<_TExecutor>(executor), std::forward<_TFunction>(func));
+		}
+
 		template <class... Args>
 		static TAsyncSharedReadWriteAccessRequester make(Args&&... args) {
 			//auto shptr = std::make_shared<TAsyncSharedObj<_Ty>>(std::forward<Args>(args)...);
@@ -521,12 +1521,75 @@ namespace mse {
 	private:
 		TAsyncSharedReadWriteAccessRequester(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr) {}
 
+		template<class _TLockPointer, class _TExecutor, class _TFunction>
+		class TAsyncLockRequest : public impl::CAsyncSharedLockQueue::CRequestBase {
+		public:
+			typedef impl::TAsyncSharedLockFunctionResult<_TFunction, _TLockPointer> result_t;
+
+			TAsyncLockRequest(const std::shared_ptr<TAsyncSharedObj<_Ty>>& shptr, _TExecutor&& executor, _TFunction&& func)
+				: m_shptr(shptr), m_executor(std::forward<_TExecutor>(executor)), m_func(std::forward<_TFunction>(func)) {}
+
+			virtual void submit(const impl::CAsyncSharedLockQueue::request_shptr_t& self_shptr) {
+				auto dispatch_shptr = std::make_shared<impl::CAsyncSharedLockRequestDispatch>(queue_ref(), self_shptr);
+				try {
+					m_executor(std::function<void()>([dispatch_shptr]() { (*dispatch_shptr).run(); }));
+				}
+				catch (...) {
+					/* This may be called while releasing a lock (i.e. from a destructor). If the executor fails to take the
+					task, the task is destroyed without being run, so the request is abandoned (and the future reports a
+					broken promise). */
+				}
+			}
+			virtual void attempt() {
+				auto& mutex_ref = (*m_shptr).m_mutex1;
+				while (true) {
+					const auto release_count = queue_ref().release_count();
+					if (mutex_ref.front_request_try_lock()) {
+						queue_ref().on_acquired(this);
+						try {
+							impl::TAsyncSharedResultHolder<result_t> result_holder;
+							{
+								_TLockPointer lock_ptr(m_shptr, std::adopt_lock);
+								result_holder.call(m_func, lock_ptr);
+							}
+							result_holder.set_promise_value(m_promise);
+						}
+						catch (...) {
+							m_promise.set_exception(std::current_exception());
+						}
+						return;
+					}
+					if (!queue_ref().on_failed_attempt(this, release_count)) {
+						return;
+					}
+				}
+			}
+
+			std::promise<result_t> m_promise;
+		private:
+			impl::CAsyncSharedLockQueue& queue_ref() const { return (*m_shptr).m_mutex1.m_async_lock_queue; }
+
+			std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
+			typename std::decay<_TExecutor>::type m_executor;
+			typename std::decay<_TFunction>::type m_func;
+		};
+
+		template<class _TLockPointer, class _TExecutor, class _TFunction>
+		auto async_lock_ptr(_TExecutor&& executor, _TFunction&& func) -> std::future<impl::TAsyncSharedLockFunctionResult<_TFunction, _TLockPointer>> {
+			typedef TAsyncLockRequest<_TLockPointer, _TExecutor, _TFunction> request_t;
+			auto request_shptr = std::make_shared<request_t>(m_shptr, std::forward<_TExecutor>(executor), std::forward<_TFunction>(func));
+			auto retval = (*request_shptr).m_promise.get_future();
+			(*m_shptr).m_mutex1.m_async_lock_queue.enqueue(request_shptr);
+			return retval;
+		}
+
 		TAsyncSharedReadWriteAccessRequester<_Ty>* operator&() { return this; }
 		const TAsyncSharedReadWriteAccessRequester<_Ty>* operator&() const { return this; }
 
 		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
 
 		friend class TAsyncSharedReadOnlyAccessRequester<_Ty>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
 	template <class X, class... Args>
@@ -558,21 +1621,22 @@ namespace mse {
 		}
 	private:
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
+		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr, std::adopt_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::adopt_lock) {}
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
 		TAsyncSharedReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		TAsyncSharedReadOnlyConstPointer<_Ty>& operator=(const TAsyncSharedReadOnlyConstPointer<_Ty>& _Right_cref) = delete;
@@ -589,6 +1653,7 @@ namespace mse {
 		std::unique_lock<async_shared_timed_mutex_type> m_unique_lock;
 
 		friend class TAsyncSharedReadOnlyAccessRequester<_Ty>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
 	template<typename _Ty>
@@ -639,6 +1704,8 @@ namespace mse {
 		const TAsyncSharedReadOnlyAccessRequester<_Ty>* operator&() const { return this; }
 
 		std::shared_ptr<const TAsyncSharedObj<_Ty>> m_shptr;
+
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
 	template <class X, class... Args>
@@ -647,9 +1714,9 @@ namespace mse {
 	}
 
 
-	template<typename _Ty> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer;
+	template<typename _Ty, class _TMutex> class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer;
 
-	template<typename _Ty>
+	template<typename _Ty, class _TMutex>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1) {}
@@ -661,160 +1728,164 @@ namespace mse {
 			return m_shptr.operator bool();
 		}
 		typename std::conditional<std::is_const<_Ty>::value
-			, const TAsyncSharedObj<_Ty>&, TAsyncSharedObj<_Ty>&>::type operator*() const {
+			, const TAsyncSharedObj<_Ty, _TMutex>&, TAsyncSharedObj<_Ty, _TMutex>&>::type operator*() const {
 			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer")); }
 			return (*m_shptr);
 		}
 		typename std::conditional<std::is_const<_Ty>::value
-			, const TAsyncSharedObj<_Ty>*, TAsyncSharedObj<_Ty>*>::type operator->() const {
+			, const TAsyncSharedObj<_Ty, _TMutex>*, TAsyncSharedObj<_Ty, _TMutex>*>::type operator->() const {
 			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer")); }
 			return std::addressof(*m_shptr);
 		}
 	private:
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::adopt_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::adopt_lock) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_unique_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& _Right_cref) = delete;
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>&& _Right) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>& _Right_cref) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>&& _Right) = delete;
 
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>* operator&() { return this; }
-		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>* operator&() const { return this; }
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>* operator&() const { return this; }
 		bool is_valid() const {
 			bool retval = m_shptr.operator bool();
 			return retval;
 		}
 
-		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
-		std::unique_lock<async_shared_timed_mutex_type> m_unique_lock;
+		std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> m_shptr;
+		std::unique_lock<_TMutex> m_unique_lock;
 
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>;
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
-	template<typename _Ty>
+	template<typename _Ty, class _TMutex>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer& src) : m_shptr(src.m_shptr), m_shared_lock(src.m_shptr->m_mutex1) {}
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer&& src) = default;
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>& src) : m_shptr(src.m_shptr), m_shared_lock(src.m_shptr->m_mutex1) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>& src) : m_shptr(src.m_shptr), m_shared_lock(src.m_shptr->m_mutex1) {}
 		virtual ~TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer() {}
 
 		operator bool() const {
 			//assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer")); }
 			return m_shptr.operator bool();
 		}
-		const TAsyncSharedObj<const _Ty>& operator*() const {
+		const TAsyncSharedObj<const _Ty, _TMutex>& operator*() const {
 			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer")); }
-			const TAsyncSharedObj<const _Ty>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty>*>(std::addressof(*m_shptr));
+			const TAsyncSharedObj<const _Ty, _TMutex>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty, _TMutex>*>(std::addressof(*m_shptr));
 			return (*extra_const_ptr);
 		}
-		const TAsyncSharedObj<const _Ty>* operator->() const {
+		const TAsyncSharedObj<const _Ty, _TMutex>* operator->() const {
 			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer")); }
-			const TAsyncSharedObj<const _Ty>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty>*>(std::addressof(*m_shptr));
+			const TAsyncSharedObj<const _Ty, _TMutex>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty, _TMutex>*>(std::addressof(*m_shptr));
 			return extra_const_ptr;
 		}
 	private:
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1) {}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::adopt_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::adopt_lock) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& _Right_cref) = delete;
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>&& _Right) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>& _Right_cref) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>&& _Right) = delete;
 
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>* operator&() { return this; }
-		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>* operator&() const { return this; }
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>* operator&() const { return this; }
 		bool is_valid() const {
 			bool retval = m_shptr.operator bool();
 			return retval;
 		}
 
-		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
-		std::shared_lock<async_shared_timed_mutex_type> m_shared_lock;
+		std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> m_shptr;
+		std::shared_lock<_TMutex> m_shared_lock;
 
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
-	template<typename _Ty>
+	template<typename _Ty, class _TMutex>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester& src_cref) = default;
 
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty> writelock_ptr() {
-			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>(m_shptr);
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex> writelock_ptr() {
+			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>(m_shptr);
 		}
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> try_writelock_ptr() {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>(m_shptr, std::try_to_lock));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>> try_writelock_ptr() {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>(m_shptr, std::try_to_lock));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
 			return retval;
 		}
 		template<class _Rep, class _Period>
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> try_writelock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>(m_shptr, std::try_to_lock, _Rel_time));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>> try_writelock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>(m_shptr, std::try_to_lock, _Rel_time));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
 			return retval;
 		}
 		template<class _Clock, class _Duration>
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> try_writelock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty>(m_shptr, std::try_to_lock, _Abs_time));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>> try_writelock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>(m_shptr, std::try_to_lock, _Abs_time));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
 			return retval;
 		}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty> readlock_ptr() {
-			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>(m_shptr);
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex> readlock_ptr() {
+			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>(m_shptr);
 		}
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> try_readlock_ptr() {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>(m_shptr, std::try_to_lock));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>> try_readlock_ptr() {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>(m_shptr, std::try_to_lock));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
 			return retval;
 		}
 		template<class _Rep, class _Period>
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>(m_shptr, std::try_to_lock, _Rel_time));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>(m_shptr, std::try_to_lock, _Rel_time));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
 			return retval;
 		}
 		template<class _Clock, class _Duration>
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty>(m_shptr, std::try_to_lock, _Abs_time));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>(m_shptr, std::try_to_lock, _Abs_time));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
@@ -823,28 +1894,30 @@ namespace mse {
 
 		template <class... Args>
 		static TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester make(Args&&... args) {
-			//auto shptr = std::make_shared<TAsyncSharedObj<_Ty>>(std::forward<Args>(args)...);
-			std::shared_ptr<TAsyncSharedObj<_Ty>> shptr(new TAsyncSharedObj<_Ty>(std::forward<Args>(args)...));
+			//auto shptr = std::make_shared<TAsyncSharedObj<_Ty, _TMutex>>(std::forward<Args>(args)...);
+			std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr(new TAsyncSharedObj<_Ty, _TMutex>(std::forward<Args>(args)...));
 			TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester retval(shptr);
 			return retval;
 		}
 
 	private:
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr) : m_shptr(shptr) {}
 
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>* operator&() { return this; }
-		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>* operator&() const { return this; }
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>* operator&() const { return this; }
 
-		std::shared_ptr<TAsyncSharedObj<_Ty>> m_shptr;
+		std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> m_shptr;
+
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
-	template <class X, class... Args>
-	TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<X> make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite(Args&&... args) {
-		return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<X>::make(std::forward<Args>(args)...);
+	template <class X, class _TMutex = async_shared_timed_mutex_type, class... Args>
+	TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<X, _TMutex> make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite(Args&&... args) {
+		return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<X, _TMutex>::make(std::forward<Args>(args)...);
 	}
 
 
-	template<typename _Ty>
+	template<typename _Ty, class _TMutex>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer& src) : m_shptr(src.m_shptr), m_shared_lock(src.m_shptr->m_mutex1) {}
@@ -855,78 +1928,80 @@ namespace mse {
 			//assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer")); }
 			return m_shptr.operator bool();
 		}
-		const TAsyncSharedObj<const _Ty>& operator*() const {
+		const TAsyncSharedObj<const _Ty, _TMutex>& operator*() const {
 			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer")); }
-			const TAsyncSharedObj<const _Ty>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty>*>(std::addressof(*m_shptr));
+			const TAsyncSharedObj<const _Ty, _TMutex>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty, _TMutex>*>(std::addressof(*m_shptr));
 			return (*extra_const_ptr);
 		}
-		const TAsyncSharedObj<const _Ty>* operator->() const {
+		const TAsyncSharedObj<const _Ty, _TMutex>* operator->() const {
 			assert(is_valid()); //{ MSE_THROW(asyncshared_use_of_invalid_pointer_error("attempt to use invalid pointer - mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer")); }
-			const TAsyncSharedObj<const _Ty>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty>*>(std::addressof(*m_shptr));
+			const TAsyncSharedObj<const _Ty, _TMutex>* extra_const_ptr = reinterpret_cast<const TAsyncSharedObj<const _Ty, _TMutex>*>(std::addressof(*m_shptr));
 			return extra_const_ptr;
 		}
 	private:
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1) {}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty, _TMutex>> shptr) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<const TAsyncSharedObj<_Ty, _TMutex>> shptr, std::adopt_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::adopt_lock) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock()) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Rep, class _Period>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_for(_Rel_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
 		template<class _Clock, class _Duration>
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer(std::shared_ptr<TAsyncSharedObj<_Ty, _TMutex>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_shared_lock(shptr->m_mutex1, std::defer_lock) {
 			if (!m_shared_lock.try_lock_until(_Abs_time)) {
-				shptr = nullptr;
+				m_shptr = nullptr;
 			}
 		}
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& _Right_cref) = delete;
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>&& _Right) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>& operator=(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>& _Right_cref) = delete;
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>& operator=(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>&& _Right) = delete;
 
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>* operator&() { return this; }
-		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>* operator&() const { return this; }
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>* operator&() const { return this; }
 		bool is_valid() const {
 			bool retval = m_shptr.operator bool();
 			return retval;
 		}
 
-		std::shared_ptr<const TAsyncSharedObj<_Ty>> m_shptr;
-		std::shared_lock<async_shared_timed_mutex_type> m_shared_lock;
+		std::shared_ptr<const TAsyncSharedObj<_Ty, _TMutex>> m_shptr;
+		std::shared_lock<_TMutex> m_shared_lock;
 
-		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>;
+		friend class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty, _TMutex>;
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
-	template<typename _Ty>
+	template<typename _Ty, class _TMutex>
 	class TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester {
 	public:
 		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester& src_cref) = default;
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty>& src_cref) : m_shptr(src_cref.m_shptr) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>& src_cref) : m_shptr(src_cref.m_shptr) {}
 
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty> readlock_ptr() {
-			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr);
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex> readlock_ptr() {
+			return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>(m_shptr);
 		}
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr() {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr, std::try_to_lock));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>> try_readlock_ptr() {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>(m_shptr, std::try_to_lock));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
 			return retval;
 		}
 		template<class _Rep, class _Period>
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr, std::try_to_lock, _Rel_time));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>> try_readlock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>(m_shptr, std::try_to_lock, _Rel_time));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
 			return retval;
 		}
 		template<class _Clock, class _Duration>
-		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
-			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty>(m_shptr, std::try_to_lock, _Abs_time));
+		mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>> try_readlock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			mse::optional<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>> retval(TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>(m_shptr, std::try_to_lock, _Abs_time));
 			if (!((*retval).is_valid())) {
 				return{};
 			}
@@ -935,26 +2010,463 @@ namespace mse {
 
 		template <class... Args>
 		static TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester make(Args&&... args) {
-			//auto shptr = std::make_shared<const TAsyncSharedObj<_Ty>>(std::forward<Args>(args)...);
-			std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr(new const TAsyncSharedObj<_Ty>(std::forward<Args>(args)...));
+			//auto shptr = std::make_shared<const TAsyncSharedObj<_Ty, _TMutex>>(std::forward<Args>(args)...);
+			std::shared_ptr<const TAsyncSharedObj<_Ty, _TMutex>> shptr(new const TAsyncSharedObj<_Ty, _TMutex>(std::forward<Args>(args)...));
 			TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester retval(shptr);
 			return retval;
 		}
 
 	private:
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(std::shared_ptr<const TAsyncSharedObj<_Ty>> shptr) : m_shptr(shptr) {}
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester(std::shared_ptr<const TAsyncSharedObj<_Ty, _TMutex>> shptr) : m_shptr(shptr) {}
 
-		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>* operator&() { return this; }
-		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty>* operator&() const { return this; }
+		TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty, _TMutex>* operator&() { return this; }
+		const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty, _TMutex>* operator&() const { return this; }
 
-		std::shared_ptr<const TAsyncSharedObj<_Ty>> m_shptr;
+		std::shared_ptr<const TAsyncSharedObj<_Ty, _TMutex>> m_shptr;
+
+		friend class impl::CAsyncSharedMultiLocker;
+	};
+
+	template <class X, class _TMutex = async_shared_timed_mutex_type, class... Args>
+	TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<X, _TMutex> make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadonly(Args&&... args) {
+		return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<X, _TMutex>::make(std::forward<Args>(args)...);
+	}
+
+
+	template<typename _Ty> class TAsyncSharedTriviallyCopyableReadWriteAccessRequester;
+	template<typename _Ty> class TAsyncSharedTriviallyCopyableReadWritePointer;
+
+	/* TAsyncSharedTriviallyCopyableObj is the shared state behind TAsyncSharedTriviallyCopyableReadWriteAccessRequester.
+	Writers (holding the mutex) work on m_write_buffer. When the outermost write lock is released, the value is "published"
+	into an array of atomic words, bracketed by a sequence (version) number that is odd while the publish is in progress.
+	Readers copy the published words without taking any lock, and simply retry if the sequence number changed while they
+	were copying. */
+	template<typename _Ty>
+	class TAsyncSharedTriviallyCopyableObj {
+	public:
+		static_assert(std::is_trivially_copyable<_Ty>::value, "TAsyncSharedTriviallyCopyable types require a trivially copyable target type");
+
+		template <class... Args>
+		TAsyncSharedTriviallyCopyableObj(Args&&... args) : m_write_buffer(std::forward<Args>(args)...) {
+			publish();
+		}
+
+	private:
+		TAsyncSharedTriviallyCopyableObj(const TAsyncSharedTriviallyCopyableObj&) = delete;
+		TAsyncSharedTriviallyCopyableObj& operator=(const TAsyncSharedTriviallyCopyableObj&) = delete;
+
+		typedef std::uintptr_t word_t;
+		static const size_t sc_num_words = (sizeof(_Ty) + sizeof(word_t) - 1) / sizeof(word_t);
+		struct alignas(_Ty) alignas(word_t) CWordBuffer {
+			word_t m_words[sc_num_words];
+		};
+		/* A local _Ty that can be filled with std::memcpy(). (_Ty is trivially copyable, but isn't required to be default
+		constructible.) */
+		union CValueBuffer {
+			CValueBuffer() {}
+			_Ty m_value;
+		};
+
+		/* Must only be called by a thread holding (the outermost) write lock. */
+		void publish() {
+			CWordBuffer word_buffer;
+			/* If sizeof(_Ty) isn't a multiple of the word size, the memcpy() doesn't cover the trailing bytes of the last word. */
+			word_buffer.m_words[sc_num_words - 1] = 0;
+			std::memcpy(word_buffer.m_words, std::addressof(m_write_buffer), sizeof(_Ty));
+			const auto sequence = m_sequence.load(std::memory_order_relaxed);
+			m_sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for (size_t i = 0; i < sc_num_words; i += 1) {
+				m_published_words[i].store(word_buffer.m_words[i], std::memory_order_relaxed);
+			}
+			m_sequence.store(sequence + 2, std::memory_order_release);
+		}
+
+		_Ty optimistic_read() const {
+			CWordBuffer word_buffer;
+			size_t num_attempts = 0;
+			while (true) {
+				const auto sequence1 = m_sequence.load(std::memory_order_acquire);
+				if (0 == (sequence1 & 1)) {
+					for (size_t i = 0; i < sc_num_words; i += 1) {
+						word_buffer.m_words[i] = m_published_words[i].load(std::memory_order_relaxed);
+					}
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (m_sequence.load(std::memory_order_relaxed) == sequence1) {
+						break;
+					}
+				}
+				/* A publish is in progress. Publishing is brief, so we just spin (politely). */
+				num_attempts += 1;
+				if (16 <= num_attempts) {
+					std::this_thread::yield();
+				}
+			}
+			CValueBuffer value_buffer;
+			std::memcpy(std::addressof(value_buffer.m_value), word_buffer.m_words, sizeof(_Ty));
+			return value_buffer.m_value;
+		}
+
+		mutable async_shared_timed_mutex_type m_mutex1;
+		_Ty m_write_buffer;
+		int m_writelock_depth = 0;
+
+		std::atomic<size_t> m_sequence{ 0 };
+		std::atomic<word_t> m_published_words[sc_num_words];
+
+		friend class TAsyncSharedTriviallyCopyableReadWriteAccessRequester<_Ty>;
+		friend class TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>;
+		friend class impl::CAsyncSharedMultiLocker;
+	};
+
+	template<typename _Ty>
+	class TAsyncSharedTriviallyCopyableReadWritePointer {
+	public:
+		TAsyncSharedTriviallyCopyableReadWritePointer(const TAsyncSharedTriviallyCopyableReadWritePointer& src) : m_shptr(src.m_shptr), m_unique_lock(src.m_shptr->m_mutex1) {
+			note_writelock_acquired();
+		}
+		TAsyncSharedTriviallyCopyableReadWritePointer(TAsyncSharedTriviallyCopyableReadWritePointer&& src) = default;
+		virtual ~TAsyncSharedTriviallyCopyableReadWritePointer() {
+			if (m_unique_lock.owns_lock()) {
+				assert(1 <= m_shptr->m_writelock_depth);
+				m_shptr->m_writelock_depth -= 1;
+				if (0 == m_shptr->m_writelock_depth) {
+					m_shptr->publish();
+				}
+			}
+		}
+
+		operator bool() const {
+			return m_shptr.operator bool();
+		}
+		_Ty& operator*() const {
+			assert(is_valid());
+			return m_shptr->m_write_buffer;
+		}
+		_Ty* operator->() const {
+			assert(is_valid());
+			return std::addressof(m_shptr->m_write_buffer);
+		}
+	private:
+		TAsyncSharedTriviallyCopyableReadWritePointer(std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> shptr) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1) {
+			note_writelock_acquired();
+		}
+		TAsyncSharedTriviallyCopyableReadWritePointer(std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> shptr, std::adopt_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::adopt_lock) {
+			note_writelock_acquired();
+		}
+		TAsyncSharedTriviallyCopyableReadWritePointer(std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> shptr, std::try_to_lock_t) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
+			if (m_unique_lock.try_lock()) {
+				note_writelock_acquired();
+			}
+		}
+		template<class _Rep, class _Period>
+		TAsyncSharedTriviallyCopyableReadWritePointer(std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::duration<_Rep, _Period>& _Rel_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
+			if (m_unique_lock.try_lock_for(_Rel_time)) {
+				note_writelock_acquired();
+			}
+		}
+		template<class _Clock, class _Duration>
+		TAsyncSharedTriviallyCopyableReadWritePointer(std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> shptr, std::try_to_lock_t, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) : m_shptr(shptr), m_unique_lock(shptr->m_mutex1, std::defer_lock) {
+			if (m_unique_lock.try_lock_until(_Abs_time)) {
+				note_writelock_acquired();
+			}
+		}
+		TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>& operator=(const TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>& _Right_cref) = delete;
+		TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>& operator=(TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>&& _Right) = delete;
+
+		TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>* operator&() { return this; }
+		const TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>* operator&() const { return this; }
+		bool is_valid() const {
+			bool retval = (m_shptr.operator bool()) && m_unique_lock.owns_lock();
+			return retval;
+		}
+		void note_writelock_acquired() {
+			m_shptr->m_writelock_depth += 1;
+		}
+
+		std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> m_shptr;
+		std::unique_lock<async_shared_timed_mutex_type> m_unique_lock;
+
+		friend class TAsyncSharedTriviallyCopyableReadWriteAccessRequester<_Ty>;
+		friend class impl::CAsyncSharedMultiLocker;
+	};
+
+	/* TAsyncSharedTriviallyCopyableReadWriteAccessRequester is for (small) trivially copyable objects (counters, configuration
+	snapshots, etc.) whose reads are too frequent, and too cheap, to justify taking a lock each time. Writers get the usual
+	writelock_ptr() (and try_writelock_ptr*()) interface. Readers don't lock at all. optimistic_read() returns a copy of the
+	object as of the last released write lock. Readers never block writers (or each other), and don't write to any shared
+	memory. Modifications made through a write lock pointer become visible to readers when the (outermost) write lock is
+	released. */
+	template<typename _Ty>
+	class TAsyncSharedTriviallyCopyableReadWriteAccessRequester {
+	public:
+		TAsyncSharedTriviallyCopyableReadWriteAccessRequester(const TAsyncSharedTriviallyCopyableReadWriteAccessRequester& src_cref) = default;
+
+		TAsyncSharedTriviallyCopyableReadWritePointer<_Ty> writelock_ptr() {
+			return TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>(m_shptr);
+		}
+		mse::optional<TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>> try_writelock_ptr() {
+			mse::optional<TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>> retval(TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>(m_shptr, std::try_to_lock));
+			if (!((*retval).is_valid())) {
+				return{};
+			}
+			return retval;
+		}
+		template<class _Rep, class _Period>
+		mse::optional<TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>> try_writelock_ptr_for(const std::chrono::duration<_Rep, _Period>& _Rel_time) {
+			mse::optional<TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>> retval(TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>(m_shptr, std::try_to_lock, _Rel_time));
+			if (!((*retval).is_valid())) {
+				return{};
+			}
+			return retval;
+		}
+		template<class _Clock, class _Duration>
+		mse::optional<TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>> try_writelock_ptr_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+			mse::optional<TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>> retval(TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>(m_shptr, std::try_to_lock, _Abs_time));
+			if (!((*retval).is_valid())) {
+				return{};
+			}
+			return retval;
+		}
+		_Ty optimistic_read() const {
+			return m_shptr->optimistic_read();
+		}
+
+		template <class... Args>
+		static TAsyncSharedTriviallyCopyableReadWriteAccessRequester make(Args&&... args) {
+			std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> shptr = std::make_shared<TAsyncSharedTriviallyCopyableObj<_Ty>>(std::forward<Args>(args)...);
+			TAsyncSharedTriviallyCopyableReadWriteAccessRequester retval(shptr);
+			return retval;
+		}
+
+	private:
+		TAsyncSharedTriviallyCopyableReadWriteAccessRequester(std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> shptr) : m_shptr(shptr) {}
+
+		TAsyncSharedTriviallyCopyableReadWriteAccessRequester<_Ty>* operator&() { return this; }
+		const TAsyncSharedTriviallyCopyableReadWriteAccessRequester<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<TAsyncSharedTriviallyCopyableObj<_Ty>> m_shptr;
+
+		friend class impl::CAsyncSharedMultiLocker;
 	};
 
 	template <class X, class... Args>
-	TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<X> make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadonly(Args&&... args) {
-		return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<X>::make(std::forward<Args>(args)...);
+	TAsyncSharedTriviallyCopyableReadWriteAccessRequester<X> make_asyncsharedtriviallycopyablereadwrite(Args&&... args) {
+		return TAsyncSharedTriviallyCopyableReadWriteAccessRequester<X>::make(std::forward<Args>(args)...);
+	}
+
+
+	/* mse::readlock_request() designates an access requester, passed to mse::lock_all() (and friends), that should
+	yield a "readlock" (const) pointer rather than a "writelock" pointer. */
+	template<typename _TAccessRequester>
+	class TAsyncSharedReadLockRequest {
+	public:
+		TAsyncSharedReadLockRequest(const _TAccessRequester& access_requester) : m_access_requester(access_requester) {}
+		const _TAccessRequester m_access_requester;
+	};
+	template<typename _TAccessRequester>
+	TAsyncSharedReadLockRequest<_TAccessRequester> readlock_request(const _TAccessRequester& access_requester) {
+		return TAsyncSharedReadLockRequest<_TAccessRequester>(access_requester);
 	}
 
+	namespace impl {
+		class CAsyncSharedMultiLocker {
+		public:
+			/* The requested objects' mutexes aren't necessarily all of the same type, so each lock item holds (along with
+			the mutex's address) a table of functions for the mutex's type. */
+			class CLockItem {
+			public:
+				typedef std::chrono::steady_clock::time_point time_point_t;
+
+				template<class _TMutex>
+				CLockItem(_TMutex& mutex_ref, bool is_shared) : m_mutex_ptr(std::addressof(mutex_ref)), m_ops_ptr(&TMutexOps<_TMutex>::sc_ops), m_is_shared(is_shared) {}
+
+				void lock() { (*m_ops_ptr).m_lock(m_mutex_ptr, m_is_shared); }
+				bool try_lock() { return (*m_ops_ptr).m_try_lock(m_mutex_ptr, m_is_shared); }
+				bool try_lock_until(const time_point_t& _Abs_time) { return (*m_ops_ptr).m_try_lock_until(m_mutex_ptr, m_is_shared, _Abs_time); }
+				void unlock() { (*m_ops_ptr).m_unlock(m_mutex_ptr, m_is_shared); }
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+				void set_instrumentation_name(const std::string& name) { (*m_ops_ptr).m_set_instrumentation_name(m_mutex_ptr, name); }
+				CAsyncSharedLockStats::CSnapshot instrumentation_stats() const { return (*m_ops_ptr).m_instrumentation_stats(m_mutex_ptr); }
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+
+			private:
+				struct COps {
+					void(*m_lock)(void* mutex_ptr, bool is_shared);
+					bool(*m_try_lock)(void* mutex_ptr, bool is_shared);
+					bool(*m_try_lock_until)(void* mutex_ptr, bool is_shared, const time_point_t& _Abs_time);
+					void(*m_unlock)(void* mutex_ptr, bool is_shared);
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					void(*m_set_instrumentation_name)(void* mutex_ptr, const std::string& name);
+					CAsyncSharedLockStats::CSnapshot(*m_instrumentation_stats)(void* mutex_ptr);
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+				};
+				template<class _TMutex>
+				struct TMutexOps {
+					static _TMutex& mutex_ref(void* mutex_ptr) { return *static_cast<_TMutex*>(mutex_ptr); }
+					static void lock(void* mutex_ptr, bool is_shared) {
+						if (is_shared) { mutex_ref(mutex_ptr).lock_shared(); } else { mutex_ref(mutex_ptr).lock(); }
+					}
+					static bool try_lock(void* mutex_ptr, bool is_shared) {
+						return is_shared ? mutex_ref(mutex_ptr).try_lock_shared() : mutex_ref(mutex_ptr).try_lock();
+					}
+					static bool try_lock_until(void* mutex_ptr, bool is_shared, const time_point_t& _Abs_time) {
+						return is_shared ? mutex_ref(mutex_ptr).try_lock_shared_until(_Abs_time) : mutex_ref(mutex_ptr).try_lock_until(_Abs_time);
+					}
+					static void unlock(void* mutex_ptr, bool is_shared) {
+						if (is_shared) { mutex_ref(mutex_ptr).unlock_shared(); } else { mutex_ref(mutex_ptr).unlock(); }
+					}
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+					static void set_instrumentation_name(void* mutex_ptr, const std::string& name) { mutex_ref(mutex_ptr).set_instrumentation_name(name); }
+					static CAsyncSharedLockStats::CSnapshot instrumentation_stats(void* mutex_ptr) { return mutex_ref(mutex_ptr).instrumentation_stats(); }
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+					static const COps sc_ops;
+				};
+
+				void* m_mutex_ptr = nullptr;
+				const COps* m_ops_ptr = nullptr;
+				bool m_is_shared = false;
+			};
+
+			template<typename _Ty> static CLockItem lock_item(const TAsyncSharedReadWriteAccessRequester<_Ty>& src) { return CLockItem(src.m_shptr->m_mutex1, false); }
+			template<typename _Ty> static CLockItem lock_item(const TAsyncSharedReadLockRequest<TAsyncSharedReadWriteAccessRequester<_Ty>>& src) { return CLockItem(src.m_access_requester.m_shptr->m_mutex1, false); }
+			template<typename _Ty> static CLockItem lock_item(const TAsyncSharedReadOnlyAccessRequester<_Ty>& src) { return CLockItem(src.m_shptr->m_mutex1, false); }
+			template<typename _Ty, class _TMutex> static CLockItem lock_item(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>& src) { return CLockItem(src.m_shptr->m_mutex1, false); }
+			template<typename _Ty, class _TMutex> static CLockItem lock_item(const TAsyncSharedReadLockRequest<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>>& src) { return CLockItem(src.m_access_requester.m_shptr->m_mutex1, true); }
+			template<typename _Ty, class _TMutex> static CLockItem lock_item(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty, _TMutex>& src) { return CLockItem(src.m_shptr->m_mutex1, true); }
+			template<typename _Ty> static CLockItem lock_item(const TAsyncSharedTriviallyCopyableReadWriteAccessRequester<_Ty>& src) { return CLockItem(src.m_shptr->m_mutex1, false); }
+
+			/* These must correspond to the lock_item()s above. They construct the lock pointers that take ownership of the
+			(already acquired) locks. */
+			template<typename _Ty> static TAsyncSharedReadWritePointer<_Ty> adopted_lock_ptr(const TAsyncSharedReadWriteAccessRequester<_Ty>& src) { return TAsyncSharedReadWritePointer<_Ty>(src.m_shptr, std::adopt_lock); }
+			template<typename _Ty> static TAsyncSharedReadWriteConstPointer<_Ty> adopted_lock_ptr(const TAsyncSharedReadLockRequest<TAsyncSharedReadWriteAccessRequester<_Ty>>& src) { return TAsyncSharedReadWriteConstPointer<_Ty>(src.m_access_requester.m_shptr, std::adopt_lock); }
+			template<typename _Ty> static TAsyncSharedReadOnlyConstPointer<_Ty> adopted_lock_ptr(const TAsyncSharedReadOnlyAccessRequester<_Ty>& src) { return TAsyncSharedReadOnlyConstPointer<_Ty>(src.m_shptr, std::adopt_lock); }
+			template<typename _Ty, class _TMutex> static TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex> adopted_lock_ptr(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>& src) { return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<_Ty, _TMutex>(src.m_shptr, std::adopt_lock); }
+			template<typename _Ty, class _TMutex> static TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex> adopted_lock_ptr(const TAsyncSharedReadLockRequest<TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<_Ty, _TMutex>>& src) { return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<_Ty, _TMutex>(src.m_access_requester.m_shptr, std::adopt_lock); }
+			template<typename _Ty, class _TMutex> static TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex> adopted_lock_ptr(const TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyAccessRequester<_Ty, _TMutex>& src) { return TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadOnlyConstPointer<_Ty, _TMutex>(src.m_shptr, std::adopt_lock); }
+			template<typename _Ty> static TAsyncSharedTriviallyCopyableReadWritePointer<_Ty> adopted_lock_ptr(const TAsyncSharedTriviallyCopyableReadWriteAccessRequester<_Ty>& src) { return TAsyncSharedTriviallyCopyableReadWritePointer<_Ty>(src.m_shptr, std::adopt_lock); }
+
+			/* The deadlock avoidance algorithm is the same one typically used by std::lock(). Block on one lock, then just
+			try the rest. If one of them fails, release everything and start over by blocking on the one that failed. So no
+			thread ever blocks while holding any of the locks. */
+			static void lock_items(CLockItem* items, size_t num_items) {
+				size_t first_index = 0;
+				while (!lock_items_starting_with<std::chrono::steady_clock::time_point>(items, num_items, first_index, nullptr)) {
+					std::this_thread::yield();
+				}
+			}
+			static bool try_lock_items(CLockItem* items, size_t num_items) {
+				for (size_t i = 0; i < num_items; i += 1) {
+					if (!items[i].try_lock()) {
+						unlock_items(items, i);
+						return false;
+					}
+				}
+				return true;
+			}
+			template<class _Clock, class _Duration>
+			static bool try_lock_items_until(CLockItem* items, size_t num_items, const std::chrono::time_point<_Clock, _Duration>& _Abs_time) {
+				/* The lock items take steady clock time points. */
+				const CLockItem::time_point_t steady_abs_time = std::chrono::steady_clock::now()
+					+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(_Abs_time - _Clock::now());
+				size_t first_index = 0;
+				bool timed_out = false;
+				while (!lock_items_starting_with(items, num_items, first_index, &steady_abs_time, &timed_out)) {
+					if (timed_out) {
+						return false;
+					}
+					std::this_thread::yield();
+				}
+				return true;
+			}
+
+		private:
+			static void unlock_items(CLockItem* items, size_t num_items) {
+				for (size_t i = 0; i < num_items; i += 1) {
+					items[i].unlock();
+				}
+			}
+			/* On failure, first_index_ref is updated to the index of the lock that couldn't be obtained. */
+			template<class _TTimePoint>
+			static bool lock_items_starting_with(CLockItem* items, size_t num_items, size_t& first_index_ref, const _TTimePoint* abs_time_ptr, bool* timed_out_ptr = nullptr) {
+				if (0 == num_items) {
+					return true;
+				}
+				auto& first_item_ref = items[first_index_ref];
+				if (nullptr == abs_time_ptr) {
+					first_item_ref.lock();
+				}
+				else if (!first_item_ref.try_lock_until(*abs_time_ptr)) {
+					*timed_out_ptr = true;
+					return false;
+				}
+				for (size_t i = 1; i < num_items; i += 1) {
+					const auto index = (first_index_ref + i) % num_items;
+					if (!items[index].try_lock()) {
+						for (size_t j = 0; j < i; j += 1) {
+							items[(first_index_ref + j) % num_items].unlock();
+						}
+						first_index_ref = index;
+						return false;
+					}
+				}
+				return true;
+			}
+		};
+		template<class _TMutex>
+		const CAsyncSharedMultiLocker::CLockItem::COps CAsyncSharedMultiLocker::CLockItem::TMutexOps<_TMutex>::sc_ops = {
+			lock, try_lock, try_lock_until, unlock,
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+			set_instrumentation_name, instrumentation_stats,
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+		};
+	}
+
+	/* mse::lock_all() obtains lock pointers to all the given objects at once, without risk of deadlock (with other threads
+	using lock_all() or acquiring locks one at a time). Access requesters with write access yield writelock pointers,
+	unless wrapped with mse::readlock_request(), in which case they yield readlock pointers. The lock pointers are returned
+	in a std::tuple<>. Note that, as with the individual lock pointers, a thread mustn't request both a readlock and a
+	writelock on the same object. */
+	template<class... _TRequests>
+	auto lock_all(const _TRequests&... requests) -> std::tuple<decltype(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests))...> {
+		impl::CAsyncSharedMultiLocker::CLockItem items[] = { impl::CAsyncSharedMultiLocker::lock_item(requests)... };
+		impl::CAsyncSharedMultiLocker::lock_items(items, sizeof...(requests));
+		return std::tuple<decltype(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests))...>(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests)...);
+	}
+	template<class... _TRequests>
+	auto try_lock_all(const _TRequests&... requests) -> mse::optional<std::tuple<decltype(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests))...>> {
+		impl::CAsyncSharedMultiLocker::CLockItem items[] = { impl::CAsyncSharedMultiLocker::lock_item(requests)... };
+		if (!impl::CAsyncSharedMultiLocker::try_lock_items(items, sizeof...(requests))) {
+			return{};
+		}
+		return std::tuple<decltype(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests))...>(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests)...);
+	}
+	template<class _Clock, class _Duration, class... _TRequests>
+	auto try_lock_all_until(const std::chrono::time_point<_Clock, _Duration>& _Abs_time, const _TRequests&... requests) -> mse::optional<std::tuple<decltype(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests))...>> {
+		impl::CAsyncSharedMultiLocker::CLockItem items[] = { impl::CAsyncSharedMultiLocker::lock_item(requests)... };
+		if (!impl::CAsyncSharedMultiLocker::try_lock_items_until(items, sizeof...(requests), _Abs_time)) {
+			return{};
+		}
+		return std::tuple<decltype(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests))...>(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests)...);
+	}
+	template<class _Rep, class _Period, class... _TRequests>
+	auto try_lock_all_for(const std::chrono::duration<_Rep, _Period>& _Rel_time, const _TRequests&... requests) -> mse::optional<std::tuple<decltype(impl::CAsyncSharedMultiLocker::adopted_lock_ptr(requests))...>> {
+		return try_lock_all_until(std::chrono::steady_clock::now() + _Rel_time, requests...);
+	}
+
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+	/* Gives the shared object (targeted by the given access requester) a name under which its lock stats will be listed in
+	the instrumentation registry. */
+	template<class _TAccessRequester>
+	void set_asyncshared_instrumentation_name(const _TAccessRequester& access_requester, const std::string& name) {
+		impl::CAsyncSharedMultiLocker::lock_item(access_requester).set_instrumentation_name(name);
+	}
+	template<class _TAccessRequester>
+	CAsyncSharedLockStats::CSnapshot asyncshared_instrumentation_stats(const _TAccessRequester& access_requester) {
+		return impl::CAsyncSharedMultiLocker::lock_item(access_requester).instrumentation_stats();
+	}
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
+
 
 	/* For "read-only" situations when you need, or want, the shared object to be managed by std::shared_ptrs we provide a
 	slightly safety enhanced std::shared_ptr wrapper. The wrapper enforces "const"ness and tries to ensure that it always
@@ -995,6 +2507,167 @@ namespace mse {
 	}
 
 
+	template<typename _Ty> class TAsyncSharedSnapshotPublisher;
+	template<typename _Ty> class TAsyncSharedSnapshotReader;
+
+	namespace impl {
+		/* Whether the given (publish()) arguments are just a single (already constructed) version. */
+		template<typename _Ty, class... Args>
+		struct is_single_snapshot_pointer_arg : std::false_type {};
+		template<typename _Ty, class Arg>
+		struct is_single_snapshot_pointer_arg<_Ty, Arg> : std::is_same<typename std::decay<Arg>::type, TStdSharedImmutableFixedPointer<_Ty>> {};
+
+		template<typename _Ty>
+		class TAsyncSharedSnapshotState {
+		public:
+			TAsyncSharedSnapshotState(const TStdSharedImmutableFixedPointer<_Ty>& snapshot_cref) : m_current(snapshot_cref) {}
+
+			void publish(const TStdSharedImmutableFixedPointer<_Ty>& snapshot_cref) {
+				/* The previous version is released (and possibly destroyed) only after the lock is released. */
+				mse::optional<TStdSharedImmutableFixedPointer<_Ty>> previous;
+				{
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					previous.emplace(*m_current);
+					m_current.emplace(snapshot_cref);
+					m_generation.store(m_generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+				}
+			}
+			TStdSharedImmutableFixedPointer<_Ty> current(std::uint64_t* generation_ptr = nullptr) const {
+				std::lock_guard<std::mutex> lock1(m_mutex);
+				if (generation_ptr) {
+					(*generation_ptr) = m_generation.load(std::memory_order_relaxed);
+				}
+				return (*m_current);
+			}
+
+			/* Serializes update()s (read-copy-update) with each other. Publishers that don't update don't take it. */
+			std::mutex m_update_mutex;
+			/* Protects m_current. Held only long enough to copy or replace a (shared) pointer. */
+			mutable std::mutex m_mutex;
+			mse::optional<TStdSharedImmutableFixedPointer<_Ty>> m_current;
+			/* Incremented (while holding m_mutex) each time a new version is published, so that readers can tell whether the
+			snapshot they already hold is current with a single load. */
+			std::atomic<std::uint64_t> m_generation{ 0 };
+		};
+	}
+
+	/* TAsyncSharedSnapshotPublisher is for read-mostly shared data (configuration, routing tables, etc.) whose versions are
+	immutable. Writers build a new version and publish() it, replacing the current version atomically. Readers obtain
+	the current version as a TStdSharedImmutableFixedPointer<> "snapshot", which remains valid (and unchanging) for as
+	long as they hold it, regardless of subsequent publications. A version is destroyed when neither the publisher nor any
+	snapshot refers to it anymore. Like the access requesters, publishers are copyable handles to the same shared state,
+	and may be passed to other threads. And again, beware of sharing objects with mutable members.
+	For frequent reads, each reading thread should use its own TAsyncSharedSnapshotReader (obtained from reader()), which
+	avoids taking any lock as long as no new version has been published. */
+	template<typename _Ty>
+	class TAsyncSharedSnapshotPublisher {
+	public:
+		TAsyncSharedSnapshotPublisher(const TAsyncSharedSnapshotPublisher& src_cref) = default;
+
+		/* Publishes a new version constructed from the given arguments. (A TStdSharedImmutableFixedPointer<_Ty> argument,
+		whatever its value category, is published as is by the overload below.) */
+		template <class... Args, class = typename std::enable_if<!impl::is_single_snapshot_pointer_arg<_Ty, Args...>::value>::type>
+		void publish(Args&&... args) {
+			(*m_shptr).publish(TStdSharedImmutableFixedPointer<_Ty>::make(std::forward<Args>(args)...));
+		}
+		void publish(const TStdSharedImmutableFixedPointer<_Ty>& snapshot_cref) {
+			(*m_shptr).publish(snapshot_cref);
+		}
+		/* Publishes the version returned by the given function when called with (a const reference to) the current version.
+		Concurrent update()s are serialized, so none of them are lost. */
+		template<class _TFunction>
+		void update(_TFunction&& func) {
+			std::lock_guard<std::mutex> lock1((*m_shptr).m_update_mutex);
+			const auto current_snapshot = (*m_shptr).current();
+			(*m_shptr).publish(TStdSharedImmutableFixedPointer<_Ty>::make(func(*current_snapshot)));
+		}
+
+		/* Obtains the current version. This takes a (briefly held) lock. See TAsyncSharedSnapshotReader. */
+		TStdSharedImmutableFixedPointer<_Ty> snapshot() const {
+			return (*m_shptr).current();
+		}
+		TAsyncSharedSnapshotReader<_Ty> reader() const {
+			return TAsyncSharedSnapshotReader<_Ty>(m_shptr);
+		}
+		/* The number of versions published (after the initial one). */
+		std::uint64_t generation() const {
+			return (*m_shptr).m_generation.load(std::memory_order_acquire);
+		}
+
+		template <class... Args>
+		static TAsyncSharedSnapshotPublisher make(Args&&... args) {
+			auto shptr = std::make_shared<impl::TAsyncSharedSnapshotState<_Ty>>(TStdSharedImmutableFixedPointer<_Ty>::make(std::forward<Args>(args)...));
+			TAsyncSharedSnapshotPublisher retval(shptr);
+			return retval;
+		}
+
+	private:
+		TAsyncSharedSnapshotPublisher(std::shared_ptr<impl::TAsyncSharedSnapshotState<_Ty>> shptr) : m_shptr(shptr) {}
+
+		TAsyncSharedSnapshotPublisher<_Ty>* operator&() { return this; }
+		const TAsyncSharedSnapshotPublisher<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<impl::TAsyncSharedSnapshotState<_Ty>> m_shptr;
+	};
+
+	template <class X, class... Args>
+	TAsyncSharedSnapshotPublisher<X> make_asyncsharedsnapshotpublisher(Args&&... args) {
+		return TAsyncSharedSnapshotPublisher<X>::make(std::forward<Args>(args)...);
+	}
+
+	/* A TAsyncSharedSnapshotReader caches the most recent snapshot it obtained, along with its generation. snapshot() just
+	checks (with a single atomic load) whether a newer version has since been published, and only if so takes the
+	publisher's lock to obtain it. Otherwise no lock is taken and no shared state is written, other than the (shared) snapshot's
+	reference count (and snapshot_ref() avoids even that). A reader is not itself thread safe; each thread should use its own. Note that the reader keeps its
+	cached version alive until its next snapshot() after a newer version is published, or until it is destroyed. */
+	template<typename _Ty>
+	class TAsyncSharedSnapshotReader {
+	public:
+		TAsyncSharedSnapshotReader(const TAsyncSharedSnapshotReader& src_cref) = default;
+		TAsyncSharedSnapshotReader(const TAsyncSharedSnapshotPublisher<_Ty>& publisher_cref) : TAsyncSharedSnapshotReader(publisher_cref.reader()) {}
+
+		TStdSharedImmutableFixedPointer<_Ty> snapshot() {
+			if ((*m_shptr).m_generation.load(std::memory_order_acquire) != m_cached_generation) {
+				refresh();
+			}
+			return (*m_cached_snapshot);
+		}
+		/* Like snapshot(), but returns a reference to the (cached) version rather than a copy of the (shared) pointer to
+		it, so that (as long as no new version has been published) no shared state is written at all. The reference
+		remains valid until this reader's next snapshot() or snapshot_ref() call (or its destruction). */
+		const _Ty& snapshot_ref() {
+			if ((*m_shptr).m_generation.load(std::memory_order_acquire) != m_cached_generation) {
+				refresh();
+			}
+			return (*(*m_cached_snapshot));
+		}
+		/* Returns true if the snapshot this reader holds is the current version. */
+		bool is_current() const {
+			return ((*m_shptr).m_generation.load(std::memory_order_acquire) == m_cached_generation);
+		}
+
+	private:
+		TAsyncSharedSnapshotReader(std::shared_ptr<impl::TAsyncSharedSnapshotState<_Ty>> shptr) : m_shptr(shptr) {
+			refresh();
+		}
+		void refresh() {
+			std::uint64_t generation = 0;
+			auto current_snapshot = (*m_shptr).current(&generation);
+			m_cached_snapshot.emplace(current_snapshot);
+			m_cached_generation = generation;
+		}
+
+		TAsyncSharedSnapshotReader<_Ty>* operator&() { return this; }
+		const TAsyncSharedSnapshotReader<_Ty>* operator&() const { return this; }
+
+		std::shared_ptr<impl::TAsyncSharedSnapshotState<_Ty>> m_shptr;
+		mse::optional<TStdSharedImmutableFixedPointer<_Ty>> m_cached_snapshot;
+		std::uint64_t m_cached_generation = 0;
+
+		friend class TAsyncSharedSnapshotPublisher<_Ty>;
+	};
+
+
 #if defined(MSEREFCOUNTING_H_)
 	template<class _TTargetType, class _Ty>
 	TStrongFixedPointer<_TTargetType, TAsyncSharedReadWritePointer<_Ty>> make_pointer_to_member(_TTargetType& target, const TAsyncSharedReadWritePointer<_Ty> &lease_pointer) {
@@ -9,6 +9,7 @@
 #define MSEIVECTOR_H
 
 #include "msemsevector.h"
+#include "mserefcounting.h"
 
 namespace mse {
 
@@ -31,62 +32,71 @@ namespace mse {
 		typedef typename _MV::reference reference;
 		typedef typename _MV::const_reference const_reference;
 
-		const _MV& msevector() const { return (*m_shptr); }
-		_MV& msevector() { return (*m_shptr); }
+		const _MV& msevector() const { return (*msevector_shptr()); }
+		_MV& msevector() { return (*msevector_shptr()); }
 		operator const _MV() const { return msevector(); }
 		operator _MV() { return msevector(); }
 
-		explicit ivector(const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_Al)) {}
-		explicit ivector(size_type _N) : m_shptr(std::make_shared<_MV>(_N)) {}
-		explicit ivector(size_type _N, const _Ty& _V, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_N, _V, _Al)) {}
-		ivector(_MV&& _X) : m_shptr(std::make_shared<_MV>(std::move(_X))) {}
-		ivector(const _MV& _X) : m_shptr(std::make_shared<_MV>(_X)) {}
-		ivector(_Myt&& _X) : m_shptr(std::make_shared<_MV>(std::move(_X.msevector()))) {}
-		ivector(const _Myt& _X) : m_shptr(std::make_shared<_MV>(_X.msevector())) {}
+		explicit ivector(const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_Al)) {}
+		explicit ivector(size_type _N) : m_shptr(mse::make_refcounting<_MV>(_N)) {}
+		explicit ivector(size_type _N, const _Ty& _V, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_N, _V, _Al)) {}
+		ivector(_MV&& _X) : m_shptr(mse::make_refcounting<_MV>(std::move(_X))) {}
+		ivector(const _MV& _X) : m_shptr(mse::make_refcounting<_MV>(_X)) {}
+		/* Moving just transfers ownership of the underlying msevector. The moved-from ivector is given a new (empty)
+		one, so that m_shptr is never null (and the const member functions never need to allocate). */
+		ivector(_Myt&& _X) : m_shptr(mse::make_refcounting<_MV>()) { std::swap(m_shptr, _X.m_shptr); }
+		ivector(const _Myt& _X) : m_shptr(mse::make_refcounting<_MV>(_X.msevector())) {}
 		typedef typename _MV::const_iterator _It;
-		ivector(_It _F, _It _L, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_F, _L, _Al)) {}
-		ivector(const _Ty* _F, const _Ty* _L, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_F, _L, _Al)) {}
+		ivector(_It _F, _It _L, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_F, _L, _Al)) {}
+		ivector(const _Ty* _F, const _Ty* _L, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_F, _L, _Al)) {}
 		template<class _Iter, class = typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type>
-			ivector(_Iter _First, _Iter _Last) : m_shptr(std::make_shared<_MV>(_First, _Last)) {}
+			ivector(_Iter _First, _Iter _Last) : m_shptr(mse::make_refcounting<_MV>(_First, _Last)) {}
 		template<class _Iter, class = typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type>
-			ivector(_Iter _First, _Iter _Last, const _A& _Al) : m_shptr(std::make_shared<_MV>(_First, _Last, _Al)) {}
+			ivector(_Iter _First, _Iter _Last, const _A& _Al) : m_shptr(mse::make_refcounting<_MV>(_First, _Last, _Al)) {}
 
-		_Myt& operator=(_MV&& _X) { m_shptr->operator=(std::move(_X)); return (*this); }
-		_Myt& operator=(const _MV& _X) { m_shptr->operator=(_X); return (*this); }
-		_Myt& operator=(_Myt&& _X) { m_shptr->operator=(std::move(_X.msevector())); return (*this); }
-		_Myt& operator=(const _Myt& _X) { m_shptr->operator=(_X.msevector()); return (*this); }
-		void reserve(size_type _Count) { m_shptr->reserve(_Count); }
-		void resize(size_type _N, const _Ty& _X = _Ty()) { m_shptr->resize(_N, _X); }
-		typename _MV::const_reference operator[](size_type _P) const { return m_shptr->operator[](_P); }
-		typename _MV::reference operator[](size_type _P) { return m_shptr->operator[](_P); }
-		void push_back(_Ty&& _X) { m_shptr->push_back(std::move(_X)); }
-		void push_back(const _Ty& _X) { m_shptr->push_back(_X); }
-		void pop_back() { m_shptr->pop_back(); }
-		void assign(_It _F, _It _L) { m_shptr->assign(_F, _L); }
-		void assign(size_type _N, const _Ty& _X = _Ty()) { m_shptr->assign(_N, _X); }
+		_Myt& operator=(_MV&& _X) { msevector().operator=(std::move(_X)); return (*this); }
+		_Myt& operator=(const _MV& _X) { msevector().operator=(_X); return (*this); }
+		_Myt& operator=(_Myt&& _X) {
+			if (this != std::addressof(_X)) {
+				TRefCountingPointer<_MV> empty_shptr(mse::make_refcounting<_MV>());
+				m_shptr = std::move(_X.m_shptr);
+				_X.m_shptr = std::move(empty_shptr);
+			}
+			return (*this);
+		}
+		_Myt& operator=(const _Myt& _X) { msevector().operator=(_X.msevector()); return (*this); }
+		void reserve(size_type _Count) { msevector().reserve(_Count); }
+		void resize(size_type _N, const _Ty& _X = _Ty()) { msevector().resize(_N, _X); }
+		typename _MV::const_reference operator[](size_type _P) const { return msevector().operator[](_P); }
+		typename _MV::reference operator[](size_type _P) { return msevector().operator[](_P); }
+		void push_back(_Ty&& _X) { msevector().push_back(std::move(_X)); }
+		void push_back(const _Ty& _X) { msevector().push_back(_X); }
+		void pop_back() { msevector().pop_back(); }
+		void assign(_It _F, _It _L) { msevector().assign(_F, _L); }
+		void assign(size_type _N, const _Ty& _X = _Ty()) { msevector().assign(_N, _X); }
 		template<class ..._Valty>
-		void emplace_back(_Valty&& ..._Val) { m_shptr->emplace_back(std::forward<_Valty>(_Val)...); }
-		void clear() { m_shptr->clear(); }
-		void swap(_MV& _X) { m_shptr->swap(_X); }
-		void swap(_Myt& _X) { m_shptr->swap(_X.msevector()); }
+		void emplace_back(_Valty&& ..._Val) { msevector().emplace_back(std::forward<_Valty>(_Val)...); }
+		void clear() { msevector().clear(); }
+		void swap(_MV& _X) { msevector().swap(_X); }
+		void swap(_Myt& _X) { msevector().swap(_X.msevector()); }
 
-		ivector(_XSTD initializer_list<typename _MV::value_type> _Ilist, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_Ilist, _Al)) {}
-		_Myt& operator=(_XSTD initializer_list<typename _MV::value_type> _Ilist) { m_shptr->operator=(_Ilist); return (*this); }
-		void assign(_XSTD initializer_list<typename _MV::value_type> _Ilist) { m_shptr->assign(_Ilist); }
-		typename _MV::iterator insert(typename _MV::const_iterator _Where, _XSTD initializer_list<typename _MV::value_type> _Ilist) { return m_shptr->insert(_Where, _Ilist); }
+		ivector(_XSTD initializer_list<typename _MV::value_type> _Ilist, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_Ilist, _Al)) {}
+		_Myt& operator=(_XSTD initializer_list<typename _MV::value_type> _Ilist) { msevector().operator=(_Ilist); return (*this); }
+		void assign(_XSTD initializer_list<typename _MV::value_type> _Ilist) { msevector().assign(_Ilist); }
+		typename _MV::iterator insert(typename _MV::const_iterator _Where, _XSTD initializer_list<typename _MV::value_type> _Ilist) { return msevector().insert(_Where, _Ilist); }
 
-		size_type capacity() const _NOEXCEPT{ return m_shptr->capacity(); }
-		void shrink_to_fit() { m_shptr->shrink_to_fit(); }
-		size_type size() const _NOEXCEPT{ return m_shptr->size(); }
-		size_type max_size() const _NOEXCEPT{ return m_shptr->max_size(); }
-		bool empty() const _NOEXCEPT{ return m_shptr->empty(); }
-		_A get_allocator() const _NOEXCEPT{ return m_shptr->get_allocator(); }
-		typename _MV::const_reference at(size_type _Pos) const { return m_shptr->at(_Pos); }
-		typename _MV::reference at(size_type _Pos) { return m_shptr->at(_Pos); }
-		typename _MV::reference front() { return m_shptr->front(); }
-		typename _MV::const_reference front() const { return m_shptr->front(); }
-		typename _MV::reference back() { return m_shptr->back(); }
-		typename _MV::const_reference back() const { return m_shptr->back(); }
+		size_type capacity() const _NOEXCEPT{ return msevector().capacity(); }
+		void shrink_to_fit() { msevector().shrink_to_fit(); }
+		size_type size() const _NOEXCEPT{ return msevector().size(); }
+		size_type max_size() const _NOEXCEPT{ return msevector().max_size(); }
+		bool empty() const _NOEXCEPT{ return msevector().empty(); }
+		_A get_allocator() const _NOEXCEPT{ return msevector().get_allocator(); }
+		typename _MV::const_reference at(size_type _Pos) const { return msevector().at(_Pos); }
+		typename _MV::reference at(size_type _Pos) { return msevector().at(_Pos); }
+		typename _MV::reference front() { return msevector().front(); }
+		typename _MV::const_reference front() const { return msevector().front(); }
+		typename _MV::reference back() { return msevector().back(); }
+		typename _MV::const_reference back() const { return msevector().back(); }
 
 		class cipointer {
 		public:
@@ -97,7 +107,7 @@ namespace mse {
 			typedef typename _MV::mm_const_iterator_type::pointer pointer;
 			typedef typename _MV::mm_const_iterator_type::reference reference;
 
-			cipointer(const _Myt& owner_cref) : m_msevector_cshptr(owner_cref.m_shptr), m_cipointer(*(owner_cref.m_shptr)) {}
+			cipointer(const _Myt& owner_cref) : m_msevector_cshptr(owner_cref.msevector_shptr()), m_cipointer(*(owner_cref.msevector_shptr())) {}
 			cipointer(const cipointer& src_cref) : m_msevector_cshptr(src_cref.m_msevector_cshptr), m_cipointer(src_cref.m_cipointer) {}
 			~cipointer() {}
 			const typename _MV::cipointer& msevector_cipointer() const { return m_cipointer; }
@@ -143,8 +153,8 @@ namespace mse {
 			void set_to_const_item_pointer(const cipointer& _Right_cref) { msevector_cipointer().set_to_const_item_pointer(_Right_cref.msevector_cipointer()); }
 			msev_size_t position() const { return msevector_cipointer().position(); }
 		private:
-			cipointer(const std::shared_ptr<_MV>& msevector_shptr) : m_msevector_cshptr(msevector_shptr), m_cipointer(*msevector_shptr) {}
-			std::shared_ptr<const _MV> m_msevector_cshptr;
+			cipointer(const TRefCountingPointer<_MV>& msevector_shptr) : m_msevector_cshptr(msevector_shptr), m_cipointer(*msevector_shptr) {}
+			TRefCountingConstPointer<_MV> m_msevector_cshptr;
 			/* m_cipointer needs to be declared after m_msevector_cshptr so that it's destructor will be called first. */
 			typename _MV::cipointer m_cipointer;
 			friend class /*_Myt*/ivector<_Ty, _A>;
@@ -159,7 +169,7 @@ namespace mse {
 			typedef typename _MV::mm_iterator_type::pointer pointer;
 			typedef typename _MV::mm_iterator_type::reference reference;
 
-			ipointer(_Myt& owner_ref) : m_msevector_shptr(owner_ref.m_shptr), m_ipointer(*(owner_ref.m_shptr)) {}
+			ipointer(_Myt& owner_ref) : m_msevector_shptr(owner_ref.msevector_shptr()), m_ipointer(*(owner_ref.msevector_shptr())) {}
 			ipointer(const ipointer& src_cref) : m_msevector_shptr(src_cref.m_msevector_shptr), m_ipointer(src_cref.m_ipointer) {}
 			~ipointer() {}
 			const typename _MV::ipointer& msevector_ipointer() const { return m_ipointer; }
@@ -212,7 +222,7 @@ namespace mse {
 			void set_to_item_pointer(const ipointer& _Right_cref) { msevector_ipointer().set_to_item_pointer(_Right_cref.msevector_ipointer()); }
 			msev_size_t position() const { return msevector_ipointer().position(); }
 		private:
-			std::shared_ptr<_MV> m_msevector_shptr;
+			TRefCountingPointer<_MV> m_msevector_shptr;
 			/* m_ipointer needs to be declared after m_msevector_shptr so that it's destructor will be called first. */
 			typename _MV::ipointer m_ipointer;
 			friend class /*_Myt*/ivector<_Ty, _A>;
@@ -252,26 +262,26 @@ namespace mse {
 		}
 
 		ivector(const cipointer &start, const cipointer &end, const _A& _Al = _A())
-			: m_shptr(std::make_shared<_MV>(start.msevector_cipointer(), end.msevector_cipointer(), _Al)) {}
+			: m_shptr(mse::make_refcounting<_MV>(start.msevector_cipointer(), end.msevector_cipointer(), _Al)) {}
 		void assign(const cipointer &start, const cipointer &end) {
-			m_shptr->assign(start.msevector_cipointer(), end.msevector_cipointer());
+			msevector().assign(start.msevector_cipointer(), end.msevector_cipointer());
 		}
 		void assign_inclusive(const cipointer &first, const cipointer &last) {
-			m_shptr->assign_inclusive(first.msevector_cipointer(), last.msevector_cipointer());
+			msevector().assign_inclusive(first.msevector_cipointer(), last.msevector_cipointer());
 		}
 		ipointer insert_before(const cipointer &pos, size_type _M, const _Ty& _X) {
-			auto res = m_shptr->insert_before(pos.msevector_cipointer(), _M, _X);
+			auto res = msevector().insert_before(pos.msevector_cipointer(), _M, _X);
 			ipointer retval(*this); retval.msevector_ipointer() = res;
 			return retval;
 		}
 		ipointer insert_before(const cipointer &pos, _Ty&& _X) {
-			auto res = m_shptr->insert_before(pos.msevector_cipointer(), std::move(_X));
+			auto res = msevector().insert_before(pos.msevector_cipointer(), std::move(_X));
 			ipointer retval(*this); retval.msevector_ipointer() = res;
 			return retval;
 		}
 		ipointer insert_before(const cipointer &pos, const _Ty& _X = _Ty()) { return insert_before(pos, 1, _X); }
 		ipointer insert_before(const cipointer &pos, const cipointer &start, const cipointer &end) {
-			auto res = m_shptr->insert_before(pos.msevector_cipointer(), start.msevector_cipointer(), end.msevector_cipointer());
+			auto res = msevector().insert_before(pos.msevector_cipointer(), start.msevector_cipointer(), end.msevector_cipointer());
 			ipointer retval(*this); retval.msevector_ipointer() = res;
 			return retval;
 		}
@@ -280,35 +290,35 @@ namespace mse {
 			return insert_before(pos, first, end);
 		}
 		ipointer insert_before(const cipointer &pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) {	// insert initializer_list
-			auto res = m_shptr->insert_before(pos.msevector_cipointer(), _Ilist);
+			auto res = msevector().insert_before(pos.msevector_cipointer(), _Ilist);
 			ipointer retval(*this); retval.msevector_ipointer() = res;
 			return retval;
 		}
 		void insert_before(msev_size_t pos, _Ty&& _X) {
-			m_shptr->insert_before(pos, std::move(_X));
+			msevector().insert_before(pos, std::move(_X));
 		}
 		void insert_before(msev_size_t pos, const _Ty& _X = _Ty()) {
-			m_shptr->insert_before(pos, _X);
+			msevector().insert_before(pos, _X);
 		}
 		void insert_before(msev_size_t pos, size_type _M, const _Ty& _X) {
-			m_shptr->insert_before(pos, _M, _X);
+			msevector().insert_before(pos, _M, _X);
 		}
 		void insert_before(msev_size_t pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) {	// insert initializer_list
-			m_shptr->insert_before(pos, _Ilist);
+			msevector().insert_before(pos, _Ilist);
 		}
 		template<class ..._Valty>
 		ipointer emplace(const cipointer &pos, _Valty&& ..._Val) {
-			auto res = m_shptr->emplace(pos.msevector_cipointer(), std::forward<_Valty>(_Val)...);
+			auto res = msevector().emplace(pos.msevector_cipointer(), std::forward<_Valty>(_Val)...);
 			ipointer retval = begin(); retval.msevector_ipointer() = res;
 			return retval;
 		}
 		ipointer erase(const ipointer &pos) {
-			auto res = m_shptr->erase(pos.msevector_ipointer());
+			auto res = msevector().erase(pos.msevector_ipointer());
 			ipointer retval(*this); retval.msevector_ipointer() = res;
 			return retval;
 		}
 		ipointer erase(const ipointer &start, const ipointer &end) {
-			auto res = m_shptr->erase(start.msevector_ipointer(), end.msevector_ipointer());
+			auto res = msevector().erase(start.msevector_ipointer(), end.msevector_ipointer());
 			ipointer retval(*this); retval.msevector_ipointer() = res;
 			return retval;
 		}
@@ -317,14 +327,16 @@ namespace mse {
 			return erase_inclusive(first, end);
 		}
 		bool operator==(const _Myt& _Right) const {	// test for ivector equality
-			return ((*(_Right.m_shptr)) == (*m_shptr));
+			return (_Right.msevector() == msevector());
 		}
 		bool operator<(const _Myt& _Right) const {	// test if _Left < _Right for ivectors
-			return ((*m_shptr) < (*(_Right.m_shptr)));
+			return (msevector() < _Right.msevector());
 			}
 
 	private:
-		std::shared_ptr<_MV> m_shptr;
+		const TRefCountingPointer<_MV>& msevector_shptr() const { return m_shptr; }
+
+		TRefCountingPointer<_MV> m_shptr;
 	};
 
 	template<class _Ty, class _Alloc> inline bool operator!=(const ivector<_Ty, _Alloc>& _Left,
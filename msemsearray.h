@@ -446,6 +446,8 @@ namespace mse {
 			msear_size_t position() const {
 				return m_index;
 			}
+			/* Returns a pointer to the array that the iterator refers to (or null). */
+			const _Myt* target_container_ptr() const { return m_owner_cptr; }
 		private:
 			msear_size_t m_index = 0;
 			msear_pointer<const _Myt> m_owner_cptr = nullptr;
@@ -598,6 +600,8 @@ namespace mse {
 			msear_size_t position() const {
 				return m_index;
 			}
+			/* Returns a pointer to the array that the iterator refers to (or null). */
+			_Myt* target_container_ptr() const { return m_owner_ptr; }
 			operator ss_const_iterator_type() const {
 				ss_const_iterator_type retval;
 				if (nullptr != m_owner_ptr) {
@@ -26,14 +26,14 @@
 #endif /*_MSC_VER*/
 
 //define MSE_MSEVECTOR_USE_MSE_PRIMITIVES 1
-#ifdef MSE_MSEVECTOR_USE_MSE_PRIMITIVES
 #include "mseprimitives.h"
-#endif // MSE_MSEVECTOR_USE_MSE_PRIMITIVES
+#include "mserangedestruction.h"
 
 #include <vector>
+#include <algorithm>
 #include <assert.h>
 #include <memory>
-#include <unordered_map>
+#include <type_traits>
 #include <functional>
 #include <climits>       // ULONG_MAX
 #include <stdexcept>
@@ -65,6 +65,16 @@ namespace mse {
 	typedef size_t msev_as_a_size_t;
 #endif // MSE_MSEVECTOR_USE_MSE_PRIMITIVES
 
+	/* When an msevector has more than this many ipointers/cipointers, inserts and erases are recorded in a log rather than
+	being applied to each ipointer immediately. */
+#ifndef MSE_MSEVECTOR_MODIFICATION_LOG_ITERATOR_THRESHOLD
+#define MSE_MSEVECTOR_MODIFICATION_LOG_ITERATOR_THRESHOLD 6
+#endif // !MSE_MSEVECTOR_MODIFICATION_LOG_ITERATOR_THRESHOLD
+	/* The number of log entries at which all ipointers are brought up to date and the log is emptied. */
+#ifndef MSE_MSEVECTOR_MODIFICATION_LOG_MAX_SIZE
+#define MSE_MSEVECTOR_MODIFICATION_LOG_MAX_SIZE 256
+#endif // !MSE_MSEVECTOR_MODIFICATION_LOG_MAX_SIZE
+
 
 	class msevector_range_error : public std::range_error { public:
 		using std::range_error::range_error;
@@ -72,6 +82,26 @@ namespace mse {
 	class msevector_null_dereference_error : public std::logic_error { public:
 		using std::logic_error::logic_error;
 	};
+	class msevector_size_pinned_error : public std::logic_error { public:
+		using std::logic_error::logic_error;
+	};
+
+	/* CSizePin is held by objects (like checked spans) that need the size of a container to remain fixed while they exist. A
+	default constructed CSizePin doesn't pin anything. */
+	class CSizePin {
+	public:
+		CSizePin() {}
+		explicit CSizePin(std::size_t& pin_count_ref) : m_pin_count_ptr(&pin_count_ref) { (*m_pin_count_ptr) += 1; }
+		CSizePin(const CSizePin& src) : m_pin_count_ptr(src.m_pin_count_ptr) {
+			if (m_pin_count_ptr) { (*m_pin_count_ptr) += 1; }
+		}
+		~CSizePin() {
+			if (m_pin_count_ptr) { assert(1 <= (*m_pin_count_ptr)); (*m_pin_count_ptr) -= 1; }
+		}
+	private:
+		CSizePin& operator=(const CSizePin& _Right_cref) = delete;
+		std::size_t* m_pin_count_ptr = nullptr;
+	};
 
 	/* msev_pointer behaves similar to native pointers. It's a bit safer in that it initializes to
 	nullptr by default and checks for attempted dereference of null pointers. */
@@ -140,6 +170,118 @@ namespace mse {
 		//_mse_Is_iterator<_InIter>::value
 	>::type;
 
+	namespace impl {
+		/* TMMIteratorPool holds the iterator objects that back msevector's ipointers and cipointers. Records are allocated
+		in fixed size slabs (allocated on demand, so a vector that never has an ipointer doesn't pay for any) and recycled via
+		a free list, so creating and destroying ipointers doesn't generally incur any heap allocation. Records never move once
+		allocated, and are addressed by index. Each record is tagged with the key it was allocated with, so that releasing a
+		stale handle (whose record has since been released, and possibly reused) is detected. The pool is not thread safe.
+		(Neither is the vector.) */
+		template<typename _TMMIterator>
+		class TMMIteratorPool {
+		public:
+			typedef std::size_t key_type;
+
+			TMMIteratorPool() {}
+			~TMMIteratorPool() { clear(); }
+
+			template<typename _TOwner>
+			std::size_t allocate(_TOwner& owner_ref, const key_type& key) {
+				std::size_t index = m_first_free_index;
+				const bool from_free_list = (sc_no_index != index);
+				if (!from_free_list) {
+					index = m_num_records_used;
+					if (m_slabs.size() * sc_slab_size <= index) {
+						m_slabs.push_back(std::make_unique<CSlab>());
+					}
+				}
+				m_live_indices.push_back(index);
+				auto& rec = record(index);
+				try {
+					new (&(rec.m_storage)) _TMMIterator(owner_ref);
+				}
+				catch (...) {
+					m_live_indices.pop_back();
+					throw;
+				}
+				if (from_free_list) {
+					m_first_free_index = rec.m_next_free_index;
+				}
+				else {
+					m_num_records_used += 1;
+				}
+				rec.m_key = key;
+				rec.m_in_use = true;
+				rec.m_live_index = m_live_indices.size() - 1;
+				return index;
+			}
+			void release(std::size_t index, const key_type& key) {
+				if ((m_num_records_used <= index) || (!record(index).m_in_use) || (key != record(index).m_key)) {
+					MSE_THROW(msevector_range_error("invalid handle - void release(std::size_t index, const key_type& key) - TMMIteratorPool"));
+				}
+				auto& rec = record(index);
+				/* Remove the record from the list of live records by moving the last live record into its place. */
+				const auto last_live_index = m_live_indices.back();
+				m_live_indices[rec.m_live_index] = last_live_index;
+				record(last_live_index).m_live_index = rec.m_live_index;
+				m_live_indices.pop_back();
+
+				rec.iterator().~_TMMIterator();
+				rec.m_in_use = false;
+				rec.m_next_free_index = m_first_free_index;
+				m_first_free_index = index;
+			}
+			void clear() {
+				while (!m_live_indices.empty()) {
+					const auto index = m_live_indices.back();
+					release(index, record(index).m_key);
+				}
+			}
+			_TMMIterator& iterator(std::size_t index) {
+				assert((m_num_records_used > index) && record(index).m_in_use);
+				return record(index).iterator();
+			}
+			template<typename _TFunction>
+			void apply_to_all(const _TFunction& func_obj_ref) {
+				for (const auto index : m_live_indices) {
+					func_obj_ref(record(index).iterator());
+				}
+			}
+			std::size_t size() const { return m_live_indices.size(); }
+
+		private:
+			TMMIteratorPool(const TMMIteratorPool&) = delete;
+			TMMIteratorPool& operator=(const TMMIteratorPool&) = delete;
+
+			static const std::size_t sc_no_index = std::size_t(-1);
+			static const std::size_t sc_slab_size_shift = 3;
+			static const std::size_t sc_slab_size = std::size_t(1) << sc_slab_size_shift;
+
+			class CRecord {
+			public:
+				_TMMIterator& iterator() { return *reinterpret_cast<_TMMIterator*>(&m_storage); }
+				typename std::aligned_storage<sizeof(_TMMIterator), alignof(_TMMIterator)>::type m_storage;
+				key_type m_key = 0;
+				std::size_t m_next_free_index = sc_no_index;
+				/* The position of this record's index in m_live_indices. */
+				std::size_t m_live_index = 0;
+				bool m_in_use = false;
+			};
+			class CSlab {
+			public:
+				CRecord m_records[sc_slab_size];
+			};
+			CRecord& record(std::size_t index) {
+				return (*(m_slabs[index >> sc_slab_size_shift])).m_records[index & (sc_slab_size - 1)];
+			}
+
+			std::vector<std::unique_ptr<CSlab>> m_slabs;
+			std::size_t m_num_records_used = 0;
+			std::size_t m_first_free_index = sc_no_index;
+			std::vector<std::size_t> m_live_indices;
+		};
+	}
+
 	/* Note that, at the moment, msevector inherits publicly from std::vector. This is not intended to be a permanent
 		characteristic of msevector and any reference to, or interpretation of, an msevector as an std::vector is (and has
 		always been) depricated. msevector endeavors to support the subset of the std::vector interface that is compatible
@@ -177,7 +319,7 @@ namespace mse {
 		}
 		msevector(base_class&& _X) : base_class(std::move(_X)), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		msevector(const base_class& _X) : base_class(_X), m_mmitset(*this) { /*m_debug_size = size();*/ }
-		msevector(_Myt&& _X) : base_class(std::move(_X)), m_mmitset(*this) { /*m_debug_size = size();*/ }
+		msevector(_Myt&& _X) : base_class(std::move(_X.size_unpinned_self())), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		msevector(const _Myt& _X) : base_class(_X), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		typedef typename base_class::const_iterator _It;
 		/* Note that safety cannot be guaranteed when using these constructors that take unsafe typename base_class::iterator and/or pointer parameters. */
@@ -192,13 +334,18 @@ namespace mse {
 			, class = _mse_RequireInputIter<_Iter> >
 		//msevector(_Iter _First, _Iter _Last, const typename base_class::_Alloc& _Al) : base_class(_First, _Last, _Al), m_mmitset(*this) { /*m_debug_size = size();*/ }
 		msevector(_Iter _First, _Iter _Last, const _A& _Al) : base_class(_First, _Last, _Al), m_mmitset(*this) { /*m_debug_size = size();*/ }
+		~msevector() {
+			destroy_elements(0, msev_size_t((*this).size()), [this]() { (*this).base_class::clear(); });
+		}
 		_Myt& operator=(const base_class& _X) {
+			throw_if_size_pinned();
 			base_class::operator =(_X);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 			return (*this);
 		}
 		_Myt& operator=(_Myt&& _X) {
+			_X.throw_if_size_pinned();
 			operator=(std::move(static_cast<base_class&>(_X)));
 			m_mmitset.reset();
 			return (*this);
@@ -212,6 +359,7 @@ namespace mse {
 		{	// determine new minimum length of allocated storage
 			auto original_capacity = msev_size_t((*this).capacity());
 
+			throw_if_size_pinned();
 			base_class::reserve(msev_as_a_size_t(_Count));
 
 			auto new_capacity = msev_size_t((*this).capacity());
@@ -223,6 +371,7 @@ namespace mse {
 		void shrink_to_fit() {	// reduce capacity
 			auto original_capacity = msev_size_t((*this).capacity());
 
+			throw_if_size_pinned();
 			base_class::shrink_to_fit();
 
 			auto new_capacity = msev_size_t((*this).capacity());
@@ -236,7 +385,13 @@ namespace mse {
 			auto original_capacity = msev_size_t((*this).capacity());
 			bool shrinking = (_N < original_size);
 
-			base_class::resize(msev_as_a_size_t(_N), _X);
+			throw_if_size_pinned();
+			if (shrinking) {
+				destroy_elements(_N, original_size, [this, _N, &_X]() { (*this).base_class::resize(msev_as_a_size_t(_N), _X); });
+			}
+			else {
+				base_class::resize(msev_as_a_size_t(_N), _X);
+			}
 			/*m_debug_size = size();*/
 
 			if (shrinking) {
@@ -273,12 +428,14 @@ namespace mse {
 		}
 		void push_back(_Ty&& _X) {
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				base_class::push_back(std::move(_X));
 			}
 			else {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				base_class::push_back(std::move(_X));
 				/*m_debug_size = size();*/
 
@@ -293,12 +450,14 @@ namespace mse {
 		}
 		void push_back(const _Ty& _X) {
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				base_class::push_back(_X);
 			}
 			else {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				base_class::push_back(_X);
 				/*m_debug_size = size();*/
 
@@ -313,6 +472,7 @@ namespace mse {
 		}
 		void pop_back() {
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				base_class::pop_back();
 			}
 			else {
@@ -320,6 +480,7 @@ namespace mse {
 				auto original_capacity = msev_size_t((*this).capacity());
 
 				if (0 == original_size) { MSE_THROW(msevector_range_error("pop_back() on empty - void pop_back() - msevector")); }
+				throw_if_size_pinned();
 				base_class::pop_back();
 				/*m_debug_size = size();*/
 
@@ -334,17 +495,20 @@ namespace mse {
 			}
 		}
 		void assign(_It _F, _It _L) {
+			throw_if_size_pinned();
 			base_class::assign(_F, _L);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		template<class _Iter>
 		void assign(_Iter _First, _Iter _Last) {	// assign [_First, _Last)
+			throw_if_size_pinned();
 			base_class::assign(_First, _Last);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		void assign(size_type _N, const _Ty& _X = _Ty()) {
+			throw_if_size_pinned();
 			base_class::assign(msev_as_a_size_t(_N), _X);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
@@ -354,6 +518,7 @@ namespace mse {
 		}
 		typename base_class::iterator insert(typename base_class::const_iterator _P, const _Ty& _X = _Ty()) {
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::insert(_P, _X);
 				/*m_debug_size = size();*/
 				return retval;
@@ -366,6 +531,7 @@ namespace mse {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::insert(_P, _X);
 				/*m_debug_size = size();*/
 
@@ -384,6 +550,7 @@ namespace mse {
 #if !(defined(GPP4P8_COMPATIBLE))
 		typename base_class::iterator insert(typename base_class::const_iterator _P, size_type _M, const _Ty& _X) {
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::insert(_P, msev_as_a_size_t(_M), _X);
 				/*m_debug_size = size();*/
 				return retval;
@@ -396,6 +563,7 @@ namespace mse {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::insert(_P, msev_as_a_size_t(_M), _X);
 				/*m_debug_size = size();*/
 
@@ -415,6 +583,7 @@ namespace mse {
 			, class = _mse_RequireInputIter<_Iter> >
 		typename base_class::iterator insert(typename base_class::const_iterator _Where, _Iter _First, _Iter _Last) {	// insert [_First, _Last) at _Where
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				auto retval = base_class::insert(_Where, _First, _Last);
 				/*m_debug_size = size();*/
 				return retval;
@@ -429,6 +598,7 @@ namespace mse {
 				auto original_capacity = msev_size_t((*this).capacity());
 
 				//if (0 > _M) { MSE_THROW(msevector_range_error("invalid argument - typename base_class::iterator insert() - msevector")); }
+				throw_if_size_pinned();
 				auto retval = base_class::insert(_Where, _First, _Last);
 				/*m_debug_size = size();*/
 
@@ -457,6 +627,7 @@ namespace mse {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				/*typename base_class::iterator retval =*/
 					base_class::insert(_P, _M, _X);
 				/*m_debug_size = size();*/
@@ -484,6 +655,7 @@ namespace mse {
 				auto original_capacity = msev_size_t((*this).capacity());
 
 				//if (0 > _M) { MSE_THROW(msevector_range_error("invalid argument - typename base_class::iterator insert() - msevector")); }
+				throw_if_size_pinned();
 				/*auto retval =*/
 					base_class::insert(_Where, _First, _Last);
 				/*m_debug_size = size();*/
@@ -504,6 +676,7 @@ namespace mse {
 		void emplace_back(_Valty&& ..._Val)
 		{	// insert by moving into element at end
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				base_class::emplace_back(std::forward<_Valty>(_Val)...);
 				/*m_debug_size = size();*/
 			}
@@ -511,6 +684,7 @@ namespace mse {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				base_class::emplace_back(std::forward<_Valty>(_Val)...);
 				/*m_debug_size = size();*/
 
@@ -533,6 +707,7 @@ namespace mse {
 #endif /*!(defined(GPP4P8_COMPATIBLE))*/
 
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				auto retval = base_class::emplace(_Where, std::forward<_Valty>(_Val)...);
 				/*m_debug_size = size();*/
 				return retval;
@@ -551,6 +726,7 @@ namespace mse {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				auto retval = base_class::emplace(_Where, std::forward<_Valty>(_Val)...);
 				/*m_debug_size = size();*/
 
@@ -567,6 +743,7 @@ namespace mse {
 		}
 		typename base_class::iterator erase(typename base_class::const_iterator _P) {
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::erase(_P);
 				/*m_debug_size = size();*/
 				return retval;
@@ -580,6 +757,7 @@ namespace mse {
 				auto original_capacity = msev_size_t((*this).capacity());
 
 				if (base_class::end() == _P) { MSE_THROW(msevector_range_error("invalid argument - typename base_class::iterator erase(typename base_class::const_iterator _P) - msevector")); }
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::erase(_P);
 				/*m_debug_size = size();*/
 
@@ -599,6 +777,7 @@ namespace mse {
 		}
 		typename base_class::iterator erase(typename base_class::const_iterator _F, typename base_class::const_iterator _L) {
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::erase(_F, _L);
 				/*m_debug_size = size();*/
 				return retval;
@@ -616,6 +795,7 @@ namespace mse {
 				auto original_capacity = msev_size_t((*this).capacity());
 
 				if ((base_class::end() == _F)/* || (0 > _M)*/) { MSE_THROW(msevector_range_error("invalid argument - typename base_class::iterator erase(typename base_class::iterator _F, typename base_class::iterator _L) - msevector")); }
+				throw_if_size_pinned();
 				typename base_class::iterator retval = base_class::erase(_F, _L);
 				/*m_debug_size = size();*/
 
@@ -635,17 +815,95 @@ namespace mse {
 				return retval;
 			}
 		}
+
+		/* The following "bulk" operations are equivalent to a sequence of single element inserts or erases, but move the
+		elements only once and adjust any registered iterators (and ipointers) only once per call. */
+
+		/* Inserts the elements [_First, _Last) before the element at index _P. */
+		template<class _Iter
+			, class = _mse_RequireInputIter<_Iter> >
+		void insert_many(size_type _P, _Iter _First, _Iter _Last) {
+			if ((*this).size() < _P) { MSE_THROW(msevector_range_error("index out of range - void insert_many() - msevector")); }
+			insert(base_class::begin() + msev_as_a_size_t(_P), _First, _Last);
+		}
+		template<class _TRange>
+		void insert_many(size_type _P, const _TRange& _Range) {
+			using std::begin; using std::end;
+			insert_many(_P, begin(_Range), end(_Range));
+		}
+		/* Moves (rather than copies) the elements of the given vector into this one, before the element at index _P. */
+		void insert_many(size_type _P, base_class&& _Src) {
+			insert_many(_P, std::make_move_iterator(_Src.begin()), std::make_move_iterator(_Src.end()));
+			_Src.clear();
+		}
+		void insert_many(size_type _P, _XSTD initializer_list<typename base_class::value_type> _Ilist) {
+			insert_many(_P, _Ilist.begin(), _Ilist.end());
+		}
+		/* Erases every element for which the given predicate returns true. Returns the number of elements erased. */
+		template<class _TPredicate>
+		size_type erase_if(_TPredicate _Pred) {
+			throw_if_size_pinned();
+			if (m_mmitset.is_empty()) {
+				auto new_end = std::remove_if(base_class::begin(), base_class::end(), _Pred);
+				auto num_erased = size_type(std::distance(new_end, base_class::end()));
+				base_class::erase(new_end, base_class::end());
+				/*m_debug_size = size();*/
+				return num_erased;
+			}
+			else {
+				/* The predicate is evaluated for every element before anything is moved, so that an exception thrown by the
+				predicate leaves the vector (and its iterators) unmodified. */
+				std::vector<msev_size_t> erased_indices;
+				const auto original_size = msev_size_t((*this).size());
+				for (msev_size_t i = 0; original_size > i; i += 1) {
+					if (_Pred(base_class::operator[](msev_as_a_size_t(i)))) {
+						erased_indices.push_back(i);
+					}
+				}
+				erase_sorted_positions(erased_indices);
+				return size_type(erased_indices.size());
+			}
+		}
+		/* Erases the elements at the given indices, which must be in strictly ascending order. */
+		template<class _TIndexContainer>
+		void erase_positions(const _TIndexContainer& _Sorted_indices) {
+			std::vector<msev_size_t> erased_indices;
+			const auto original_size = msev_size_t((*this).size());
+			for (const auto& index : _Sorted_indices) {
+				const auto i = msev_size_t(index);
+				if (original_size <= i) { MSE_THROW(msevector_range_error("index out of range - void erase_positions() - msevector")); }
+				if ((!erased_indices.empty()) && (erased_indices.back() >= i)) {
+					MSE_THROW(msevector_range_error("invalid argument - indices must be in strictly ascending order - void erase_positions() - msevector"));
+				}
+				erased_indices.push_back(i);
+			}
+			erase_sorted_positions(erased_indices);
+		}
+		void erase_positions(_XSTD initializer_list<size_type> _Sorted_indices) {
+			erase_positions<_XSTD initializer_list<size_type> >(_Sorted_indices);
+		}
+		/* Replaces the contents of this vector with those of the given vector, without copying any elements. */
+		void assign_from_range(base_class&& _Src) {
+			throw_if_size_pinned();
+			base_class::operator=(std::move(_Src));
+			/*m_debug_size = size();*/
+			m_mmitset.reset();
+		}
+
 		void clear() {
-			base_class::clear();
+			throw_if_size_pinned();
+			destroy_elements(0, msev_size_t((*this).size()), [this]() { (*this).base_class::clear(); });
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		void swap(base_class& _X) {
+			throw_if_size_pinned();
 			base_class::swap(_X);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
 		}
 		void swap(_Myt& _X) {
+			_X.throw_if_size_pinned();
 			swap(static_cast<base_class&>(_X));
 			m_mmitset.reset();
 		}
@@ -661,6 +919,7 @@ namespace mse {
 			return (*this);
 		}
 		void assign(_XSTD initializer_list<typename base_class::value_type> _Ilist) {	// assign initializer_list
+			throw_if_size_pinned();
 			base_class::assign(_Ilist);
 			/*m_debug_size = size();*/
 			m_mmitset.reset();
@@ -676,6 +935,7 @@ namespace mse {
 			auto original_size = msev_size_t((*this).size());
 			auto original_capacity = msev_size_t((*this).capacity());
 
+			throw_if_size_pinned();
 			/*auto retval = */base_class::insert(_Where, _Ilist);
 			/*m_debug_size = size();*/
 
@@ -692,6 +952,7 @@ namespace mse {
 #else /*defined(GPP4P8_COMPATIBLE)*/
 		typename base_class::iterator insert(typename base_class::const_iterator _Where, _XSTD initializer_list<typename base_class::value_type> _Ilist) {	// insert initializer_list
 			if (m_mmitset.is_empty()) {
+				throw_if_size_pinned();
 				auto retval = base_class::insert(_Where, _Ilist);
 				/*m_debug_size = size();*/
 				return retval;
@@ -705,6 +966,7 @@ namespace mse {
 				auto original_size = msev_size_t((*this).size());
 				auto original_capacity = msev_size_t((*this).capacity());
 
+				throw_if_size_pinned();
 				auto retval = base_class::insert(_Where, _Ilist);
 				/*m_debug_size = size();*/
 
@@ -915,6 +1177,8 @@ namespace mse {
 			msev_bool m_points_to_an_item = false;
 			msev_size_t m_index = 0;
 			const _Myt* m_owner_cptr = nullptr;
+			/* The generation of the owner's modification log that this iterator has been brought up to date with. */
+			std::size_t m_mmitset_generation = 0;
 			friend class mm_iterator_set_type;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 			friend class mm_iterator_type;
@@ -1109,6 +1373,8 @@ namespace mse {
 			msev_bool m_points_to_an_item = false;
 			msev_size_t m_index = 0;
 			_Myt* m_owner_ptr = nullptr;
+			/* The generation of the owner's modification log that this iterator has been brought up to date with. */
+			std::size_t m_mmitset_generation = 0;
 			friend class mm_iterator_set_type;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
@@ -1117,279 +1383,230 @@ namespace mse {
 		typedef std::size_t CHashKey1;
 		class mm_const_iterator_handle_type {
 		public:
-			mm_const_iterator_handle_type(const CHashKey1& key_cref, const std::shared_ptr<mm_const_iterator_type>& shptr_cref) : m_shptr(shptr_cref), m_key(key_cref) {}
+			mm_const_iterator_handle_type(const CHashKey1& key_cref, std::size_t index) : m_key(key_cref), m_index(index) {}
 		private:
-			std::shared_ptr<mm_const_iterator_type> m_shptr;
 			CHashKey1 m_key;
+			/* The index of the iterator's record in the owner's iterator pool. */
+			std::size_t m_index;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 			friend class mm_iterator_set_type;
 		};
 		class mm_iterator_handle_type {
 		public:
-			mm_iterator_handle_type(const CHashKey1& key_cref, const std::shared_ptr<mm_iterator_type>& shptr_ref) : m_shptr(shptr_ref), m_key(key_cref) {}
+			mm_iterator_handle_type(const CHashKey1& key_cref, std::size_t index) : m_key(key_cref), m_index(index) {}
 		private:
-			std::shared_ptr<mm_iterator_type> m_shptr;
 			CHashKey1 m_key;
+			/* The index of the iterator's record in the owner's iterator pool. */
+			std::size_t m_index;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 			friend class mm_iterator_set_type;
 		};
 
 		class mm_iterator_set_type {
 		public:
-			class CMMConstIterators : public std::unordered_map<CHashKey1, std::shared_ptr<mm_const_iterator_type>> {};
-			class CMMIterators : public std::unordered_map<CHashKey1, std::shared_ptr<mm_iterator_type>> {};
-
-			class assignable_CMMConstIterators_value_type : public std::pair<CHashKey1, std::shared_ptr<mm_const_iterator_type>> {
-			public:
-				assignable_CMMConstIterators_value_type() {}
-				assignable_CMMConstIterators_value_type(const typename CMMConstIterators::value_type& src) : std::pair<CHashKey1, std::shared_ptr<mm_iterator_type>>(src.first, src.second) {}
-				assignable_CMMConstIterators_value_type& operator=(const typename CMMConstIterators::value_type& rhs) { (*this).first = rhs.first; (*this).second = rhs.second; return (*this); }
-				operator typename CMMConstIterators::value_type() const { return CMMConstIterators::value_type((*this).first, (*this).second); }
-			};
-			class assignable_CMMIterators_value_type : public std::pair<CHashKey1, std::shared_ptr<mm_iterator_type>> {
-			public:
-				assignable_CMMIterators_value_type() {}
-				assignable_CMMIterators_value_type(const typename CMMIterators::value_type& src) : std::pair<CHashKey1, std::shared_ptr<mm_iterator_type>>(src.first, src.second) {}
-				assignable_CMMIterators_value_type& operator=(const typename CMMIterators::value_type& rhs) { (*this).first = rhs.first; (*this).second = rhs.second; return (*this); }
-				operator typename CMMIterators::value_type() const { return CMMIterators::value_type((*this).first, (*this).second); }
-			};
-
-			~mm_iterator_set_type() {
-				if (!mm_const_fast_mode1()) {
-					delete m_aux_mm_const_iterator_shptrs_ptr;
-				}
-				if (!mm_fast_mode1()) {
-					delete m_aux_mm_iterator_shptrs_ptr;
-				}
+			template<typename _TFunction>
+			void apply_to_all_mm_const_iterators(const _TFunction& func_obj_ref) {
+				m_const_iterator_pool.apply_to_all(func_obj_ref);
 			}
-
-			void apply_to_all_mm_const_iterator_shptrs(const std::function<void(std::shared_ptr<mm_const_iterator_type>&)>& func_obj_ref) {
-				if (!mm_const_fast_mode1()) {
-					for (auto it = (*m_aux_mm_const_iterator_shptrs_ptr).begin(); (*m_aux_mm_const_iterator_shptrs_ptr).end() != it; it++) {
-						func_obj_ref((*it).second);
-					}
-				}
-				else {
-					for (int i = 0; i < m_fm1_num_mm_const_iterators; i += 1) {
-						func_obj_ref(m_fm1_key_mm_const_it_array[i].second);
-					}
-				}
-			}
-			void apply_to_all_mm_iterator_shptrs(const std::function<void(std::shared_ptr<mm_iterator_type>&)>& func_obj_ref) {
-				if (!mm_fast_mode1()) {
-					for (auto it = (*m_aux_mm_iterator_shptrs_ptr).begin(); (*m_aux_mm_iterator_shptrs_ptr).end() != it; it++) {
-						func_obj_ref((*it).second);
-					}
-				}
-				else {
-					for (int i = 0; i < m_fm1_num_mm_iterators; i += 1) {
-						func_obj_ref(m_fm1_key_mm_it_array[i].second);
-					}
-				}
+			template<typename _TFunction>
+			void apply_to_all_mm_iterators(const _TFunction& func_obj_ref) {
+				m_iterator_pool.apply_to_all(func_obj_ref);
 			}
 			mm_iterator_set_type(_Myt& owner_ref) : m_next_available_key(0), m_owner_ptr(&owner_ref) {}
 			void reset() {
-				/* We can use "static" here because the lambda function does not capture any parameters. */
-				static const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [](std::shared_ptr<mm_const_iterator_type>& a) { a->reset(); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				static const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [](std::shared_ptr<mm_iterator_type>& a) { a->reset(); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
+				if (use_modification_log()) {
+					append_to_modification_log(CModification(CModification::sc_reset, 0, 0, 0, msev_size_t(m_owner_ptr->size())));
+					return;
+				}
+				apply_to_all_mm_const_iterators([](mm_const_iterator_type& a) { a.reset(); });
+				apply_to_all_mm_iterators([](mm_iterator_type& a) { a.reset(); });
 			}
 			void sync_iterators_to_index() {
 				/* No longer used. Relic from when mm_iterator_type contained a "native" iterator. */
-				/* We can use "static" here because the lambda function does not capture any parameters. */
-				/*
-				static const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [](std::shared_ptr<mm_const_iterator_type>& a) { a->sync_const_iterator_to_index(); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				static const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [](std::shared_ptr<mm_iterator_type>& a) { a->sync_iterator_to_index(); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
-				*/
 			}
 			void invalidate_inclusive_range(msev_size_t start_index, msev_size_t end_index) {
-				const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [start_index, end_index](std::shared_ptr<mm_const_iterator_type>& a) { a->invalidate_inclusive_range(start_index, end_index); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [start_index, end_index](std::shared_ptr<mm_iterator_type>& a) { a->invalidate_inclusive_range(start_index, end_index); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
+				if (use_modification_log()) {
+					append_to_modification_log(CModification(CModification::sc_invalidate, start_index, end_index, 0, msev_size_t(m_owner_ptr->size())));
+					return;
+				}
+				apply_to_all_mm_const_iterators([start_index, end_index](mm_const_iterator_type& a) { a.invalidate_inclusive_range(start_index, end_index); });
+				apply_to_all_mm_iterators([start_index, end_index](mm_iterator_type& a) { a.invalidate_inclusive_range(start_index, end_index); });
 			}
 			void shift_inclusive_range(msev_size_t start_index, msev_size_t end_index, msev_int shift) {
-				const std::function<void(std::shared_ptr<mm_const_iterator_type>&)> cit_func_obj = [start_index, end_index, shift](std::shared_ptr<mm_const_iterator_type>& a) { a->shift_inclusive_range(start_index, end_index, shift); };
-				apply_to_all_mm_const_iterator_shptrs(cit_func_obj);
-				const std::function<void(std::shared_ptr<mm_iterator_type>&)> it_func_obj = [start_index, end_index, shift](std::shared_ptr<mm_iterator_type>& a) { a->shift_inclusive_range(start_index, end_index, shift); };
-				apply_to_all_mm_iterator_shptrs(it_func_obj);
+				if (use_modification_log()) {
+					append_to_modification_log(CModification(CModification::sc_shift, start_index, end_index, shift, msev_size_t(m_owner_ptr->size())));
+					return;
+				}
+				apply_to_all_mm_const_iterators([start_index, end_index, shift](mm_const_iterator_type& a) { a.shift_inclusive_range(start_index, end_index, shift); });
+				apply_to_all_mm_iterators([start_index, end_index, shift](mm_iterator_type& a) { a.shift_inclusive_range(start_index, end_index, shift); });
+			}
+			/* Adjusts the iterators to reflect the erasure of the elements at the given (strictly ascending) indices. Iterators that
+			pointed to an erased element become end markers, the others are shifted down by the number of erased elements that
+			preceded them. */
+			void erase_sorted_positions(const std::vector<msev_size_t>& sorted_indices) {
+				if (is_empty() || sorted_indices.empty()) { return; }
+				flush_modification_log();
+				auto indices_ptr = &sorted_indices;
+				const auto size_after = msev_size_t(m_owner_ptr->size());
+				apply_to_all_mm_const_iterators([indices_ptr, size_after](mm_const_iterator_type& a) { remap_after_erase(a, *indices_ptr, size_after); });
+				apply_to_all_mm_iterators([indices_ptr, size_after](mm_iterator_type& a) { remap_after_erase(a, *indices_ptr, size_after); });
+			}
+			std::size_t num_iterators() const {
+				return m_const_iterator_pool.size() + m_iterator_pool.size();
 			}
 			bool is_empty() const {
-				if (mm_const_fast_mode1()) {
-					if (1 <= m_fm1_num_mm_const_iterators) {
-						return false;
-					}
-				}
-				else {
-					if (1 <= m_aux_mm_const_iterator_shptrs_ptr->size()) {
-						return false;
-					}
-				}
-				if (mm_fast_mode1()) {
-					if (1 <= m_fm1_num_mm_iterators) {
-						return false;
-					}
-				}
-				else {
-					if (1 <= m_aux_mm_iterator_shptrs_ptr->size()) {
-						return false;
-					}
-				}
-				return true;
+				return (0 == num_iterators());
 			}
 
 			mm_const_iterator_handle_type allocate_new_const_item_pointer() {
-				//auto shptr = std::shared_ptr<mm_const_iterator_type>(new mm_const_iterator_type(*m_owner_ptr));
-				auto shptr = std::make_shared<mm_const_iterator_type>(*m_owner_ptr);
 				auto key = m_next_available_key; m_next_available_key++;
-				mm_const_iterator_handle_type retval(key, shptr);
-				typename CMMConstIterators::value_type new_item(key, shptr);
-				if (!mm_const_fast_mode1()) {
-					(*m_aux_mm_const_iterator_shptrs_ptr).insert(new_item);
-				} else {
-					if (sc_fm1_max_mm_iterators == m_fm1_num_mm_const_iterators) {
-						/* Too many items. Initiate and switch to slow mode. */
-						/* Initialize slow storage. */
-						m_aux_mm_const_iterator_shptrs_ptr = new CMMConstIterators();
-						/* First copy the items from fast storage to slow storage. */
-						for (int i = 0; i < sc_fm1_max_mm_iterators; i += 1) {
-							(*m_aux_mm_const_iterator_shptrs_ptr).insert(m_fm1_key_mm_const_it_array[i]);
-						}
-						/* Add the new items to slow storage. */
-						(*m_aux_mm_const_iterator_shptrs_ptr).insert(new_item);
-					}
-					else {
-						m_fm1_key_mm_const_it_array[m_fm1_num_mm_const_iterators] = new_item;
-						m_fm1_num_mm_const_iterators += 1;
-					}
-				}
-				return retval;
+				auto index = m_const_iterator_pool.allocate(*static_cast<const _Myt*>(m_owner_ptr), key);
+				note_iterator_allocated(m_const_iterator_pool.iterator(index));
+				return mm_const_iterator_handle_type(key, index);
 			}
 			void release_const_item_pointer(mm_const_iterator_handle_type handle) {
-				if (!mm_const_fast_mode1()) {
-					auto it = (*m_aux_mm_const_iterator_shptrs_ptr).find(handle.m_key);
-					if ((*m_aux_mm_const_iterator_shptrs_ptr).end() != it) {
-						(*m_aux_mm_const_iterator_shptrs_ptr).erase(it);
-					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_const_iterator(mm_const_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
-					}
-				}
-				else {
-					int found_index = -1;
-					for (int i = 0; i < m_fm1_num_mm_const_iterators; i += 1) {
-						if (handle.m_key == m_fm1_key_mm_const_it_array[i].first) {
-							found_index = i;
-							break;
-						}
-					}
-					if (0 <= found_index) {
-						m_fm1_num_mm_const_iterators -= 1;
-						assert(0 <= m_fm1_num_mm_const_iterators);
-						for (int j = found_index; j < m_fm1_num_mm_const_iterators; j += 1) {
-							m_fm1_key_mm_const_it_array[j] = m_fm1_key_mm_const_it_array[j + 1];
-						}
-					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_const_iterator(mm_const_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
-					}
-				}
+				const auto generation = m_const_iterator_pool.iterator(handle.m_index).m_mmitset_generation;
+				m_const_iterator_pool.release(handle.m_index, handle.m_key);
+				note_iterator_released(generation);
 			}
 
 			mm_iterator_handle_type allocate_new_item_pointer() {
-				//auto shptr = std::shared_ptr<mm_iterator_type>(new mm_iterator_type(*m_owner_ptr));
-				auto shptr = std::make_shared<mm_iterator_type>(*m_owner_ptr);
 				auto key = m_next_available_key; m_next_available_key++;
-				mm_iterator_handle_type retval(key, shptr);
-				typename CMMIterators::value_type new_item(key, shptr);
-				if (!mm_fast_mode1()) {
-					(*m_aux_mm_iterator_shptrs_ptr).insert(new_item);
-				}
-				else {
-					if (sc_fm1_max_mm_iterators == m_fm1_num_mm_iterators) {
-						/* Too many items. Initiate and switch to slow mode. */
-						/* Initialize slow storage. */
-						m_aux_mm_iterator_shptrs_ptr = new CMMIterators();
-						/* First copy the items from fast storage to slow storage. */
-						for (int i = 0; i < sc_fm1_max_mm_iterators; i += 1) {
-							(*m_aux_mm_iterator_shptrs_ptr).insert(m_fm1_key_mm_it_array[i]);
-						}
-						/* Add the new items to slow storage. */
-						(*m_aux_mm_iterator_shptrs_ptr).insert(new_item);
-					}
-					else {
-						m_fm1_key_mm_it_array[m_fm1_num_mm_iterators] = new_item;
-						m_fm1_num_mm_iterators += 1;
-					}
-				}
-				return retval;
+				auto index = m_iterator_pool.allocate(*m_owner_ptr, key);
+				note_iterator_allocated(m_iterator_pool.iterator(index));
+				return mm_iterator_handle_type(key, index);
 			}
 			void release_item_pointer(mm_iterator_handle_type handle) {
-				if (!mm_fast_mode1()) {
-					auto it = (*m_aux_mm_iterator_shptrs_ptr).find(handle.m_key);
-					if ((*m_aux_mm_iterator_shptrs_ptr).end() != it) {
-						(*m_aux_mm_iterator_shptrs_ptr).erase(it);
-					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_iterator(mm_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
+				const auto generation = m_iterator_pool.iterator(handle.m_index).m_mmitset_generation;
+				m_iterator_pool.release(handle.m_index, handle.m_key);
+				note_iterator_released(generation);
+			}
+			void release_all_item_pointers() {
+				flush_modification_log();
+				m_iterator_pool.clear();
+				m_num_iterators_at_current_generation = num_iterators();
+			}
+			mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) {
+				auto& it = m_const_iterator_pool.iterator(handle.m_index);
+				bring_up_to_date(it);
+				return it;
+			}
+			mm_iterator_type &item_pointer(mm_iterator_handle_type handle) {
+				auto& it = m_iterator_pool.iterator(handle.m_index);
+				bring_up_to_date(it);
+				return it;
+			}
+
+		private:
+			/* When there are many iterators, rather than adjusting each of them on every insert or erase, modifications are
+			appended to a log, and each iterator replays the log entries it hasn't yet seen the next time it is accessed (via its
+			handle). So the cost of an insert or erase is independent of the number of iterators. */
+			class CModification {
+			public:
+				enum EKind { sc_shift, sc_invalidate, sc_reset };
+				CModification(EKind kind, msev_size_t index_of_first, msev_size_t index_of_last, msev_int shift, msev_size_t size_after)
+					: m_kind(kind), m_index_of_first(index_of_first), m_index_of_last(index_of_last), m_shift(shift), m_size_after(size_after) {}
+				EKind m_kind;
+				msev_size_t m_index_of_first;
+				msev_size_t m_index_of_last;
+				msev_int m_shift;
+				/* The size of the owner at the time of the modification. */
+				msev_size_t m_size_after;
+			};
+
+			std::size_t current_generation() const { return m_modification_log_base_generation + m_modification_log.size(); }
+			bool use_modification_log() const {
+				return ((!m_modification_log.empty()) || (sc_modification_log_iterator_threshold < num_iterators()));
+			}
+			void append_to_modification_log(const CModification& modification) {
+				m_modification_log.push_back(modification);
+				m_num_iterators_at_current_generation = 0;
+				if (sc_modification_log_max_size <= m_modification_log.size()) {
+					flush_modification_log();
+				}
+			}
+			void clear_modification_log() {
+				m_modification_log_base_generation = current_generation();
+				m_modification_log.clear();
+				m_num_iterators_at_current_generation = num_iterators();
+			}
+			/* Brings every iterator up to date and empties the log. */
+			void flush_modification_log() {
+				if (m_modification_log.empty()) { return; }
+				auto this_ptr = this;
+				apply_to_all_mm_const_iterators([this_ptr](mm_const_iterator_type& a) { this_ptr->replay_modification_log(a); });
+				apply_to_all_mm_iterators([this_ptr](mm_iterator_type& a) { this_ptr->replay_modification_log(a); });
+				clear_modification_log();
+			}
+			template<typename _TMMIterator>
+			void replay_modification_log(_TMMIterator& mm_iterator_ref) {
+				auto& it = mm_iterator_ref;
+				assert(m_modification_log_base_generation <= it.m_mmitset_generation);
+				const auto end_index = m_modification_log.size();
+				for (auto i = it.m_mmitset_generation - m_modification_log_base_generation; end_index > i; i += 1) {
+					const auto& modification = m_modification_log[i];
+					if (CModification::sc_reset == modification.m_kind) {
+						it.m_index = modification.m_size_after;
+						it.m_points_to_an_item = false;
 					}
-				}
-				else {
-					int found_index = -1;
-					for (int i = 0; i < m_fm1_num_mm_iterators; i += 1) {
-						if (handle.m_key == m_fm1_key_mm_it_array[i].first) {
-							found_index = i;
-							break;
+					else if ((modification.m_index_of_first <= it.m_index) && (modification.m_index_of_last >= it.m_index)) {
+						if (CModification::sc_invalidate == modification.m_kind) {
+							it.m_index = modification.m_size_after;
+							it.m_points_to_an_item = false;
 						}
-					}
-					if (0 <= found_index) {
-						m_fm1_num_mm_iterators -= 1;
-						assert(0 <= m_fm1_num_mm_iterators);
-						for (int j = found_index; j < m_fm1_num_mm_iterators; j += 1) {
-							m_fm1_key_mm_it_array[j] = m_fm1_key_mm_it_array[j + 1];
+						else {
+							auto new_index = msev_int(it.m_index) + modification.m_shift;
+							if ((0 > new_index) || (modification.m_size_after < msev_size_t(new_index))) {
+								MSE_THROW(msevector_range_error("void replay_modification_log() - mm_iterator_set_type - msevector"));
+							}
+							it.m_index = msev_size_t(new_index);
 						}
 					}
-					else {
-						/* Do we need to throw here? */
-						MSE_THROW(msevector_range_error("invalid handle - void release_aux_mm_iterator(mm_iterator_handle_type handle) - msevector::mm_iterator_set_type"));
-					}
 				}
+				it.m_mmitset_generation = current_generation();
 			}
-			void release_all_item_pointers() {
-				if (!mm_fast_mode1()) {
-					(*m_aux_mm_iterator_shptrs_ptr).clear();
+			template<typename _TMMIterator>
+			static void remap_after_erase(_TMMIterator& mm_iterator_ref, const std::vector<msev_size_t>& sorted_indices, msev_size_t size_after) {
+				auto& it = mm_iterator_ref;
+				const auto found = std::lower_bound(sorted_indices.cbegin(), sorted_indices.cend(), it.m_index);
+				if ((sorted_indices.cend() != found) && ((*found) == it.m_index)) {
+					it.m_index = size_after;
+					it.m_points_to_an_item = false;
 				}
 				else {
-					for (int i = 0; i < m_fm1_num_mm_iterators; i += 1) {
-						m_fm1_key_mm_it_array[i] = assignable_CMMIterators_value_type();
+					it.m_index -= msev_size_t(std::distance(sorted_indices.cbegin(), found));
+				}
+			}
+			template<typename _TMMIterator>
+			void bring_up_to_date(_TMMIterator& mm_iterator_ref) {
+				if (current_generation() != mm_iterator_ref.m_mmitset_generation) {
+					replay_modification_log(mm_iterator_ref);
+					m_num_iterators_at_current_generation += 1;
+					if (num_iterators() <= m_num_iterators_at_current_generation) {
+						/* Every iterator has seen every entry, so the log is no longer needed. */
+						clear_modification_log();
 					}
-					m_fm1_num_mm_iterators = 0;
 				}
 			}
-			mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) const {
-				return (*(handle.m_shptr));
+			template<typename _TMMIterator>
+			void note_iterator_allocated(_TMMIterator& mm_iterator_ref) {
+				mm_iterator_ref.m_mmitset_generation = current_generation();
+				m_num_iterators_at_current_generation += 1;
 			}
-			mm_iterator_type &item_pointer(mm_iterator_handle_type handle) {
-				return (*(handle.m_shptr));
+			void note_iterator_released(std::size_t released_iterator_generation) {
+				if (current_generation() == released_iterator_generation) {
+					assert(1 <= m_num_iterators_at_current_generation);
+					m_num_iterators_at_current_generation -= 1;
+				}
+				if ((!m_modification_log.empty()) && (num_iterators() <= m_num_iterators_at_current_generation)) {
+					clear_modification_log();
+				}
 			}
 
-		private:
 			void release_all_const_item_pointers() {
-				if (!mm_const_fast_mode1()) {
-					(*m_aux_mm_const_iterator_shptrs_ptr).clear();
-				}
-				else {
-					for (int i = 0; i < m_fm1_num_mm_const_iterators; i += 1) {
-						m_fm1_key_mm_const_it_array[i] = assignable_CMMConstIterators_value_type();
-					}
-					m_fm1_num_mm_const_iterators = 0;
-				}
+				flush_modification_log();
+				m_const_iterator_pool.clear();
+				m_num_iterators_at_current_generation = num_iterators();
 			}
 
 			mm_iterator_set_type& operator=(const mm_iterator_set_type& src_cref) {
@@ -1406,17 +1623,14 @@ namespace mse {
 
 			CHashKey1 m_next_available_key = 0;
 
-			static const int sc_fm1_max_mm_iterators = 6/*arbitrary*/;
+			static const std::size_t sc_modification_log_iterator_threshold = MSE_MSEVECTOR_MODIFICATION_LOG_ITERATOR_THRESHOLD;
+			static const std::size_t sc_modification_log_max_size = MSE_MSEVECTOR_MODIFICATION_LOG_MAX_SIZE;
+			std::vector<CModification> m_modification_log;
+			std::size_t m_modification_log_base_generation = 0;
+			std::size_t m_num_iterators_at_current_generation = 0;
 
-			bool mm_const_fast_mode1() const { return (nullptr == m_aux_mm_const_iterator_shptrs_ptr); }
-			int m_fm1_num_mm_const_iterators = 0;
-			assignable_CMMConstIterators_value_type m_fm1_key_mm_const_it_array[sc_fm1_max_mm_iterators];
-			CMMConstIterators* m_aux_mm_const_iterator_shptrs_ptr = nullptr;
-
-			bool mm_fast_mode1() const { return (nullptr == m_aux_mm_iterator_shptrs_ptr); }
-			int m_fm1_num_mm_iterators = 0;
-			assignable_CMMIterators_value_type m_fm1_key_mm_it_array[sc_fm1_max_mm_iterators];
-			CMMIterators* m_aux_mm_iterator_shptrs_ptr = nullptr;
+			impl::TMMIteratorPool<mm_const_iterator_type> m_const_iterator_pool;
+			impl::TMMIteratorPool<mm_iterator_type> m_iterator_pool;
 
 			_Myt* m_owner_ptr = nullptr;
 
@@ -1424,6 +1638,54 @@ namespace mse {
 		};
 		mutable mm_iterator_set_type m_mmitset;
 
+	public:
+		/* Returns an object that, while it (or any copy of it) exists, causes any operation that would change the size or
+		capacity of the vector to throw an exception. This is what allows a checked span to skip per-element bounds checks. */
+		CSizePin size_pin() const { return CSizePin(m_size_pin_count); }
+		bool is_size_pinned() const { return (0 != m_size_pin_count); }
+
+	private:
+		void throw_if_size_pinned() const {
+			if (is_size_pinned()) { MSE_THROW(msevector_size_pinned_error("attempt to change the size of a vector whose size is pinned - msevector")); }
+		}
+		_Myt& size_unpinned_self() { throw_if_size_pinned(); return (*this); }
+		/* Calls destroy_fn, which is expected to destroy the elements in the index range [first, last). If the element type
+		provides a "range_destruction_notifier_type" (see impl::THasRangeDestructionNotifier), it is notified first. */
+		template<class _TDestroyFunction>
+		void destroy_elements(msev_size_t first, msev_size_t last, const _TDestroyFunction& destroy_fn) {
+			destroy_elements(first, last, destroy_fn, typename impl::THasRangeDestructionNotifier<_Ty>::type());
+		}
+		template<class _TDestroyFunction>
+		void destroy_elements(msev_size_t first, msev_size_t last, const _TDestroyFunction& destroy_fn, std::true_type) {
+			typename _Ty::range_destruction_notifier_type notifier;
+			notifier.notify_range_destruction(base_class::data() + msev_as_a_size_t(first), base_class::data() + msev_as_a_size_t(last));
+			destroy_fn();
+		}
+		template<class _TDestroyFunction>
+		void destroy_elements(msev_size_t, msev_size_t, const _TDestroyFunction& destroy_fn, std::false_type) { destroy_fn(); }
+		/* Compacts the remaining elements in a single pass, then adjusts the registered iterators in a single pass. */
+		void erase_sorted_positions(const std::vector<msev_size_t>& sorted_indices) {
+			if (sorted_indices.empty()) { return; }
+			throw_if_size_pinned();
+			const auto original_size = msev_size_t((*this).size());
+			msev_size_t next_erased = 0;
+			auto write_index = sorted_indices.front();
+			for (auto read_index = write_index; original_size > read_index; read_index += 1) {
+				if ((sorted_indices.size() > next_erased) && (sorted_indices[msev_as_a_size_t(next_erased)] == read_index)) {
+					next_erased += 1;
+				}
+				else {
+					base_class::operator[](msev_as_a_size_t(write_index)) = std::move(base_class::operator[](msev_as_a_size_t(read_index)));
+					write_index += 1;
+				}
+			}
+			base_class::erase(base_class::begin() + msev_as_a_size_t(write_index), base_class::end());
+			/*m_debug_size = size();*/
+			assert((original_size - sorted_indices.size()) == msev_size_t((*this).size()));
+			m_mmitset.erase_sorted_positions(sorted_indices);
+		}
+		mutable std::size_t m_size_pin_count = 0;
+
 	public:
 		mm_const_iterator_type &const_item_pointer(mm_const_iterator_handle_type handle) const {
 			return m_mmitset.const_item_pointer(handle);
@@ -1452,21 +1714,16 @@ namespace mse {
 			typedef typename mm_const_iterator_type::reference reference;
 			typedef typename mm_const_iterator_type::const_reference const_reference;
 
-			cipointer(const _Myt& owner_cref) : m_owner_cptr(&owner_cref) {
-				mm_const_iterator_handle_type handle = m_owner_cptr->allocate_new_const_item_pointer();
-				m_handle_shptr = std::make_shared<mm_const_iterator_handle_type>(handle);
-			}
-			cipointer(const cipointer& src_cref) : m_owner_cptr(src_cref.m_owner_cptr) {
-				mm_const_iterator_handle_type handle = m_owner_cptr->allocate_new_const_item_pointer();
-				m_handle_shptr = std::make_shared<mm_const_iterator_handle_type>(handle);
+			cipointer(const _Myt& owner_cref) : m_owner_cptr(&owner_cref), m_handle(m_owner_cptr->allocate_new_const_item_pointer()) {}
+			cipointer(const cipointer& src_cref) : m_owner_cptr(src_cref.m_owner_cptr), m_handle(m_owner_cptr->allocate_new_const_item_pointer()) {
 				const_item_pointer() = src_cref.const_item_pointer();
 			}
 			~cipointer() {
-				m_owner_cptr->release_const_item_pointer(*m_handle_shptr);
+				m_owner_cptr->release_const_item_pointer(m_handle);
 			}
-			mm_const_iterator_type& const_item_pointer() const { return m_owner_cptr->const_item_pointer(*m_handle_shptr); }
+			mm_const_iterator_type& const_item_pointer() const { return m_owner_cptr->const_item_pointer(m_handle); }
 			mm_const_iterator_type& cip() const { return const_item_pointer(); }
-			//const mm_const_iterator_handle_type& handle() const { return (*m_handle_shptr); }
+			//const mm_const_iterator_handle_type& handle() const { return m_handle; }
 
 			void reset() { const_item_pointer().reset(); }
 			bool points_to_an_item() const { return const_item_pointer().points_to_an_item(); }
@@ -1508,7 +1765,7 @@ namespace mse {
 			msev_size_t position() const { return const_item_pointer().position(); }
 		private:
 			const _Myt* m_owner_cptr = nullptr;
-			std::shared_ptr<mm_const_iterator_handle_type> m_handle_shptr;
+			mm_const_iterator_handle_type m_handle;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
 		class ipointer {
@@ -1520,21 +1777,16 @@ namespace mse {
 			typedef typename mm_iterator_type::pointer pointer;
 			typedef typename mm_iterator_type::reference reference;
 
-			ipointer(_Myt& owner_ref) : m_owner_ptr(&owner_ref) {
-				mm_iterator_handle_type handle = m_owner_ptr->allocate_new_item_pointer();
-				m_handle_shptr = std::make_shared<mm_iterator_handle_type>(handle);
-			}
-			ipointer(const ipointer& src_cref) : m_owner_ptr(src_cref.m_owner_ptr) {
-				mm_iterator_handle_type handle = m_owner_ptr->allocate_new_item_pointer();
-				m_handle_shptr = std::make_shared<mm_iterator_handle_type>(handle);
+			ipointer(_Myt& owner_ref) : m_owner_ptr(&owner_ref), m_handle(m_owner_ptr->allocate_new_item_pointer()) {}
+			ipointer(const ipointer& src_cref) : m_owner_ptr(src_cref.m_owner_ptr), m_handle(m_owner_ptr->allocate_new_item_pointer()) {
 				item_pointer() = src_cref.item_pointer();
 			}
 			~ipointer() {
-				m_owner_ptr->release_item_pointer(*m_handle_shptr);
+				m_owner_ptr->release_item_pointer(m_handle);
 			}
-			mm_iterator_type& item_pointer() const { return m_owner_ptr->item_pointer(*m_handle_shptr); }
+			mm_iterator_type& item_pointer() const { return m_owner_ptr->item_pointer(m_handle); }
 			mm_iterator_type& ip() const { return item_pointer(); }
-			//const mm_iterator_handle_type& handle() const { return (*m_handle_shptr); }
+			//const mm_iterator_handle_type& handle() const { return m_handle; }
 			operator cipointer() const {
 				cipointer retval(*m_owner_ptr);
 				retval.const_item_pointer().set_to_beginning();
@@ -1582,7 +1834,7 @@ namespace mse {
 			msev_size_t position() const { return item_pointer().position(); }
 		private:
 			_Myt* m_owner_ptr = nullptr;
-			std::shared_ptr<mm_iterator_handle_type> m_handle_shptr;
+			mm_iterator_handle_type m_handle;
 			friend class /*_Myt*/msevector<_Ty, _A>;
 		};
 
@@ -1747,6 +1999,7 @@ namespace mse {
 #endif /*!(defined(GPP4P8_COMPATIBLE))*/
 			if (pos.m_owner_cptr != this) { MSE_THROW(msevector_range_error("invalid arguments - void emplace() - msevector")); }
 			typename base_class::const_iterator _P = pos;
+			throw_if_size_pinned();
 			auto retval = base_class::emplace(_P, std::forward<_Valty>(_Val)...);
 		}
 		template<class ..._Valty>
@@ -1988,6 +2241,8 @@ namespace mse {
 			msev_size_t position() const {
 				return m_index;
 			}
+			/* Returns a pointer to the vector that the iterator refers to (or null). */
+			const _Myt* target_container_ptr() const { return m_owner_cptr; }
 			operator typename base_class::const_iterator() const {
 				typename base_class::const_iterator retval = (*m_owner_cptr).cbegin();
 				retval += msev_as_a_size_t(m_index);
@@ -2167,6 +2422,8 @@ namespace mse {
 			msev_size_t position() const {
 				return m_index;
 			}
+			/* Returns a pointer to the vector that the iterator refers to (or null). */
+			_Myt* target_container_ptr() const { return m_owner_ptr; }
 			operator ss_const_iterator_type() const {
 				ss_const_iterator_type retval;
 				if (nullptr != m_owner_ptr) {
@@ -2423,6 +2680,68 @@ namespace mse {
 		}
 	};
 
+	namespace impl {
+		template<class _Ty, class _TCheckingPolicy, class _A> class TPolicyVector;
+		template<class _Ty, class _A> class TPolicyVector<_Ty, CCheckedPolicy, _A> { public: typedef msevector<_Ty, _A> type; };
+		template<class _Ty, class _A> class TPolicyVector<_Ty, CUncheckedPolicy, _A> { public: typedef std::vector<_Ty, _A> type; };
+	}
+	/* See the comment on CCheckedPolicy. An unchecked vector can be moved into a checked one with the msevector(base_class&&)
+	constructor or assign_from_range(), and the contents of a checked vector can be moved out with swap(base_class&). */
+	template<class _Ty, class _TCheckingPolicy = CCheckedPolicy, class _A = std::allocator<_Ty> >
+	using TPolicyVector = typename impl::TPolicyVector<_Ty, _TCheckingPolicy, _A>::type;
+
+	static void s_msevector_iterator_pool_test1() {
+#ifdef MSE_SELF_TESTS
+		class CIterator {
+		public:
+			CIterator(int& num_live_ref) : m_num_live_ptr(&num_live_ref) { (*m_num_live_ptr) += 1; }
+			~CIterator() { (*m_num_live_ptr) -= 1; }
+			int* m_num_live_ptr;
+		};
+		int num_live = 0;
+		{
+			impl::TMMIteratorPool<CIterator> pool;
+			const auto index1 = pool.allocate(num_live, 1);
+			const auto index2 = pool.allocate(num_live, 2);
+			assert((2 == pool.size()) && (2 == num_live));
+
+			/* A released record is reused by the next allocation. */
+			pool.release(index1, 1);
+			assert((1 == pool.size()) && (1 == num_live));
+			const auto index3 = pool.allocate(num_live, 3);
+			assert(index1 == index3);
+			assert(&num_live == pool.iterator(index3).m_num_live_ptr);
+
+			/* Releasing a stale handle (whose record was released, or released and reused) is an error. */
+			bool stale_release_detected = false;
+			try {
+				pool.release(index1, 1);
+			}
+			catch (const msevector_range_error&) {
+				stale_release_detected = true;
+			}
+			assert(stale_release_detected);
+			stale_release_detected = false;
+			pool.release(index2, 2);
+			try {
+				pool.release(index2, 2);
+			}
+			catch (const msevector_range_error&) {
+				stale_release_detected = true;
+			}
+			assert(stale_release_detected);
+			assert((1 == pool.size()) && (1 == num_live));
+
+			/* Allocations beyond the first slab. */
+			for (int i = 0; i < 40; i += 1) {
+				pool.allocate(num_live, 100 + i);
+			}
+			assert((41 == pool.size()) && (41 == num_live));
+		}
+		/* The pool's destructor destroys any remaining records. */
+		assert(0 == num_live);
+#endif // MSE_SELF_TESTS
+	}
 }
 
 #undef MSE_THROW
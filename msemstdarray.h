@@ -12,6 +12,7 @@
 #include <type_traits>
 #include <stdexcept>
 #include "msemsearray.h"
+#include "mserangedestruction.h"
 #ifndef MSE_MSTDARRAY_DISABLED
 #include "mseregistered.h"
 #endif /*MSE_MSTDARRAY_DISABLED*/
@@ -114,7 +115,7 @@ namespace mse {
 		/* Template specializations that construct mse::msearrays of different sizes are located later in the file. */
 
 		template<class _Ty, size_t _Size >
-		class array {
+		class array : private mse::impl::TRangeDestructionNotifierBase<_Ty> {
 		public:
 			typedef mse::mstd::array<_Ty, _Size> _Myt;
 			typedef mse::msearray<_Ty, _Size> _MA;
@@ -137,6 +138,11 @@ namespace mse {
 			array(const _MA& _X) : m_msearray(_X) {}
 			array(_Myt&& _X) : m_msearray(std::move(_X.msearray())) {}
 			array(const _Myt& _X) : m_msearray(_X.msearray()) {}
+			~array() {
+				/* The elements are destroyed (by m_msearray's destructor) after this body and before the base class (which
+				holds the notifier, if any) is destroyed. */
+				(*this).notify_range_destruction(m_msearray.data(), m_msearray.data() + _Size);
+			}
 			//array(_XSTD initializer_list<typename _MA::base_class::value_type> _Ilist) : m_msearray(_Ilist) {}
 			static mse::msearray<_Ty, _Size> msearray_initial_value(std::true_type, _XSTD initializer_list<_Ty> _Ilist) {
 				/* _Ty is default constructible. */
@@ -257,6 +263,7 @@ namespace mse {
 				bool operator>=(const const_iterator& _Right) const { return (msearray_ss_const_iterator_type() >= _Right.msearray_ss_const_iterator_type()); }
 				void set_to_const_item_pointer(const const_iterator& _Right_cref) { msearray_ss_const_iterator_type().set_to_const_item_pointer(_Right_cref.msearray_ss_const_iterator_type()); }
 				msear_size_t position() const { return msearray_ss_const_iterator_type().position(); }
+				const _MA* target_container_ptr() const { return msearray_ss_const_iterator_type().target_container_ptr(); }
 			private:
 				const_iterator(mse::TRegisteredConstPointer<_MA> msearray_regcptr) : m_msearray_regcptr(msearray_regcptr) {
 					m_ss_const_iterator = msearray_regcptr->ss_cbegin();
@@ -338,6 +345,7 @@ namespace mse {
 				bool operator>=(const iterator& _Right) const { return (msearray_ss_iterator_type() >= _Right.msearray_ss_iterator_type()); }
 				void set_to_item_pointer(const iterator& _Right_cref) { msearray_ss_iterator_type().set_to_item_pointer(_Right_cref.msearray_ss_iterator_type()); }
 				msear_size_t position() const { return msearray_ss_iterator_type().position(); }
+				_MA* target_container_ptr() const { return msearray_ss_iterator_type().target_container_ptr(); }
 			private:
 				mse::TRegisteredPointer<_MA> m_msearray_regptr = nullptr;
 				/* m_ss_iterator needs to be declared after m_msearray_regptr so that it's destructor will be called first. */
@@ -488,6 +496,7 @@ namespace mse {
 				bool operator>=(const xscope_const_iterator& _Right) const { return (msearray_xscope_ss_const_iterator_type() >= _Right.msearray_xscope_ss_const_iterator_type()); }
 				void set_to_const_item_pointer(const xscope_const_iterator& _Right_cref) { msearray_xscope_ss_const_iterator_type().set_to_const_item_pointer(_Right_cref.msearray_xscope_ss_const_iterator_type()); }
 				msear_size_t position() const { return msearray_xscope_ss_const_iterator_type().position(); }
+				const _MA* target_container_ptr() const { return msearray_xscope_ss_const_iterator_type().target_container_ptr(); }
 				void xscope_iterator_tag() const {}
 			private:
 				typename _MA::xscope_ss_const_iterator_type m_xscope_ss_const_iterator;
@@ -564,6 +573,7 @@ namespace mse {
 				bool operator>=(const xscope_iterator& _Right) const { return (msearray_xscope_ss_iterator_type() >= _Right.msearray_xscope_ss_iterator_type()); }
 				void set_to_item_pointer(const xscope_iterator& _Right_cref) { msearray_xscope_ss_iterator_type().set_to_item_pointer(_Right_cref.msearray_xscope_ss_iterator_type()); }
 				msear_size_t position() const { return msearray_xscope_ss_iterator_type().position(); }
+				_MA* target_container_ptr() const { return msearray_xscope_ss_iterator_type().target_container_ptr(); }
 				void xscope_iterator_tag() const {}
 			private:
 				typename _MA::xscope_ss_iterator_type m_xscope_ss_iterator;
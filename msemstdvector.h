@@ -9,11 +9,19 @@
 #define MSEMSTDVECTOR_H
 
 #include "msemsevector.h"
+#include "mserefcounting.h"
 
 #ifdef MSE_SAFER_SUBSTITUTES_DISABLED
 #define MSE_MSTDVECTOR_DISABLED
 #endif /*MSE_SAFER_SUBSTITUTES_DISABLED*/
 
+#ifdef MSE_CUSTOM_THROW_DEFINITION
+#include <iostream>
+#define MSE_THROW(x) MSE_CUSTOM_THROW_DEFINITION(x)
+#else // MSE_CUSTOM_THROW_DEFINITION
+#define MSE_THROW(x) throw(x)
+#endif // MSE_CUSTOM_THROW_DEFINITION
+
 namespace mse {
 
 	namespace mstd {
@@ -42,61 +50,71 @@ namespace mse {
 			typedef typename _MV::reference reference;
 			typedef typename _MV::const_reference const_reference;
 
-			const _MV& msevector() const { return (*m_shptr); }
-			_MV& msevector() { return (*m_shptr); }
+			const _MV& msevector() const { return (*msevector_shptr()); }
+			_MV& msevector() { return (*msevector_shptr()); }
 			operator const _MV() const { return msevector(); }
 			operator _MV() { return msevector(); }
 
-			explicit vector(const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_Al)) {}
-			explicit vector(size_type _N) : m_shptr(std::make_shared<_MV>(_N)) {}
-			explicit vector(size_type _N, const _Ty& _V, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_N, _V, _Al)) {}
-			vector(_MV&& _X) : m_shptr(std::make_shared<_MV>(std::move(_X))) {}
-			vector(const _MV& _X) : m_shptr(std::make_shared<_MV>(_X)) {}
-			vector(_Myt&& _X) : m_shptr(std::make_shared<_MV>(std::move(_X.msevector()))) {}
-			vector(const _Myt& _X) : m_shptr(std::make_shared<_MV>(_X.msevector())) {}
+			explicit vector(const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_Al)) {}
+			explicit vector(size_type _N) : m_shptr(mse::make_refcounting<_MV>(_N)) {}
+			explicit vector(size_type _N, const _Ty& _V, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_N, _V, _Al)) {}
+			vector(_MV&& _X) : m_shptr(mse::make_refcounting<_MV>(std::move(_X))) {}
+			vector(const _MV& _X) : m_shptr(mse::make_refcounting<_MV>(_X)) {}
+			/* Moving just transfers ownership of the underlying msevector. The moved-from vector is given a new (empty)
+			one, so that m_shptr is never null (and the const member functions never need to allocate). */
+			vector(_Myt&& _X) : m_shptr(mse::make_refcounting<_MV>()) { std::swap(m_shptr, _X.m_shptr); }
+			vector(const _Myt& _X) : m_shptr(mse::make_refcounting<_MV>(_X.msevector())) {}
 			typedef typename _MV::const_iterator _It;
-			vector(_It _F, _It _L, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_F, _L, _Al)) {}
-			vector(const _Ty* _F, const _Ty* _L, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_F, _L, _Al)) {}
+			vector(_It _F, _It _L, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_F, _L, _Al)) {}
+			vector(const _Ty* _F, const _Ty* _L, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_F, _L, _Al)) {}
 			template<class _Iter, class = typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type>
-			vector(_Iter _First, _Iter _Last) : m_shptr(std::make_shared<_MV>(_First, _Last)) {}
+			vector(_Iter _First, _Iter _Last) : m_shptr(mse::make_refcounting<_MV>(_First, _Last)) {}
 			template<class _Iter, class = typename std::enable_if<_mse_Is_iterator<_Iter>::value, void>::type>
-			vector(_Iter _First, _Iter _Last, const _A& _Al) : m_shptr(std::make_shared<_MV>(_First, _Last, _Al)) {}
-
-			_Myt& operator=(_MV&& _X) { m_shptr->operator=(std::move(_X)); return (*this); }
-			_Myt& operator=(const _MV& _X) { m_shptr->operator=(_X); return (*this); }
-			_Myt& operator=(_Myt&& _X) { m_shptr->operator=(std::move(_X.msevector())); return (*this); }
-			_Myt& operator=(const _Myt& _X) { m_shptr->operator=(_X.msevector()); return (*this); }
-			void reserve(size_type _Count) { m_shptr->reserve(_Count); }
-			void resize(size_type _N, const _Ty& _X = _Ty()) { m_shptr->resize(_N, _X); }
-			typename _MV::const_reference operator[](size_type _P) const { return m_shptr->operator[](_P); }
-			typename _MV::reference operator[](size_type _P) { return m_shptr->operator[](_P); }
-			void push_back(_Ty&& _X) { m_shptr->push_back(std::move(_X)); }
-			void push_back(const _Ty& _X) { m_shptr->push_back(_X); }
-			void pop_back() { m_shptr->pop_back(); }
-			void assign(_It _F, _It _L) { m_shptr->assign(_F, _L); }
-			void assign(size_type _N, const _Ty& _X = _Ty()) { m_shptr->assign(_N, _X); }
+			vector(_Iter _First, _Iter _Last, const _A& _Al) : m_shptr(mse::make_refcounting<_MV>(_First, _Last, _Al)) {}
+
+			_Myt& operator=(_MV&& _X) { msevector().operator=(std::move(_X)); return (*this); }
+			_Myt& operator=(const _MV& _X) { msevector().operator=(_X); return (*this); }
+			_Myt& operator=(_Myt&& _X) {
+				if (this != std::addressof(_X)) {
+					if (m_shptr->is_size_pinned()) { MSE_THROW(msevector_size_pinned_error("attempt to replace a vector whose size is pinned - _Myt& operator=(_Myt&& _X) - vector")); }
+					TRefCountingPointer<_MV> empty_shptr(mse::make_refcounting<_MV>());
+					m_shptr = std::move(_X.m_shptr);
+					_X.m_shptr = std::move(empty_shptr);
+				}
+				return (*this);
+			}
+			_Myt& operator=(const _Myt& _X) { msevector().operator=(_X.msevector()); return (*this); }
+			void reserve(size_type _Count) { msevector().reserve(_Count); }
+			void resize(size_type _N, const _Ty& _X = _Ty()) { msevector().resize(_N, _X); }
+			typename _MV::const_reference operator[](size_type _P) const { return msevector().operator[](_P); }
+			typename _MV::reference operator[](size_type _P) { return msevector().operator[](_P); }
+			void push_back(_Ty&& _X) { msevector().push_back(std::move(_X)); }
+			void push_back(const _Ty& _X) { msevector().push_back(_X); }
+			void pop_back() { msevector().pop_back(); }
+			void assign(_It _F, _It _L) { msevector().assign(_F, _L); }
+			void assign(size_type _N, const _Ty& _X = _Ty()) { msevector().assign(_N, _X); }
 			template<class ..._Valty>
-			void emplace_back(_Valty&& ..._Val) { m_shptr->emplace_back(std::forward<_Valty>(_Val)...); }
-			void clear() { m_shptr->clear(); }
-			void swap(_MV& _X) { m_shptr->swap(_X); }
-			void swap(_Myt& _X) { m_shptr->swap(_X.msevector()); }
-
-			vector(_XSTD initializer_list<typename _MV::value_type> _Ilist, const _A& _Al = _A()) : m_shptr(std::make_shared<_MV>(_Ilist, _Al)) {}
-			_Myt& operator=(_XSTD initializer_list<typename _MV::value_type> _Ilist) { m_shptr->operator=(_Ilist); return (*this); }
-			void assign(_XSTD initializer_list<typename _MV::value_type> _Ilist) { m_shptr->assign(_Ilist); }
-
-			size_type capacity() const _NOEXCEPT{ return m_shptr->capacity(); }
-			void shrink_to_fit() { m_shptr->shrink_to_fit(); }
-			size_type size() const _NOEXCEPT{ return m_shptr->size(); }
-			size_type max_size() const _NOEXCEPT{ return m_shptr->max_size(); }
-			bool empty() const _NOEXCEPT{ return m_shptr->empty(); }
-			_A get_allocator() const _NOEXCEPT{ return m_shptr->get_allocator(); }
-			typename _MV::const_reference at(size_type _Pos) const { return m_shptr->at(_Pos); }
-			typename _MV::reference at(size_type _Pos) { return m_shptr->at(_Pos); }
-			typename _MV::reference front() { return m_shptr->front(); }
-			typename _MV::const_reference front() const { return m_shptr->front(); }
-			typename _MV::reference back() { return m_shptr->back(); }
-			typename _MV::const_reference back() const { return m_shptr->back(); }
+			void emplace_back(_Valty&& ..._Val) { msevector().emplace_back(std::forward<_Valty>(_Val)...); }
+			void clear() { msevector().clear(); }
+			void swap(_MV& _X) { msevector().swap(_X); }
+			void swap(_Myt& _X) { msevector().swap(_X.msevector()); }
+
+			vector(_XSTD initializer_list<typename _MV::value_type> _Ilist, const _A& _Al = _A()) : m_shptr(mse::make_refcounting<_MV>(_Ilist, _Al)) {}
+			_Myt& operator=(_XSTD initializer_list<typename _MV::value_type> _Ilist) { msevector().operator=(_Ilist); return (*this); }
+			void assign(_XSTD initializer_list<typename _MV::value_type> _Ilist) { msevector().assign(_Ilist); }
+
+			size_type capacity() const _NOEXCEPT{ return msevector().capacity(); }
+			void shrink_to_fit() { msevector().shrink_to_fit(); }
+			size_type size() const _NOEXCEPT{ return msevector().size(); }
+			size_type max_size() const _NOEXCEPT{ return msevector().max_size(); }
+			bool empty() const _NOEXCEPT{ return msevector().empty(); }
+			_A get_allocator() const _NOEXCEPT{ return msevector().get_allocator(); }
+			typename _MV::const_reference at(size_type _Pos) const { return msevector().at(_Pos); }
+			typename _MV::reference at(size_type _Pos) { return msevector().at(_Pos); }
+			typename _MV::reference front() { return msevector().front(); }
+			typename _MV::const_reference front() const { return msevector().front(); }
+			typename _MV::reference back() { return msevector().back(); }
+			typename _MV::const_reference back() const { return msevector().back(); }
 
 
 			class const_iterator {
@@ -155,11 +173,15 @@ namespace mse {
 				bool operator>=(const const_iterator& _Right) const { return (msevector_ss_const_iterator_type() >= _Right.msevector_ss_const_iterator_type()); }
 				void set_to_const_item_pointer(const const_iterator& _Right_cref) { msevector_ss_const_iterator_type().set_to_const_item_pointer(_Right_cref.msevector_ss_const_iterator_type()); }
 				msev_size_t position() const { return msevector_ss_const_iterator_type().position(); }
+				const _MV* target_container_ptr() const { return msevector_ss_const_iterator_type().target_container_ptr(); }
+				/* Indicates that the iterator keeps its target container alive (so direct access to the container's elements,
+				e.g. by a scope section, remains valid for as long as the iterator exists). */
+				void target_container_retained_tag() const {}
 			private:
-				const_iterator(std::shared_ptr<_MV> msevector_shptr) : m_msevector_cshptr(msevector_shptr) {
+				const_iterator(TRefCountingPointer<_MV> msevector_shptr) : m_msevector_cshptr(msevector_shptr) {
 					m_ss_const_iterator = msevector_shptr->ss_cbegin();
 				}
-				std::shared_ptr<const _MV> m_msevector_cshptr;
+				TRefCountingConstPointer<_MV> m_msevector_cshptr;
 				/* m_ss_const_iterator needs to be declared after m_msevector_cshptr so that it's destructor will be called first. */
 				typename _MV::ss_const_iterator_type m_ss_const_iterator;
 				friend class /*_Myt*/vector<_Ty, _A>;
@@ -229,8 +251,10 @@ namespace mse {
 				bool operator>=(const iterator& _Right) const { return (msevector_ss_iterator_type() >= _Right.msevector_ss_iterator_type()); }
 				void set_to_item_pointer(const iterator& _Right_cref) { msevector_ss_iterator_type().set_to_item_pointer(_Right_cref.msevector_ss_iterator_type()); }
 				msev_size_t position() const { return msevector_ss_iterator_type().position(); }
+				_MV* target_container_ptr() const { return msevector_ss_iterator_type().target_container_ptr(); }
+				void target_container_retained_tag() const {}
 			private:
-				std::shared_ptr<_MV> m_msevector_shptr;
+				TRefCountingPointer<_MV> m_msevector_shptr;
 				/* m_ss_iterator needs to be declared after m_msevector_shptr so that it's destructor will be called first. */
 				typename _MV::ss_iterator_type m_ss_iterator;
 				friend class /*_Myt*/vector<_Ty, _A>;
@@ -238,55 +262,55 @@ namespace mse {
 
 			iterator begin()
 			{	// return iterator for beginning of mutable sequence
-				iterator retval; retval.m_msevector_shptr = this->m_shptr;
-				(retval.m_ss_iterator) = m_shptr->ss_begin();
+				iterator retval; retval.m_msevector_shptr = msevector_shptr();
+				(retval.m_ss_iterator) = msevector().ss_begin();
 				return retval;
 			}
 
 			const_iterator begin() const
 			{	// return iterator for beginning of nonmutable sequence
-				const_iterator retval; retval.m_msevector_cshptr = this->m_shptr;
-				(retval.m_ss_const_iterator) = m_shptr->ss_begin();
+				const_iterator retval; retval.m_msevector_cshptr = msevector_shptr();
+				(retval.m_ss_const_iterator) = msevector().ss_begin();
 				return retval;
 			}
 
 			iterator end() {	// return iterator for end of mutable sequence
-				iterator retval; retval.m_msevector_shptr = this->m_shptr;
-				(retval.m_ss_iterator) = m_shptr->ss_end();
+				iterator retval; retval.m_msevector_shptr = msevector_shptr();
+				(retval.m_ss_iterator) = msevector().ss_end();
 				return retval;
 			}
 			const_iterator end() const {	// return iterator for end of nonmutable sequence
-				const_iterator retval; retval.m_msevector_cshptr = this->m_shptr;
-				(retval.m_ss_const_iterator) = m_shptr->ss_end();
+				const_iterator retval; retval.m_msevector_cshptr = msevector_shptr();
+				(retval.m_ss_const_iterator) = msevector().ss_end();
 				return retval;
 			}
 			const_iterator cbegin() const {	// return iterator for beginning of nonmutable sequence
-				const_iterator retval; retval.m_msevector_cshptr = this->m_shptr;
-				(retval.m_ss_const_iterator) = m_shptr->ss_cbegin();
+				const_iterator retval; retval.m_msevector_cshptr = msevector_shptr();
+				(retval.m_ss_const_iterator) = msevector().ss_cbegin();
 				return retval;
 			}
 			const_iterator cend() const {	// return iterator for end of nonmutable sequence
-				const_iterator retval; retval.m_msevector_cshptr = this->m_shptr;
-				(retval.m_ss_const_iterator) = m_shptr->ss_cend();
+				const_iterator retval; retval.m_msevector_cshptr = msevector_shptr();
+				(retval.m_ss_const_iterator) = msevector().ss_cend();
 				return retval;
 			}
 
 
 			vector(const const_iterator &start, const const_iterator &end, const _A& _Al = _A())
-				: m_shptr(std::make_shared<_MV>(start.msevector_ss_const_iterator_type(), end.msevector_ss_const_iterator_type(), _Al)) {}
+				: m_shptr(mse::make_refcounting<_MV>(start.msevector_ss_const_iterator_type(), end.msevector_ss_const_iterator_type(), _Al)) {}
 			void assign(const const_iterator &start, const const_iterator &end) {
-				m_shptr->assign(start.msevector_ss_const_iterator_type(), end.msevector_ss_const_iterator_type());
+				msevector().assign(start.msevector_ss_const_iterator_type(), end.msevector_ss_const_iterator_type());
 			}
 			void assign_inclusive(const const_iterator &first, const const_iterator &last) {
-				m_shptr->assign_inclusive(first.msevector_ss_const_iterator_type(), last.msevector_ss_const_iterator_type());
+				msevector().assign_inclusive(first.msevector_ss_const_iterator_type(), last.msevector_ss_const_iterator_type());
 			}
 			iterator insert_before(const const_iterator &pos, size_type _M, const _Ty& _X) {
-				auto res = m_shptr->insert_before(pos.msevector_ss_const_iterator_type(), _M, _X);
+				auto res = msevector().insert_before(pos.msevector_ss_const_iterator_type(), _M, _X);
 				iterator retval = begin(); retval.msevector_ss_iterator_type() = res;
 				return retval;
 			}
 			iterator insert_before(const const_iterator &pos, _Ty&& _X) {
-				auto res = m_shptr->insert_before(pos.msevector_ss_const_iterator_type(), std::move(_X));
+				auto res = msevector().insert_before(pos.msevector_ss_const_iterator_type(), std::move(_X));
 				iterator retval = begin(); retval.msevector_ss_iterator_type() = res;
 				return retval;
 			}
@@ -295,7 +319,7 @@ namespace mse {
 				//>typename std::enable_if<_mse_Is_iterator<_Iter>::value, typename base_class::iterator>::type
 				, class = _mse_RequireInputIter<_Iter> >
 			iterator insert_before(const const_iterator &pos, const _Iter &start, const _Iter &end) {
-				auto res = m_shptr->insert_before(pos.msevector_ss_const_iterator_type(), start, end);
+				auto res = msevector().insert_before(pos.msevector_ss_const_iterator_type(), start, end);
 				iterator retval = begin(); retval.msevector_ss_iterator_type() = res;
 				return retval;
 			}
@@ -307,18 +331,18 @@ namespace mse {
 				return insert_before(pos, first, end);
 			}
 			iterator insert_before(const const_iterator &pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) {	// insert initializer_list
-				auto res = m_shptr->insert_before(pos.msevector_ss_const_iterator_type(), _Ilist);
+				auto res = msevector().insert_before(pos.msevector_ss_const_iterator_type(), _Ilist);
 				iterator retval = begin(); retval.msevector_ss_iterator_type() = res;
 				return retval;
 			}
 			void insert_before(msev_size_t pos, const _Ty& _X = _Ty()) {
-				m_shptr->insert_before(pos, _X);
+				msevector().insert_before(pos, _X);
 			}
 			void insert_before(msev_size_t pos, size_type _M, const _Ty& _X) {
-				m_shptr->insert_before(pos, _M, _X);
+				msevector().insert_before(pos, _M, _X);
 			}
 			void insert_before(msev_size_t pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) {	// insert initializer_list
-				m_shptr->insert_before(pos, _Ilist);
+				msevector().insert_before(pos, _Ilist);
 			}
 			/* These insert() functions are just aliases for their corresponding insert_before() functions. */
 			iterator insert(const const_iterator &pos, size_type _M, const _Ty& _X) { return insert_before(pos, _M, _X); }
@@ -332,17 +356,17 @@ namespace mse {
 			iterator insert(const const_iterator &pos, _XSTD initializer_list<typename _MV::value_type> _Ilist) { return insert_before(pos, _Ilist); }
 			template<class ..._Valty>
 			iterator emplace(const const_iterator &pos, _Valty&& ..._Val) {
-				auto res = m_shptr->emplace(pos.msevector_ss_const_iterator_type(), std::forward<_Valty>(_Val)...);
+				auto res = msevector().emplace(pos.msevector_ss_const_iterator_type(), std::forward<_Valty>(_Val)...);
 				iterator retval = begin(); retval.msevector_ss_iterator_type() = res;
 				return retval;
 			}
 			iterator erase(const const_iterator &pos) {
-				auto res = m_shptr->erase(pos.msevector_ss_const_iterator_type());
+				auto res = msevector().erase(pos.msevector_ss_const_iterator_type());
 				iterator retval = begin(); retval.msevector_ss_iterator_type() = res;
 				return retval;
 			}
 			iterator erase(const const_iterator &start, const const_iterator &end) {
-				auto res = m_shptr->erase(start.msevector_ss_const_iterator_type(), end.msevector_ss_const_iterator_type());
+				auto res = msevector().erase(start.msevector_ss_const_iterator_type(), end.msevector_ss_const_iterator_type());
 				iterator retval = begin(); retval.msevector_ss_iterator_type() = res;
 				return retval;
 			}
@@ -351,14 +375,16 @@ namespace mse {
 				return erase_inclusive(first, end);
 			}
 			bool operator==(const _Myt& _Right) const {	// test for vector equality
-				return ((*(_Right.m_shptr)) == (*m_shptr));
+				return (_Right.msevector() == msevector());
 			}
 			bool operator<(const _Myt& _Right) const {	// test if _Left < _Right for vectors
-				return ((*m_shptr) < (*(_Right.m_shptr)));
+				return (msevector() < _Right.msevector());
 			}
 
 		private:
-			std::shared_ptr<_MV> m_shptr;
+			const TRefCountingPointer<_MV>& msevector_shptr() const { return m_shptr; }
+
+			TRefCountingPointer<_MV> m_shptr;
 		};
 
 		template<class _Ty, class _Alloc> inline bool operator!=(const vector<_Ty, _Alloc>& _Left,
@@ -0,0 +1,372 @@
+// Copyright (c) 2015 Noah Lopez
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef MSEPARALLEL_H_
+#define MSEPARALLEL_H_
+
+#include "msepoly.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+
+#ifdef MSE_CUSTOM_THROW_DEFINITION
+#include <iostream>
+#define MSE_THROW(x) MSE_CUSTOM_THROW_DEFINITION(x)
+#else // MSE_CUSTOM_THROW_DEFINITION
+#define MSE_THROW(x) throw(x)
+#endif // MSE_CUSTOM_THROW_DEFINITION
+
+/* The number of (worker) threads in the pool used by the mse::par algorithms. Zero means one less than the number of
+hardware threads (the calling thread also does its share of the work). */
+#ifndef MSE_PAR_NUM_WORKER_THREADS
+#define MSE_PAR_NUM_WORKER_THREADS 0
+#endif // !MSE_PAR_NUM_WORKER_THREADS
+/* Ranges with fewer elements than this (per available thread) are processed with fewer threads, or just by the calling
+thread. */
+#ifndef MSE_PAR_MIN_CHUNK_SIZE
+#define MSE_PAR_MIN_CHUNK_SIZE 4096
+#endif // !MSE_PAR_MIN_CHUNK_SIZE
+
+namespace mse {
+
+	/* The mse::par algorithms (for_each(), transform(), reduce() and sort()) operate on whole "ranges", where a range is an
+	msevector, mstd::vector, msearray, mstd::array, TXScopeCheckedSpan, TXScopeRandomAccessSection or
+	TXScopeRandomAccessConstSection. The range is validated once, up front, and, in the case of vectors, its size is pinned
+	(see msevector<>::size_pin()) for the duration of the algorithm. The range is then divided into chunks which are
+	processed concurrently (by a shared pool of threads, and the calling thread) directly on the underlying (contiguous)
+	storage, without the per-element checks of the safe iterators. A section that doesn't have direct access to its
+	elements is just processed by the calling thread (through its (checked) operator[]).
+	As with the standard parallel algorithms, the given functions are invoked concurrently, so they must not (unsafely)
+	access shared state, and the operation given to reduce() must be associative. If any invocation throws an exception,
+	the (first) exception is rethrown by the algorithm once all the chunks have completed. */
+	namespace impl {
+		namespace par {
+			class CThreadPool {
+			public:
+				static CThreadPool& instance() {
+					static CThreadPool s_thread_pool;
+					return s_thread_pool;
+				}
+				/* The number of threads, including the calling thread, that work can be divided among. */
+				size_t concurrency() const { return m_threads.size() + 1; }
+				void submit(std::function<void()> task) {
+					{
+						std::lock_guard<std::mutex> lock1(m_mutex);
+						m_tasks.push_back(std::move(task));
+					}
+					m_cv.notify_one();
+				}
+
+			private:
+				CThreadPool() {
+					size_t num_worker_threads = MSE_PAR_NUM_WORKER_THREADS;
+					if (0 == num_worker_threads) {
+						auto num_hardware_threads = size_t(std::thread::hardware_concurrency());
+						num_worker_threads = (2 <= num_hardware_threads) ? (num_hardware_threads - 1) : 0;
+					}
+					for (size_t i = 0; i < num_worker_threads; i += 1) {
+						m_threads.emplace_back([this]() { (*this).worker_loop(); });
+					}
+				}
+				~CThreadPool() {
+					{
+						std::lock_guard<std::mutex> lock1(m_mutex);
+						m_is_stopping = true;
+					}
+					m_cv.notify_all();
+					for (auto& thread_ref : m_threads) {
+						thread_ref.join();
+					}
+				}
+				CThreadPool(const CThreadPool&) = delete;
+				CThreadPool& operator=(const CThreadPool&) = delete;
+
+				void worker_loop() {
+					while (true) {
+						std::function<void()> task;
+						{
+							std::unique_lock<std::mutex> lock1(m_mutex);
+							m_cv.wait(lock1, [this]() { return m_is_stopping || (!m_tasks.empty()); });
+							if (m_tasks.empty()) {
+								return;
+							}
+							task = std::move(m_tasks.front());
+							m_tasks.pop_front();
+						}
+						task();
+					}
+				}
+
+				std::mutex m_mutex;
+				std::condition_variable m_cv;
+				std::deque<std::function<void()>> m_tasks;
+				bool m_is_stopping = false;
+				std::vector<std::thread> m_threads;
+			};
+
+			/* The state shared by the threads participating in a run_tasks() call. Helper threads that get around to it after
+			all the tasks have been claimed just return, so the state is reference counted rather than owned by the caller. */
+			class CForkJoinState {
+			public:
+				CForkJoinState(size_t num_tasks, const std::function<void(size_t)>& task_function_ref)
+					: m_num_tasks(num_tasks), m_task_function_ptr(&task_function_ref) {}
+
+				/* Claims and runs tasks until there are none left. Note that the task function (which belongs to the caller
+				of run_tasks()) is only accessed while there are unfinished tasks. */
+				void work() {
+					while (true) {
+						const size_t task_index = m_next_task_index.fetch_add(1);
+						if (m_num_tasks <= task_index) {
+							return;
+						}
+						try {
+							(*m_task_function_ptr)(task_index);
+						}
+						catch (...) {
+							std::lock_guard<std::mutex> lock1(m_mutex);
+							if (!m_exception_ptr) {
+								m_exception_ptr = std::current_exception();
+							}
+						}
+						bool all_done = false;
+						{
+							std::lock_guard<std::mutex> lock1(m_mutex);
+							m_num_completed_tasks += 1;
+							all_done = (m_num_tasks == m_num_completed_tasks);
+						}
+						if (all_done) {
+							m_cv.notify_all();
+						}
+					}
+				}
+				void wait_for_completion_and_rethrow() {
+					std::unique_lock<std::mutex> lock1(m_mutex);
+					m_cv.wait(lock1, [this]() { return (m_num_tasks == m_num_completed_tasks); });
+					if (m_exception_ptr) {
+						std::rethrow_exception(m_exception_ptr);
+					}
+				}
+
+			private:
+				const size_t m_num_tasks = 0;
+				const std::function<void(size_t)>* const m_task_function_ptr = nullptr;
+				std::atomic<size_t> m_next_task_index{ 0 };
+				std::mutex m_mutex;
+				std::condition_variable m_cv;
+				size_t m_num_completed_tasks = 0;
+				std::exception_ptr m_exception_ptr;
+			};
+
+			/* Calls task_function(i) for each i in [0, num_tasks), concurrently, and returns once they've all completed. */
+			inline void run_tasks(size_t num_tasks, const std::function<void(size_t)>& task_function) {
+				if (1 >= num_tasks) {
+					if (1 == num_tasks) { task_function(0); }
+					return;
+				}
+				auto& thread_pool_ref = CThreadPool::instance();
+				auto state_shptr = std::make_shared<CForkJoinState>(num_tasks, task_function);
+				const auto num_helpers = std::min(num_tasks, thread_pool_ref.concurrency()) - 1;
+				for (size_t i = 0; i < num_helpers; i += 1) {
+					thread_pool_ref.submit([state_shptr]() { (*state_shptr).work(); });
+				}
+				/* The calling thread does its share too. (So the tasks are completed even if the pool's threads are all busy,
+				as they would be, for example, when an algorithm is invoked from a function passed to another algorithm.) */
+				(*state_shptr).work();
+				(*state_shptr).wait_for_completion_and_rethrow();
+			}
+
+			/* The number of chunks a range of the given size is divided into. */
+			inline size_t num_chunks_for(size_t count) {
+				const size_t min_chunk_size = (1 <= MSE_PAR_MIN_CHUNK_SIZE) ? MSE_PAR_MIN_CHUNK_SIZE : 1;
+				return std::max(size_t(1), std::min(CThreadPool::instance().concurrency(), count / min_chunk_size));
+			}
+			inline size_t chunk_boundary(size_t count, size_t num_chunks, size_t chunk_index) {
+				return size_t((unsigned long long)(count) * chunk_index / num_chunks);
+			}
+			/* Calls chunk_function(first_index, last_index) for each of the chunks [first_index, last_index) that the
+			index range [0, count) is divided into, concurrently. */
+			template<typename _TChunkFunction>
+			void for_each_chunk(size_t count, const _TChunkFunction& chunk_function) {
+				if (0 == count) { return; }
+				const auto num_chunks = num_chunks_for(count);
+				run_tasks(num_chunks, [&chunk_function, count, num_chunks](size_t chunk_index) {
+					chunk_function(chunk_boundary(count, num_chunks, chunk_index), chunk_boundary(count, num_chunks, chunk_index + 1));
+				});
+			}
+
+			/* A native pointer to the first element of a (validated) range, the number of elements, and a size pin on the
+			range's container (if applicable). A null m_data_ptr indicates that the elements can't be accessed directly. */
+			template<typename _Ty>
+			class TContiguousElements {
+			public:
+				TContiguousElements(_Ty* data_ptr, size_t count, const CSizePin& size_pin) : m_data_ptr(data_ptr), m_count(count), m_size_pin(size_pin) {}
+				TContiguousElements(const TContiguousElements& src) = default;
+
+				_Ty* const m_data_ptr = nullptr;
+				const size_t m_count = 0;
+				const CSizePin m_size_pin;
+			};
+			template<typename _TContainer>
+			auto contiguous_elements(_TContainer& container_ref) -> TContiguousElements<typename std::remove_pointer<decltype(mse::impl::contiguous_data_ptr(container_ref))>::type> {
+				typedef typename std::remove_pointer<decltype(mse::impl::contiguous_data_ptr(container_ref))>::type element_t;
+				/* Obtaining the pin first ensures the elements won't be relocated after we've obtained their address. */
+				const auto size_pin = mse::impl::contiguous_size_pin(container_ref);
+				return TContiguousElements<element_t>(mse::impl::contiguous_data_ptr(container_ref), size_t(container_ref.size()), size_pin);
+			}
+			/* Spans and sections hold their own size pins, and they outlive the algorithm invocation. */
+			template<typename _Ty>
+			TContiguousElements<_Ty> contiguous_elements(const TXScopeCheckedSpan<_Ty>& span_ref) {
+				return TContiguousElements<_Ty>(span_ref.data(), size_t(span_ref.size()), CSizePin());
+			}
+			template<typename _Ty>
+			TContiguousElements<_Ty> contiguous_elements(const TXScopeRandomAccessSection<_Ty>& section_ref) {
+				return TContiguousElements<_Ty>(section_ref.contiguous_data_ptr(), size_t(section_ref.size()), CSizePin());
+			}
+			template<typename _Ty>
+			TContiguousElements<const _Ty> contiguous_elements(const TXScopeRandomAccessConstSection<_Ty>& section_ref) {
+				return TContiguousElements<const _Ty>(section_ref.contiguous_data_ptr(), size_t(section_ref.size()), CSizePin());
+			}
+
+			template<typename _TRange>
+			using range_element_t = typename std::remove_reference<decltype(std::declval<_TRange&>()[0])>::type;
+		}
+	}
+
+	namespace par {
+		/* Calls function(element) for each element of the range. */
+		template<typename _TRange, typename _TFunction>
+		void for_each(_TRange&& range, _TFunction function) {
+			const auto elements = impl::par::contiguous_elements(range);
+			if (nullptr == elements.m_data_ptr) {
+				for (size_t i = 0; elements.m_count > i; i += 1) {
+					function(range[i]);
+				}
+				return;
+			}
+			const auto data_ptr = elements.m_data_ptr;
+			impl::par::for_each_chunk(elements.m_count, [data_ptr, &function](size_t first, size_t last) {
+				std::for_each(data_ptr + first, data_ptr + last, function);
+			});
+		}
+
+		/* Assigns op(src_range[i]) to dest_range[i] for each element of src_range. dest_range must have at least as many
+		elements as src_range. */
+		template<typename _TSrcRange, typename _TDestRange, typename _TUnaryOperation>
+		void transform(const _TSrcRange& src_range, _TDestRange&& dest_range, _TUnaryOperation op) {
+			const auto src_elements = impl::par::contiguous_elements(src_range);
+			const auto dest_elements = impl::par::contiguous_elements(dest_range);
+			if (dest_elements.m_count < src_elements.m_count) { MSE_THROW(msearray_range_error("destination range too small - transform() - mse::par")); }
+			if ((nullptr == src_elements.m_data_ptr) || (nullptr == dest_elements.m_data_ptr)) {
+				for (size_t i = 0; src_elements.m_count > i; i += 1) {
+					dest_range[i] = op(src_range[i]);
+				}
+				return;
+			}
+			const auto src_data_ptr = src_elements.m_data_ptr;
+			const auto dest_data_ptr = dest_elements.m_data_ptr;
+			impl::par::for_each_chunk(src_elements.m_count, [src_data_ptr, dest_data_ptr, &op](size_t first, size_t last) {
+				std::transform(src_data_ptr + first, src_data_ptr + last, dest_data_ptr + first, op);
+			});
+		}
+
+		/* Returns the "sum" (according to op) of init and all the elements of the range. Because the elements are summed in
+		chunks (and the chunk results then combined), op must be associative. But unlike std::accumulate(), the result
+		doesn't depend on the number of chunks if op is also commutative. It isn't required to be. */
+		template<typename _TRange, typename _Ty, typename _TBinaryOperation>
+		_Ty reduce(const _TRange& range, _Ty init, _TBinaryOperation op) {
+			const auto elements = impl::par::contiguous_elements(range);
+			if (nullptr == elements.m_data_ptr) {
+				for (size_t i = 0; elements.m_count > i; i += 1) {
+					init = op(init, range[i]);
+				}
+				return init;
+			}
+			if (0 == elements.m_count) { return init; }
+			const auto data_ptr = elements.m_data_ptr;
+			const auto count = elements.m_count;
+			const auto num_chunks = impl::par::num_chunks_for(count);
+			/* Each chunk is non-empty, so its partial result can start with its first element (op needn't have an identity). */
+			std::vector<_Ty> partial_results(num_chunks, init);
+			impl::par::run_tasks(num_chunks, [data_ptr, count, num_chunks, &op, &partial_results](size_t chunk_index) {
+				const auto first = impl::par::chunk_boundary(count, num_chunks, chunk_index);
+				const auto last = impl::par::chunk_boundary(count, num_chunks, chunk_index + 1);
+				_Ty partial_result = data_ptr[first];
+				for (auto i = first + 1; last > i; i += 1) {
+					partial_result = op(partial_result, data_ptr[i]);
+				}
+				partial_results[chunk_index] = std::move(partial_result);
+			});
+			for (auto& partial_result : partial_results) {
+				init = op(init, partial_result);
+			}
+			return init;
+		}
+		template<typename _TRange, typename _Ty>
+		_Ty reduce(const _TRange& range, _Ty init) {
+			return mse::par::reduce(range, init, std::plus<_Ty>());
+		}
+
+		/* Sorts the elements of the range. Like std::sort(), the sort is not stable. */
+		template<typename _TRange, typename _TCompare>
+		void sort(_TRange&& range, _TCompare comp) {
+			typedef typename std::remove_const<impl::par::range_element_t<_TRange>>::type element_t;
+			const auto elements = impl::par::contiguous_elements(range);
+			if (nullptr == elements.m_data_ptr) {
+				/* The elements aren't contiguous, so they're sorted in a temporary buffer. */
+				std::vector<element_t> buffer;
+				buffer.reserve(elements.m_count);
+				for (size_t i = 0; elements.m_count > i; i += 1) {
+					buffer.push_back(std::move(range[i]));
+				}
+				std::sort(buffer.begin(), buffer.end(), comp);
+				for (size_t i = 0; elements.m_count > i; i += 1) {
+					range[i] = std::move(buffer[i]);
+				}
+				return;
+			}
+			const auto data_ptr = elements.m_data_ptr;
+			const auto count = elements.m_count;
+			const auto num_chunks = impl::par::num_chunks_for(count);
+			/* The chunks are sorted concurrently, then (adjacent pairs of) sorted runs are merged concurrently, halving
+			the number of runs each round. */
+			impl::par::run_tasks(num_chunks, [data_ptr, count, num_chunks, &comp](size_t chunk_index) {
+				std::sort(data_ptr + impl::par::chunk_boundary(count, num_chunks, chunk_index)
+					, data_ptr + impl::par::chunk_boundary(count, num_chunks, chunk_index + 1), comp);
+			});
+			for (size_t run_width = 1; num_chunks > run_width; run_width *= 2) {
+				const size_t num_merges = (num_chunks + (2 * run_width) - 1) / (2 * run_width);
+				impl::par::run_tasks(num_merges, [data_ptr, count, num_chunks, run_width, &comp](size_t merge_index) {
+					const auto first_chunk = merge_index * 2 * run_width;
+					const auto middle_chunk = std::min(num_chunks, first_chunk + run_width);
+					const auto last_chunk = std::min(num_chunks, first_chunk + 2 * run_width);
+					if (middle_chunk < last_chunk) {
+						std::inplace_merge(data_ptr + impl::par::chunk_boundary(count, num_chunks, first_chunk)
+							, data_ptr + impl::par::chunk_boundary(count, num_chunks, middle_chunk)
+							, data_ptr + impl::par::chunk_boundary(count, num_chunks, last_chunk), comp);
+					}
+				});
+			}
+		}
+		template<typename _TRange>
+		void sort(_TRange&& range) {
+			typedef typename std::remove_const<impl::par::range_element_t<_TRange>>::type element_t;
+			mse::par::sort(std::forward<_TRange>(range), std::less<element_t>());
+		}
+	}
+}
+
+#undef MSE_THROW
+
+#endif // MSEPARALLEL_H_
@@ -79,6 +79,10 @@ namespace mse {
 	using TSaferPtrForLegacy = _Ty*;
 #else /*MSE_SAFERPTR_DISABLED*/
 
+	/* CSaferPtrBase is the interface through which trackers (like those of the registered pointers) null the pointers
+	targeting an object when that object is destroyed. Only pointers that register with a tracker derive from it, so
+	TSaferPtr and TSaferPtrForLegacy themselves remain non-polymorphic, trivially copyable, single word (when
+	MSE_TSAFERPTR_CHECK_USE_BEFORE_SET isn't defined) types that can be passed in registers. */
 	class CSaferPtrBase {
 	public:
 		/* setToNull() needs to be available even when the smart pointer is const, because the object it points to may become
@@ -95,16 +99,13 @@ namespace mse {
 	/* TSaferPtr behaves similar to, and is largely compatible with, native pointers. It's a bit safer in that it initializes to
 	nullptr by default and checks for attempted dereference of null pointers. */
 	template<typename _Ty>
-	class TSaferPtr : public CSaferPtrBase {
+	class TSaferPtr {
 	public:
 		TSaferPtr() : m_ptr(nullptr) {}
 		TSaferPtr(_Ty* ptr) : m_ptr(ptr) { note_value_assignment(); }
-		TSaferPtr(const TSaferPtr<_Ty>& src) : m_ptr(src.m_ptr) { note_value_assignment(); }
+		TSaferPtr(const TSaferPtr<_Ty>& src) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TSaferPtr(const TSaferPtr<_Ty2>& src_cref) : m_ptr(src_cref.m_ptr) { note_value_assignment(); }
-		virtual ~TSaferPtr() {}
-
-		virtual void setToNull() const { m_ptr = nullptr; }
 
 		void raw_pointer(_Ty* ptr) { note_value_assignment(); m_ptr = ptr; }
 		_Ty* raw_pointer() const { return m_ptr; }
@@ -132,11 +133,7 @@ namespace mse {
 			m_ptr = ptr;
 			return (*this);
 		}
-		TSaferPtr<_Ty>& operator=(const TSaferPtr<_Ty>& _Right_cref) {
-			note_value_assignment();
-			m_ptr = _Right_cref.m_ptr;
-			return (*this);
-		}
+		TSaferPtr<_Ty>& operator=(const TSaferPtr<_Ty>& _Right_cref) = default;
 		bool operator==(const _Ty* _Right_cref) const { assert_initialized(); return (_Right_cref == m_ptr); }
 		bool operator!=(const _Ty* _Right_cref) const { assert_initialized(); return (!((*this) == _Right_cref)); }
 		bool operator==(const TSaferPtr<_Ty> &_Right_cref) const { assert_initialized(); return (_Right_cref == m_ptr); }
@@ -174,15 +171,12 @@ namespace mse {
 	native pointers with safer pointers in legacy code, fewer code changes (explicit casts) may be required when using this
 	template. */
 	template<typename _Ty>
-	class TSaferPtrForLegacy : public CSaferPtrBase {
+	class TSaferPtrForLegacy {
 	public:
 		TSaferPtrForLegacy() : m_ptr(nullptr) {}
 		TSaferPtrForLegacy(_Ty* ptr) : m_ptr(ptr) { note_value_assignment(); }
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TSaferPtrForLegacy(const TSaferPtrForLegacy<_Ty2>& src_cref) : m_ptr(src_cref.m_ptr) { note_value_assignment(); }
-		virtual ~TSaferPtrForLegacy() {}
-
-		virtual void setToNull() const { m_ptr = nullptr; }
 
 		void raw_pointer(_Ty* ptr) { note_value_assignment(); m_ptr = ptr; }
 		_Ty* raw_pointer() const { return m_ptr; }
@@ -238,16 +232,17 @@ namespace mse {
 	template<typename _Ty>
 	class TPointerID {};
 
-	/* TPointer is just a wrapper for native pointers that can act as a base class. */
+	/* TPointer is just a wrapper for native pointers that can act as a base class. Like TPointerForLegacy, it is not
+	polymorphic and is trivially copyable, so (absent the debug mode "use before set" flag) it's the size of a native
+	pointer and is passed the same way. (Derived classes are not intended to be deleted through a TPointer*.) */
 	template<typename _Ty, typename _TID = TPointerID<_Ty>>
 	class TPointer {
 	public:
 		TPointer() : m_ptr(nullptr) {}
 		TPointer(_Ty* ptr) : m_ptr(ptr) { note_value_assignment(); }
-		TPointer(const TPointer<_Ty, _TID>& src) : m_ptr(src.m_ptr) { note_value_assignment(); }
+		TPointer(const TPointer<_Ty, _TID>& src) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value || std::is_same<const _Ty2, _Ty>::value, void>::type>
 		TPointer(const TPointer<_Ty2, _TID>& src_cref) : m_ptr(src_cref.m_ptr) { note_value_assignment(); }
-		virtual ~TPointer() {}
 
 		void raw_pointer(_Ty* ptr) { note_value_assignment(); m_ptr = ptr; }
 		_Ty* raw_pointer() const { return m_ptr; }
@@ -275,11 +270,7 @@ namespace mse {
 			m_ptr = ptr;
 			return (*this);
 		}
-		TPointer<_Ty, _TID>& operator=(const TPointer<_Ty, _TID>& _Right_cref) {
-			note_value_assignment();
-			m_ptr = _Right_cref.m_ptr;
-			return (*this);
-		}
+		TPointer<_Ty, _TID>& operator=(const TPointer<_Ty, _TID>& _Right_cref) = default;
 		bool operator==(const _Ty* _Right_cref) const { assert_initialized(); return (_Right_cref == m_ptr); }
 		bool operator!=(const _Ty* _Right_cref) const { assert_initialized(); return (!((*this) == _Right_cref)); }
 		bool operator==(const TPointer<_Ty, _TID> &_Right_cref) const { assert_initialized(); return (_Right_cref == m_ptr); }
@@ -318,7 +309,6 @@ namespace mse {
 		TPointerForLegacy(_Ty* ptr) : m_ptr(ptr) { note_value_assignment(); }
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value || std::is_same<const _Ty2, _Ty>::value, void>::type>
 		TPointerForLegacy(const TPointerForLegacy<_Ty2, _TID>& src_cref) : m_ptr(src_cref.m_ptr) { note_value_assignment(); }
-		virtual ~TPointerForLegacy() {}
 
 		void raw_pointer(_Ty* ptr) { note_value_assignment(); m_ptr = ptr; }
 		_Ty* raw_pointer() const { return m_ptr; }
@@ -69,42 +69,68 @@ namespace mse {
 			static_max<arg2, others...>::value;
 	};
 
+	/* The types held by a tdp_variant are identified by their (compile-time) index in the variant's list of types, and
+	the operations on the held object are dispatched through (static) tables of function pointers indexed by the type
+	index. So each operation costs a single (indirect) call, rather than a (run-time) comparison against each of the
+	candidate types in turn. */
+	template<typename T, typename... Ts>
+	struct tdp_variant_type_index;
+
+	/* When T is not one of the candidate types, its index is the number of candidate types (i.e. the "invalid" index). */
+	template<typename T>
+	struct tdp_variant_type_index<T> : std::integral_constant<size_t, 0> {};
+
+	template<typename T, typename... Ts>
+	struct tdp_variant_type_index<T, T, Ts...> : std::integral_constant<size_t, 0> {};
+
+	template<typename T, typename F, typename... Ts>
+	struct tdp_variant_type_index<T, F, Ts...> : std::integral_constant<size_t, 1 + tdp_variant_type_index<T, Ts...>::value> {};
+
+	template<typename F>
+	struct tdp_variant_type_ops {
+		static void destroy(void * data) {
+			reinterpret_cast<F*>(data)->~F();
+		}
+		static void move(void * old_v, void * new_v) {
+			::new (new_v) F(std::move(*reinterpret_cast<F*>(old_v)));
+		}
+		static void copy(const void * old_v, void * new_v) {
+			::new (new_v) F(*reinterpret_cast<const F*>(old_v));
+		}
+	};
+
+	/* The operations for the "invalid" index (i.e. for an empty variant). */
+	struct tdp_variant_no_type_ops {
+		static void destroy(void *) { }
+		static void move(void *, void *) { }
+		static void copy(const void *, void *) { }
+	};
+
 	template<typename... Ts>
-	struct tdp_variant_helper;
+	struct tdp_variant_helper {
+		typedef void(*destroy_fn_t)(void *);
+		typedef void(*move_fn_t)(void *, void *);
+		typedef void(*copy_fn_t)(const void *, void *);
 
-	template<typename F, typename... Ts>
-	struct tdp_variant_helper<F, Ts...> {
 		inline static void destroy(size_t id, void * data)
 		{
-			if (id == typeid(F).hash_code())
-				reinterpret_cast<F*>(data)->~F();
-			else
-				tdp_variant_helper<Ts...>::destroy(id, data);
+			static const destroy_fn_t sc_fn_table[] = { &tdp_variant_type_ops<Ts>::destroy..., &tdp_variant_no_type_ops::destroy };
+			sc_fn_table[id](data);
 		}
 
 		inline static void move(size_t old_t, void * old_v, void * new_v)
 		{
-			if (old_t == typeid(F).hash_code())
-				::new (new_v) F(std::move(*reinterpret_cast<F*>(old_v)));
-			else
-				tdp_variant_helper<Ts...>::move(old_t, old_v, new_v);
+			static const move_fn_t sc_fn_table[] = { &tdp_variant_type_ops<Ts>::move..., &tdp_variant_no_type_ops::move };
+			sc_fn_table[old_t](old_v, new_v);
 		}
 
 		inline static void copy(size_t old_t, const void * old_v, void * new_v)
 		{
-			if (old_t == typeid(F).hash_code())
-				::new (new_v) F(*reinterpret_cast<const F*>(old_v));
-			else
-				tdp_variant_helper<Ts...>::copy(old_t, old_v, new_v);
+			static const copy_fn_t sc_fn_table[] = { &tdp_variant_type_ops<Ts>::copy..., &tdp_variant_no_type_ops::copy };
+			sc_fn_table[old_t](old_v, new_v);
 		}
 	};
 
-	template<> struct tdp_variant_helper<> {
-		inline static void destroy(size_t id, void * data) { }
-		inline static void move(size_t old_t, void * old_v, void * new_v) { }
-		inline static void copy(size_t old_t, const void * old_v, void * new_v) { }
-	};
-
 	template<typename... Ts>
 	struct tdp_variant {
 	protected:
@@ -116,7 +142,11 @@ namespace mse {
 		using helper_t = tdp_variant_helper<Ts...>;
 
 		static inline size_t invalid_type() {
-			return typeid(void).hash_code();
+			return sizeof...(Ts);
+		}
+		template<typename T>
+		static inline size_t type_index() {
+			return tdp_variant_type_index<T, Ts...>::value;
 		}
 
 		size_t type_id;
@@ -160,7 +190,7 @@ namespace mse {
 
 		template<typename T>
 		bool is() const {
-			return (type_id == typeid(T).hash_code());
+			return ((invalid_type() != type_index<T>()) && (type_id == type_index<T>()));
 		}
 
 		bool valid() const {
@@ -170,19 +200,20 @@ namespace mse {
 		template<typename T, typename... Args>
 		void set(Args&&... args)
 		{
+			static_assert(tdp_variant_type_index<T, Ts...>::value < sizeof...(Ts), "T is not one of the variant's types");
 			// First we destroy the current contents    
 			auto held_type_id = type_id;
 			type_id = invalid_type();
 			helper_t::destroy(held_type_id, &data);
 			::new (&data) T(std::forward<Args>(args)...);
-			type_id = typeid(T).hash_code();
+			type_id = type_index<T>();
 		}
 
 		template<typename T>
 		const T& get() const
 		{
 			// It is a dynamic_cast-like behaviour
-			if (type_id == typeid(T).hash_code())
+			if (is<T>())
 				return *reinterpret_cast<const T*>(&data);
 			else
 				MSE_THROW(std::bad_cast());
@@ -192,7 +223,7 @@ namespace mse {
 		T& get()
 		{
 			// It is a dynamic_cast-like behaviour
-			if (type_id == typeid(T).hash_code())
+			if (is<T>())
 				return *reinterpret_cast<T*>(&data);
 			else
 				MSE_THROW(std::bad_cast());
@@ -205,35 +236,37 @@ namespace mse {
 		}
 	};
 
+	template<typename F>
+	struct tdp_pointer_variant_type_ops {
+		static void* arrow_operator(const void * data) {
+			return (reinterpret_cast<const F*>(data))->operator->();
+		}
+		static const void* const_arrow_operator(const void * data) {
+			return (reinterpret_cast<const F*>(data))->operator->();
+		}
+	};
+
+	struct tdp_pointer_variant_no_type_ops {
+		static void* arrow_operator(const void *) { return nullptr; }
+		static const void* const_arrow_operator(const void *) { return nullptr; }
+	};
+
 	template<typename... Ts>
-	struct tdp_pointer_variant_helper;
+	struct tdp_pointer_variant_helper {
+		typedef void*(*arrow_operator_fn_t)(const void *);
+		typedef const void*(*const_arrow_operator_fn_t)(const void *);
 
-	template<typename F, typename... Ts>
-	struct tdp_pointer_variant_helper<F, Ts...> {
 		inline static void* arrow_operator(size_t id, const void * data) {
-			if (id == typeid(F).hash_code()) {
-				return (reinterpret_cast<const F*>(data))->operator->();
-			}
-			else {
-				return tdp_pointer_variant_helper<Ts...>::arrow_operator(id, data);
-			}
+			static const arrow_operator_fn_t sc_fn_table[] = { &tdp_pointer_variant_type_ops<Ts>::arrow_operator..., &tdp_pointer_variant_no_type_ops::arrow_operator };
+			return sc_fn_table[id](data);
 		}
 
 		inline static const void* const_arrow_operator(size_t id, const void * data) {
-			if (id == typeid(F).hash_code()) {
-				return (reinterpret_cast<const F*>(data))->operator->();
-			}
-			else {
-				return tdp_pointer_variant_helper<Ts...>::const_arrow_operator(id, data);
-			}
+			static const const_arrow_operator_fn_t sc_fn_table[] = { &tdp_pointer_variant_type_ops<Ts>::const_arrow_operator..., &tdp_pointer_variant_no_type_ops::const_arrow_operator };
+			return sc_fn_table[id](data);
 		}
 	};
 
-	template<> struct tdp_pointer_variant_helper<> {
-		inline static void* arrow_operator(size_t id, const void * data) { return nullptr; }
-		inline static const void* const_arrow_operator(size_t id, const void * data) { return nullptr; }
-	};
-
 	template<typename... Ts>
 	struct tdp_pointer_variant : public tdp_variant<Ts...> {
 	protected:
@@ -249,6 +282,53 @@ namespace mse {
 		}
 	};
 
+	namespace impl {
+		class CAnyPointerSizingPlaceholder {};
+		/* Has the same layout as the (polymorphic) wrappers that the "any" pointer and iterator types store. */
+		template <typename _TPointer1>
+		class TPolymorphicWrapperSizingProxy {
+		public:
+			virtual ~TPolymorphicWrapperSizingProxy() {}
+			_TPointer1 m_pointer;
+		};
+		template <typename _TPointer1>
+		using TWrappedSize = std::integral_constant<size_t, sizeof(TPolymorphicWrapperSizingProxy<_TPointer1>)>;
+		typedef CAnyPointerSizingPlaceholder placeholder_t;
+
+		/* The amount of inline storage used by the "any" pointer and iterator types. It's chosen to accommodate (the wrapper
+		of) each of the pointer types supported by TXScopePolyPointer<> and each of the library's safe iterator types, so
+		that constructing or copying an "any" pointer or iterator doesn't allocate. */
+		static const size_t sc_any_pointer_inline_storage_size = static_max<
+#if !defined(MSE_SCOPEPOINTER_DISABLED)
+			TWrappedSize<mse::TXScopeFixedPointer<placeholder_t> >::value,
+#endif // !defined(MSE_SCOPEPOINTER_DISABLED)
+#if !defined(MSE_REGISTEREDPOINTER_DISABLED)
+			TWrappedSize<mse::TRegisteredPointer<placeholder_t> >::value,
+			TWrappedSize<mse::TRelaxedRegisteredPointer<placeholder_t> >::value,
+#endif // !defined(MSE_REGISTEREDPOINTER_DISABLED)
+#if !defined(MSE_REFCOUNTINGPOINTER_DISABLED)
+			TWrappedSize<mse::TRefCountingPointer<placeholder_t> >::value,
+#endif // !defined(MSE_REFCOUNTINGPOINTER_DISABLED)
+#if !defined(MSE_MSTDVECTOR_DISABLED)
+			TWrappedSize<typename mse::mstd::vector<placeholder_t>::iterator>::value,
+#endif // !defined(MSE_MSTDVECTOR_DISABLED)
+#if !defined(MSE_MSTDARRAY_DISABLED)
+			TWrappedSize<typename mse::mstd::array<placeholder_t, 1>::iterator>::value,
+#endif // !defined(MSE_MSTDARRAY_DISABLED)
+			TWrappedSize<typename mse::msevector<placeholder_t>::iterator>::value,
+			TWrappedSize<typename mse::msevector<placeholder_t>::ipointer>::value,
+			TWrappedSize<typename mse::msevector<placeholder_t>::ss_iterator_type>::value,
+			TWrappedSize<typename mse::msearray<placeholder_t, 1>::ss_iterator_type>::value,
+			TWrappedSize<mse::TAsyncSharedReadWritePointer<placeholder_t> >::value,
+			TWrappedSize<mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWritePointer<placeholder_t> >::value,
+			TWrappedSize<std::shared_ptr<placeholder_t> >::value,
+			TWrappedSize<mse::TPointer<placeholder_t> >::value
+		>::value;
+	}
+	/* The type used by the "any" pointer and iterator types to hold the (type-erased) pointer or iterator. Any pointer type
+	that fits is stored inline, even if its move constructor isn't declared noexcept. */
+	typedef mse::basic_any<impl::sc_any_pointer_inline_storage_size, false> CAnyPointerStorage;
+
 	template <typename _Ty>
 	class TAnyPointer;
 	template <typename _Ty>
@@ -326,7 +406,7 @@ namespace mse {
 			return retval;
 		}
 
-		mse::any m_any_pointer;
+		CAnyPointerStorage m_any_pointer;
 	};
 
 	template <typename _Ty>
@@ -425,7 +505,7 @@ namespace mse {
 			return retval;
 		}
 
-		mse::any m_any_const_pointer;
+		CAnyPointerStorage m_any_const_pointer;
 	};
 
 	template <typename _Ty>
@@ -868,7 +948,7 @@ namespace mse {
 		TXScopeAnyRandomAccessIterator(const _TRandomAccessIterator1& random_access_iterator) : m_any_random_access_iterator(TCommonizedRandomAccessIterator<_Ty, _TRandomAccessIterator1>(random_access_iterator)) {}
 
 		friend void swap(TXScopeAnyRandomAccessIterator& first, TXScopeAnyRandomAccessIterator& second) {
-			std::swap(first.m_any_random_access_iterator, second.m_any_random_access_iterator);
+			first.m_any_random_access_iterator.swap(second.m_any_random_access_iterator);
 		}
 
 		_Ty& operator*() const {
@@ -922,7 +1002,7 @@ namespace mse {
 			return retval;
 		}
 
-		mse::any m_any_random_access_iterator;
+		CAnyPointerStorage m_any_random_access_iterator;
 
 		friend class TAnyRandomAccessIterator<_Ty>;
 	};
@@ -990,7 +1070,7 @@ namespace mse {
 		TXScopeAnyRandomAccessConstIterator(const _TRandomAccessConstIterator1& random_access_const_iterator) : m_any_random_access_const_iterator(TCommonizedRandomAccessConstIterator<const _Ty, _TRandomAccessConstIterator1>(random_access_const_iterator)) {}
 
 		friend void swap(TXScopeAnyRandomAccessConstIterator& first, TXScopeAnyRandomAccessConstIterator& second) {
-			std::swap(first.m_any_random_access_const_iterator, second.m_any_random_access_const_iterator);
+			first.m_any_random_access_const_iterator.swap(second.m_any_random_access_const_iterator);
 		}
 
 		const _Ty& operator*() const {
@@ -1044,7 +1124,7 @@ namespace mse {
 			return retval;
 		}
 
-		mse::any m_any_random_access_const_iterator;
+		CAnyPointerStorage m_any_random_access_const_iterator;
 
 		friend class TAnyRandomAccessConstIterator<_Ty>;
 	};
@@ -1113,22 +1193,156 @@ namespace mse {
 	//template<typename _Ty> using TAnyArrayIterator = TAnyRandomAccessIterator<_Ty>;
 	//template<typename _Ty> using TAnyConstArrayIterator = TAnyRandomAccessConstIterator<_Ty>;
 
+	namespace impl {
+		/* These overloads provide direct (native pointer) access to the elements of the supported contiguous containers, along
+		with a "size pin" that prevents the container from being resized (and its elements relocated) while the pin exists. */
+		template<typename _Ty2, class _A> _Ty2* contiguous_data_ptr(mse::msevector<_Ty2, _A>& container_ref) { return container_ref.std::vector<_Ty2, _A>::data(); }
+		template<typename _Ty2, class _A> const _Ty2* contiguous_data_ptr(const mse::msevector<_Ty2, _A>& container_ref) { return container_ref.std::vector<_Ty2, _A>::data(); }
+		template<typename _Ty2, class _A> CSizePin contiguous_size_pin(const mse::msevector<_Ty2, _A>& container_ref) { return container_ref.size_pin(); }
+		template<typename _Ty2, class _A> bool contiguous_size_is_fixed(const mse::msevector<_Ty2, _A>&) { return false; }
+		template<typename _Ty2, size_t _Size> _Ty2* contiguous_data_ptr(mse::msearray<_Ty2, _Size>& container_ref) { return container_ref.data(); }
+		template<typename _Ty2, size_t _Size> const _Ty2* contiguous_data_ptr(const mse::msearray<_Ty2, _Size>& container_ref) { return container_ref.data(); }
+		/* The size of an array can't change anyway. */
+		template<typename _Ty2, size_t _Size> CSizePin contiguous_size_pin(const mse::msearray<_Ty2, _Size>&) { return CSizePin(); }
+		template<typename _Ty2, size_t _Size> bool contiguous_size_is_fixed(const mse::msearray<_Ty2, _Size>&) { return true; }
+#ifndef MSE_MSTDVECTOR_DISABLED
+		template<typename _Ty2, class _A> _Ty2* contiguous_data_ptr(mse::mstd::vector<_Ty2, _A>& container_ref) { return contiguous_data_ptr(container_ref.msevector()); }
+		template<typename _Ty2, class _A> const _Ty2* contiguous_data_ptr(const mse::mstd::vector<_Ty2, _A>& container_ref) { return contiguous_data_ptr(container_ref.msevector()); }
+		template<typename _Ty2, class _A> CSizePin contiguous_size_pin(const mse::mstd::vector<_Ty2, _A>& container_ref) { return container_ref.msevector().size_pin(); }
+		template<typename _Ty2, class _A> bool contiguous_size_is_fixed(const mse::mstd::vector<_Ty2, _A>&) { return false; }
+#else // !MSE_MSTDVECTOR_DISABLED
+		/* std::vector has no way to pin its size, so in this case the validity of any (native) pointers obtained is the user's responsibility. */
+		template<typename _Ty2, class _A> _Ty2* contiguous_data_ptr(std::vector<_Ty2, _A>& container_ref) { return container_ref.data(); }
+		template<typename _Ty2, class _A> const _Ty2* contiguous_data_ptr(const std::vector<_Ty2, _A>& container_ref) { return container_ref.data(); }
+		template<typename _Ty2, class _A> CSizePin contiguous_size_pin(const std::vector<_Ty2, _A>&) { return CSizePin(); }
+		template<typename _Ty2, class _A> bool contiguous_size_is_fixed(const std::vector<_Ty2, _A>&) { return false; }
+#endif // !MSE_MSTDVECTOR_DISABLED
+#ifndef MSE_MSTDARRAY_DISABLED
+		template<typename _Ty2, size_t _Size> _Ty2* contiguous_data_ptr(mse::mstd::array<_Ty2, _Size>& container_ref) { return contiguous_data_ptr(container_ref.msearray()); }
+		template<typename _Ty2, size_t _Size> const _Ty2* contiguous_data_ptr(const mse::mstd::array<_Ty2, _Size>& container_ref) { return contiguous_data_ptr(container_ref.msearray()); }
+		template<typename _Ty2, size_t _Size> CSizePin contiguous_size_pin(const mse::mstd::array<_Ty2, _Size>&) { return CSizePin(); }
+		template<typename _Ty2, size_t _Size> bool contiguous_size_is_fixed(const mse::mstd::array<_Ty2, _Size>&) { return true; }
+#else // !MSE_MSTDARRAY_DISABLED
+		template<typename _Ty2, size_t _Size> _Ty2* contiguous_data_ptr(std::array<_Ty2, _Size>& container_ref) { return container_ref.data(); }
+		template<typename _Ty2, size_t _Size> const _Ty2* contiguous_data_ptr(const std::array<_Ty2, _Size>& container_ref) { return container_ref.data(); }
+		template<typename _Ty2, size_t _Size> CSizePin contiguous_size_pin(const std::array<_Ty2, _Size>&) { return CSizePin(); }
+		template<typename _Ty2, size_t _Size> bool contiguous_size_is_fixed(const std::array<_Ty2, _Size>&) { return true; }
+#endif // !MSE_MSTDARRAY_DISABLED
+
+		/* A native pointer to the first element of a contiguous range, along with a size pin on the range's container. A null
+		m_data_ptr indicates that no such range was available. */
+		template<typename _Ty>
+		class TContiguousRange {
+		public:
+			TContiguousRange() {}
+			TContiguousRange(_Ty* data_ptr, const CSizePin& size_pin) : m_data_ptr(data_ptr), m_size_pin(size_pin) {}
+			TContiguousRange(const TContiguousRange& src) = default;
+
+			_Ty* const m_data_ptr = nullptr;
+			const CSizePin m_size_pin;
+		};
+
+		/* Determines whether the given (safe) iterator type can provide the container that it refers to, and whether that
+		container is one whose elements (of type _Ty) we can access directly. */
+		template<typename _Ty, typename _TRAIterator>
+		struct IsContiguousContainerIterator {
+			template<typename U, typename _Tptr = decltype(contiguous_data_ptr(*std::declval<const U&>().target_container_ptr())),
+				typename _Tposition = decltype(std::declval<const U&>().position())>
+			static std::integral_constant<bool, std::is_same<typename std::remove_const<typename std::remove_pointer<_Tptr>::type>::type
+				, typename std::remove_const<_Ty>::type>::value && std::is_convertible<_Tptr, _Ty*>::value> Test(int);
+			template<typename U> static std::false_type Test(...);
+			static const bool value = decltype(Test<_TRAIterator>(0))::value;
+		};
+
+		template<typename T>
+		struct HasTargetContainerRetainedTagMethod
+		{
+			template<typename U, void(U::*)() const> struct SFINAE {};
+			template<typename U> static char Test(SFINAE<U, &U::target_container_retained_tag>*);
+			template<typename U> static int Test(...);
+			static const bool Has = (sizeof(Test<T>(0)) == sizeof(char));
+		};
+		/* A fixed (or pinned) size doesn't mean that the container will outlive the section (or span) holding a native pointer
+		to its elements. So elements are only accessed directly via iterators that guarantee the lifetime of their target
+		container, i.e. scope iterators (whose containers outlive them by construction), and iterators that hold a strong
+		reference to their container (like mstd::vector's). Other (checked) iterators, such as mstd::array's, which verify
+		that their container still exists on each access, are used as is. */
+		template<typename _TRAIterator>
+		struct IteratorGuaranteesTargetLifetime : std::integral_constant<bool, HasXScopeIteratorTagMethod<_TRAIterator>::Has
+			|| HasXScopeSSIteratorTypeTagMethod<_TRAIterator>::Has || HasTargetContainerRetainedTagMethod<_TRAIterator>::Has> {};
+
+		template<typename _Ty, typename _TRAIterator>
+		TContiguousRange<_Ty> make_contiguous_range_helper(std::true_type, const _TRAIterator& ra_iter, std::size_t count, bool pin_size) {
+			auto container_ptr = ra_iter.target_container_ptr();
+			if ((nullptr != container_ptr) && (pin_size || contiguous_size_is_fixed(*container_ptr))) {
+				const auto position = std::size_t(ra_iter.position());
+				const auto container_size = std::size_t(container_ptr->size());
+				if ((container_size >= position) && (container_size - position >= count)) {
+					return TContiguousRange<_Ty>(contiguous_data_ptr(*container_ptr) + position, contiguous_size_pin(*container_ptr));
+				}
+			}
+			return TContiguousRange<_Ty>();
+		}
+		template<typename _Ty, typename _TRAIterator>
+		TContiguousRange<_Ty> make_contiguous_range_helper(std::false_type, const _TRAIterator&, std::size_t, bool) {
+			return TContiguousRange<_Ty>();
+		}
+		/* Returns the range of count elements starting at the one the given iterator refers to, if the iterator refers to one of
+		the supported contiguous containers and the range is valid. Otherwise returns an empty TContiguousRange<> and the caller
+		should fall back to using the iterator itself. The iterator must guarantee the lifetime of its container (see
+		IteratorGuaranteesTargetLifetime<>). A container whose size can change (i.e. a vector) is only accessed directly (and
+		its size pinned) if pin_size is true. */
+		template<typename _Ty, typename _TRAIterator>
+		TContiguousRange<_Ty> make_contiguous_range(const _TRAIterator& ra_iter, std::size_t count, bool pin_size) {
+			return make_contiguous_range_helper<_Ty>(std::integral_constant<bool, IsContiguousContainerIterator<_Ty, _TRAIterator>::value
+				&& IteratorGuaranteesTargetLifetime<_TRAIterator>::value>(), ra_iter, count, pin_size);
+		}
+		/* Native pointers (which include the iterators of some implementations of std::array) aren't bounds checked anyway. */
+		template<typename _Ty>
+		TContiguousRange<_Ty> make_contiguous_range_from_native_pointer(std::true_type, _Ty* ptr) {
+			return TContiguousRange<_Ty>(ptr, CSizePin());
+		}
+		template<typename _Ty, typename _Ty2>
+		TContiguousRange<_Ty> make_contiguous_range_from_native_pointer(std::false_type, _Ty2*) {
+			return TContiguousRange<_Ty>();
+		}
+		template<typename _Ty, typename _Ty2>
+		TContiguousRange<_Ty> make_contiguous_range(_Ty2* const& ptr, std::size_t, bool) {
+			return make_contiguous_range_from_native_pointer<_Ty>(std::integral_constant<bool, std::is_same<typename std::remove_const<_Ty2>::type
+				, typename std::remove_const<_Ty>::type>::value && std::is_convertible<_Ty2*, _Ty*>::value>(), ptr);
+		}
+	}
+
+	/* Passing pin_container_size as the first argument of a scope section's constructor requests that, if the section's
+	elements are those of a vector, the vector's size be pinned (i.e. the vector can't be resized) for as long as the
+	section (or any of its iterators) exists, so that the section can access the elements directly. */
+	struct pin_container_size_t {};
+	MSE_CONSTEXPR static const pin_container_size_t pin_container_size{};
+
 	template <typename _TRAIterator>
 	class TRASectionIterator {
 	public:
 		typedef typename mse::mstd::array<int, 0>::difference_type difference_t;
 		typedef typename mse::mstd::array<int, 0>::size_type size_type;
 
+		typedef typename std::remove_reference<decltype(*std::declval<const _TRAIterator&>())>::type* contiguous_pointer_t;
+
 	private:
 		const _TRAIterator m_ra_iterator;
 		const size_type m_count = 0;
 		difference_t m_index = 0;
+		/* If the section refers to a contiguous range, this points to its first element, and element access bypasses
+		m_ra_iterator (and its indirect calls). The size pin ensures the range isn't relocated while this iterator exists. */
+		const contiguous_pointer_t m_contiguous_data_ptr = nullptr;
+		const CSizePin m_size_pin;
 
 	public:
 		TRASectionIterator(_TRAIterator ra_iterator, size_type count, size_type index = 0)
 			: m_ra_iterator(ra_iterator), m_count(count), m_index(difference_t(index)) {}
+		TRASectionIterator(_TRAIterator ra_iterator, size_type count, size_type index, contiguous_pointer_t contiguous_data_ptr, const CSizePin& size_pin)
+			: m_ra_iterator(ra_iterator), m_count(count), m_index(difference_t(index)), m_contiguous_data_ptr(contiguous_data_ptr), m_size_pin(size_pin) {}
 		TRASectionIterator(const TRASectionIterator& src)
-			: m_ra_iterator(src.m_ra_iterator), m_count(src.m_count), m_index(src.m_index) {}
+			: m_ra_iterator(src.m_ra_iterator), m_count(src.m_count), m_index(src.m_index), m_contiguous_data_ptr(src.m_contiguous_data_ptr), m_size_pin(src.m_size_pin) {}
 
 		void dereference_bounds_check() const {
 			if ((0 > m_index) || (difference_t(m_count) <= m_index)) {
@@ -1137,12 +1351,18 @@ namespace mse {
 		}
 		auto operator*() -> decltype((m_ra_iterator).operator*()) const {
 			dereference_bounds_check();
+			if (m_contiguous_data_ptr) {
+				return m_contiguous_data_ptr[m_index];
+			}
 			auto tmp_ra_iterator(m_ra_iterator);
 			tmp_ra_iterator += m_index;
 			return (tmp_ra_iterator).operator*();
 		}
 		auto operator->() -> decltype((m_ra_iterator).operator->()) const {
 			dereference_bounds_check();
+			if (m_contiguous_data_ptr) {
+				return m_contiguous_data_ptr + m_index;
+			}
 			auto tmp_ra_iterator(m_ra_iterator);
 			tmp_ra_iterator += m_index;
 			return (tmp_ra_iterator).operator->();
@@ -1193,28 +1413,53 @@ namespace mse {
 		typedef typename TXScopeAnyRandomAccessIterator<_Ty>::difference_t difference_t;
 
 		TXScopeRandomAccessSection(const TXScopeAnyRandomAccessIterator<_Ty>& start_iter, size_type count) : m_start_iter(start_iter), m_count(count) {}
+		/* If start_iter is a scope iterator of an mstd::array (or is a native pointer), and the section lies within the
+		container, the section will access the elements directly, rather than through the type-erased iterator. Elements of
+		an mstd::vector are accessed directly only if pin_container_size is passed (see the next constructor), because then
+		the vector can't be resized while the section exists. Other iterators (whose containers might not outlive the
+		section) are always used as is (see impl::IteratorGuaranteesTargetLifetime<>). */
+		template <typename _TRAIterator, class = typename std::enable_if<(!std::is_base_of<TXScopeAnyRandomAccessIterator<_Ty>, _TRAIterator>::value)
+			&& (!std::is_array<_TRAIterator>::value), void>::type>
+		TXScopeRandomAccessSection(const _TRAIterator& start_iter, size_type count)
+			: m_start_iter(start_iter), m_count(count), m_contiguous_range(impl::make_contiguous_range<_Ty>(start_iter, std::size_t(count), false)) {}
+		/* Like the constructor above, but if start_iter refers to an element of a vector, the vector's size is pinned for as
+		long as the section (or any of its iterators) exists, so resizing it throws msevector_size_pinned_error. */
+		template <typename _TRAIterator, class = typename std::enable_if<(!std::is_base_of<TXScopeAnyRandomAccessIterator<_Ty>, _TRAIterator>::value)
+			&& (!std::is_array<_TRAIterator>::value), void>::type>
+		TXScopeRandomAccessSection(pin_container_size_t, const _TRAIterator& start_iter, size_type count)
+			: m_start_iter(start_iter), m_count(count), m_contiguous_range(impl::make_contiguous_range<_Ty>(start_iter, std::size_t(count), true)) {}
+		template <size_t _Size>
+		TXScopeRandomAccessSection(_Ty (&native_array)[_Size], size_type count) : TXScopeRandomAccessSection(static_cast<_Ty*>(native_array), count) {
+			if (_Size < count) { MSE_THROW(msearray_range_error("out of bounds range - TXScopeRandomAccessSection(_Ty (&native_array)[_Size], size_type count) - TXScopeRandomAccessSection")); }
+		}
 		TXScopeRandomAccessSection(const TXScopeRandomAccessSection& src) = default;
 		TXScopeRandomAccessSection(const TRandomAccessSection<_Ty>& src) : m_start_iter(src.m_start_iter), m_count(src.size()) {}
 
 		reference_t operator[](size_type _P) const {
 			if (m_count <= _P) { MSE_THROW(msearray_range_error("out of bounds index - reference_t operator[](size_type _P) - TXScopeRandomAccessSection")); }
+			if (m_contiguous_range.m_data_ptr) {
+				return m_contiguous_range.m_data_ptr[_P];
+			}
 			return m_start_iter[difference_t(_P)];
 		}
 		size_type size() const {
 			return m_count;
 		}
+		/* Returns a native pointer to the first element if the section accesses its elements directly (see above), otherwise
+		null. The pointer is only valid while the section exists. */
+		_Ty* contiguous_data_ptr() const { return m_contiguous_range.m_data_ptr; }
 
 		typedef TRASectionIterator<TXScopeAnyRandomAccessIterator<_Ty>> iterator;
 		typedef TRASectionIterator<TXScopeAnyRandomAccessConstIterator<_Ty>> const_iterator;
-		iterator begin() const { return iterator(m_start_iter, m_count); }
-		const_iterator cbegin() const { return const_iterator(m_start_iter, m_count); }
+		iterator begin() const { return iterator(m_start_iter, m_count, 0, m_contiguous_range.m_data_ptr, m_contiguous_range.m_size_pin); }
+		const_iterator cbegin() const { return const_iterator(m_start_iter, m_count, 0, m_contiguous_range.m_data_ptr, m_contiguous_range.m_size_pin); }
 		iterator end() const {
-			auto retval(iterator(m_start_iter, m_count));
+			auto retval(begin());
 			retval += (*this).m_count;
 			return retval;
 		}
 		const_iterator cend() const {
-			auto retval(const_iterator(m_start_iter, m_count));
+			auto retval(cbegin());
 			retval += (*this).m_count;
 			return retval;
 		}
@@ -1228,6 +1473,7 @@ namespace mse {
 
 		TXScopeAnyRandomAccessIterator<_Ty> m_start_iter;
 		const size_type m_count = 0;
+		const impl::TContiguousRange<_Ty> m_contiguous_range;
 
 		friend class TXScopeRandomAccessConstSection<_Ty>;
 	};
@@ -1240,30 +1486,49 @@ namespace mse {
 		typedef typename TXScopeAnyRandomAccessConstIterator<_Ty>::difference_t difference_t;
 
 		TXScopeRandomAccessConstSection(const TXScopeAnyRandomAccessConstIterator<_Ty>& start_const_iter, size_type count) : m_start_const_iter(start_const_iter), m_count(count) {}
+		/* See the corresponding TXScopeRandomAccessSection constructors. */
+		template <typename _TRAConstIterator, class = typename std::enable_if<(!std::is_base_of<TXScopeAnyRandomAccessConstIterator<_Ty>, _TRAConstIterator>::value)
+			&& (!std::is_array<_TRAConstIterator>::value), void>::type>
+		TXScopeRandomAccessConstSection(const _TRAConstIterator& start_const_iter, size_type count)
+			: m_start_const_iter(start_const_iter), m_count(count), m_contiguous_range(impl::make_contiguous_range<const _Ty>(start_const_iter, std::size_t(count), false)) {}
+		template <typename _TRAConstIterator, class = typename std::enable_if<(!std::is_base_of<TXScopeAnyRandomAccessConstIterator<_Ty>, _TRAConstIterator>::value)
+			&& (!std::is_array<_TRAConstIterator>::value), void>::type>
+		TXScopeRandomAccessConstSection(pin_container_size_t, const _TRAConstIterator& start_const_iter, size_type count)
+			: m_start_const_iter(start_const_iter), m_count(count), m_contiguous_range(impl::make_contiguous_range<const _Ty>(start_const_iter, std::size_t(count), true)) {}
+		template <size_t _Size>
+		TXScopeRandomAccessConstSection(const _Ty (&native_array)[_Size], size_type count) : TXScopeRandomAccessConstSection(static_cast<const _Ty*>(native_array), count) {
+			if (_Size < count) { MSE_THROW(msearray_range_error("out of bounds range - TXScopeRandomAccessConstSection(const _Ty (&native_array)[_Size], size_type count) - TXScopeRandomAccessConstSection")); }
+		}
 		TXScopeRandomAccessConstSection(const TXScopeRandomAccessConstSection& src) = default;
-		TXScopeRandomAccessConstSection(const TXScopeRandomAccessSection<_Ty>& src) : m_start_const_iter(src.m_start_iter), m_count(src.size()) {}
+		TXScopeRandomAccessConstSection(const TXScopeRandomAccessSection<_Ty>& src) : m_start_const_iter(src.m_start_iter), m_count(src.size())
+			, m_contiguous_range(src.m_contiguous_range.m_data_ptr, src.m_contiguous_range.m_size_pin) {}
 		TXScopeRandomAccessConstSection(const TRandomAccessSection<_Ty>& src) : m_start_const_iter(src.m_start_iter), m_count(src.size()) {}
 		TXScopeRandomAccessConstSection(const TRandomAccessConstSection<_Ty>& src) : m_start_const_iter(src.m_start_const_iter), m_count(src.size()) {}
 
 		const_reference_t operator[](size_type _P) const {
 			if (m_count <= _P) { MSE_THROW(msearray_range_error("out of bounds index - const_reference_t operator[](size_type _P) - TXScopeRandomAccessConstSection")); }
+			if (m_contiguous_range.m_data_ptr) {
+				return m_contiguous_range.m_data_ptr[_P];
+			}
 			return m_start_const_iter[difference_t(_P)];
 		}
 		size_type size() const {
 			return m_count;
 		}
+		/* See TXScopeRandomAccessSection<>::contiguous_data_ptr(). */
+		const _Ty* contiguous_data_ptr() const { return m_contiguous_range.m_data_ptr; }
 
 		typedef TRASectionIterator<TXScopeAnyRandomAccessConstIterator<_Ty>> iterator;
 		typedef TRASectionIterator<TXScopeAnyRandomAccessConstIterator<_Ty>> const_iterator;
-		iterator begin() const { return iterator(m_start_const_iter, m_count); }
-		const_iterator cbegin() const { return const_iterator(m_start_const_iter, m_count); }
+		iterator begin() const { return iterator(m_start_const_iter, m_count, 0, m_contiguous_range.m_data_ptr, m_contiguous_range.m_size_pin); }
+		const_iterator cbegin() const { return const_iterator(m_start_const_iter, m_count, 0, m_contiguous_range.m_data_ptr, m_contiguous_range.m_size_pin); }
 		iterator end() const {
-			auto retval(iterator(m_start_const_iter, m_count));
+			auto retval(begin());
 			retval += (*this).m_count;
 			return retval;
 		}
 		const_iterator cend() const {
-			auto retval(const_iterator(m_start_const_iter, m_count));
+			auto retval(cbegin());
 			retval += (*this).m_count;
 			return retval;
 		}
@@ -1277,6 +1542,7 @@ namespace mse {
 
 		const TXScopeAnyRandomAccessConstIterator<_Ty> m_start_const_iter;
 		const size_type m_count = 0;
+		const impl::TContiguousRange<const _Ty> m_contiguous_range;
 	};
 
 	//template<typename _Ty> using TArraySection = TXScopeRandomAccessSection<_Ty>;
@@ -1354,6 +1620,106 @@ namespace mse {
 	//template<typename _Ty> using TArraySection = TRandomAccessSection<_Ty>;
 	//template<typename _Ty> using TConstArraySection = TRandomAccessConstSection<_Ty>;
 
+	/* TXScopeCheckedSpan is like TXScopeRandomAccessSection, but refers directly to a contiguous range of elements in an
+	msevector, mstd::vector, msearray or mstd::array. The range is validated once, when the span is constructed, and, while the
+	span (or any copy of it) exists, any attempt to change the size of the (vector) container will throw an exception. So
+	element access through the span doesn't need to be (re)checked. The unchecked accessors (unchecked_at(), data(), begin()
+	and end()) are intended for inner loops, which the compiler is then free to vectorize. Use TXScopeCheckedSpan<const _Ty>
+	for read-only access. Since the span holds a native pointer to the elements, it can only be constructed from a scope
+	pointer (TXScopeFixedPointer or TXScopeFixedConstPointer) to the container. So the container, being a scope object
+	itself, outlives the span. */
+	template <typename _Ty>
+	class TXScopeCheckedSpan {
+	public:
+		typedef _Ty value_type;
+		typedef _Ty& reference_t;
+		typedef std::size_t size_type;
+		typedef std::ptrdiff_t difference_t;
+		typedef _Ty* iterator;
+
+		template<typename _TContainer>
+		TXScopeCheckedSpan(const TXScopeFixedPointer<_TContainer>& container_xscpptr)
+			: TXScopeCheckedSpan(*container_xscpptr, 0, size_type((*container_xscpptr).size())) {}
+		template<typename _TContainer>
+		TXScopeCheckedSpan(const TXScopeFixedPointer<_TContainer>& container_xscpptr, size_type offset, size_type count)
+			: TXScopeCheckedSpan(*container_xscpptr, offset, count) {}
+		template<typename _TContainer>
+		TXScopeCheckedSpan(const TXScopeFixedConstPointer<_TContainer>& container_xscpptr)
+			: TXScopeCheckedSpan(*container_xscpptr, 0, size_type((*container_xscpptr).size())) {}
+		template<typename _TContainer>
+		TXScopeCheckedSpan(const TXScopeFixedConstPointer<_TContainer>& container_xscpptr, size_type offset, size_type count)
+			: TXScopeCheckedSpan(*container_xscpptr, offset, count) {}
+		TXScopeCheckedSpan(const TXScopeCheckedSpan& src) = default;
+		template<typename _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2*, _Ty*>::value, void>::type>
+		TXScopeCheckedSpan(const TXScopeCheckedSpan<_Ty2>& src) : m_data_ptr(src.m_data_ptr), m_count(src.m_count), m_size_pin(src.m_size_pin) {}
+
+		reference_t operator[](size_type _P) const {
+			if (m_count <= _P) { MSE_THROW(msearray_range_error("out of bounds index - reference_t operator[](size_type _P) - TXScopeCheckedSpan")); }
+			return m_data_ptr[_P];
+		}
+		reference_t at(size_type _P) const { return (*this)[_P]; }
+		/* No bounds checking. The caller is responsible for ensuring that _P < size(). */
+		reference_t unchecked_at(size_type _P) const {
+			assert(m_count > _P);
+			return m_data_ptr[_P];
+		}
+		size_type size() const { return m_count; }
+		bool empty() const { return (0 == m_count); }
+
+		/* The returned (native) pointers are only valid while the span exists. */
+		_Ty* data() const { return m_data_ptr; }
+		iterator begin() const { return m_data_ptr; }
+		iterator end() const { return m_data_ptr + m_count; }
+
+		TXScopeCheckedSpan subspan(size_type offset, size_type count) const {
+			return TXScopeCheckedSpan(m_data_ptr, m_count, offset, count, m_size_pin);
+		}
+
+	private:
+		template<typename _TContainer>
+		TXScopeCheckedSpan(_TContainer& container_ref, size_type offset, size_type count)
+			: TXScopeCheckedSpan(impl::contiguous_data_ptr(container_ref), size_type(container_ref.size()), offset, count, impl::contiguous_size_pin(container_ref)) {}
+		TXScopeCheckedSpan(_Ty* data_ptr, size_type container_size, size_type offset, size_type count, const CSizePin& size_pin)
+			: m_data_ptr(checked_range_begin(data_ptr, container_size, offset, count)), m_count(count), m_size_pin(size_pin) {}
+
+		/* The range is validated before the offset is applied, so an invalid offset never produces an out of bounds pointer. */
+		static _Ty* checked_range_begin(_Ty* data_ptr, size_type container_size, size_type offset, size_type count) {
+			if ((container_size < offset) || (container_size - offset < count)) {
+				MSE_THROW(msearray_range_error("out of bounds range - TXScopeCheckedSpan"));
+			}
+			return data_ptr + offset;
+		}
+
+		TXScopeCheckedSpan<_Ty>& operator=(const TXScopeCheckedSpan<_Ty>& _Right_cref) = delete;
+		void* operator new(size_t size) { return ::operator new(size); }
+
+		TXScopeCheckedSpan<_Ty>* operator&() { return this; }
+		const TXScopeCheckedSpan<_Ty>* operator&() const { return this; }
+
+		_Ty* const m_data_ptr = nullptr;
+		const size_type m_count = 0;
+		const CSizePin m_size_pin;
+
+		template <typename _Ty2> friend class TXScopeCheckedSpan;
+	};
+
+	template<typename _TContainer>
+	auto make_xscope_checked_span(const TXScopeFixedPointer<_TContainer>& container_xscpptr) -> TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type> {
+		return TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type>(container_xscpptr);
+	}
+	template<typename _TContainer>
+	auto make_xscope_checked_span(const TXScopeFixedPointer<_TContainer>& container_xscpptr, std::size_t offset, std::size_t count) -> TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type> {
+		return TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type>(container_xscpptr, offset, count);
+	}
+	template<typename _TContainer>
+	auto make_xscope_checked_span(const TXScopeFixedConstPointer<_TContainer>& container_xscpptr) -> TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type> {
+		return TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type>(container_xscpptr);
+	}
+	template<typename _TContainer>
+	auto make_xscope_checked_span(const TXScopeFixedConstPointer<_TContainer>& container_xscpptr, std::size_t offset, std::size_t count) -> TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type> {
+		return TXScopeCheckedSpan<typename std::remove_reference<decltype((*container_xscpptr)[0])>::type>(container_xscpptr, offset, count);
+	}
+
 	template <typename _Ty>
 	class TOpaqueWrapper {
 	public:
@@ -1399,7 +1765,7 @@ namespace mse {
 				ipointer_base_class::operator=(_Right_cref);
 			}
 			else {
-				~TIPointerWithBundledVector();
+				(*this).~TIPointerWithBundledVector();
 				::new (this) TIPointerWithBundledVector(_Right_cref);
 			}
 			return(*this);
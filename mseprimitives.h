@@ -12,6 +12,10 @@
 #include <climits>       // ULONG_MAX
 #include <limits>       // std::numeric_limits
 #include <stdexcept>      // primitives_range_error
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
 
 /*compiler specific defines*/
 #ifdef _MSC_VER
@@ -43,6 +47,19 @@
 #define MSE_CONSTEXPR constexpr
 #endif // defined(MSVC2013_COMPATIBLE) || defined(MSVC2010_COMPATIBLE)
 
+#if defined(MSVC2013_COMPATIBLE) || defined(MSVC2010_COMPATIBLE)
+#define MSE_NOEXCEPT
+#else // defined(MSVC2013_COMPATIBLE) || defined(MSVC2010_COMPATIBLE)
+#define MSE_NOEXCEPT noexcept
+#endif // defined(MSVC2013_COMPATIBLE) || defined(MSVC2010_COMPATIBLE)
+
+/* MSE_CONSTEXPR14 is for functions that rely on C++14's "relaxed" constexpr rules (i.e. have multiple statements). */
+#if defined(MSVC2015_COMPATIBLE) || defined(MSVC2013_COMPATIBLE) || defined(MSVC2010_COMPATIBLE) || (defined(__cplusplus) && (__cplusplus < 201402L) && !defined(_MSC_VER))
+#define MSE_CONSTEXPR14
+#else // defined(MSVC2015_COMPATIBLE) || ...
+#define MSE_CONSTEXPR14 constexpr
+#endif // defined(MSVC2015_COMPATIBLE) || ...
+
 #ifdef MSVC2015_COMPATIBLE
 #ifndef MSE_FORCE_PRIMITIVE_ASSIGN_RANGE_CHECK_ENABLED
 /* msvc2015's incomplete support for "constexpr" means that range checks that should be done at compile time would
@@ -76,6 +93,15 @@ namespace mse {
 		using std::range_error::range_error;
 	};
 
+	/* Checking policies. The "policy selected" type templates (TPolicyInt<>, TPolicyVector<>, TPolicyRegisteredPointer<>,
+	etc.) resolve to the library's (checked) safe type when given CCheckedPolicy, and to its native or standard library
+	counterpart when given CUncheckedPolicy. Unlike the global MSE_..._DISABLED macros, the choice is made per use rather than
+	per program. Since the checked and unchecked types are always distinct types, a performance critical module can use the
+	unchecked ones while the rest of the program uses the checked ones without any violation of the one definition rule.
+	Values are converted between the two explicitly at the module boundary. */
+	class CCheckedPolicy {};
+	class CUncheckedPolicy {};
+
 	/* When the mse primitive replacements are "disabled" they lose their default initialization and may cause problems for
 	code that relies on it. */
 #ifdef MSE_PRIMITIVES_DISABLED
@@ -95,33 +121,33 @@ namespace mse {
 	class CBool {
 	public:
 		// Constructs zero.
-		CBool() : m_val(false) {}
+		MSE_CONSTEXPR14 CBool() : m_val(false) {}
 
 		// Copy constructor
-		CBool(const CBool &x) : m_val(x.m_val) { note_value_assignment(); };
+		MSE_CONSTEXPR14 CBool(const CBool &x) : m_val(x.m_val) { note_value_assignment(); };
 
 		// Assignment operator
-		CBool& operator=(const CBool &x) { note_value_assignment(); m_val = x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CBool& operator=(const CBool &x) { note_value_assignment(); m_val = x.m_val; return (*this); }
 
 		// Constructors from primitive boolean types
-		CBool(bool   x) { note_value_assignment(); m_val = x; }
+		MSE_CONSTEXPR14 CBool(bool   x) : m_val(x) { note_value_assignment(); }
 
 		// Casts to primitive boolean types
-		operator bool() const { assert_initialized(); return m_val; }
+		MSE_CONSTEXPR14 operator bool() const { assert_initialized(); return m_val; }
 
-		CBool& operator |=(const CBool &x) { assert_initialized(); m_val |= x.m_val; return (*this); }
-		CBool& operator &=(const CBool &x) { assert_initialized(); m_val &= x.m_val; return (*this); }
-		CBool& operator ^=(const CBool &x) { assert_initialized(); m_val ^= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CBool& operator |=(const CBool &x) { assert_initialized(); m_val |= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CBool& operator &=(const CBool &x) { assert_initialized(); m_val &= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CBool& operator ^=(const CBool &x) { assert_initialized(); m_val ^= x.m_val; return (*this); }
 
 		bool m_val;
 
 #ifdef MSE_CHECK_USE_BEFORE_SET
-		void note_value_assignment() { m_initialized = true; }
-		void assert_initialized() const { assert(m_initialized); }
+		MSE_CONSTEXPR14 void note_value_assignment() { m_initialized = true; }
+		MSE_CONSTEXPR14 void assert_initialized() const { assert(m_initialized); }
 		bool m_initialized = false;
 #else // MSE_CHECK_USE_BEFORE_SET
-		void note_value_assignment() {}
-		void assert_initialized() const {}
+		MSE_CONSTEXPR14 void note_value_assignment() {}
+		MSE_CONSTEXPR14 void assert_initialized() const {}
 #endif // MSE_CHECK_USE_BEFORE_SET
 	};
 
@@ -146,33 +172,128 @@ namespace mse {
 			);
 	}
 
+	namespace impl {
+		inline void throw_primitives_range_error() {
+			MSE_THROW(primitives_range_error("range error - value to be assigned is out of range of the target (integer) type"));
+		}
+
+		/* Conversions that can't possibly be out of range are (statically) dispatched to a no-op, so the check costs nothing
+		even in unoptimized builds. */
+		template<typename _TDestination, typename _TSource>
+		MSE_CONSTEXPR14 void assign_check_upper_bound(const _TSource &x, std::true_type/*can_exceed_upper_bound*/) {
+			if (x > _TSource(std::numeric_limits<_TDestination>::max())) {
+				throw_primitives_range_error();
+			}
+		}
+		template<typename _TDestination, typename _TSource>
+		MSE_CONSTEXPR14 void assign_check_upper_bound(const _TSource &, std::false_type/*can_exceed_upper_bound*/) {}
+		template<typename _TDestination, typename _TSource>
+		MSE_CONSTEXPR14 void assign_check_lower_bound(const _TSource &x, std::true_type/*can_exceed_lower_bound*/) {
+			/* We're assuming that std::numeric_limits<>::lowest() will never be greater than zero. */
+			if (0 > x) {
+				if (0 == std::numeric_limits<_TDestination>::lowest()) {
+					throw_primitives_range_error();
+				}
+				else if (x < _TSource(std::numeric_limits<_TDestination>::lowest())) {
+					throw_primitives_range_error();
+				}
+			}
+		}
+		template<typename _TDestination, typename _TSource>
+		MSE_CONSTEXPR14 void assign_check_lower_bound(const _TSource &, std::false_type/*can_exceed_lower_bound*/) {}
+	}
+
 	template<typename _TDestination, typename _TSource>
-	void g_assign_check_range(const _TSource &x) {
+	MSE_CONSTEXPR14 void g_assign_check_range(const _TSource &x) {
 #ifndef MSE_PRIMITIVE_ASSIGN_RANGE_CHECK_DISABLED
-		/* This probably needs to be cleaned up. But at the moment this should be mostly compile time complexity. And
-		as is it avoids "signed/unsigned" mismatch warnings. */
-		MSE_CONSTEXPR const bool rhs_can_exceed_upper_bound = sg_can_exceed_upper_bound<_TDestination, _TSource>();
-		MSE_CONSTEXPR const bool rhs_can_exceed_lower_bound = sg_can_exceed_lower_bound<_TDestination, _TSource>();
-		MSE_CONSTEXPR const bool can_exceed_bounds = rhs_can_exceed_upper_bound || rhs_can_exceed_lower_bound;
-		if (can_exceed_bounds) {
-			if (rhs_can_exceed_upper_bound) {
-				if (x > _TSource(std::numeric_limits<_TDestination>::max())) {
-					MSE_THROW(primitives_range_error("range error - value to be assigned is out of range of the target (integer) type"));
+		impl::assign_check_upper_bound<_TDestination, _TSource>(x, std::integral_constant<bool, sg_can_exceed_upper_bound<_TDestination, _TSource>()>());
+		impl::assign_check_lower_bound<_TDestination, _TSource>(x, std::integral_constant<bool, sg_can_exceed_lower_bound<_TDestination, _TSource>()>());
+#endif // !MSE_PRIMITIVE_ASSIGN_RANGE_CHECK_DISABLED
+	}
+
+	namespace impl {
+		/* Overflow checked arithmetic. Where available, compiler intrinsics are used. */
+		inline void throw_primitives_overflow_error() {
+			MSE_THROW(primitives_range_error("range error - the result of the (integer) operation is out of range"));
+		}
+		template<typename _Ty>
+		MSE_CONSTEXPR14 _Ty checked_add(_Ty a, _Ty b) {
+#ifndef MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+#if defined(__GNUC__) || defined(__clang__)
+			_Ty result = 0;
+			if (__builtin_add_overflow(a, b, &result)) {
+				throw_primitives_overflow_error();
+			}
+			return result;
+#else // defined(__GNUC__) || defined(__clang__)
+			if (std::numeric_limits<_Ty>::is_signed) {
+				if (((0 < b) && (a > std::numeric_limits<_Ty>::max() - b)) || ((0 > b) && (a < std::numeric_limits<_Ty>::lowest() - b))) {
+					throw_primitives_overflow_error();
 				}
 			}
-			if (rhs_can_exceed_lower_bound) {
-				/* We're assuming that std::numeric_limits<>::lowest() will never be greater than zero. */
-				if (0 > x) {
-					if (0 == std::numeric_limits<_TDestination>::lowest()) {
-						MSE_THROW(primitives_range_error("range error - value to be assigned is out of range of the target (integer) type"));
-					}
-					else if (x < _TSource(std::numeric_limits<_TDestination>::lowest())) {
-						MSE_THROW(primitives_range_error("range error - value to be assigned is out of range of the target (integer) type"));
-					}
+			else if (a > std::numeric_limits<_Ty>::max() - b) {
+				throw_primitives_overflow_error();
+			}
+			return a + b;
+#endif // defined(__GNUC__) || defined(__clang__)
+#else // !MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+			return a + b;
+#endif // !MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+		}
+		template<typename _Ty>
+		MSE_CONSTEXPR14 _Ty checked_subtract(_Ty a, _Ty b) {
+#ifndef MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+#if defined(__GNUC__) || defined(__clang__)
+			_Ty result = 0;
+			if (__builtin_sub_overflow(a, b, &result)) {
+				throw_primitives_overflow_error();
+			}
+			return result;
+#else // defined(__GNUC__) || defined(__clang__)
+			if (std::numeric_limits<_Ty>::is_signed) {
+				if (((0 > b) && (a > std::numeric_limits<_Ty>::max() + b)) || ((0 < b) && (a < std::numeric_limits<_Ty>::lowest() + b))) {
+					throw_primitives_overflow_error();
 				}
 			}
+			else if (b > a) {
+				throw_primitives_overflow_error();
+			}
+			return a - b;
+#endif // defined(__GNUC__) || defined(__clang__)
+#else // !MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+			return a - b;
+#endif // !MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+		}
+		template<typename _Ty>
+		MSE_CONSTEXPR14 _Ty checked_multiply(_Ty a, _Ty b) {
+#ifndef MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+#if defined(__GNUC__) || defined(__clang__)
+			_Ty result = 0;
+			if (__builtin_mul_overflow(a, b, &result)) {
+				throw_primitives_overflow_error();
+			}
+			return result;
+#else // defined(__GNUC__) || defined(__clang__)
+			const _Ty max_val = std::numeric_limits<_Ty>::max();
+			const _Ty lowest_val = std::numeric_limits<_Ty>::lowest();
+			if (0 < a) {
+				if (0 < b) {
+					if (a > max_val / b) { throw_primitives_overflow_error(); }
+				}
+				else if (b < lowest_val / a) { throw_primitives_overflow_error(); }
+			}
+			else if (0 > a) {
+				if (0 < b) {
+					if (a < lowest_val / b) { throw_primitives_overflow_error(); }
+				}
+				else if ((0 > b) && (b < max_val / a)) { throw_primitives_overflow_error(); }
+			}
+			return a * b;
+#endif // defined(__GNUC__) || defined(__clang__)
+#else // !MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
+			return a * b;
+#endif // !MSE_PRIMITIVE_OVERFLOW_CHECK_DISABLED
 		}
-#endif // !MSE_PRIMITIVE_ASSIGN_RANGE_CHECK_DISABLED
 	}
 
 	/* The CInt and CSize_t classes are meant to substitute for standard "int" and "size_t" types. The differences between
@@ -185,16 +306,16 @@ namespace mse {
 	class TIntBase1 {
 	public:
 		// Constructs zero.
-		TIntBase1() : m_val(0) {}
+		MSE_CONSTEXPR14 TIntBase1() : m_val(0) {}
 
 		// Copy constructor
-		TIntBase1(const TIntBase1 &x) : m_val(x.m_val) { note_value_assignment(); };
+		MSE_CONSTEXPR14 TIntBase1(const TIntBase1 &x) : m_val(x.m_val) { note_value_assignment(); };
 
 		// Constructors from primitive integer types
-		explicit TIntBase1(_Ty   x) { note_value_assignment(); m_val = x; }
+		MSE_CONSTEXPR14 explicit TIntBase1(_Ty   x) : m_val(x) { note_value_assignment(); }
 
 		template<typename _Tz>
-		void assign_check_range(const _Tz &x) {
+		MSE_CONSTEXPR14 void assign_check_range(const _Tz &x) {
 			note_value_assignment();
 			g_assign_check_range<_Ty, _Tz>(x);
 		}
@@ -202,12 +323,12 @@ namespace mse {
 		_Ty m_val;
 
 #ifdef MSE_CHECK_USE_BEFORE_SET
-		void note_value_assignment() { m_initialized = true; }
-		void assert_initialized() const { assert(m_initialized); }
+		MSE_CONSTEXPR14 void note_value_assignment() { m_initialized = true; }
+		MSE_CONSTEXPR14 void assert_initialized() const { assert(m_initialized); }
 		bool m_initialized = false;
 #else // MSE_CHECK_USE_BEFORE_SET
-		void note_value_assignment() {}
-		void assert_initialized() const {}
+		MSE_CONSTEXPR14 void note_value_assignment() {}
+		MSE_CONSTEXPR14 void assert_initialized() const {}
 #endif // MSE_CHECK_USE_BEFORE_SET
 	};
 
@@ -217,22 +338,22 @@ namespace mse {
 		typedef TIntBase1<_Ty> _Myt;
 
 		// Constructs zero.
-		CInt() : _Myt() {}
+		MSE_CONSTEXPR14 CInt() : _Myt() {}
 
 		// Copy constructor
-		CInt(const CInt &x) : _Myt(x) {};
-		CInt(const _Myt &x) : _Myt(x) {};
+		MSE_CONSTEXPR14 CInt(const CInt &x) : _Myt(x) {};
+		MSE_CONSTEXPR14 CInt(const _Myt &x) : _Myt(x) {};
 
 		// Assignment operator
-		CInt& operator=(const CInt &x) { (*this).note_value_assignment(); m_val = x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CInt& operator=(const CInt &x) { (*this).note_value_assignment(); m_val = x.m_val; return (*this); }
 		//CInt& operator=(const _Ty &x) { (*this).note_value_assignment(); m_val = x; return (*this); }
 
-		CInt& operator=(long long x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CInt& operator=(long x) { assign_check_range<long>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CInt& operator=(int x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CInt& operator=(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CInt& operator=(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CInt& operator=(size_t x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator=(long long x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator=(long x) { assign_check_range<long>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator=(int x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator=(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator=(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator=(size_t x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); return (*this); }
 		//CInt& operator=(CSize_t x) { assign_check_range<size_t>(x.as_a_size_t()); m_val = x.as_a_size_t(); return (*this); }
 		/* We would have liked to have assignment operators for the unsigned primitive integer types, but one of them could
 		potentially clash with the size_t assignment operator. */
@@ -244,12 +365,12 @@ namespace mse {
 
 		// Constructors from primitive integer types
 		//CInt(_Ty   x) { m_val = x; }
-		CInt(long long  x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); }
-		CInt(long  x) { assign_check_range< long>(x); m_val = static_cast<_Ty>(x); }
-		CInt(int   x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); }
-		CInt(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); }
-		CInt(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); }
-		CInt(size_t   x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 CInt(long long  x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 CInt(long  x) { assign_check_range< long>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 CInt(int   x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 CInt(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 CInt(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 CInt(size_t   x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); }
 		//CInt(CSize_t   x) { assign_check_range<size_t>(x.as_a_size_t()); m_val = x.as_a_size_t(); }
 		/* We would have liked to have constructors for the unsigned primitive integer types, but one of them could
 		potentially clash with the size_t constructor. */
@@ -260,121 +381,121 @@ namespace mse {
 		//CInt(unsigned char x) { assign_check_range<unsigned char>(x); m_val = static_cast<_Ty>(x); }
 
 		// Casts to primitive integer types
-		operator _Ty() const { (*this).assert_initialized(); return m_val; }
-
-		CInt operator ~() const { (*this).assert_initialized(); return CInt(~m_val); }
-		CInt& operator |=(const CInt &x) { (*this).assert_initialized(); m_val |= x.m_val; return (*this); }
-		CInt& operator &=(const CInt &x) { (*this).assert_initialized(); m_val &= x.m_val; return (*this); }
-		CInt& operator ^=(const CInt &x) { (*this).assert_initialized(); m_val ^= x.m_val; return (*this); }
-
-		CInt operator -() const { (*this).assert_initialized(); return CInt(-m_val); }
-		CInt& operator +=(const CInt &x) { (*this).assert_initialized(); m_val += x.m_val; return (*this); }
-		CInt& operator -=(const CInt &x) { (*this).assert_initialized(); m_val -= x.m_val; return (*this); }
-		CInt& operator *=(const CInt &x) { (*this).assert_initialized(); m_val *= x.m_val; return (*this); }
-		CInt& operator /=(const CInt &x) { (*this).assert_initialized(); m_val /= x.m_val; return (*this); }
-		CInt& operator %=(const CInt &x) { (*this).assert_initialized(); m_val %= x.m_val; return (*this); }
-		CInt& operator >>=(const CInt &x) { (*this).assert_initialized(); m_val >>= x.m_val; return (*this); }
-		CInt& operator <<=(const CInt &x) { (*this).assert_initialized(); m_val <<= x.m_val; return (*this); }
-
-		CInt operator +(const CInt &x) const { (*this).assert_initialized(); return CInt(m_val + x.m_val); }
-		CInt operator +(long long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(int x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(short x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(char x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(size_t x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 operator _Ty() const { (*this).assert_initialized(); return m_val; }
+
+		MSE_CONSTEXPR14 CInt operator ~() const { (*this).assert_initialized(); return CInt(~m_val); }
+		MSE_CONSTEXPR14 CInt& operator |=(const CInt &x) { (*this).assert_initialized(); m_val |= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CInt& operator &=(const CInt &x) { (*this).assert_initialized(); m_val &= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CInt& operator ^=(const CInt &x) { (*this).assert_initialized(); m_val ^= x.m_val; return (*this); }
+
+		MSE_CONSTEXPR14 CInt operator -() const { (*this).assert_initialized(); return CInt(impl::checked_subtract(_Ty(0), m_val)); }
+		MSE_CONSTEXPR14 CInt& operator +=(const CInt &x) { (*this).assert_initialized(); m_val = impl::checked_add(m_val, x.m_val); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator -=(const CInt &x) { (*this).assert_initialized(); m_val = impl::checked_subtract(m_val, x.m_val); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator *=(const CInt &x) { (*this).assert_initialized(); m_val = impl::checked_multiply(m_val, x.m_val); return (*this); }
+		MSE_CONSTEXPR14 CInt& operator /=(const CInt &x) { (*this).assert_initialized(); m_val /= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CInt& operator %=(const CInt &x) { (*this).assert_initialized(); m_val %= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CInt& operator >>=(const CInt &x) { (*this).assert_initialized(); m_val >>= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CInt& operator <<=(const CInt &x) { (*this).assert_initialized(); m_val <<= x.m_val; return (*this); }
+
+		MSE_CONSTEXPR14 CInt operator +(const CInt &x) const { (*this).assert_initialized(); return CInt(impl::checked_add(m_val, x.m_val)); }
+		MSE_CONSTEXPR14 CInt operator +(long long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(int x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(short x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(char x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(size_t x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
 		//CInt operator +(CSize_t x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
 
-		CInt operator -(const CInt &x) const { (*this).assert_initialized(); return CInt(m_val - x.m_val); }
-		CInt operator -(long long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(int x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(short x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(char x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(size_t x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(const CInt &x) const { (*this).assert_initialized(); return CInt(impl::checked_subtract(m_val, x.m_val)); }
+		MSE_CONSTEXPR14 CInt operator -(long long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(int x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(short x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(char x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(size_t x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
 		//CInt operator -(CSize_t x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
 
-		CInt operator *(const CInt &x) const { (*this).assert_initialized(); return CInt(m_val * x.m_val); }
-		CInt operator *(long long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(int x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(short x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(char x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(size_t x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(const CInt &x) const { (*this).assert_initialized(); return CInt(impl::checked_multiply(m_val, x.m_val)); }
+		MSE_CONSTEXPR14 CInt operator *(long long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(int x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(short x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(char x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(size_t x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
 		//CInt operator *(CSize_t x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
 
-		CInt operator /(const CInt &x) const { (*this).assert_initialized(); return CInt(m_val / x.m_val); }
-		CInt operator /(long long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(int x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(short x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(char x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(size_t x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(const CInt &x) const { (*this).assert_initialized(); return CInt(m_val / x.m_val); }
+		MSE_CONSTEXPR14 CInt operator /(long long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(int x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(short x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(char x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(size_t x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
 		//CInt operator /(CSize_t x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
 
-		bool operator <(const CInt &x) const { (*this).assert_initialized(); return (m_val < x.m_val); }
-		bool operator <(long long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(int x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(short x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(char x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(size_t x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(const CInt &x) const { (*this).assert_initialized(); return (m_val < x.m_val); }
+		MSE_CONSTEXPR14 bool operator <(long long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(int x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(short x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(char x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(size_t x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
 		//bool operator <(CSize_t x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
 
-		bool operator >(const CInt &x) const { (*this).assert_initialized(); return (m_val > x.m_val); }
-		bool operator >(long long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(int x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(short x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(char x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(size_t x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(const CInt &x) const { (*this).assert_initialized(); return (m_val > x.m_val); }
+		MSE_CONSTEXPR14 bool operator >(long long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(int x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(short x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(char x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(size_t x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
 		//bool operator >(CSize_t x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
 
-		bool operator <=(const CInt &x) const { (*this).assert_initialized(); return (m_val <= x.m_val); }
-		bool operator <=(long long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(int x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(short x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(char x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(size_t x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(const CInt &x) const { (*this).assert_initialized(); return (m_val <= x.m_val); }
+		MSE_CONSTEXPR14 bool operator <=(long long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(int x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(short x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(char x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(size_t x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
 		//bool operator <=(CSize_t x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
 
-		bool operator >=(const CInt &x) const { (*this).assert_initialized(); return (m_val >= x.m_val); }
-		bool operator >=(long long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(int x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(short x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(char x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(size_t x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(const CInt &x) const { (*this).assert_initialized(); return (m_val >= x.m_val); }
+		MSE_CONSTEXPR14 bool operator >=(long long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(int x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(short x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(char x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(size_t x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
 		//bool operator >=(CSize_t x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
 
-		bool operator ==(const CInt &x) const { (*this).assert_initialized(); return (m_val == x.m_val); }
-		bool operator ==(long long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(int x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(short x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(char x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(size_t x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(const CInt &x) const { (*this).assert_initialized(); return (m_val == x.m_val); }
+		MSE_CONSTEXPR14 bool operator ==(long long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(int x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(short x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(char x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(size_t x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
 		//bool operator ==(CSize_t x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
 
-		bool operator !=(const CInt &x) const { (*this).assert_initialized(); return (m_val != x.m_val); }
-		bool operator !=(long long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(int x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(short x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(char x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(size_t x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(const CInt &x) const { (*this).assert_initialized(); return (m_val != x.m_val); }
+		MSE_CONSTEXPR14 bool operator !=(long long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(int x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(short x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(char x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(size_t x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
 		//bool operator !=(CSize_t x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
 
 		// INCREMENT/DECREMENT OPERATORS
-		CInt& operator ++() { (*this).assert_initialized(); m_val++; return (*this); }
-		CInt operator ++(int) {
+		MSE_CONSTEXPR14 CInt& operator ++() { (*this).assert_initialized(); m_val = impl::checked_add(m_val, _Ty(1)); return (*this); }
+		MSE_CONSTEXPR14 CInt operator ++(int) {
 			(*this).assert_initialized();
 			CInt tmp(*this); // copy
 			operator++(); // pre-increment
 			return tmp;   // return old value
 		}
-		CInt& operator --() {
+		MSE_CONSTEXPR14 CInt& operator --() {
 			(*this).assert_initialized();
 			if (0 <= std::numeric_limits<_Ty>::lowest()) {
 				(*this).assert_initialized();
@@ -382,10 +503,10 @@ namespace mse {
 			}
 			else {
 				(*this).assert_initialized();
-				m_val--; return (*this);
+				m_val = impl::checked_subtract(m_val, _Ty(1)); return (*this);
 			}
 		}
-		CInt operator --(int) {
+		MSE_CONSTEXPR14 CInt operator --(int) {
 			(*this).assert_initialized();
 			CInt tmp(*this); // copy
 			operator--(); // pre-decrement
@@ -472,7 +593,7 @@ namespace std {
 
 namespace mse {
 	class CSize_t;
-	static size_t as_a_size_t(CSize_t n);
+	MSE_CONSTEXPR14 static size_t as_a_size_t(CSize_t n);
 
 	/* Note that CSize_t does not have a default conversion to size_t. This is by design. Use the as_a_size_t() member
 	function to get a size_t when necessary. */
@@ -483,23 +604,23 @@ namespace mse {
 		typedef TIntBase1<_Ty> _Myt;
 
 		// Constructs zero.
-		CSize_t() : _Myt() {}
+		MSE_CONSTEXPR14 CSize_t() : _Myt() {}
 
 		// Copy constructor
-		CSize_t(const CSize_t &x) : _Myt(x) {};
-		CSize_t(const _Myt &x) : _Myt(x) {};
+		MSE_CONSTEXPR14 CSize_t(const CSize_t &x) : _Myt(x) {};
+		MSE_CONSTEXPR14 CSize_t(const _Myt &x) : _Myt(x) {};
 
 		// Assignment operator
-		CSize_t& operator=(const CSize_t &x) { m_val = x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(const CSize_t &x) { m_val = x.m_val; return (*this); }
 		//CSize_t& operator=(const _Ty &x) { m_val = x; return (*this); }
 
-		CSize_t& operator=(long long x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CSize_t& operator=(long x) { assign_check_range<long>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CSize_t& operator=(int x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CSize_t& operator=(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CSize_t& operator=(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CSize_t& operator=(size_t x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); return (*this); }
-		CSize_t& operator=(CInt x) { assign_check_range<MSE_CINT_BASE_INTEGER_TYPE>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(long long x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(long x) { assign_check_range<long>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(int x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(size_t x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator=(CInt x) { assign_check_range<MSE_CINT_BASE_INTEGER_TYPE>(x); m_val = static_cast<_Ty>(x); return (*this); }
 		/* We would have liked to have assignment operators for the unsigned primitive integer types, but one of them could
 		potentially clash with the size_t assignment operator. */
 		//CSize_t& operator=(unsigned long long x) { assign_check_range<unsigned long long>(x); m_val = static_cast<_Ty>(x); return (*this); }
@@ -510,13 +631,13 @@ namespace mse {
 
 		// Constructors from primitive integer types
 		//explicit CSize_t(_Ty   x) { m_val = x; }
-		explicit CSize_t(long long  x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); }
-		explicit CSize_t(long  x) { assign_check_range< long>(x); m_val = static_cast<_Ty>(x); }
-		explicit CSize_t(int   x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); }
-		explicit CSize_t(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); }
-		explicit CSize_t(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); }
-		CSize_t(size_t   x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); }
-		/*explicit */CSize_t(CInt   x) { assign_check_range<MSE_CINT_BASE_INTEGER_TYPE>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 explicit CSize_t(long long  x) { assign_check_range<long long>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 explicit CSize_t(long  x) { assign_check_range< long>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 explicit CSize_t(int   x) { assign_check_range<int>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 explicit CSize_t(short x) { assign_check_range<short>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 explicit CSize_t(char x) { assign_check_range<char>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 CSize_t(size_t   x) { assign_check_range<size_t>(x); m_val = static_cast<_Ty>(x); }
+		MSE_CONSTEXPR14 /*explicit */CSize_t(CInt   x) { assign_check_range<MSE_CINT_BASE_INTEGER_TYPE>(x); m_val = static_cast<_Ty>(x); }
 		/* We would have liked to have constructors for the unsigned primitive integer types, but one of them could
 		potentially clash with the size_t constructor. */
 		//explicit CSize_t(unsigned long long  x) { assign_check_range<unsigned long long>(x); m_val = static_cast<_Ty>(x); }
@@ -526,22 +647,22 @@ namespace mse {
 		//explicit CSize_t(unsigned char x) { assign_check_range<unsigned char>(x); m_val = static_cast<_Ty>(x); }
 
 		// Casts to primitive integer types
-		operator CInt() const { (*this).assert_initialized(); return CInt(m_val); }
+		MSE_CONSTEXPR14 operator CInt() const { (*this).assert_initialized(); return CInt(m_val); }
 #ifndef MSVC2010_COMPATIBLE
-		explicit operator size_t() const { (*this).assert_initialized(); return (m_val); }
+		MSE_CONSTEXPR14 explicit operator size_t() const { (*this).assert_initialized(); return (m_val); }
 #endif /*MSVC2010_COMPATIBLE*/
 		//size_t as_a_size_t() const { (*this).assert_initialized(); return m_val; }
 
-		CSize_t operator ~() const { (*this).assert_initialized(); return (~m_val); }
-		CSize_t& operator |=(const CSize_t &x) { (*this).assert_initialized(); m_val |= x.m_val; return (*this); }
-		CSize_t& operator &=(const CSize_t &x) { (*this).assert_initialized(); m_val &= x.m_val; return (*this); }
-		CSize_t& operator ^=(const CSize_t &x) { (*this).assert_initialized(); m_val ^= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CSize_t operator ~() const { (*this).assert_initialized(); return (~m_val); }
+		MSE_CONSTEXPR14 CSize_t& operator |=(const CSize_t &x) { (*this).assert_initialized(); m_val |= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator &=(const CSize_t &x) { (*this).assert_initialized(); m_val &= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator ^=(const CSize_t &x) { (*this).assert_initialized(); m_val ^= x.m_val; return (*this); }
 
-		CInt operator -() const { (*this).assert_initialized(); /* Should unsigned types even support this opperator? */
+		MSE_CONSTEXPR14 CInt operator -() const { (*this).assert_initialized(); /* Should unsigned types even support this opperator? */
 			return (-(CInt(m_val)));
 		}
-		CSize_t& operator +=(const CSize_t &x) { (*this).assert_initialized(); m_val += x.m_val; return (*this); }
-		CSize_t& operator -=(const CSize_t &x) {
+		MSE_CONSTEXPR14 CSize_t& operator +=(const CSize_t &x) { (*this).assert_initialized(); m_val = impl::checked_add(m_val, x.m_val); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator -=(const CSize_t &x) {
 			(*this).assert_initialized();
 			//assert(0 <= std::numeric_limits<_Ty>::lowest());
 			if (x.m_val > m_val) {
@@ -549,118 +670,118 @@ namespace mse {
 			}
 			m_val -= x.m_val; return (*this);
 		}
-		CSize_t& operator *=(const CSize_t &x) { (*this).assert_initialized(); m_val *= x.m_val; return (*this); }
-		CSize_t& operator /=(const CSize_t &x) { (*this).assert_initialized(); m_val /= x.m_val; return (*this); }
-		CSize_t& operator %=(const CSize_t &x) { (*this).assert_initialized(); m_val %= x.m_val; return (*this); }
-		CSize_t& operator >>=(const CSize_t &x) { (*this).assert_initialized(); m_val >>= x.m_val; return (*this); }
-		CSize_t& operator <<=(const CSize_t &x) { (*this).assert_initialized(); m_val <<= x.m_val; return (*this); }
-
-		CSize_t operator +(const CSize_t &x) const { (*this).assert_initialized(); return (m_val + x.m_val); }
-		CInt operator +(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) + x); }
-		CInt operator +(long long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(int x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(short x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CInt operator +(char x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
-		CSize_t operator +(size_t x) const { (*this).assert_initialized(); return ((*this) + CSize_t(x)); }
-
-		CInt operator -(const CSize_t &x) const { (*this).assert_initialized(); return (CInt(m_val) - CInt(x.m_val)); }
-		CInt operator -(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) - x); }
-		CInt operator -(long long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(int x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(short x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(char x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
-		CInt operator -(size_t x) const { (*this).assert_initialized(); return ((*this) - CSize_t(x)); }
-
-		CSize_t operator *(const CSize_t &x) const { (*this).assert_initialized(); return (m_val * x.m_val); }
-		CInt operator *(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) * x); }
-		CInt operator *(long long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(int x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(short x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CInt operator *(char x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
-		CSize_t operator *(size_t x) const { (*this).assert_initialized(); return ((*this) * CSize_t(x)); }
-
-		CSize_t operator /(const CSize_t &x) const { (*this).assert_initialized(); return (m_val / x.m_val); }
-		CInt operator /(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) / x); }
-		CInt operator /(long long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(int x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(short x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CInt operator /(char x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
-		CSize_t operator /(size_t x) const { (*this).assert_initialized(); return ((*this) / CSize_t(x)); }
-
-		bool operator <(const CSize_t &x) const { (*this).assert_initialized(); return (m_val < x.m_val); }
-		bool operator <(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) < x); }
-		bool operator <(long long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(int x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(short x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(char x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
-		bool operator <(size_t x) const { (*this).assert_initialized(); return ((*this) < CSize_t(x)); }
-
-		bool operator >(const CSize_t &x) const { (*this).assert_initialized(); return (m_val > x.m_val); }
-		bool operator >(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) > x); }
-		bool operator >(long long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(int x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(short x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(char x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
-		bool operator >(size_t x) const { (*this).assert_initialized(); return ((*this) > CSize_t(x)); }
-
-		bool operator <=(const CSize_t &x) const { (*this).assert_initialized(); return (m_val <= x.m_val); }
-		bool operator <=(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) <= x); }
-		bool operator <=(long long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(int x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(short x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(char x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
-		bool operator <=(size_t x) const { (*this).assert_initialized(); return ((*this) <= CSize_t(x)); }
-
-		bool operator >=(const CSize_t &x) const { (*this).assert_initialized(); return (m_val >= x.m_val); }
-		bool operator >=(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) >= x); }
-		bool operator >=(long long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(int x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(short x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(char x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
-		bool operator >=(size_t x) const { (*this).assert_initialized(); return ((*this) >= CSize_t(x)); }
-
-		bool operator ==(const CSize_t &x) const { (*this).assert_initialized(); return (m_val == x.m_val); }
-		bool operator ==(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) == x); }
-		bool operator ==(long long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(int x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(short x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(char x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
-		bool operator ==(size_t x) const { (*this).assert_initialized(); return ((*this) == CSize_t(x)); }
-
-		bool operator !=(const CSize_t &x) const { (*this).assert_initialized(); return (m_val != x.m_val); }
-		bool operator !=(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) != x); }
-		bool operator !=(long long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(int x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(short x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(char x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
-		bool operator !=(size_t x) const { (*this).assert_initialized(); return ((*this) != CSize_t(x)); }
+		MSE_CONSTEXPR14 CSize_t& operator *=(const CSize_t &x) { (*this).assert_initialized(); m_val = impl::checked_multiply(m_val, x.m_val); return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator /=(const CSize_t &x) { (*this).assert_initialized(); m_val /= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator %=(const CSize_t &x) { (*this).assert_initialized(); m_val %= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator >>=(const CSize_t &x) { (*this).assert_initialized(); m_val >>= x.m_val; return (*this); }
+		MSE_CONSTEXPR14 CSize_t& operator <<=(const CSize_t &x) { (*this).assert_initialized(); m_val <<= x.m_val; return (*this); }
+
+		MSE_CONSTEXPR14 CSize_t operator +(const CSize_t &x) const { (*this).assert_initialized(); return (impl::checked_add(m_val, x.m_val)); }
+		MSE_CONSTEXPR14 CInt operator +(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) + x); }
+		MSE_CONSTEXPR14 CInt operator +(long long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(long x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(int x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(short x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator +(char x) const { (*this).assert_initialized(); return ((*this) + CInt(x)); }
+		MSE_CONSTEXPR14 CSize_t operator +(size_t x) const { (*this).assert_initialized(); return ((*this) + CSize_t(x)); }
+
+		MSE_CONSTEXPR14 CInt operator -(const CSize_t &x) const { (*this).assert_initialized(); return (CInt(m_val) - CInt(x.m_val)); }
+		MSE_CONSTEXPR14 CInt operator -(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) - x); }
+		MSE_CONSTEXPR14 CInt operator -(long long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(long x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(int x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(short x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(char x) const { (*this).assert_initialized(); return ((*this) - CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator -(size_t x) const { (*this).assert_initialized(); return ((*this) - CSize_t(x)); }
+
+		MSE_CONSTEXPR14 CSize_t operator *(const CSize_t &x) const { (*this).assert_initialized(); return (impl::checked_multiply(m_val, x.m_val)); }
+		MSE_CONSTEXPR14 CInt operator *(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) * x); }
+		MSE_CONSTEXPR14 CInt operator *(long long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(long x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(int x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(short x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator *(char x) const { (*this).assert_initialized(); return ((*this) * CInt(x)); }
+		MSE_CONSTEXPR14 CSize_t operator *(size_t x) const { (*this).assert_initialized(); return ((*this) * CSize_t(x)); }
+
+		MSE_CONSTEXPR14 CSize_t operator /(const CSize_t &x) const { (*this).assert_initialized(); return (m_val / x.m_val); }
+		MSE_CONSTEXPR14 CInt operator /(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) / x); }
+		MSE_CONSTEXPR14 CInt operator /(long long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(long x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(int x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(short x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CInt operator /(char x) const { (*this).assert_initialized(); return ((*this) / CInt(x)); }
+		MSE_CONSTEXPR14 CSize_t operator /(size_t x) const { (*this).assert_initialized(); return ((*this) / CSize_t(x)); }
+
+		MSE_CONSTEXPR14 bool operator <(const CSize_t &x) const { (*this).assert_initialized(); return (m_val < x.m_val); }
+		MSE_CONSTEXPR14 bool operator <(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) < x); }
+		MSE_CONSTEXPR14 bool operator <(long long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(long x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(int x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(short x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(char x) const { (*this).assert_initialized(); return ((*this) < CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <(size_t x) const { (*this).assert_initialized(); return ((*this) < CSize_t(x)); }
+
+		MSE_CONSTEXPR14 bool operator >(const CSize_t &x) const { (*this).assert_initialized(); return (m_val > x.m_val); }
+		MSE_CONSTEXPR14 bool operator >(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) > x); }
+		MSE_CONSTEXPR14 bool operator >(long long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(long x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(int x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(short x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(char x) const { (*this).assert_initialized(); return ((*this) > CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >(size_t x) const { (*this).assert_initialized(); return ((*this) > CSize_t(x)); }
+
+		MSE_CONSTEXPR14 bool operator <=(const CSize_t &x) const { (*this).assert_initialized(); return (m_val <= x.m_val); }
+		MSE_CONSTEXPR14 bool operator <=(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) <= x); }
+		MSE_CONSTEXPR14 bool operator <=(long long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(long x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(int x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(short x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(char x) const { (*this).assert_initialized(); return ((*this) <= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator <=(size_t x) const { (*this).assert_initialized(); return ((*this) <= CSize_t(x)); }
+
+		MSE_CONSTEXPR14 bool operator >=(const CSize_t &x) const { (*this).assert_initialized(); return (m_val >= x.m_val); }
+		MSE_CONSTEXPR14 bool operator >=(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) >= x); }
+		MSE_CONSTEXPR14 bool operator >=(long long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(long x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(int x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(short x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(char x) const { (*this).assert_initialized(); return ((*this) >= CInt(x)); }
+		MSE_CONSTEXPR14 bool operator >=(size_t x) const { (*this).assert_initialized(); return ((*this) >= CSize_t(x)); }
+
+		MSE_CONSTEXPR14 bool operator ==(const CSize_t &x) const { (*this).assert_initialized(); return (m_val == x.m_val); }
+		MSE_CONSTEXPR14 bool operator ==(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) == x); }
+		MSE_CONSTEXPR14 bool operator ==(long long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(long x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(int x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(short x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(char x) const { (*this).assert_initialized(); return ((*this) == CInt(x)); }
+		MSE_CONSTEXPR14 bool operator ==(size_t x) const { (*this).assert_initialized(); return ((*this) == CSize_t(x)); }
+
+		MSE_CONSTEXPR14 bool operator !=(const CSize_t &x) const { (*this).assert_initialized(); return (m_val != x.m_val); }
+		MSE_CONSTEXPR14 bool operator !=(const CInt &x) const { (*this).assert_initialized(); return (CInt(m_val) != x); }
+		MSE_CONSTEXPR14 bool operator !=(long long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(long x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(int x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(short x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(char x) const { (*this).assert_initialized(); return ((*this) != CInt(x)); }
+		MSE_CONSTEXPR14 bool operator !=(size_t x) const { (*this).assert_initialized(); return ((*this) != CSize_t(x)); }
 
 		// INCREMENT/DECREMENT OPERATORS
-		CSize_t& operator ++() { (*this).assert_initialized(); m_val++; return (*this); }
-		CSize_t operator ++(int) { (*this).assert_initialized();
+		MSE_CONSTEXPR14 CSize_t& operator ++() { (*this).assert_initialized(); m_val = impl::checked_add(m_val, _Ty(1)); return (*this); }
+		MSE_CONSTEXPR14 CSize_t operator ++(int) { (*this).assert_initialized();
 			CSize_t tmp(*this); // copy
 			operator++(); // pre-increment
 			return tmp;   // return old value
 		}
-		CSize_t& operator --() { (*this).assert_initialized();
+		MSE_CONSTEXPR14 CSize_t& operator --() { (*this).assert_initialized();
 			if (0 <= std::numeric_limits<_Ty>::lowest()) { (*this).assert_initialized();
 				(*this) = (*this) - 1; return (*this);
 			}
 			else { (*this).assert_initialized();
-				m_val--; return (*this);
+				m_val = impl::checked_subtract(m_val, _Ty(1)); return (*this);
 			}
 		}
-		CSize_t operator --(int) { (*this).assert_initialized();
+		MSE_CONSTEXPR14 CSize_t operator --(int) { (*this).assert_initialized();
 			CSize_t tmp(*this); // copy
 			operator--(); // pre-decrement
 			return tmp;   // return old value
@@ -668,9 +789,9 @@ namespace mse {
 
 		//_Ty m_val;
 
-		friend size_t as_a_size_t(CSize_t n);
+		friend MSE_CONSTEXPR14 size_t as_a_size_t(CSize_t n);
 	};
-	size_t as_a_size_t(CSize_t n) { n.assert_initialized(); return n.m_val; }
+	MSE_CONSTEXPR14 size_t as_a_size_t(CSize_t n) { n.assert_initialized(); return n.m_val; }
 }
 
 namespace std {
@@ -749,71 +870,323 @@ namespace std {
 
 namespace mse {
 
-	inline CInt operator+(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); rhs.assert_initialized(); return CSize_t(lhs) + rhs; }
-	inline CSize_t operator+(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) + rhs; }
-	inline CInt operator+(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) + rhs; }
-	inline CInt operator+(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) + as_a_size_t(rhs); }
-	inline CInt operator+(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs + as_a_size_t(rhs); }
-	inline CInt operator-(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) - rhs; }
-	inline CInt operator-(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) - rhs; }
-	inline CInt operator-(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) - rhs; }
-	inline CInt operator-(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) - as_a_size_t(rhs); }
-	inline CInt operator-(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs - as_a_size_t(rhs); }
-	inline CInt operator*(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) * rhs; }
-	inline CSize_t operator*(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) * rhs; }
-	inline CInt operator*(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) * rhs; }
-	inline CInt operator*(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) * as_a_size_t(rhs); }
-	inline CInt operator*(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs * as_a_size_t(rhs); }
-	inline CInt operator/(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) / rhs; }
-	inline CSize_t operator/(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) / rhs; }
-	inline CInt operator/(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) / rhs; }
-	inline CInt operator/(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) / as_a_size_t(rhs); }
-	inline CInt operator/(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs / as_a_size_t(rhs); }
-
-	inline bool operator<(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) < rhs; }
-	inline bool operator<(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) < rhs; }
-	inline bool operator<(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) < rhs; }
-	inline bool operator<(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) < as_a_size_t(rhs); }
-	inline bool operator<(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) < rhs; }
-	inline bool operator<(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) < as_a_size_t(rhs); }
-	inline bool operator<(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs < as_a_size_t(rhs); }
-	inline bool operator>(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) > rhs; }
-	inline bool operator>(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) > rhs; }
-	inline bool operator>(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) > rhs; }
-	inline bool operator>(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) > as_a_size_t(rhs); }
-	inline bool operator>(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) > rhs; }
-	inline bool operator>(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) > as_a_size_t(rhs); }
-	inline bool operator>(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs > as_a_size_t(rhs); }
-	inline bool operator<=(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) <= rhs; }
-	inline bool operator<=(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) <= rhs; }
-	inline bool operator<=(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) <= rhs; }
-	inline bool operator<=(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) <= as_a_size_t(rhs); }
-	inline bool operator<=(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) <= rhs; }
-	inline bool operator<=(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) <= as_a_size_t(rhs); }
-	inline bool operator<=(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs <= as_a_size_t(rhs); }
-	inline bool operator>=(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) >= rhs; }
-	inline bool operator>=(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) >= rhs; }
-	inline bool operator>=(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) >= rhs; }
-	inline bool operator>=(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) >= as_a_size_t(rhs); }
-	inline bool operator>=(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) >= rhs; }
-	inline bool operator>=(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) >= as_a_size_t(rhs); }
-	inline bool operator>=(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs >= as_a_size_t(rhs); }
-	inline bool operator==(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) == rhs; }
-	inline bool operator==(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) == rhs; }
-	inline bool operator==(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) == rhs; }
-	inline bool operator==(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) == as_a_size_t(rhs); }
-	inline bool operator==(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) == rhs; }
-	inline bool operator==(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) == as_a_size_t(rhs); }
-	inline bool operator==(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs == as_a_size_t(rhs); }
-	inline bool operator!=(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) != rhs; }
-	inline bool operator!=(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) != rhs; }
-	inline bool operator!=(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) != rhs; }
-	inline bool operator!=(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) != as_a_size_t(rhs); }
-	inline bool operator!=(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) != rhs; }
-	inline bool operator!=(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) != as_a_size_t(rhs); }
-	inline bool operator!=(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs != as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator+(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); rhs.assert_initialized(); return CSize_t(lhs) + rhs; }
+	inline MSE_CONSTEXPR14 CSize_t operator+(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) + rhs; }
+	inline MSE_CONSTEXPR14 CInt operator+(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) + rhs; }
+	inline MSE_CONSTEXPR14 CInt operator+(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) + as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator+(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs + as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator-(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) - rhs; }
+	inline MSE_CONSTEXPR14 CInt operator-(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) - rhs; }
+	inline MSE_CONSTEXPR14 CInt operator-(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) - rhs; }
+	inline MSE_CONSTEXPR14 CInt operator-(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) - as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator-(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs - as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator*(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) * rhs; }
+	inline MSE_CONSTEXPR14 CSize_t operator*(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) * rhs; }
+	inline MSE_CONSTEXPR14 CInt operator*(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) * rhs; }
+	inline MSE_CONSTEXPR14 CInt operator*(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) * as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator*(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs * as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator/(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) / rhs; }
+	inline MSE_CONSTEXPR14 CSize_t operator/(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) / rhs; }
+	inline MSE_CONSTEXPR14 CInt operator/(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) / rhs; }
+	inline MSE_CONSTEXPR14 CInt operator/(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) / as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 CInt operator/(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs / as_a_size_t(rhs); }
+
+	inline MSE_CONSTEXPR14 bool operator<(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) < rhs; }
+	inline MSE_CONSTEXPR14 bool operator<(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) < rhs; }
+	inline MSE_CONSTEXPR14 bool operator<(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) < rhs; }
+	inline MSE_CONSTEXPR14 bool operator<(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) < as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator<(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) < rhs; }
+	inline MSE_CONSTEXPR14 bool operator<(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) < as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator<(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs < as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator>(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) > rhs; }
+	inline MSE_CONSTEXPR14 bool operator>(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) > rhs; }
+	inline MSE_CONSTEXPR14 bool operator>(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) > rhs; }
+	inline MSE_CONSTEXPR14 bool operator>(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) > as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator>(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) > rhs; }
+	inline MSE_CONSTEXPR14 bool operator>(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) > as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator>(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs > as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator<=(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) <= rhs; }
+	inline MSE_CONSTEXPR14 bool operator<=(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) <= rhs; }
+	inline MSE_CONSTEXPR14 bool operator<=(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) <= rhs; }
+	inline MSE_CONSTEXPR14 bool operator<=(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) <= as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator<=(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) <= rhs; }
+	inline MSE_CONSTEXPR14 bool operator<=(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) <= as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator<=(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs <= as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator>=(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) >= rhs; }
+	inline MSE_CONSTEXPR14 bool operator>=(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) >= rhs; }
+	inline MSE_CONSTEXPR14 bool operator>=(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) >= rhs; }
+	inline MSE_CONSTEXPR14 bool operator>=(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) >= as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator>=(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) >= rhs; }
+	inline MSE_CONSTEXPR14 bool operator>=(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) >= as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator>=(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs >= as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator==(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) == rhs; }
+	inline MSE_CONSTEXPR14 bool operator==(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) == rhs; }
+	inline MSE_CONSTEXPR14 bool operator==(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) == rhs; }
+	inline MSE_CONSTEXPR14 bool operator==(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) == as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator==(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) == rhs; }
+	inline MSE_CONSTEXPR14 bool operator==(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) == as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator==(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs == as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator!=(size_t lhs, const CInt &rhs) { rhs.assert_initialized(); return CSize_t(lhs) != rhs; }
+	inline MSE_CONSTEXPR14 bool operator!=(size_t lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CSize_t(lhs) != rhs; }
+	inline MSE_CONSTEXPR14 bool operator!=(int lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) != rhs; }
+	inline MSE_CONSTEXPR14 bool operator!=(int lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) != as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator!=(long long lhs, const CInt &rhs) { rhs.assert_initialized(); return CInt(lhs) != rhs; }
+	inline MSE_CONSTEXPR14 bool operator!=(long long lhs, const CSize_t &rhs) { rhs.assert_initialized(); return CInt(lhs) != as_a_size_t(rhs); }
+	inline MSE_CONSTEXPR14 bool operator!=(const CInt &lhs, const CSize_t &rhs) { rhs.assert_initialized(); return lhs != as_a_size_t(rhs); }
+#endif /*MSE_PRIMITIVES_DISABLED*/
+
+	namespace impl {
+		template<class _TCheckingPolicy> class TPolicyPrimitives;
+		template<> class TPolicyPrimitives<CCheckedPolicy> {
+		public:
+			typedef CBool bool_type;
+			typedef CInt int_type;
+			typedef CSize_t size_type;
+		};
+		template<> class TPolicyPrimitives<CUncheckedPolicy> {
+		public:
+			typedef bool bool_type;
+			typedef MSE_CINT_BASE_INTEGER_TYPE int_type;
+			typedef size_t size_type;
+		};
+	}
+	/* CInt, CSize_t and CBool convert implicitly (with range checking where appropriate) to and from their native
+	counterparts, so no explicit conversion is needed at the boundary. */
+	template<class _TCheckingPolicy = CCheckedPolicy> using TPolicyBool = typename impl::TPolicyPrimitives<_TCheckingPolicy>::bool_type;
+	template<class _TCheckingPolicy = CCheckedPolicy> using TPolicyInt = typename impl::TPolicyPrimitives<_TCheckingPolicy>::int_type;
+	template<class _TCheckingPolicy = CCheckedPolicy> using TPolicySize_t = typename impl::TPolicyPrimitives<_TCheckingPolicy>::size_type;
+
+	/* The "bulk" functions below perform operations on contiguous ranges of CInts or CSize_ts (or when the primitives are
+	"disabled", their native counterparts). Rather than checking for overflow and range errors element by element, they
+	accumulate the information needed to detect them in a (vectorizable) branch free manner and check it once at the end.
+	If an error is detected, a primitives_range_error exception is thrown, in which case the contents of any output range
+	are unspecified. */
+	namespace impl {
+		namespace bulk {
+#ifndef MSE_PRIMITIVES_DISABLED
+			inline MSE_CINT_BASE_INTEGER_TYPE raw_value(const CInt& x) { x.assert_initialized(); return x.m_val; }
+			inline size_t raw_value(const CSize_t& x) { x.assert_initialized(); return x.m_val; }
+			inline void set_raw_value(CInt& x, MSE_CINT_BASE_INTEGER_TYPE val) { x.note_value_assignment(); x.m_val = val; }
+			inline void set_raw_value(CSize_t& x, size_t val) { x.note_value_assignment(); x.m_val = val; }
+#else /*MSE_PRIMITIVES_DISABLED*/
+			template<typename _Ty>
+			_Ty raw_value(const _Ty& x) { return x; }
+			template<typename _Ty>
+			void set_raw_value(_Ty& x, _Ty val) { x = val; }
 #endif /*MSE_PRIMITIVES_DISABLED*/
 
+			template<typename _TInt>
+			struct TBase {
+				typedef typename std::remove_cv<typename std::remove_reference<decltype(raw_value(std::declval<const _TInt&>()))>::type>::type type;
+			};
+
+			inline void throw_range_error() {
+				MSE_THROW(primitives_range_error("range error - the result of a bulk operation is out of range of the target (integer) type"));
+			}
+
+			/* Element-wise addition (with wraparound) that returns a value whose most significant bit is set on overflow. */
+			template<typename _TUnsigned>
+			_TUnsigned add_with_overflow_bit(_TUnsigned a, _TUnsigned b, _TUnsigned& result, std::true_type/*is_signed*/) {
+				result = a + b;
+				return ((~(a ^ b)) & (a ^ result));
+			}
+			template<typename _TUnsigned>
+			_TUnsigned add_with_overflow_bit(_TUnsigned a, _TUnsigned b, _TUnsigned& result, std::false_type/*is_signed*/) {
+				result = a + b;
+				return (_TUnsigned(result < a) << (std::numeric_limits<_TUnsigned>::digits - 1));
+			}
+
+			template<typename _Ty>
+			bool multiply_overflows(_Ty a, _Ty b, _Ty& result) {
+#if defined(__GNUC__) || defined(__clang__)
+				return __builtin_mul_overflow(a, b, &result);
+#else // defined(__GNUC__) || defined(__clang__)
+				typedef typename std::make_unsigned<_Ty>::type _TUnsigned;
+				result = _Ty(_TUnsigned(a) * _TUnsigned(b));
+				if (0 == a) {
+					return false;
+				}
+				if (std::numeric_limits<_Ty>::is_signed && (_Ty(-1) == a)) {
+					return (std::numeric_limits<_Ty>::lowest() == b);
+				}
+				return ((result / a) != b);
+#endif // defined(__GNUC__) || defined(__clang__)
+			}
+
+			/* Sums blocks of integers no wider than 32 bits in (wider) 64 bit accumulators. */
+			template<typename _TInt>
+			typename TBase<_TInt>::type sum(const _TInt* first, size_t count, std::true_type/*is_narrow*/) {
+				typedef typename TBase<_TInt>::type _Ty;
+				typedef typename std::conditional<std::numeric_limits<_Ty>::is_signed, long long, unsigned long long>::type _TAccumulator;
+				_TAccumulator total = 0;
+				for (size_t i = 0; i < count; i += 1) {
+					total += _TAccumulator(raw_value(first[i]));
+				}
+				if ((_TAccumulator(std::numeric_limits<_Ty>::max()) < total) || (_TAccumulator(std::numeric_limits<_Ty>::lowest()) > total)) {
+					throw_range_error();
+				}
+				return _Ty(total);
+			}
+			/* Wider integers are split into 32 bit "high" and "low" halves that are summed separately, and then recombined. */
+			template<typename _TInt>
+			typename TBase<_TInt>::type sum(const _TInt* first, size_t count, std::false_type/*is_narrow*/) {
+				typedef typename TBase<_TInt>::type _Ty;
+				typedef typename std::make_unsigned<_Ty>::type _TUnsigned;
+				/* The high halves of unsigned integers fit (with room to spare) in a signed accumulator too. */
+				typedef long long _THighAccumulator;
+				static const int sc_half_width = 32;
+				static const _TUnsigned sc_low_mask = 0xffffffff;
+				/* Ensures that neither accumulator can overflow within a block. */
+				static const size_t sc_max_block_size = size_t(1) << 30;
+				static const long long sc_max_intermediate_high_total = 1LL << 61;
+
+				_THighAccumulator high_total = 0;
+				unsigned long long low_total = 0;
+				while (0 < count) {
+					const size_t block_size = std::min(count, sc_max_block_size);
+					_THighAccumulator block_high_total = 0;
+					unsigned long long block_low_total = 0;
+					for (size_t i = 0; i < block_size; i += 1) {
+						const _Ty val = raw_value(first[i]);
+						block_high_total += _THighAccumulator(val >> sc_half_width);
+						block_low_total += (_TUnsigned(val) & sc_low_mask);
+					}
+					/* Normalize so that the low total fits in the low half. */
+					low_total += block_low_total;
+					high_total += block_high_total + _THighAccumulator(low_total >> sc_half_width);
+					low_total &= sc_low_mask;
+
+					if ((sc_max_intermediate_high_total < high_total) || (-sc_max_intermediate_high_total > high_total)) {
+						/* The (exact) intermediate sum is so far out of range that continuing could overflow the accumulator. */
+						throw_range_error();
+					}
+					first += block_size;
+					count -= block_size;
+				}
+				const _THighAccumulator high_max = _THighAccumulator(std::numeric_limits<_Ty>::max() >> sc_half_width);
+				const _THighAccumulator high_lowest = _THighAccumulator(std::numeric_limits<_Ty>::lowest() >> sc_half_width);
+				if ((high_max < high_total) || (high_lowest > high_total)) {
+					throw_range_error();
+				}
+				return _Ty((_TUnsigned(high_total) << sc_half_width) | _TUnsigned(low_total));
+			}
+		}
+	}
+
+	/* Returns the sum of the elements in the range. The sum is calculated exactly, so only the final result needs to be
+	representable. */
+	template<typename _TInt>
+	_TInt bulk_sum(const _TInt* first, const _TInt* last) {
+		typedef typename impl::bulk::TBase<_TInt>::type _Ty;
+		_TInt retval;
+		impl::bulk::set_raw_value(retval, impl::bulk::sum(first, size_t(last - first), std::integral_constant<bool, (4 >= sizeof(_Ty))>()));
+		return retval;
+	}
+
+	/* Element-wise (d_first[i] = first1[i] + first2[i]) addition. Returns the end of the output range. */
+	template<typename _TInt>
+	_TInt* bulk_add(const _TInt* first1, const _TInt* last1, const _TInt* first2, _TInt* d_first) {
+		typedef typename impl::bulk::TBase<_TInt>::type _Ty;
+		typedef typename std::make_unsigned<_Ty>::type _TUnsigned;
+		const size_t count = size_t(last1 - first1);
+		_TUnsigned overflow_bits = 0;
+		for (size_t i = 0; i < count; i += 1) {
+			_TUnsigned result;
+			overflow_bits |= impl::bulk::add_with_overflow_bit(_TUnsigned(impl::bulk::raw_value(first1[i])), _TUnsigned(impl::bulk::raw_value(first2[i]))
+				, result, std::integral_constant<bool, std::numeric_limits<_Ty>::is_signed>());
+			impl::bulk::set_raw_value(d_first[i], _Ty(result));
+		}
+		if (overflow_bits >> (std::numeric_limits<_TUnsigned>::digits - 1)) {
+			impl::bulk::throw_range_error();
+		}
+		return d_first + count;
+	}
+
+	/* Element-wise (d_first[i] = first1[i] * first2[i]) multiplication. Returns the end of the output range. */
+	template<typename _TInt>
+	_TInt* bulk_multiply(const _TInt* first1, const _TInt* last1, const _TInt* first2, _TInt* d_first) {
+		typedef typename impl::bulk::TBase<_TInt>::type _Ty;
+		const size_t count = size_t(last1 - first1);
+		bool overflowed = false;
+		for (size_t i = 0; i < count; i += 1) {
+			_Ty result;
+			overflowed |= impl::bulk::multiply_overflows(impl::bulk::raw_value(first1[i]), impl::bulk::raw_value(first2[i]), result);
+			impl::bulk::set_raw_value(d_first[i], result);
+		}
+		if (overflowed) {
+			impl::bulk::throw_range_error();
+		}
+		return d_first + count;
+	}
+
+	/* Element-wise (d_first[i] = (first1[i] == first2[i])) comparison. Returns the end of the output range. */
+	template<typename _TInt, typename _TBoolOutputIt>
+	_TBoolOutputIt bulk_equal(const _TInt* first1, const _TInt* last1, const _TInt* first2, _TBoolOutputIt d_first) {
+		const size_t count = size_t(last1 - first1);
+		for (size_t i = 0; i < count; i += 1, ++d_first) {
+			(*d_first) = (impl::bulk::raw_value(first1[i]) == impl::bulk::raw_value(first2[i]));
+		}
+		return d_first;
+	}
+
+	/* Element-wise (d_first[i] = (first1[i] < first2[i])) comparison. Returns the end of the output range. */
+	template<typename _TInt, typename _TBoolOutputIt>
+	_TBoolOutputIt bulk_less(const _TInt* first1, const _TInt* last1, const _TInt* first2, _TBoolOutputIt d_first) {
+		const size_t count = size_t(last1 - first1);
+		for (size_t i = 0; i < count; i += 1, ++d_first) {
+			(*d_first) = (impl::bulk::raw_value(first1[i]) < impl::bulk::raw_value(first2[i]));
+		}
+		return d_first;
+	}
+
+	/* Copies a range of native integers into a range of CInts or CSize_ts. The range check is performed (just on the
+	minimum and maximum values) before anything is copied. Returns the end of the output range. */
+	template<typename _TNative, typename _TInt>
+	_TInt* bulk_copy_from_native(const _TNative* first, const _TNative* last, _TInt* d_first) {
+		typedef typename impl::bulk::TBase<_TInt>::type _Ty;
+		const size_t count = size_t(last - first);
+#ifndef MSE_PRIMITIVES_DISABLED
+		if (0 < count) {
+			_TNative min_val = first[0];
+			_TNative max_val = first[0];
+			for (size_t i = 1; i < count; i += 1) {
+				min_val = std::min(min_val, first[i]);
+				max_val = std::max(max_val, first[i]);
+			}
+			g_assign_check_range<_Ty, _TNative>(min_val);
+			g_assign_check_range<_Ty, _TNative>(max_val);
+		}
+#endif // !MSE_PRIMITIVES_DISABLED
+		for (size_t i = 0; i < count; i += 1) {
+			impl::bulk::set_raw_value(d_first[i], static_cast<_Ty>(first[i]));
+		}
+		return d_first + count;
+	}
+
+	/* Copies a range of CInts or CSize_ts into a range of native integers. The range check is performed (just on the
+	minimum and maximum values) before anything is copied. Returns the end of the output range. */
+	template<typename _TInt, typename _TNative>
+	_TNative* bulk_copy_to_native(const _TInt* first, const _TInt* last, _TNative* d_first) {
+		typedef typename impl::bulk::TBase<_TInt>::type _Ty;
+		const size_t count = size_t(last - first);
+#ifndef MSE_PRIMITIVES_DISABLED
+		if (0 < count) {
+			_Ty min_val = impl::bulk::raw_value(first[0]);
+			_Ty max_val = min_val;
+			for (size_t i = 1; i < count; i += 1) {
+				min_val = std::min(min_val, impl::bulk::raw_value(first[i]));
+				max_val = std::max(max_val, impl::bulk::raw_value(first[i]));
+			}
+			g_assign_check_range<_TNative, _Ty>(min_val);
+			g_assign_check_range<_TNative, _Ty>(max_val);
+		}
+#endif // !MSE_PRIMITIVES_DISABLED
+		for (size_t i = 0; i < count; i += 1) {
+			d_first[i] = static_cast<_TNative>(impl::bulk::raw_value(first[i]));
+		}
+		return d_first + count;
+	}
+
 	static void s_type_test1() {
 #ifdef MSE_SELF_TESTS
 		CInt i1(3);
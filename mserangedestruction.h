@@ -0,0 +1,43 @@
+// Copyright (c) 2015 Noah Lopez
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#ifndef MSERANGEDESTRUCTION_H_
+#define MSERANGEDESTRUCTION_H_
+
+#include <type_traits>
+
+namespace mse {
+	namespace impl {
+		template<typename...> class TVoid { public: typedef void type; };
+
+		/* Element types (like TRelaxedRegisteredObj) that can be more efficiently destroyed in bulk provide a nested
+		"range_destruction_notifier_type". An instance of it is (default) constructed, then "notified" (via its
+		notify_range_destruction(first, last) member function) before a contiguous range of elements is destroyed, and is
+		itself destroyed after the elements are. The library's containers use this when clearing, shrinking or destroying. */
+		template<class _Ty, class = void>
+		class THasRangeDestructionNotifier : public std::false_type {};
+		template<class _Ty>
+		class THasRangeDestructionNotifier<_Ty, typename TVoid<typename _Ty::range_destruction_notifier_type>::type> : public std::true_type {};
+
+		/* For containers whose elements are destroyed by an (implicitly invoked) member destructor. Base class destructors
+		are invoked after member destructors, so the notifier can be held here. This (empty) base class takes no space when
+		the element type has no notifier. */
+		template<class _Ty, bool = THasRangeDestructionNotifier<_Ty>::value>
+		class TRangeDestructionNotifierBase {
+		protected:
+			void notify_range_destruction(const _Ty*, const _Ty*) {}
+		};
+		template<class _Ty>
+		class TRangeDestructionNotifierBase<_Ty, true> {
+		protected:
+			void notify_range_destruction(const _Ty* first, const _Ty* last) { m_range_destruction_notifier.notify_range_destruction(first, last); }
+		private:
+			typename _Ty::range_destruction_notifier_type m_range_destruction_notifier;
+		};
+	}
+}
+
+#endif /*ndef MSERANGEDESTRUCTION_H_*/
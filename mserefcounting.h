@@ -14,6 +14,14 @@
 #include <utility>
 #include <cassert>
 #include <stdexcept>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <algorithm>
 
 
 /* for the test functions */
@@ -33,6 +41,241 @@
 
 namespace mse {
 
+	namespace impl {
+		/* CRefCountingSizeClassPool is a simple per-thread pool of memory blocks, segregated by (rounded up) size. Blocks are
+		carved out of larger chunks, and freed blocks are kept on (per-thread, per-size-class) free lists for reuse. A block
+		may be freed by a thread other than the one that allocated it, in which case it just joins the freeing thread's free
+		list. A thread's free list (of each size class) is capped at a couple of chunks' worth of blocks. The excess, and
+		when a thread exits, all its free blocks, are handed over to a global "orphanage", from which other threads will
+		adopt them before allocating new chunks. So in a producer/consumer arrangement, the blocks freed by the consumer
+		make their way back to the producer, and memory use stays bounded. Chunks are never returned to the system. */
+		class CRefCountingSizeClassPool {
+		public:
+			static const size_t sc_granularity = 16;
+			static const size_t sc_num_size_classes = 16;
+			static const size_t sc_max_pooled_size = sc_granularity * sc_num_size_classes;
+			static const size_t sc_target_chunk_size = 16 * 1024;
+
+			static void* allocate(size_t num_bytes) {
+				if ((sc_max_pooled_size < num_bytes) || (0 == num_bytes)) {
+					return ::operator new(num_bytes);
+				}
+				const auto size_class = size_class_of(num_bytes);
+				auto& state_ref = tl_state();
+				if (state_ref.m_has_exited) {
+					/* This thread's pool is gone (see deallocate()), and any free list we started now would never be
+					drained, so the block comes straight from the orphanage (or, if it has none, the global allocator). As
+					with any other block, it'll end up on some thread's free list (or in the orphanage) when it's freed. */
+					auto block_ptr = orphanage().adopt_one(size_class);
+					if (!block_ptr) {
+						block_ptr = static_cast<CFreeBlock*>(::operator new(block_size_of(size_class)));
+					}
+					return block_ptr;
+				}
+				auto& free_list_head_ref = state_ref.m_free_list_heads[size_class];
+				if (!free_list_head_ref) {
+					refill(size_class);
+				}
+				auto retval = free_list_head_ref;
+				free_list_head_ref = (*retval).m_next_ptr;
+				state_ref.m_free_list_sizes[size_class] -= 1;
+				return retval;
+			}
+			static void deallocate(void* ptr, size_t num_bytes) {
+				if ((sc_max_pooled_size < num_bytes) || (0 == num_bytes)) {
+					::operator delete(ptr);
+					return;
+				}
+				const auto size_class = size_class_of(num_bytes);
+				auto block_ptr = static_cast<CFreeBlock*>(ptr);
+				auto& state_ref = tl_state();
+				if (state_ref.m_has_exited) {
+					/* This thread's pool is gone (we're being called from the destructor of some other thread local or
+					static object), so the block goes straight to the orphanage. */
+					(*block_ptr).m_next_ptr = nullptr;
+					orphanage().donate(size_class, block_ptr, block_ptr, 1);
+					return;
+				}
+				if (!state_ref.m_exit_handler_registered) {
+					/* A thread that only frees blocks (and never allocates any) still needs to hand them over when it exits. */
+					register_exit_handler();
+				}
+				(*block_ptr).m_next_ptr = state_ref.m_free_list_heads[size_class];
+				state_ref.m_free_list_heads[size_class] = block_ptr;
+				auto& free_list_size_ref = state_ref.m_free_list_sizes[size_class];
+				free_list_size_ref += 1;
+				const auto num_blocks_per_chunk = num_blocks_per_chunk_of(size_class);
+				if (sc_max_free_list_chunks * num_blocks_per_chunk < free_list_size_ref) {
+					/* Donate a chunk's worth of the excess. */
+					auto head_ptr = state_ref.m_free_list_heads[size_class];
+					auto tail_ptr = nth_block(head_ptr, num_blocks_per_chunk - 1);
+					state_ref.m_free_list_heads[size_class] = (*tail_ptr).m_next_ptr;
+					(*tail_ptr).m_next_ptr = nullptr;
+					free_list_size_ref -= num_blocks_per_chunk;
+					orphanage().donate(size_class, head_ptr, tail_ptr, num_blocks_per_chunk);
+				}
+			}
+
+			/* The number of chunks allocated so far (by all threads). */
+			static size_t num_chunks_allocated() {
+				return s_num_chunks_allocated().load();
+			}
+
+		private:
+			struct CFreeBlock {
+				CFreeBlock* m_next_ptr;
+			};
+			static size_t size_class_of(size_t num_bytes) {
+				return (num_bytes - 1) / sc_granularity;
+			}
+			static size_t block_size_of(size_t size_class) {
+				return (size_class + 1) * sc_granularity;
+			}
+			static size_t num_blocks_per_chunk_of(size_t size_class) {
+				return std::max(size_t(8), sc_target_chunk_size / block_size_of(size_class));
+			}
+			/* A thread will hold on to at most this many chunks' worth of free blocks (of each size class). */
+			static const size_t sc_max_free_list_chunks = 2;
+
+			/* Returns the block n places after the given one. The list must be long enough. */
+			static CFreeBlock* nth_block(CFreeBlock* block_ptr, size_t n) {
+				for (size_t i = 0; i < n; i += 1) {
+					block_ptr = (*block_ptr).m_next_ptr;
+				}
+				return block_ptr;
+			}
+
+			class COrphanage {
+			public:
+				void donate(size_t size_class, CFreeBlock* head_ptr, CFreeBlock* tail_ptr, size_t num_blocks) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					(*tail_ptr).m_next_ptr = m_free_list_heads[size_class];
+					m_free_list_heads[size_class] = head_ptr;
+					m_free_list_sizes[size_class] += num_blocks;
+				}
+				/* Takes (up to) a chunk's worth of blocks. Returns the number of blocks taken. */
+				size_t adopt(size_t size_class, CFreeBlock*& head_ptr_ref) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					auto& available_ref = m_free_list_sizes[size_class];
+					const auto num_blocks = std::min(available_ref, num_blocks_per_chunk_of(size_class));
+					head_ptr_ref = nullptr;
+					if (0 != num_blocks) {
+						head_ptr_ref = m_free_list_heads[size_class];
+						auto tail_ptr = nth_block(head_ptr_ref, num_blocks - 1);
+						m_free_list_heads[size_class] = (*tail_ptr).m_next_ptr;
+						(*tail_ptr).m_next_ptr = nullptr;
+						available_ref -= num_blocks;
+					}
+					return num_blocks;
+				}
+				/* Takes a single block, if one is available. */
+				CFreeBlock* adopt_one(size_t size_class) {
+					std::lock_guard<std::mutex> lock1(m_mutex);
+					auto head_ptr = m_free_list_heads[size_class];
+					if (head_ptr) {
+						m_free_list_heads[size_class] = (*head_ptr).m_next_ptr;
+						m_free_list_sizes[size_class] -= 1;
+					}
+					return head_ptr;
+				}
+			private:
+				std::mutex m_mutex;
+				CFreeBlock* m_free_list_heads[sc_num_size_classes] = {};
+				size_t m_free_list_sizes[sc_num_size_classes] = {};
+			};
+			/* The orphanage is intentionally never destroyed, so it remains usable during static destruction. */
+			static COrphanage& orphanage() {
+				static COrphanage* s_orphanage_ptr = new COrphanage();
+				return *s_orphanage_ptr;
+			}
+
+			/* The per-thread state is trivially destructible, so it remains accessible throughout the thread's lifetime. A
+			separate thread local object with a destructor donates the free lists when the thread exits. */
+			struct CThreadState {
+				CFreeBlock* m_free_list_heads[sc_num_size_classes];
+				size_t m_free_list_sizes[sc_num_size_classes];
+				bool m_exit_handler_registered;
+				bool m_has_exited;
+			};
+			class CThreadExitHandler {
+			public:
+				~CThreadExitHandler() {
+					auto& state_ref = tl_state();
+					for (size_t size_class = 0; size_class < sc_num_size_classes; size_class += 1) {
+						auto head_ptr = state_ref.m_free_list_heads[size_class];
+						if (head_ptr) {
+							const auto num_blocks = state_ref.m_free_list_sizes[size_class];
+							orphanage().donate(size_class, head_ptr, nth_block(head_ptr, num_blocks - 1), num_blocks);
+							state_ref.m_free_list_heads[size_class] = nullptr;
+							state_ref.m_free_list_sizes[size_class] = 0;
+						}
+					}
+					state_ref.m_has_exited = true;
+				}
+			};
+			static void register_exit_handler() {
+				/* Ensures the exit handler is constructed (and so will be destroyed) for this thread. */
+				thread_local CThreadExitHandler tl_exit_handler;
+				(void)tl_exit_handler;
+				tl_state().m_exit_handler_registered = true;
+			}
+			static std::atomic<size_t>& s_num_chunks_allocated() {
+				static std::atomic<size_t> s_count{ 0 };
+				return s_count;
+			}
+			static CThreadState& tl_state() {
+				thread_local CThreadState tl_thread_state = {};
+				return tl_thread_state;
+			}
+
+			static void refill(size_t size_class) {
+				auto& state_ref = tl_state();
+				if (!state_ref.m_exit_handler_registered) {
+					register_exit_handler();
+				}
+
+				auto& free_list_head_ref = state_ref.m_free_list_heads[size_class];
+				auto& free_list_size_ref = state_ref.m_free_list_sizes[size_class];
+				free_list_size_ref = orphanage().adopt(size_class, free_list_head_ref);
+				if (free_list_head_ref) {
+					return;
+				}
+				const auto block_size = block_size_of(size_class);
+				const auto num_blocks = num_blocks_per_chunk_of(size_class);
+				auto chunk_ptr = static_cast<unsigned char*>(::operator new(num_blocks * block_size));
+				s_num_chunks_allocated().fetch_add(1, std::memory_order_relaxed);
+				for (size_t i = num_blocks; 0 < i; i -= 1) {
+					auto block_ptr = reinterpret_cast<CFreeBlock*>(chunk_ptr + ((i - 1) * block_size));
+					(*block_ptr).m_next_ptr = free_list_head_ref;
+					free_list_head_ref = block_ptr;
+				}
+				free_list_size_ref = num_blocks;
+			}
+		};
+	}
+
+	/* TRefCountingPoolAllocator is a (stateless) allocator that uses the per-thread size-class pool. It's suitable for use
+	with mse::allocate_refcounting<>() when large numbers of (small) objects are being created and destroyed. */
+	template<class _Ty>
+	class TRefCountingPoolAllocator {
+	public:
+		typedef _Ty value_type;
+
+		TRefCountingPoolAllocator() {}
+		template<class _Ty2> TRefCountingPoolAllocator(const TRefCountingPoolAllocator<_Ty2>&) {}
+
+		_Ty* allocate(size_t n) {
+			static_assert(alignof(_Ty) <= impl::CRefCountingSizeClassPool::sc_granularity, "over-aligned types are not supported - mse::TRefCountingPoolAllocator<>");
+			return static_cast<_Ty*>(impl::CRefCountingSizeClassPool::allocate(n * sizeof(_Ty)));
+		}
+		void deallocate(_Ty* ptr, size_t n) {
+			impl::CRefCountingSizeClassPool::deallocate(ptr, n * sizeof(_Ty));
+		}
+
+		template<class _Ty2> bool operator==(const TRefCountingPoolAllocator<_Ty2>&) const { return true; }
+		template<class _Ty2> bool operator!=(const TRefCountingPoolAllocator<_Ty2>&) const { return false; }
+	};
+
 #ifdef MSE_REFCOUNTINGPOINTER_DISABLED
 	template <class X> using TRefCountingPointer = std::shared_ptr<X>;
 	template <class X> using TRefCountingNotNullPointer = std::shared_ptr<X>;
@@ -45,6 +288,23 @@ namespace mse {
 	TRefCountingFixedPointer<X> make_refcounting(Args&&... args) {
 		return std::make_shared<X>(std::forward<Args>(args)...);
 	}
+	template <class X, class _TAlloc, class... Args>
+	TRefCountingFixedPointer<X> allocate_refcounting(const _TAlloc& alloc, Args&&... args) {
+		return std::allocate_shared<X>(alloc, std::forward<Args>(args)...);
+	}
+
+	template <class X> using TAtomicRefCountingPointer = std::shared_ptr<X>;
+	template <class X> using TAtomicRefCountingNotNullPointer = std::shared_ptr<X>;
+	template <class X> using TAtomicRefCountingFixedPointer = std::shared_ptr<X>;
+	template <class X> using TAtomicRefCountingConstPointer = std::shared_ptr<const X>;
+	template <class X> using TAtomicRefCountingNotNullConstPointer = std::shared_ptr<const X>;
+	template <class X> using TAtomicRefCountingFixedConstPointer = std::shared_ptr<const X>;
+
+	template <class X, class... Args>
+	TAtomicRefCountingFixedPointer<X> make_atomic_refcounting(Args&&... args) {
+		return std::make_shared<X>(std::forward<Args>(args)...);
+	}
+	inline void merge_deferred_atomic_refcounting_releases() {}
 #else /*MSE_REFCOUNTINGPOINTER_DISABLED*/
 
 	class refcounting_null_dereference_error : public std::logic_error { public:
@@ -56,17 +316,23 @@ namespace mse {
 	template<typename _Ty> class TRefCountingNotNullConstPointer;
 	template<typename _Ty> class TRefCountingFixedConstPointer;
 
+	/* CRefCounter is the (non-polymorphic) header of the dynamically allocated "control block" that holds the target object. The
+	pointers themselves hold the (appropriately typed) address of the target object, so the control block is only accessed when
+	the reference count changes. Destruction is dispatched through a (single) stored function pointer rather than a vtable. */
 	class CRefCounter {
-	private:
-		int m_counter;
-
 	public:
-		CRefCounter() : m_counter(1) {}
-		virtual ~CRefCounter() {}
+		typedef void(*destroy_fn_t)(CRefCounter*);
+
+		explicit CRefCounter(destroy_fn_t destroy_fn) : m_destroy_fn(destroy_fn), m_counter(1) {}
 		void increment() { m_counter++; }
 		void decrement() { assert(0 <= m_counter); m_counter--; }
 		int use_count() const { return m_counter; }
-		virtual void* target_obj_address() const = 0;
+		/* Destroys and deallocates the (dynamically allocated) control block (including the target object). */
+		void destroy() { m_destroy_fn(this); }
+
+	private:
+		destroy_fn_t m_destroy_fn;
+		int m_counter;
 	};
 
 	template<class Y>
@@ -75,11 +341,63 @@ namespace mse {
 		Y m_object;
 
 		template<class ... Args>
-		TRefWithTargetObj(Args && ...args) : m_object(args...) {}
+		TRefWithTargetObj(Args && ...args) : CRefCounter(&s_delete), m_object(std::forward<Args>(args)...) {}
 
 		void* target_obj_address() const {
 			return const_cast<void *>(static_cast<const void *>(std::addressof(m_object)));
 		}
+
+	protected:
+		/* Used by derived classes that need to be destroyed some other way. */
+		class CCustomDestroyFn {
+		public:
+			explicit CCustomDestroyFn(destroy_fn_t destroy_fn) : m_destroy_fn(destroy_fn) {}
+			destroy_fn_t m_destroy_fn;
+		};
+		template<class ... Args>
+		TRefWithTargetObj(CCustomDestroyFn custom_destroy_fn, Args && ...args) : CRefCounter(custom_destroy_fn.m_destroy_fn), m_object(std::forward<Args>(args)...) {}
+
+	private:
+		static void s_delete(CRefCounter* ref_counter_ptr) {
+			delete static_cast<TRefWithTargetObj*>(ref_counter_ptr);
+		}
+	};
+
+	/* TRefWithTargetObjAndAllocator is used (by mse::allocate_refcounting<>()) when the object is allocated with a given
+	allocator, in which case it has to be deallocated with (a copy of) that allocator, rather than deleted. */
+	template<class Y, class _TAlloc>
+	class TRefWithTargetObjAndAllocator : public TRefWithTargetObj<Y> {
+	public:
+		typedef typename std::allocator_traits<_TAlloc>::template rebind_alloc<TRefWithTargetObjAndAllocator> allocator_type;
+		typedef std::allocator_traits<allocator_type> allocator_traits_type;
+
+		template<class ... Args>
+		TRefWithTargetObjAndAllocator(const allocator_type& alloc, Args && ...args)
+			: TRefWithTargetObj<Y>(typename TRefWithTargetObj<Y>::CCustomDestroyFn(&s_destroy), std::forward<Args>(args)...), m_allocator(alloc) {}
+
+		template<class ... Args>
+		static TRefWithTargetObjAndAllocator* allocate(const _TAlloc& alloc, Args && ...args) {
+			allocator_type l_allocator(alloc);
+			auto ptr = allocator_traits_type::allocate(l_allocator, 1);
+			try {
+				::new (static_cast<void*>(std::addressof(*ptr))) TRefWithTargetObjAndAllocator(l_allocator, std::forward<Args>(args)...);
+			}
+			catch (...) {
+				allocator_traits_type::deallocate(l_allocator, ptr, 1);
+				throw;
+			}
+			return std::addressof(*ptr);
+		}
+
+	private:
+		static void s_destroy(CRefCounter* ref_counter_ptr) {
+			auto this_ptr = static_cast<TRefWithTargetObjAndAllocator*>(ref_counter_ptr);
+			allocator_type l_allocator(std::move((*this_ptr).m_allocator));
+			(*this_ptr).~TRefWithTargetObjAndAllocator();
+			allocator_traits_type::deallocate(l_allocator, this_ptr, 1);
+		}
+
+		allocator_type m_allocator;
 	};
 
 	/* Some code originally came from this stackoverflow post:
@@ -93,23 +411,45 @@ namespace mse {
 	template <class X>
 	class TRefCountingPointer {
 	public:
-		TRefCountingPointer() : m_ref_with_target_obj_ptr(nullptr) {}
-		TRefCountingPointer(std::nullptr_t) : m_ref_with_target_obj_ptr(nullptr) {}
+		TRefCountingPointer() : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
+		TRefCountingPointer(std::nullptr_t) : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
 		~TRefCountingPointer() {
 			release();
 		}
 		TRefCountingPointer(const TRefCountingPointer& r) {
-			acquire(r.m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+		}
+		TRefCountingPointer(TRefCountingPointer&& r) : m_ref_with_target_obj_ptr(r.m_ref_with_target_obj_ptr), m_target_obj_ptr(r.m_target_obj_ptr) {
+			r.m_ref_with_target_obj_ptr = nullptr;
+			r.m_target_obj_ptr = nullptr;
+		}
+		/* "Not null" pointers must not be left null, so "moving" one is just a copy. */
+		TRefCountingPointer(TRefCountingNotNullPointer<X>&& r) {
+			const TRefCountingPointer& r_base_cref = r;
+			acquire(r_base_cref.m_ref_with_target_obj_ptr, r_base_cref.m_target_obj_ptr);
 		}
 		operator bool() const { return nullptr != get(); }
 		void clear() { (*this) = TRefCountingPointer<X>(nullptr); }
 		TRefCountingPointer& operator=(const TRefCountingPointer& r) {
 			if (this != &r) {
 				auto_release keep(m_ref_with_target_obj_ptr);
-				acquire(r.m_ref_with_target_obj_ptr);
+				acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 			}
 			return *this;
 		}
+		TRefCountingPointer& operator=(TRefCountingPointer&& r) {
+			if (this != &r) {
+				auto_release keep(m_ref_with_target_obj_ptr);
+				m_ref_with_target_obj_ptr = r.m_ref_with_target_obj_ptr;
+				m_target_obj_ptr = r.m_target_obj_ptr;
+				r.m_ref_with_target_obj_ptr = nullptr;
+				r.m_target_obj_ptr = nullptr;
+			}
+			return *this;
+		}
+		TRefCountingPointer& operator=(TRefCountingNotNullPointer<X>&& r) {
+			return operator=(static_cast<const TRefCountingPointer&>(r));
+		}
 		bool operator<(const TRefCountingPointer& r) const {
 			return get() < r.get();
 		}
@@ -128,12 +468,12 @@ namespace mse {
 		*/
 		template <class Y> friend class TRefCountingPointer;
 		template <class Y> TRefCountingPointer(const TRefCountingPointer<Y>& r) {
-			acquire(r.m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 		}
 		template <class Y> TRefCountingPointer& operator=(const TRefCountingPointer<Y>& r) {
 			if (this != &r) {
 				auto_release keep(m_ref_with_target_obj_ptr);
-				acquire(r.m_ref_with_target_obj_ptr);
+				acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 			}
 			return *this;
 		}
@@ -149,14 +489,12 @@ namespace mse {
 #endif // !MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
 
 		X& operator*() const {
-			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return (*x_ptr);
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingPointer")); }
+			return (*m_target_obj_ptr);
 		}
 		X* operator->() const {
-			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return x_ptr;
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingPointer")); }
+			return m_target_obj_ptr;
 		}
 		bool unique() const {
 			return (m_ref_with_target_obj_ptr ? (m_ref_with_target_obj_ptr->use_count() == 1) : true);
@@ -171,22 +509,18 @@ namespace mse {
 
 	protected:
 		X* get() const {
-			if (!m_ref_with_target_obj_ptr) {
-				return nullptr;
-			}
-			else {
-				X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-				return x_ptr;
-			}
+			return m_target_obj_ptr;
 		}
 
 	private:
 		explicit TRefCountingPointer(TRefWithTargetObj<X>* p/* = nullptr*/) {
 			m_ref_with_target_obj_ptr = p;
+			m_target_obj_ptr = p ? std::addressof(p->m_object) : nullptr;
 		}
 
-		void acquire(CRefCounter* c) {
+		void acquire(CRefCounter* c, X* target_obj_ptr) {
 			m_ref_with_target_obj_ptr = c;
+			m_target_obj_ptr = target_obj_ptr;
 			if (c) { c->increment(); }
 		}
 
@@ -204,7 +538,7 @@ namespace mse {
 			// decrement the count, delete if it is nullptr
 			if (ref_with_target_obj_ptr) {
 				if (1 == ref_with_target_obj_ptr->use_count()) {
-					delete ref_with_target_obj_ptr;
+					ref_with_target_obj_ptr->destroy();
 				}
 				else {
 					ref_with_target_obj_ptr->decrement();
@@ -214,6 +548,8 @@ namespace mse {
 		}
 
 		CRefCounter* m_ref_with_target_obj_ptr;
+		/* The (cached) address of the target object (which may be a base class subobject of the object in the control block). */
+		X* m_target_obj_ptr;
 
 		friend class TRefCountingNotNullPointer<X>;
 		friend class TRefCountingConstPointer<X>;
@@ -257,6 +593,12 @@ namespace mse {
 			TRefCountingFixedPointer retval(new_ptr);
 			return retval;
 		}
+		template <class _TAlloc, class... Args>
+		static TRefCountingFixedPointer allocate(const _TAlloc& alloc, Args&&... args) {
+			auto new_ptr = TRefWithTargetObjAndAllocator<_Ty, _TAlloc>::allocate(alloc, std::forward<Args>(args)...);
+			TRefCountingFixedPointer retval(new_ptr);
+			return retval;
+		}
 
 	private:
 		explicit TRefCountingFixedPointer(TRefWithTargetObj<_Ty>* p/* = nullptr*/) : TRefCountingNotNullPointer<_Ty>(p) {}
@@ -272,35 +614,40 @@ namespace mse {
 	TRefCountingFixedPointer<X> make_refcounting(Args&&... args) {
 		return TRefCountingFixedPointer<X>::make(std::forward<Args>(args)...);
 	}
+	/* Like make_refcounting<>(), but the object (and its reference count) is allocated using the given allocator. */
+	template <class X, class _TAlloc, class... Args>
+	TRefCountingFixedPointer<X> allocate_refcounting(const _TAlloc& alloc, Args&&... args) {
+		return TRefCountingFixedPointer<X>::allocate(alloc, std::forward<Args>(args)...);
+	}
 
 
 	template <class X>
 	class TRefCountingConstPointer {
 	public:
-		TRefCountingConstPointer() : m_ref_with_target_obj_ptr(nullptr) {}
-		TRefCountingConstPointer(std::nullptr_t) : m_ref_with_target_obj_ptr(nullptr) {}
+		TRefCountingConstPointer() : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
+		TRefCountingConstPointer(std::nullptr_t) : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
 		~TRefCountingConstPointer() {
 			release();
 		}
 		TRefCountingConstPointer(const TRefCountingConstPointer& r) {
-			acquire(r.m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 		}
 		TRefCountingConstPointer(const TRefCountingPointer<X>& r) {
-			acquire(r.m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 		}
 		operator bool() const { return nullptr != get(); }
 		void clear() { (*this) = TRefCountingConstPointer<X>(nullptr); }
 		TRefCountingConstPointer& operator=(const TRefCountingConstPointer& r) {
 			if (this != &r) {
 				auto_release keep(m_ref_with_target_obj_ptr);
-				acquire(r.m_ref_with_target_obj_ptr);
+				acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 			}
 			return *this;
 		}
 		TRefCountingConstPointer& operator=(const TRefCountingPointer<X>& r) {
 			/*if (this != &r) */{
 				auto_release keep(m_ref_with_target_obj_ptr);
-				acquire(r.m_ref_with_target_obj_ptr);
+				acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 			}
 			return *this;
 		}
@@ -322,12 +669,12 @@ namespace mse {
 		*/
 		template <class Y> friend class TRefCountingConstPointer;
 		template <class Y> TRefCountingConstPointer(const TRefCountingConstPointer<Y>& r) {
-			acquire(r.m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 		}
 		template <class Y> TRefCountingConstPointer& operator=(const TRefCountingConstPointer<Y>& r) {
 			if (this != &r) {
 				auto_release keep(m_ref_with_target_obj_ptr);
-				acquire(r.m_ref_with_target_obj_ptr);
+				acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
 			}
 			return *this;
 		}
@@ -343,23 +690,15 @@ namespace mse {
 #endif // !MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
 
 		const X& operator*() const {
-			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingConstPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return (*x_ptr);
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingConstPointer")); }
+			return (*m_target_obj_ptr);
 		}
 		const X* operator->() const {
-			if (!m_ref_with_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingConstPointer")); }
-			X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-			return x_ptr;
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TRefCountingConstPointer")); }
+			return m_target_obj_ptr;
 		}
 		const X* get() const {
-			if (!m_ref_with_target_obj_ptr) {
-				return nullptr;
-			}
-			else {
-				X* x_ptr = static_cast<X*>(m_ref_with_target_obj_ptr->target_obj_address());
-				return x_ptr;
-			}
+			return m_target_obj_ptr;
 		}
 		bool unique() const {
 			return (m_ref_with_target_obj_ptr ? (m_ref_with_target_obj_ptr->use_count() == 1) : true);
@@ -368,10 +707,12 @@ namespace mse {
 	private:
 		explicit TRefCountingConstPointer(TRefWithTargetObj<X>* p/* = nullptr*/) {
 			m_ref_with_target_obj_ptr = p;
+			m_target_obj_ptr = p ? std::addressof(p->m_object) : nullptr;
 		}
 
-		void acquire(CRefCounter* c) {
+		void acquire(CRefCounter* c, const X* target_obj_ptr) {
 			m_ref_with_target_obj_ptr = c;
+			m_target_obj_ptr = target_obj_ptr;
 			if (c) { c->increment(); }
 		}
 
@@ -389,7 +730,7 @@ namespace mse {
 			// decrement the count, delete if it is nullptr
 			if (ref_with_target_obj_ptr) {
 				if (1 == ref_with_target_obj_ptr->use_count()) {
-					delete ref_with_target_obj_ptr;
+					ref_with_target_obj_ptr->destroy();
 				}
 				else {
 					ref_with_target_obj_ptr->decrement();
@@ -399,6 +740,7 @@ namespace mse {
 		}
 
 		CRefCounter* m_ref_with_target_obj_ptr;
+		const X* m_target_obj_ptr;
 
 		friend class TRefCountingNotNullConstPointer<X>;
 	};
@@ -442,6 +784,593 @@ namespace mse {
 		//const TRefCountingFixedConstPointer<_Ty>* operator&() const { return this; }
 	};
 
+	template<typename _Ty> class TAtomicRefCountingNotNullPointer;
+	template<typename _Ty> class TAtomicRefCountingFixedPointer;
+	template<typename _Ty> class TAtomicRefCountingConstPointer;
+	template<typename _Ty> class TAtomicRefCountingNotNullConstPointer;
+	template<typename _Ty> class TAtomicRefCountingFixedConstPointer;
+
+	class CAtomicRefCounter;
+	namespace impl {
+		/* Each thread that creates objects owned by "atomic" refcounting pointers gets a CAtomicRefCountingOwnerQueue. Other
+		threads use it to hand back objects whose reference count can only be determined by the owner thread (see
+		CAtomicRefCounter). The queue is itself reference counted (by the owner thread and by each of its objects), so it
+		outlives the thread if necessary. */
+		class CAtomicRefCountingOwnerQueue {
+		public:
+			static CAtomicRefCountingOwnerQueue* current_thread_queue_ptr() {
+				return tl_state().m_queue_ptr;
+			}
+			/* Returns nullptr if the current thread is exiting (i.e. its thread local objects are being destroyed). */
+			static CAtomicRefCountingOwnerQueue* current_thread_queue_ptr_create_if_necessary() {
+				auto& state_ref = tl_state();
+				if ((!state_ref.m_queue_ptr) && (!state_ref.m_has_exited)) {
+					/* Ensures the exit handler is constructed (and so will be destroyed) for this thread. */
+					thread_local CThreadExitHandler tl_exit_handler;
+					(void)tl_exit_handler;
+					state_ref.m_queue_ptr = new CAtomicRefCountingOwnerQueue();
+				}
+				return state_ref.m_queue_ptr;
+			}
+
+			void add_ref() {
+				m_num_refs.fetch_add(1, std::memory_order_relaxed);
+			}
+			void release_ref() {
+				if (1 == m_num_refs.fetch_sub(1, std::memory_order_acq_rel)) {
+					delete this;
+				}
+			}
+			/* Returns false if the owner thread has exited, in which case the caller is responsible for merging the counters. */
+			bool try_enqueue(CAtomicRefCounter* ref_counter_ptr) {
+				std::lock_guard<std::mutex> lock1(m_mutex);
+				if (m_owner_has_exited) {
+					return false;
+				}
+				m_pending_merges.push_back(ref_counter_ptr);
+				m_has_pending_merges.store(true, std::memory_order_release);
+				return true;
+			}
+			bool has_pending_merges() const {
+				return m_has_pending_merges.load(std::memory_order_acquire);
+			}
+			/* Must only be called from the owner thread. */
+			void process_pending_merges_if_any() {
+				if (has_pending_merges()) {
+					process_pending_merges(false);
+				}
+			}
+
+		private:
+			CAtomicRefCountingOwnerQueue() {}
+			void process_pending_merges(bool owner_is_exiting);
+
+			std::atomic<size_t> m_num_refs{ 1 };
+			std::atomic<bool> m_has_pending_merges{ false };
+			std::mutex m_mutex;
+			std::vector<CAtomicRefCounter*> m_pending_merges;
+			bool m_owner_has_exited = false;
+
+			/* The per-thread state is trivially destructible, so it remains accessible throughout the thread's lifetime. */
+			struct CThreadState {
+				CAtomicRefCountingOwnerQueue* m_queue_ptr;
+				bool m_has_exited;
+			};
+			class CThreadExitHandler {
+			public:
+				~CThreadExitHandler() {
+					auto& state_ref = tl_state();
+					auto queue_ptr = state_ref.m_queue_ptr;
+					state_ref.m_queue_ptr = nullptr;
+					state_ref.m_has_exited = true;
+					if (queue_ptr) {
+						(*queue_ptr).process_pending_merges(true);
+						(*queue_ptr).release_ref();
+					}
+				}
+			};
+			static CThreadState& tl_state() {
+				thread_local CThreadState tl_thread_state = {};
+				return tl_thread_state;
+			}
+		};
+	}
+
+	/* CAtomicRefCounter is the header of the control block used by the "atomic" refcounting pointers. It uses "biased"
+	reference counting. The thread that creates the object (the "owner" thread) adjusts a plain (non-atomic) counter, and
+	only other threads pay for atomic operations (on a separate, shared counter). The reference count is the sum of the two
+	counters.
+	When the biased counter reaches zero, the owner thread "merges" the counters by adding the biased count to the shared
+	counter and setting a flag, and from then on the owner thread uses the shared counter too. The control block is destroyed
+	when the merged shared counter reaches zero.
+	The shared counter goes negative when references obtained on the owner thread are released by other threads. The
+	(unmerged) reference count could be zero at that point, but only the owner thread can tell, so the first thread to take
+	the shared counter negative queues the object for the owner thread to merge later. The owner thread processes its queue
+	whenever it creates or releases a reference to one of its objects, when mse::merge_deferred_atomic_refcounting_releases()
+	is called, and when it exits. So the release of such objects may be deferred until then. */
+	class CAtomicRefCounter {
+	public:
+		typedef void(*destroy_fn_t)(CAtomicRefCounter*);
+
+		explicit CAtomicRefCounter(destroy_fn_t destroy_fn) : m_destroy_fn(destroy_fn)
+			, m_owner_queue_ptr(impl::CAtomicRefCountingOwnerQueue::current_thread_queue_ptr_create_if_necessary()) {
+			if (m_owner_queue_ptr) {
+				(*m_owner_queue_ptr).add_ref();
+				(*m_owner_queue_ptr).process_pending_merges_if_any();
+			}
+			else {
+				/* Objects created on an exiting thread just use the shared counter. */
+				m_biased_counter = 0;
+				m_owner_has_merged = true;
+				m_shared_state.store(sc_shared_count_unit | sc_merged_flag, std::memory_order_relaxed);
+			}
+		}
+		void increment() {
+			if (is_owner_thread() && (!m_owner_has_merged)) {
+				m_biased_counter += 1;
+			}
+			else {
+				m_shared_state.fetch_add(sc_shared_count_unit, std::memory_order_relaxed);
+			}
+		}
+		/* Decrements the reference count, and destroys the control block (including the target object) if it reaches zero. */
+		void decrement_and_destroy_if_unreferenced() {
+			if (is_owner_thread() && (!m_owner_has_merged) && (1 < m_biased_counter) && (!(*m_owner_queue_ptr).has_pending_merges())) {
+				/* The common case. */
+				m_biased_counter -= 1;
+				return;
+			}
+			slow_decrement();
+		}
+
+	private:
+		bool is_owner_thread() const {
+			return (m_owner_queue_ptr && (impl::CAtomicRefCountingOwnerQueue::current_thread_queue_ptr() == m_owner_queue_ptr));
+		}
+
+		void slow_decrement() {
+			if (is_owner_thread()) {
+				(*m_owner_queue_ptr).process_pending_merges_if_any();
+				if (!m_owner_has_merged) {
+					assert(1 <= m_biased_counter);
+					m_biased_counter -= 1;
+					if (0 == m_biased_counter) {
+						merge();
+					}
+					return;
+				}
+			}
+			shared_decrement();
+		}
+		/* Must only be called from the owner thread (or from any thread once the owner thread has exited). */
+		void merge() {
+			assert(!m_owner_has_merged);
+			m_owner_has_merged = true;
+			const auto addend = (long long)(m_biased_counter) * sc_shared_count_unit + sc_merged_flag;
+			m_biased_counter = 0;
+			const auto new_shared_state = m_shared_state.fetch_add(addend, std::memory_order_acq_rel) + addend;
+			if (sc_merged_flag == new_shared_state) {
+				destroy();
+			}
+		}
+		void shared_decrement() {
+			auto shared_state = m_shared_state.load(std::memory_order_relaxed);
+			while (true) {
+				auto desired_shared_state = shared_state - sc_shared_count_unit;
+				bool needs_enqueueing = false;
+				if ((0 == (shared_state & (sc_merged_flag | sc_queued_flag))) && (0 > desired_shared_state)) {
+					desired_shared_state |= sc_queued_flag;
+					needs_enqueueing = true;
+				}
+				if (m_shared_state.compare_exchange_weak(shared_state, desired_shared_state, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+					if (needs_enqueueing) {
+						if (!(*m_owner_queue_ptr).try_enqueue(this)) {
+							merge_and_dequeue();
+						}
+					}
+					else if (sc_merged_flag == desired_shared_state) {
+						destroy();
+					}
+					return;
+				}
+			}
+		}
+		/* Called (from the owner thread, or any thread once the owner thread has exited) for objects that have been queued. */
+		void merge_and_dequeue() {
+			if (!m_owner_has_merged) {
+				merge();
+			}
+			const auto new_shared_state = m_shared_state.fetch_and(~sc_queued_flag, std::memory_order_acq_rel) & (~sc_queued_flag);
+			if (sc_merged_flag == new_shared_state) {
+				destroy();
+			}
+		}
+		void destroy() {
+			auto owner_queue_ptr = m_owner_queue_ptr;
+			m_destroy_fn(this);
+			if (owner_queue_ptr) {
+				(*owner_queue_ptr).release_ref();
+			}
+		}
+
+		/* The lowest two bits of the shared state are the "merged" and "queued" flags. The (signed) shared count is stored in
+		the remaining bits. */
+		static const long long sc_merged_flag = 1;
+		static const long long sc_queued_flag = 2;
+		static const long long sc_shared_count_unit = 4;
+
+		destroy_fn_t m_destroy_fn;
+		impl::CAtomicRefCountingOwnerQueue* const m_owner_queue_ptr;
+		/* Only the owner thread ever reads or modifies m_biased_counter and m_owner_has_merged (until it exits). */
+		int m_biased_counter = 1;
+		bool m_owner_has_merged = false;
+		std::atomic<long long> m_shared_state{ 0 };
+
+		friend class impl::CAtomicRefCountingOwnerQueue;
+	};
+
+	namespace impl {
+		inline void CAtomicRefCountingOwnerQueue::process_pending_merges(bool owner_is_exiting) {
+			std::vector<CAtomicRefCounter*> pending_merges;
+			{
+				std::lock_guard<std::mutex> lock1(m_mutex);
+				pending_merges.swap(m_pending_merges);
+				m_has_pending_merges.store(false, std::memory_order_relaxed);
+				if (owner_is_exiting) {
+					m_owner_has_exited = true;
+				}
+			}
+			/* Merging may destroy objects whose destructors release (and so may queue) other objects. */
+			for (auto ref_counter_ptr : pending_merges) {
+				(*ref_counter_ptr).merge_and_dequeue();
+			}
+		}
+	}
+
+	/* Merges (and releases, if unreferenced) any of the current thread's objects that were queued by other threads. */
+	inline void merge_deferred_atomic_refcounting_releases() {
+		auto queue_ptr = impl::CAtomicRefCountingOwnerQueue::current_thread_queue_ptr();
+		if (queue_ptr) {
+			(*queue_ptr).process_pending_merges_if_any();
+		}
+	}
+
+	template<class Y>
+	class TAtomicRefWithTargetObj : public CAtomicRefCounter {
+	public:
+		Y m_object;
+
+		template<class ... Args>
+		TAtomicRefWithTargetObj(Args && ...args) : CAtomicRefCounter(&s_delete), m_object(std::forward<Args>(args)...) {}
+
+	private:
+		static void s_delete(CAtomicRefCounter* ref_counter_ptr) {
+			delete static_cast<TAtomicRefWithTargetObj*>(ref_counter_ptr);
+		}
+	};
+
+	/* TAtomicRefCountingPointer is like TRefCountingPointer, except that copies of it may be safely created and destroyed
+	on different threads. Reference count adjustments made on the thread that created the target object are (nearly) as
+	cheap as TRefCountingPointer's, while those made on other threads are atomic operations. So TAtomicRefCountingPointer
+	is intended for objects that are mostly used by one thread, but are occasionally handed over to other threads.
+	Note that, like std::shared_ptr, only the reference count is thread safe. Neither the pointer object itself, nor the
+	target object is protected from concurrent access. */
+	template <class X>
+	class TAtomicRefCountingPointer {
+	public:
+		TAtomicRefCountingPointer() : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
+		TAtomicRefCountingPointer(std::nullptr_t) : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
+		~TAtomicRefCountingPointer() {
+			release();
+		}
+		TAtomicRefCountingPointer(const TAtomicRefCountingPointer& r) {
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+		}
+		TAtomicRefCountingPointer(TAtomicRefCountingPointer&& r) : m_ref_with_target_obj_ptr(r.m_ref_with_target_obj_ptr), m_target_obj_ptr(r.m_target_obj_ptr) {
+			r.m_ref_with_target_obj_ptr = nullptr;
+			r.m_target_obj_ptr = nullptr;
+		}
+		/* "Not null" pointers must not be left null, so "moving" one is just a copy. */
+		TAtomicRefCountingPointer(TAtomicRefCountingNotNullPointer<X>&& r) {
+			const TAtomicRefCountingPointer& r_base_cref = r;
+			acquire(r_base_cref.m_ref_with_target_obj_ptr, r_base_cref.m_target_obj_ptr);
+		}
+		operator bool() const { return nullptr != get(); }
+		void clear() { (*this) = TAtomicRefCountingPointer<X>(nullptr); }
+		TAtomicRefCountingPointer& operator=(const TAtomicRefCountingPointer& r) {
+			if (this != &r) {
+				auto_release keep(m_ref_with_target_obj_ptr);
+				acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+			}
+			return *this;
+		}
+		TAtomicRefCountingPointer& operator=(TAtomicRefCountingPointer&& r) {
+			if (this != &r) {
+				auto_release keep(m_ref_with_target_obj_ptr);
+				m_ref_with_target_obj_ptr = r.m_ref_with_target_obj_ptr;
+				m_target_obj_ptr = r.m_target_obj_ptr;
+				r.m_ref_with_target_obj_ptr = nullptr;
+				r.m_target_obj_ptr = nullptr;
+			}
+			return *this;
+		}
+		TAtomicRefCountingPointer& operator=(TAtomicRefCountingNotNullPointer<X>&& r) {
+			return operator=(static_cast<const TAtomicRefCountingPointer&>(r));
+		}
+		bool operator<(const TAtomicRefCountingPointer& r) const {
+			return get() < r.get();
+		}
+		bool operator==(const TAtomicRefCountingPointer& r) const {
+			return get() == r.get();
+		}
+		bool operator!=(const TAtomicRefCountingPointer& r) const {
+			return get() != r.get();
+		}
+
+#ifndef MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
+		template <class Y> friend class TAtomicRefCountingPointer;
+		template <class Y> TAtomicRefCountingPointer(const TAtomicRefCountingPointer<Y>& r) {
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+		}
+		template <class Y> TAtomicRefCountingPointer& operator=(const TAtomicRefCountingPointer<Y>& r) {
+			auto_release keep(m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+			return *this;
+		}
+		template <class Y> bool operator<(const TAtomicRefCountingPointer<Y>& r) const {
+			return get() < r.get();
+		}
+		template <class Y> bool operator==(const TAtomicRefCountingPointer<Y>& r) const {
+			return get() == r.get();
+		}
+		template <class Y> bool operator!=(const TAtomicRefCountingPointer<Y>& r) const {
+			return get() != r.get();
+		}
+#endif // !MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
+
+		X& operator*() const {
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TAtomicRefCountingPointer")); }
+			return (*m_target_obj_ptr);
+		}
+		X* operator->() const {
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TAtomicRefCountingPointer")); }
+			return m_target_obj_ptr;
+		}
+
+		template <class... Args>
+		static TAtomicRefCountingPointer make(Args&&... args) {
+			auto new_ptr = new TAtomicRefWithTargetObj<X>(std::forward<Args>(args)...);
+			TAtomicRefCountingPointer retval(new_ptr);
+			return retval;
+		}
+
+	protected:
+		X* get() const {
+			return m_target_obj_ptr;
+		}
+
+	private:
+		explicit TAtomicRefCountingPointer(TAtomicRefWithTargetObj<X>* p/* = nullptr*/) {
+			m_ref_with_target_obj_ptr = p;
+			m_target_obj_ptr = p ? std::addressof(p->m_object) : nullptr;
+		}
+
+		void acquire(CAtomicRefCounter* c, X* target_obj_ptr) {
+			m_ref_with_target_obj_ptr = c;
+			m_target_obj_ptr = target_obj_ptr;
+			if (c) { c->increment(); }
+		}
+
+		void release() {
+			dorelease(m_ref_with_target_obj_ptr);
+		}
+
+		struct auto_release {
+			auto_release(CAtomicRefCounter* c) : m_ref_with_target_obj_ptr(c) {}
+			~auto_release() { dorelease(m_ref_with_target_obj_ptr); }
+			CAtomicRefCounter* m_ref_with_target_obj_ptr;
+		};
+
+		void static dorelease(CAtomicRefCounter* ref_with_target_obj_ptr) {
+			if (ref_with_target_obj_ptr) {
+				ref_with_target_obj_ptr->decrement_and_destroy_if_unreferenced();
+			}
+		}
+
+		CAtomicRefCounter* m_ref_with_target_obj_ptr;
+		X* m_target_obj_ptr;
+
+		friend class TAtomicRefCountingNotNullPointer<X>;
+		friend class TAtomicRefCountingConstPointer<X>;
+	};
+
+	template<typename _Ty>
+	class TAtomicRefCountingNotNullPointer : public TAtomicRefCountingPointer<_Ty> {
+	public:
+		TAtomicRefCountingNotNullPointer(const TAtomicRefCountingNotNullPointer& src_cref) : TAtomicRefCountingPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingNotNullPointer() {}
+		TAtomicRefCountingNotNullPointer<_Ty>& operator=(const TAtomicRefCountingNotNullPointer<_Ty>& _Right_cref) {
+			TAtomicRefCountingPointer<_Ty>::operator=(_Right_cref);
+			return (*this);
+		}
+
+		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
+		explicit operator _Ty*() const { return TAtomicRefCountingPointer<_Ty>::get(); }
+
+	private:
+		explicit TAtomicRefCountingNotNullPointer(TAtomicRefWithTargetObj<_Ty>* p/* = nullptr*/) : TAtomicRefCountingPointer<_Ty>(p) {}
+
+		friend class TAtomicRefCountingFixedPointer<_Ty>;
+	};
+
+	/* TAtomicRefCountingFixedPointer cannot be retargeted or constructed without a target. This pointer is recommended for passing
+	parameters by reference. */
+	template<typename _Ty>
+	class TAtomicRefCountingFixedPointer : public TAtomicRefCountingNotNullPointer<_Ty> {
+	public:
+		TAtomicRefCountingFixedPointer(const TAtomicRefCountingFixedPointer& src_cref) : TAtomicRefCountingNotNullPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingFixedPointer() {}
+		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
+		explicit operator _Ty*() const { return TAtomicRefCountingNotNullPointer<_Ty>::operator _Ty*(); }
+
+		template <class... Args>
+		static TAtomicRefCountingFixedPointer make(Args&&... args) {
+			auto new_ptr = new TAtomicRefWithTargetObj<_Ty>(std::forward<Args>(args)...);
+			TAtomicRefCountingFixedPointer retval(new_ptr);
+			return retval;
+		}
+
+	private:
+		explicit TAtomicRefCountingFixedPointer(TAtomicRefWithTargetObj<_Ty>* p/* = nullptr*/) : TAtomicRefCountingNotNullPointer<_Ty>(p) {}
+		TAtomicRefCountingFixedPointer<_Ty>& operator=(const TAtomicRefCountingFixedPointer<_Ty>& _Right_cref) = delete;
+
+		friend class TAtomicRefCountingConstPointer<_Ty>;
+	};
+
+	template <class X, class... Args>
+	TAtomicRefCountingFixedPointer<X> make_atomic_refcounting(Args&&... args) {
+		return TAtomicRefCountingFixedPointer<X>::make(std::forward<Args>(args)...);
+	}
+
+
+	template <class X>
+	class TAtomicRefCountingConstPointer {
+	public:
+		TAtomicRefCountingConstPointer() : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
+		TAtomicRefCountingConstPointer(std::nullptr_t) : m_ref_with_target_obj_ptr(nullptr), m_target_obj_ptr(nullptr) {}
+		~TAtomicRefCountingConstPointer() {
+			release();
+		}
+		TAtomicRefCountingConstPointer(const TAtomicRefCountingConstPointer& r) {
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+		}
+		TAtomicRefCountingConstPointer(const TAtomicRefCountingPointer<X>& r) {
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+		}
+		TAtomicRefCountingConstPointer(TAtomicRefCountingConstPointer&& r) : m_ref_with_target_obj_ptr(r.m_ref_with_target_obj_ptr), m_target_obj_ptr(r.m_target_obj_ptr) {
+			r.m_ref_with_target_obj_ptr = nullptr;
+			r.m_target_obj_ptr = nullptr;
+		}
+		operator bool() const { return nullptr != get(); }
+		void clear() { (*this) = TAtomicRefCountingConstPointer<X>(nullptr); }
+		TAtomicRefCountingConstPointer& operator=(const TAtomicRefCountingConstPointer& r) {
+			if (this != &r) {
+				auto_release keep(m_ref_with_target_obj_ptr);
+				acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+			}
+			return *this;
+		}
+		TAtomicRefCountingConstPointer& operator=(const TAtomicRefCountingPointer<X>& r) {
+			auto_release keep(m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+			return *this;
+		}
+		bool operator<(const TAtomicRefCountingConstPointer& r) const {
+			return get() < r.get();
+		}
+		bool operator==(const TAtomicRefCountingConstPointer& r) const {
+			return get() == r.get();
+		}
+		bool operator!=(const TAtomicRefCountingConstPointer& r) const {
+			return get() != r.get();
+		}
+
+#ifndef MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
+		template <class Y> friend class TAtomicRefCountingConstPointer;
+		template <class Y> TAtomicRefCountingConstPointer(const TAtomicRefCountingConstPointer<Y>& r) {
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+		}
+		template <class Y> TAtomicRefCountingConstPointer& operator=(const TAtomicRefCountingConstPointer<Y>& r) {
+			auto_release keep(m_ref_with_target_obj_ptr);
+			acquire(r.m_ref_with_target_obj_ptr, r.m_target_obj_ptr);
+			return *this;
+		}
+		template <class Y> bool operator<(const TAtomicRefCountingConstPointer<Y>& r) const {
+			return get() < r.get();
+		}
+		template <class Y> bool operator==(const TAtomicRefCountingConstPointer<Y>& r) const {
+			return get() == r.get();
+		}
+		template <class Y> bool operator!=(const TAtomicRefCountingConstPointer<Y>& r) const {
+			return get() != r.get();
+		}
+#endif // !MSE_REFCOUNTINGPOINTER_DISABLE_MEMBER_TEMPLATES
+
+		const X& operator*() const {
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TAtomicRefCountingConstPointer")); }
+			return (*m_target_obj_ptr);
+		}
+		const X* operator->() const {
+			if (!m_target_obj_ptr) { MSE_THROW(refcounting_null_dereference_error("attempt to dereference null pointer - mse::TAtomicRefCountingConstPointer")); }
+			return m_target_obj_ptr;
+		}
+		const X* get() const {
+			return m_target_obj_ptr;
+		}
+
+	private:
+		void acquire(CAtomicRefCounter* c, const X* target_obj_ptr) {
+			m_ref_with_target_obj_ptr = c;
+			m_target_obj_ptr = target_obj_ptr;
+			if (c) { c->increment(); }
+		}
+
+		void release() {
+			dorelease(m_ref_with_target_obj_ptr);
+		}
+
+		struct auto_release {
+			auto_release(CAtomicRefCounter* c) : m_ref_with_target_obj_ptr(c) {}
+			~auto_release() { dorelease(m_ref_with_target_obj_ptr); }
+			CAtomicRefCounter* m_ref_with_target_obj_ptr;
+		};
+
+		void static dorelease(CAtomicRefCounter* ref_with_target_obj_ptr) {
+			if (ref_with_target_obj_ptr) {
+				ref_with_target_obj_ptr->decrement_and_destroy_if_unreferenced();
+			}
+		}
+
+		CAtomicRefCounter* m_ref_with_target_obj_ptr;
+		const X* m_target_obj_ptr;
+
+		friend class TAtomicRefCountingNotNullConstPointer<X>;
+	};
+
+	template<typename _Ty>
+	class TAtomicRefCountingNotNullConstPointer : public TAtomicRefCountingConstPointer<_Ty> {
+	public:
+		TAtomicRefCountingNotNullConstPointer(const TAtomicRefCountingNotNullConstPointer& src_cref) : TAtomicRefCountingConstPointer<_Ty>(src_cref) {}
+		TAtomicRefCountingNotNullConstPointer(const TAtomicRefCountingNotNullPointer<_Ty>& src_cref) : TAtomicRefCountingConstPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingNotNullConstPointer() {}
+		TAtomicRefCountingNotNullConstPointer<_Ty>& operator=(const TAtomicRefCountingNotNullConstPointer<_Ty>& _Right_cref) {
+			TAtomicRefCountingConstPointer<_Ty>::operator=(_Right_cref);
+			return (*this);
+		}
+
+		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
+		explicit operator const _Ty*() const { return TAtomicRefCountingConstPointer<_Ty>::get(); }
+
+	private:
+		friend class TAtomicRefCountingFixedConstPointer<_Ty>;
+	};
+
+	/* TAtomicRefCountingFixedConstPointer cannot be retargeted or constructed without a target. This pointer is recommended for passing
+	parameters by reference. */
+	template<typename _Ty>
+	class TAtomicRefCountingFixedConstPointer : public TAtomicRefCountingNotNullConstPointer<_Ty> {
+	public:
+		TAtomicRefCountingFixedConstPointer(const TAtomicRefCountingFixedConstPointer& src_cref) : TAtomicRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		TAtomicRefCountingFixedConstPointer(const TAtomicRefCountingFixedPointer<_Ty>& src_cref) : TAtomicRefCountingNotNullConstPointer<_Ty>(src_cref) {}
+		virtual ~TAtomicRefCountingFixedConstPointer() {}
+		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
+		explicit operator const _Ty*() const { return TAtomicRefCountingNotNullConstPointer<_Ty>::operator const _Ty*(); }
+
+	private:
+		TAtomicRefCountingFixedConstPointer<_Ty>& operator=(const TAtomicRefCountingFixedConstPointer<_Ty>& _Right_cref) = delete;
+	};
+
+
 #endif /*MSE_REFCOUNTINGPOINTER_DISABLED*/
 
 	template <class _TTargetType, class _TLeaseType> class TStrongFixedConstPointer;
@@ -754,6 +1683,72 @@ namespace mse {
 			return ok;
 		}
 
+		/* Blocks allocated by one thread and freed by another make their way back to the allocating thread (via the
+		orphanage), so a producer/consumer pattern doesn't keep allocating new chunks. */
+		bool testPoolAllocatorCrossThread()
+		{
+			bool ok = true;
+#ifdef MSE_SELF_TESTS
+			static const size_t sc_block_size = 64;
+			static const size_t sc_blocks_per_round = 1000;
+			static const size_t sc_num_rounds = 20;
+			typedef impl::CRefCountingSizeClassPool pool_t;
+
+			/* The blocks are freed by a "consumer" thread that never allocates any. */
+			std::mutex mutex1;
+			std::condition_variable cv1;
+			std::vector<void*> handed_over_blocks;
+			bool done = false;
+			std::thread consumer_thread([&]() {
+				std::unique_lock<std::mutex> lock1(mutex1);
+				while (true) {
+					cv1.wait(lock1, [&]() { return done || (!handed_over_blocks.empty()); });
+					for (auto block_ptr : handed_over_blocks) {
+						pool_t::deallocate(block_ptr, sc_block_size);
+					}
+					handed_over_blocks.clear();
+					cv1.notify_all();
+					if (done) {
+						break;
+					}
+				}
+			});
+
+			const auto num_chunks_before = pool_t::num_chunks_allocated();
+			for (size_t round = 0; round < sc_num_rounds; round += 1) {
+				std::vector<void*> blocks;
+				for (size_t i = 0; i < sc_blocks_per_round; i += 1) {
+					blocks.push_back(pool_t::allocate(sc_block_size));
+				}
+				std::unique_lock<std::mutex> lock1(mutex1);
+				handed_over_blocks = std::move(blocks);
+				cv1.notify_all();
+				cv1.wait(lock1, [&]() { return handed_over_blocks.empty(); });
+			}
+			{
+				std::lock_guard<std::mutex> lock1(mutex1);
+				done = true;
+			}
+			cv1.notify_all();
+			consumer_thread.join();
+			const auto num_chunks_allocated = pool_t::num_chunks_allocated() - num_chunks_before;
+			/* Without the blocks being returned, each round would need about four new chunks. */
+			MTXASSERT(ok, (4 * sc_num_rounds / 2 > num_chunks_allocated));
+
+			/* A (short-lived) thread that frees a block, without ever allocating one, donates it when it exits. So it's the
+			first block that the next thread to run out adopts. */
+			auto block_ptr = pool_t::allocate(sc_block_size);
+			std::thread([block_ptr]() { pool_t::deallocate(block_ptr, sc_block_size); }).join();
+			void* adopted_block_ptr = nullptr;
+			std::thread([&adopted_block_ptr]() {
+				adopted_block_ptr = pool_t::allocate(sc_block_size);
+				pool_t::deallocate(adopted_block_ptr, sc_block_size);
+			}).join();
+			MTXASSERT_EQ(ok, block_ptr, adopted_block_ptr);
+#endif // MSE_SELF_TESTS
+			return ok;
+		}
+
 		void test1() {
 #ifdef MSE_SELF_TESTS
 			class A {
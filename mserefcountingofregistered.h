@@ -41,6 +41,10 @@ namespace mse {
 	TRefCountingOfRegisteredFixedPointer<_Ty> make_refcountingofregistered(Args&&... args) {
 		return make_refcounting<TRegisteredObj<_Ty>>(std::forward<Args>(args)...);
 	}
+	template <class _Ty, class _TAlloc, class... Args>
+	TRefCountingOfRegisteredFixedPointer<_Ty> allocate_refcountingofregistered(const _TAlloc& alloc, Args&&... args) {
+		return allocate_refcounting<TRegisteredObj<_Ty>>(alloc, std::forward<Args>(args)...);
+	}
 
 
 	class TRefCountingOfRegisteredPointer_test {
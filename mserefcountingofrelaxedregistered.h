@@ -41,6 +41,10 @@ namespace mse {
 	TRefCountingOfRelaxedRegisteredFixedPointer<_Ty> make_refcountingofrelaxedregistered(Args&&... args) {
 		return make_refcounting<TRelaxedRegisteredObj<_Ty>>(std::forward<Args>(args)...);
 	}
+	template <class _Ty, class _TAlloc, class... Args>
+	TRefCountingOfRelaxedRegisteredFixedPointer<_Ty> allocate_refcountingofrelaxedregistered(const _TAlloc& alloc, Args&&... args) {
+		return allocate_refcounting<TRelaxedRegisteredObj<_Ty>>(alloc, std::forward<Args>(args)...);
+	}
 
 
 	class TRefCountingOfRelaxedRegisteredPointer_test {
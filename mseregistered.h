@@ -8,12 +8,22 @@
 #ifndef MSEREGISTERED_H_
 #define MSEREGISTERED_H_
 
-//include "mseprimitives.h"
+#include "mseprimitives.h"
 #include "msepointerbasics.h"
 #include <utility>
 #include <unordered_set>
 #include <functional>
+#include <memory>
 #include <cassert>
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+#include <typeinfo>
+#include <typeindex>
+#include <map>
+#include <string>
+#include <mutex>
+#include <iostream>
+#include <cstdlib>
+#endif // MSE_REGISTERED_INSTRUMENTATION1
 
 
 #if defined(MSE_SAFER_SUBSTITUTES_DISABLED) || defined(MSE_SAFERPTR_DISABLED)
@@ -28,24 +38,113 @@ namespace mse {
 
 	MSE_CONSTEXPR static const int sc_default_cache_size = MSE_REGISTERED_DEFAULT_CACHE_SIZE;
 
+	/* Passing this value as the "_Tn" template parameter (in place of a cache size) selects a tracker that, rather than
+	storing the pointers in a fixed size array (and "spilling" to a heap allocated set when the array is full), links the
+	registered pointers targeting the object into an intrusive doubly-linked list. Registration and unregistration are
+	then O(1) and never allocate, at the cost of each registered pointer being a few words larger. (It is negative so that
+	it can't be confused with a valid cache size.) */
+	MSE_CONSTEXPR static const int sc_intrusive_list_tracker = -1;
+
+	/* registered_tracker_traits<> determines the tracker parameter (i.e. the cache size or sc_intrusive_list_tracker) used
+	by default by registered objects and pointers with the given target type. So rather than spelling out the parameter
+	everywhere a type is used, you can specialize this template. For example:
+
+	namespace mse {
+		template<> class registered_tracker_traits<CGraphNode> : public TRegisteredArrayTrackerTraits<16> {};
+		template<> class registered_tracker_traits<CConfigRecord> : public CRegisteredIntrusiveListTrackerTraits {};
+	}
+
+	Note that pointers to a base class only convert from pointers to a derived class if both use the same tracker parameter,
+	so you'd generally want specializations for derived classes to match those of their base classes. */
+	template<int _Tcache_size>
+	class TRegisteredArrayTrackerTraits {
+	public:
+		MSE_CONSTEXPR static const int tracker_param = _Tcache_size;
+	};
+	class CRegisteredIntrusiveListTrackerTraits {
+	public:
+		MSE_CONSTEXPR static const int tracker_param = sc_intrusive_list_tracker;
+	};
+	template<typename _Ty>
+	class registered_tracker_traits : public TRegisteredArrayTrackerTraits<sc_default_cache_size> {};
+
+	template<typename _Ty>
+	class TRegisteredTrackerParam {
+	public:
+		MSE_CONSTEXPR static const int value = registered_tracker_traits<typename std::remove_const<_Ty>::type>::tracker_param;
+	};
+
 #ifdef MSE_REGISTEREDPOINTER_DISABLED
-	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredPointer = _Ty*;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredConstPointer = const _Ty*;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredNotNullPointer = _Ty*;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredNotNullConstPointer = const _Ty*;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredFixedPointer = _Ty*;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using TRegisteredFixedConstPointer = const _Ty*;
-	template<typename _TROy, int _Tn = sc_default_cache_size> using TRegisteredObj = _TROy;
-	template <class _TRRWy, int _TRRWn = sc_default_cache_size> using TRegisteredRefWrapper = std::reference_wrapper<_TRRWy>;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using TRegisteredPointer = _Ty*;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using TRegisteredConstPointer = const _Ty*;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using TRegisteredNotNullPointer = _Ty*;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using TRegisteredNotNullConstPointer = const _Ty*;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using TRegisteredFixedPointer = _Ty*;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using TRegisteredFixedConstPointer = const _Ty*;
+	template<typename _TROy, int _Tn = TRegisteredTrackerParam<_TROy>::value> using TRegisteredObj = _TROy;
+	template <class _TRRWy, int _TRRWn = TRegisteredTrackerParam<_TRRWy>::value> using TRegisteredRefWrapper = std::reference_wrapper<_TRRWy>;
 
 #else /*MSE_REGISTEREDPOINTER_DISABLED*/
 
+	namespace impl {
+		/* An allocator that holds on to (at most) one deallocated single element block, and hands it back out on the next
+		single element allocation. It's used by the trackers' (slow mode) sets so that replacing a pointer (an erase()
+		followed by an insert()) reuses the node just freed and so can't fail. (C++17's node handles (extract()) would
+		do the job more directly.) The held block isn't shared with copies of the allocator. */
+		template<typename _Ty>
+		class TSpareBlockAllocator {
+		public:
+			typedef _Ty value_type;
+
+			TSpareBlockAllocator() {}
+			TSpareBlockAllocator(const TSpareBlockAllocator&) {}
+			template<typename _Ty2>
+			TSpareBlockAllocator(const TSpareBlockAllocator<_Ty2>&) {}
+			TSpareBlockAllocator& operator=(const TSpareBlockAllocator&) { return (*this); }
+			~TSpareBlockAllocator() {
+				if (m_spare_ptr) {
+					std::allocator<_Ty>().deallocate(m_spare_ptr, 1);
+				}
+			}
+
+			_Ty* allocate(size_t n) {
+				if ((1 == n) && m_spare_ptr) {
+					auto retval = m_spare_ptr;
+					m_spare_ptr = nullptr;
+					return retval;
+				}
+				return std::allocator<_Ty>().allocate(n);
+			}
+			void deallocate(_Ty* ptr, size_t n) {
+				if ((1 == n) && (!m_spare_ptr)) {
+					m_spare_ptr = ptr;
+				}
+				else {
+					std::allocator<_Ty>().deallocate(ptr, n);
+				}
+			}
+
+			/* Any instance can deallocate memory allocated by any other. */
+			template<typename _Ty2>
+			bool operator==(const TSpareBlockAllocator<_Ty2>&) const { return true; }
+			template<typename _Ty2>
+			bool operator!=(const TSpareBlockAllocator<_Ty2>&) const { return false; }
+
+		private:
+			_Ty* m_spare_ptr = nullptr;
+		};
+
+		typedef std::unordered_set<const CSaferPtrBase*, std::hash<const CSaferPtrBase*>, std::equal_to<const CSaferPtrBase*>
+			, TSpareBlockAllocator<const CSaferPtrBase*> > registered_pointer_set_type;
+	}
+
 	/* TRPTracker is intended to keep track of all the pointers pointing to an object. TRPTracker objects are intended to be always
 	associated with (infact, a member of) the one object that is the target of the pointers it tracks. Though at the moment, it
 	doesn't need to actually know which object it is associated with. */
 	template<int _Tn = sc_default_cache_size>
 	class TRPTracker {
 	public:
+		static_assert(0 <= _Tn, "invalid registered tracker cache size");
 		TRPTracker() {}
 		TRPTracker(const TRPTracker& src_cref) {
 			/* This is a special type of class. The state (i.e. member values) of an object of this class is specific to (and only
@@ -75,26 +174,21 @@ namespace mse {
 
 		void registerPointer(const CSaferPtrBase& sp_ref) {
 			if (!fast_mode1()) {
-				std::unordered_set<const CSaferPtrBase*>::value_type item(&sp_ref);
+				impl::registered_pointer_set_type::value_type item(&sp_ref);
 				(*m_ptr_to_regptr_set_ptr).insert(item);
-#ifdef MSE_REGISTERED_INSTRUMENTATION1
-				if ((*m_ptr_to_regptr_set_ptr).size() > m_highest_ptr_to_regptr_set_size) {
-					m_highest_ptr_to_regptr_set_size = (*m_ptr_to_regptr_set_ptr).size();
-				}
-#endif // MSE_REGISTERED_INSTRUMENTATION1
 			}
 			else {
 				if (sc_fm1_max_pointers == m_fm1_num_pointers) {
 					/* Too many pointers. Initiate and switch to slow mode. */
 					/* Initialize slow storage. */
-					m_ptr_to_regptr_set_ptr = new std::unordered_set<const CSaferPtrBase*>();
+					m_ptr_to_regptr_set_ptr = new impl::registered_pointer_set_type();
 					/* First copy the pointers from fast storage to slow storage. */
 					for (int i = 0; i < sc_fm1_max_pointers; i += 1) {
-						std::unordered_set<const CSaferPtrBase*>::value_type item(m_fm1_ptr_to_regptr_array[i]);
+						impl::registered_pointer_set_type::value_type item(m_fm1_ptr_to_regptr_array[i]);
 						(*m_ptr_to_regptr_set_ptr).insert(item);
 					}
 					/* Add the new pointer to slow storage. */
-					std::unordered_set<const CSaferPtrBase*>::value_type item(&sp_ref);
+					impl::registered_pointer_set_type::value_type item(&sp_ref);
 					(*m_ptr_to_regptr_set_ptr).insert(item);
 				}
 				else {
@@ -123,6 +217,11 @@ namespace mse {
 					}
 				}
 			}
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+			if (num_pointers() > m_highest_ptr_to_regptr_set_size) {
+				m_highest_ptr_to_regptr_set_size = num_pointers();
+			}
+#endif // MSE_REGISTERED_INSTRUMENTATION1
 		}
 		void unregisterPointer(const CSaferPtrBase& sp_ref) {
 			if (!fast_mode1()) {
@@ -175,6 +274,29 @@ namespace mse {
 				}
 			}
 		}
+		/* Equivalent to registering new_sp_ref and unregistering old_sp_ref, but in fast mode the new pointer just takes
+		over the old pointer's slot. This is what allows registered pointers to be moved cheaply. In slow mode the old entry
+		is erased before the new one is inserted, so the insertion gets the node just freed (see TSpareBlockAllocator<>),
+		and, since the number of elements doesn't exceed what it was, no rehash is needed. So it doesn't allocate and
+		can't throw. */
+		void replacePointer(const CSaferPtrBase& old_sp_ref, const CSaferPtrBase& new_sp_ref) {
+			if (!fast_mode1()) {
+				const auto num_erased = (*m_ptr_to_regptr_set_ptr).erase(&old_sp_ref);
+				assert(1 == num_erased);
+				(void)num_erased;
+				impl::registered_pointer_set_type::value_type item(&new_sp_ref);
+				(*m_ptr_to_regptr_set_ptr).insert(item);
+			}
+			else {
+				for (int i = 0; i < m_fm1_num_pointers; i += 1) {
+					if ((&old_sp_ref) == m_fm1_ptr_to_regptr_array[i]) {
+						m_fm1_ptr_to_regptr_array[i] = (&new_sp_ref);
+						return;
+					}
+				}
+				assert(false);
+			}
+		}
 		void onObjectDestruction() {
 			if (!fast_mode1()) {
 				for (auto sp_ref_ptr : (*m_ptr_to_regptr_set_ptr)) {
@@ -246,13 +368,223 @@ namespace mse {
 		MSE_CONSTEXPR static const int sc_fm1_max_pointers = _Tn;
 		const CSaferPtrBase* m_fm1_ptr_to_regptr_array[sc_fm1_max_pointers];
 
-		std::unordered_set<const CSaferPtrBase*> *m_ptr_to_regptr_set_ptr = nullptr;
+		impl::registered_pointer_set_type *m_ptr_to_regptr_set_ptr = nullptr;
+
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+		size_t num_pointers() const { return fast_mode1() ? size_t(m_fm1_num_pointers) : (*m_ptr_to_regptr_set_ptr).size(); }
+		/* The highest number of pointers that have targeted the object at one time. */
+		size_t highest_num_pointers() const { return m_highest_ptr_to_regptr_set_size; }
+		size_t m_highest_ptr_to_regptr_set_size = 0;
+#endif // MSE_REGISTERED_INSTRUMENTATION1
+	};
+
+	/* TRPTrackerPointerNode<> is a base class of the registered pointers (that target objects of a particular TRPTracker<>
+	type) that holds any per-pointer state required by the tracker. The array based trackers don't need any. */
+	template<int _Tn = sc_default_cache_size>
+	class TRPTrackerPointerNode {};
+
+	template<>
+	class TRPTrackerPointerNode<sc_intrusive_list_tracker> {
+	public:
+		TRPTrackerPointerNode() {}
+		/* Like the tracker, the links are specific to the particular instance of the pointer and are not copied. */
+		TRPTrackerPointerNode(const TRPTrackerPointerNode&) {}
+		TRPTrackerPointerNode& operator=(const TRPTrackerPointerNode&) { return (*this); }
+
+		mutable const CSaferPtrBase* m_sp_ptr = nullptr;
+		mutable const TRPTrackerPointerNode* m_prev_node_ptr = nullptr;
+		mutable const TRPTrackerPointerNode* m_next_node_ptr = nullptr;
+	};
+
+	/* This version of TRPTracker keeps the pointers targeting the object in an intrusive doubly-linked list whose links are
+	stored in the pointers themselves. */
+	template<>
+	class TRPTracker<sc_intrusive_list_tracker> {
+	public:
+		typedef TRPTrackerPointerNode<sc_intrusive_list_tracker> pointer_node_type;
+
+		TRPTracker() {}
+		TRPTracker(const TRPTracker&) { /* see the comments in the general TRPTracker<> */ }
+		TRPTracker(TRPTracker&&) { /* see above */ }
+		~TRPTracker() {}
+		TRPTracker& operator=(const TRPTracker&) { /* see above */ return (*this); }
+		TRPTracker& operator=(TRPTracker&&) { /* see above */ return (*this); }
+		bool operator==(const TRPTracker&) const { return true; }
+		bool operator!=(const TRPTracker&) const { return false; }
+
+		template<class _TPointer>
+		void registerPointer(const _TPointer& ptr_cref) {
+			registerPointer(static_cast<const CSaferPtrBase&>(ptr_cref), static_cast<const pointer_node_type&>(ptr_cref));
+		}
+		void registerPointer(const CSaferPtrBase& sp_ref, const pointer_node_type& node_ref) {
+			node_ref.m_sp_ptr = &sp_ref;
+			node_ref.m_prev_node_ptr = nullptr;
+			node_ref.m_next_node_ptr = m_first_node_ptr;
+			if (nullptr != m_first_node_ptr) {
+				m_first_node_ptr->m_prev_node_ptr = &node_ref;
+			}
+			m_first_node_ptr = &node_ref;
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+			m_num_pointers += 1;
+			if (m_num_pointers > m_highest_ptr_to_regptr_set_size) {
+				m_highest_ptr_to_regptr_set_size = m_num_pointers;
+			}
+#endif // MSE_REGISTERED_INSTRUMENTATION1
+		}
+		template<class _TPointer>
+		void unregisterPointer(const _TPointer& ptr_cref) {
+			unregisterPointer(static_cast<const pointer_node_type&>(ptr_cref));
+		}
+		void unregisterPointer(const pointer_node_type& node_ref) {
+			assert(nullptr != node_ref.m_sp_ptr);
+			if (nullptr != node_ref.m_prev_node_ptr) {
+				node_ref.m_prev_node_ptr->m_next_node_ptr = node_ref.m_next_node_ptr;
+			}
+			else {
+				assert(&node_ref == m_first_node_ptr);
+				m_first_node_ptr = node_ref.m_next_node_ptr;
+			}
+			if (nullptr != node_ref.m_next_node_ptr) {
+				node_ref.m_next_node_ptr->m_prev_node_ptr = node_ref.m_prev_node_ptr;
+			}
+			node_ref.m_sp_ptr = nullptr;
+			node_ref.m_prev_node_ptr = nullptr;
+			node_ref.m_next_node_ptr = nullptr;
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+			m_num_pointers -= 1;
+#endif // MSE_REGISTERED_INSTRUMENTATION1
+		}
+		template<class _TPointer>
+		void replacePointer(const _TPointer& old_ptr_cref, const _TPointer& new_ptr_cref) {
+			replacePointer(static_cast<const pointer_node_type&>(old_ptr_cref), static_cast<const CSaferPtrBase&>(new_ptr_cref), static_cast<const pointer_node_type&>(new_ptr_cref));
+		}
+		/* The new node just takes over the old node's position in the list. */
+		void replacePointer(const pointer_node_type& old_node_ref, const CSaferPtrBase& new_sp_ref, const pointer_node_type& new_node_ref) {
+			assert(nullptr != old_node_ref.m_sp_ptr);
+			new_node_ref.m_sp_ptr = &new_sp_ref;
+			new_node_ref.m_prev_node_ptr = old_node_ref.m_prev_node_ptr;
+			new_node_ref.m_next_node_ptr = old_node_ref.m_next_node_ptr;
+			if (nullptr != new_node_ref.m_prev_node_ptr) {
+				new_node_ref.m_prev_node_ptr->m_next_node_ptr = &new_node_ref;
+			}
+			else {
+				assert(&old_node_ref == m_first_node_ptr);
+				m_first_node_ptr = &new_node_ref;
+			}
+			if (nullptr != new_node_ref.m_next_node_ptr) {
+				new_node_ref.m_next_node_ptr->m_prev_node_ptr = &new_node_ref;
+			}
+			old_node_ref.m_sp_ptr = nullptr;
+			old_node_ref.m_prev_node_ptr = nullptr;
+			old_node_ref.m_next_node_ptr = nullptr;
+		}
+		void onObjectDestruction() {
+			auto node_ptr = m_first_node_ptr;
+			while (nullptr != node_ptr) {
+				auto next_node_ptr = node_ptr->m_next_node_ptr;
+				(*(node_ptr->m_sp_ptr)).setToNull();
+				node_ptr->m_sp_ptr = nullptr;
+				node_ptr->m_prev_node_ptr = nullptr;
+				node_ptr->m_next_node_ptr = nullptr;
+				node_ptr = next_node_ptr;
+			}
+			m_first_node_ptr = nullptr;
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+			m_num_pointers = 0;
+#endif // MSE_REGISTERED_INSTRUMENTATION1
+		}
+		void reserve_space_for_one_more() {
+			/* Registering a pointer never allocates memory, so there's nothing to do here. */
+		}
+
+		const pointer_node_type* m_first_node_ptr = nullptr;
 
 #ifdef MSE_REGISTERED_INSTRUMENTATION1
+		size_t highest_num_pointers() const { return m_highest_ptr_to_regptr_set_size; }
+		size_t m_num_pointers = 0;
 		size_t m_highest_ptr_to_regptr_set_size = 0;
 #endif // MSE_REGISTERED_INSTRUMENTATION1
 	};
 
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+	/* CRegisteredInstrumentationRegistry collects, for each registered object type, a histogram of the highest number of
+	pointers that targeted each object (of that type) at one time over its lifespan. The intent is that the (per-type)
+	tracker cache sizes can be chosen based on data from real workloads (see registered_tracker_traits<>). The histograms
+	are dumped to std::cerr at program exit unless MSE_REGISTERED_INSTRUMENTATION1_NO_DUMP_AT_EXIT is defined. */
+	class CRegisteredInstrumentationRegistry {
+	public:
+		class CTypeStats {
+		public:
+			std::string m_type_name;
+			int m_tracker_param = sc_default_cache_size;
+			/* Maps the "peak number of pointers" to the number of objects with that peak. */
+			std::map<size_t, size_t> m_peak_num_pointers_histogram;
+		};
+
+		void record_object_destruction(const std::type_info& type_info_cref, int tracker_param, size_t peak_num_pointers) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto& type_stats_ref = m_type_stats_map[std::type_index(type_info_cref)];
+			if (type_stats_ref.m_type_name.empty()) {
+				type_stats_ref.m_type_name = type_info_cref.name();
+				type_stats_ref.m_tracker_param = tracker_param;
+			}
+			type_stats_ref.m_peak_num_pointers_histogram[peak_num_pointers] += 1;
+		}
+		std::map<std::type_index, CTypeStats> type_stats() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_type_stats_map;
+		}
+		void dump(std::ostream& os) {
+			auto type_stats_map = type_stats();
+			if (type_stats_map.empty()) { return; }
+			os << "registered object peak pointer count histograms: \n";
+			for (const auto& item : type_stats_map) {
+				const auto& type_stats_cref = item.second;
+				size_t num_objects = 0;
+				for (const auto& bucket : type_stats_cref.m_peak_num_pointers_histogram) {
+					num_objects += bucket.second;
+				}
+				os << type_stats_cref.m_type_name << " (tracker param: " << type_stats_cref.m_tracker_param
+					<< ", objects: " << num_objects << "): ";
+				/* The peak pointer count that covers 99% of the objects. */
+				size_t suggested_cache_size = 0;
+				size_t cumulative_num_objects = 0;
+				for (const auto& bucket : type_stats_cref.m_peak_num_pointers_histogram) {
+					os << bucket.first << ":" << bucket.second << " ";
+					if ((100 * cumulative_num_objects) < (99 * num_objects)) {
+						suggested_cache_size = bucket.first;
+					}
+					cumulative_num_objects += bucket.second;
+				}
+				/* The suggested cache size is one more than the peak because assignment reserves space for one more pointer
+				(before unregistering the pointer's previous target). */
+				os << "(suggested cache size: " << (suggested_cache_size + 1) << ") \n";
+			}
+		}
+
+	private:
+		std::map<std::type_index, CTypeStats> m_type_stats_map;
+		std::mutex m_mutex;
+	};
+	inline void dump_registered_instrumentation_at_exit();
+	/* The registry is intentionally never destroyed, so registered objects with static storage duration (which may be
+	destroyed after any static registry would be) can still record into it. The histograms are instead dumped by an
+	std::atexit() handler registered on first use. */
+	inline CRegisteredInstrumentationRegistry& registered_instrumentation_registry() {
+		static CRegisteredInstrumentationRegistry* s_registry_ptr = []() {
+			auto registry_ptr = new CRegisteredInstrumentationRegistry();
+#ifndef MSE_REGISTERED_INSTRUMENTATION1_NO_DUMP_AT_EXIT
+			std::atexit(dump_registered_instrumentation_at_exit);
+#endif // !MSE_REGISTERED_INSTRUMENTATION1_NO_DUMP_AT_EXIT
+			return registry_ptr;
+		}();
+		return *s_registry_ptr;
+	}
+	inline void dump_registered_instrumentation_at_exit() {
+		registered_instrumentation_registry().dump(std::cerr);
+	}
+#endif // MSE_REGISTERED_INSTRUMENTATION1
+
 	/* CSORPTracker is a "size optimized" (smaller and slower) version of CSPTracker. Currently not used. */
 	class CSORPTracker {
 	public:
@@ -283,9 +615,9 @@ namespace mse {
 
 		void registerPointer(const CSaferPtrBase& sp_ref) {
 			if (!m_ptr_to_regptr_set_ptr) {
-				m_ptr_to_regptr_set_ptr = new std::unordered_set<const CSaferPtrBase*>();
+				m_ptr_to_regptr_set_ptr = new impl::registered_pointer_set_type();
 			}
-			std::unordered_set<const CSaferPtrBase*>::value_type item(&sp_ref);
+			impl::registered_pointer_set_type::value_type item(&sp_ref);
 			(*m_ptr_to_regptr_set_ptr).insert(item);
 		}
 		void unregisterPointer(const CSaferPtrBase& sp_ref) {
@@ -297,6 +629,11 @@ namespace mse {
 				assert(0 != res);
 			}
 		}
+		/* As with TRPTracker<>'s slow mode, the insertion reuses the node freed by the erasure. */
+		void replacePointer(const CSaferPtrBase& old_sp_ref, const CSaferPtrBase& new_sp_ref) {
+			unregisterPointer(old_sp_ref);
+			registerPointer(new_sp_ref);
+		}
 		void onObjectDestruction() {
 			if (m_ptr_to_regptr_set_ptr) {
 				for (auto sp_ref_ptr : (*m_ptr_to_regptr_set_ptr)) {
@@ -309,31 +646,37 @@ namespace mse {
 			need to allocate more memory, and thus won't have any chance of throwing an exception due to
 			memory allocation failure. */
 			if (!m_ptr_to_regptr_set_ptr) {
-				m_ptr_to_regptr_set_ptr = new std::unordered_set<const CSaferPtrBase*>();
+				m_ptr_to_regptr_set_ptr = new impl::registered_pointer_set_type();
 			}
 			(*m_ptr_to_regptr_set_ptr).reserve((*m_ptr_to_regptr_set_ptr).size() + 1);
 		}
 
-		std::unordered_set<const CSaferPtrBase*> *m_ptr_to_regptr_set_ptr = nullptr;
+		impl::registered_pointer_set_type *m_ptr_to_regptr_set_ptr = nullptr;
 	};
 
-	template<typename _Ty, int _Tn = sc_default_cache_size> class TRegisteredObj;
-	template<typename _Ty, int _Tn = sc_default_cache_size> class TRegisteredNotNullPointer;
-	template<typename _Ty, int _Tn = sc_default_cache_size> class TRegisteredNotNullConstPointer;
-	template<typename _Ty, int _Tn = sc_default_cache_size> class TRegisteredFixedPointer;
-	template<typename _Ty, int _Tn = sc_default_cache_size> class TRegisteredFixedConstPointer;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> class TRegisteredObj;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> class TRegisteredNotNullPointer;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> class TRegisteredNotNullConstPointer;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> class TRegisteredFixedPointer;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> class TRegisteredFixedConstPointer;
 
 	/* TRegisteredPointer behaves similar to (and is largely compatible with) native pointers. It inherits the safety features of
 	TSaferPtr (default nullptr initialization and check for null pointer dereference). In addition, when pointed at a
 	TRegisteredObj, it will be checked for attempted access after destruction. It's essentially intended to be a safe pointer like
 	std::shared_ptr, but that does not take ownership of the target object (i.e. does not take responsibility for deallocation).
 	Because it does not take ownership, unlike std::shared_ptr, TRegisteredPointer can be used to point to objects on the stack. */
-	template<typename _Ty, int _Tn = sc_default_cache_size>
-	class TRegisteredPointer : public TSaferPtr<TRegisteredObj<_Ty, _Tn>> {
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value>
+	class TRegisteredPointer : public TSaferPtr<TRegisteredObj<_Ty, _Tn>>, public CSaferPtrBase, public TRPTrackerPointerNode<_Tn> {
 	public:
 		TRegisteredPointer();
 		TRegisteredPointer(TRegisteredObj<_Ty, _Tn>* ptr);
 		TRegisteredPointer(const TRegisteredPointer& src_cref);
+		/* Rather than registering itself and having the source unregister itself, the new pointer takes over the source's
+		registration. The source is left null. */
+		TRegisteredPointer(TRegisteredPointer&& src) MSE_NOEXCEPT;
+		/* Not null pointers can't be left null, so they're copied rather than moved from. */
+		template<class _TNotNullPointer, class = typename std::enable_if<std::is_base_of<TRegisteredNotNullPointer<_Ty, _Tn>, _TNotNullPointer>::value, void>::type>
+		TRegisteredPointer(_TNotNullPointer&& src) : TRegisteredPointer(static_cast<const TRegisteredPointer&>(src)) {}
 		/* The templated copy constructor accepts other TRegisteredPointer types if type of their target is "convertible"
 		to the target type if this TRegisteredPointer. Additionally, it accepts TRegisteredPointer types if their target's
 		base class is the "non-const" version of this TRegisteredPointer's target's base class. */
@@ -342,8 +685,16 @@ namespace mse {
 			, void>::type>
 		TRegisteredPointer(const TRegisteredPointer<_Ty2, _Tn>& src_cref);
 		virtual ~TRegisteredPointer();
+		/* Called by the tracker when the target object is destroyed. A tracker's entries aren't all of one pointer type. The
+		tracker of a TRegisteredObj<> is shared by the const and non-const pointers targeting it, including pointers whose
+		target type is a base class of the object's type. So a single (static) "null out" function per tracker isn't enough
+		to reset them. Without the virtual call, each entry would need to carry its own function pointer. */
+		virtual void setToNull() const { (*this).m_ptr = nullptr; }
 		TRegisteredPointer<_Ty, _Tn>& operator=(TRegisteredObj<_Ty, _Tn>* ptr);
 		TRegisteredPointer<_Ty, _Tn>& operator=(const TRegisteredPointer<_Ty, _Tn>& _Right_cref);
+		TRegisteredPointer<_Ty, _Tn>& operator=(TRegisteredPointer<_Ty, _Tn>&& _Right) MSE_NOEXCEPT;
+		template<class _TNotNullPointer, class = typename std::enable_if<std::is_base_of<TRegisteredNotNullPointer<_Ty, _Tn>, _TNotNullPointer>::value, void>::type>
+		TRegisteredPointer<_Ty, _Tn>& operator=(_TNotNullPointer&& _Right) { return operator=(static_cast<const TRegisteredPointer&>(_Right)); }
 		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 		explicit operator _Ty*() const;
 		explicit operator TRegisteredObj<_Ty, _Tn>*() const;
@@ -366,20 +717,29 @@ namespace mse {
 		const TRegisteredPointer<_Ty, _Tn>* operator&() const { return this; }
 	};
 
-	template<typename _Ty, int _Tn = sc_default_cache_size>
-	class TRegisteredConstPointer : public TSaferPtr<const TRegisteredObj<_Ty, _Tn>> {
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value>
+	class TRegisteredConstPointer : public TSaferPtr<const TRegisteredObj<_Ty, _Tn>>, public CSaferPtrBase, public TRPTrackerPointerNode<_Tn> {
 	public:
 		TRegisteredConstPointer();
 		TRegisteredConstPointer(const TRegisteredObj<_Ty, _Tn>* ptr);
 		TRegisteredConstPointer(const TRegisteredConstPointer& src_cref);
+		/* See the comment on the TRegisteredPointer move constructor. */
+		TRegisteredConstPointer(TRegisteredConstPointer&& src) MSE_NOEXCEPT;
+		template<class _TNotNullPointer, class = typename std::enable_if<std::is_base_of<TRegisteredNotNullConstPointer<_Ty, _Tn>, _TNotNullPointer>::value, void>::type>
+		TRegisteredConstPointer(_TNotNullPointer&& src) : TRegisteredConstPointer(static_cast<const TRegisteredConstPointer&>(src)) {}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<TRegisteredObj<_Ty2, _Tn> *, TRegisteredObj<_Ty, _Tn> *>::value, void>::type>
 		TRegisteredConstPointer(const TRegisteredConstPointer<_Ty2, _Tn>& src_cref);
 		TRegisteredConstPointer(const TRegisteredPointer<_Ty, _Tn>& src_cref);
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<TRegisteredObj<_Ty2, _Tn> *, TRegisteredObj<_Ty, _Tn> *>::value, void>::type>
 		TRegisteredConstPointer(const TRegisteredPointer<_Ty2, _Tn>& src_cref);
 		virtual ~TRegisteredConstPointer();
+		/* Called by the tracker when the target object is destroyed. (See the comment in TRegisteredPointer<>.) */
+		virtual void setToNull() const { (*this).m_ptr = nullptr; }
 		TRegisteredConstPointer<_Ty, _Tn>& operator=(const TRegisteredObj<_Ty, _Tn>* ptr);
 		TRegisteredConstPointer<_Ty, _Tn>& operator=(const TRegisteredConstPointer<_Ty, _Tn>& _Right_cref);
+		TRegisteredConstPointer<_Ty, _Tn>& operator=(TRegisteredConstPointer<_Ty, _Tn>&& _Right) MSE_NOEXCEPT;
+		template<class _TNotNullPointer, class = typename std::enable_if<std::is_base_of<TRegisteredNotNullConstPointer<_Ty, _Tn>, _TNotNullPointer>::value, void>::type>
+		TRegisteredConstPointer<_Ty, _Tn>& operator=(_TNotNullPointer&& _Right) { return operator=(static_cast<const TRegisteredConstPointer&>(_Right)); }
 		TRegisteredConstPointer<_Ty, _Tn>& operator=(const TRegisteredPointer<_Ty, _Tn>& _Right_cref) { return (*this).operator=(TRegisteredConstPointer(_Right_cref));  }
 		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 		explicit operator const _Ty*() const;
@@ -505,6 +865,9 @@ namespace mse {
 		TRegisteredObj(const TRegisteredObj& _X) : _TROy(_X) {}
 		TRegisteredObj(TRegisteredObj&& _X) : _TROy(std::move(_X)) {}
 		virtual ~TRegisteredObj() {
+#ifdef MSE_REGISTERED_INSTRUMENTATION1
+			registered_instrumentation_registry().record_object_destruction(typeid(_TROy), _Tn, mseRPManager().highest_num_pointers());
+#endif // MSE_REGISTERED_INSTRUMENTATION1
 			mseRPManager().onObjectDestruction();
 		}
 		using _TROy::operator=;
@@ -535,12 +898,19 @@ namespace mse {
 		}
 	}
 	template<typename _Ty, int _Tn>
-	TRegisteredPointer<_Ty, _Tn>::TRegisteredPointer(const TRegisteredPointer& src_cref) : TSaferPtr<TRegisteredObj<_Ty, _Tn>>(src_cref.m_ptr) {
+	TRegisteredPointer<_Ty, _Tn>::TRegisteredPointer(const TRegisteredPointer& src_cref) : TSaferPtr<TRegisteredObj<_Ty, _Tn>>(src_cref.m_ptr), TRPTrackerPointerNode<_Tn>() {
 		if (nullptr != (*this).m_ptr) {
 			(*((*this).m_ptr)).mseRPManager().registerPointer(*this);
 		}
 	}
 	template<typename _Ty, int _Tn>
+	TRegisteredPointer<_Ty, _Tn>::TRegisteredPointer(TRegisteredPointer&& src) MSE_NOEXCEPT : TSaferPtr<TRegisteredObj<_Ty, _Tn>>(src.m_ptr) {
+		if (nullptr != (*this).m_ptr) {
+			(*((*this).m_ptr)).mseRPManager().replacePointer(src, *this);
+			src.m_ptr = nullptr;
+		}
+	}
+	template<typename _Ty, int _Tn>
 	template<class _Ty2, class>
 	TRegisteredPointer<_Ty, _Tn>::TRegisteredPointer(const TRegisteredPointer<_Ty2, _Tn>& src_cref)
 		/* We need to use a reinterpret_cast for the cases when this TRegisteredPointer's target's base class is
@@ -582,6 +952,20 @@ namespace mse {
 	TRegisteredPointer<_Ty, _Tn>& TRegisteredPointer<_Ty, _Tn>::operator=(const TRegisteredPointer<_Ty, _Tn>& _Right_cref) {
 		return operator=(_Right_cref.m_ptr);
 	}
+	template<typename _Ty, int _Tn>
+	TRegisteredPointer<_Ty, _Tn>& TRegisteredPointer<_Ty, _Tn>::operator=(TRegisteredPointer<_Ty, _Tn>&& _Right) MSE_NOEXCEPT {
+		if (this != std::addressof(_Right)) {
+			if (nullptr != (*this).m_ptr) {
+				(*((*this).m_ptr)).mseRPManager().unregisterPointer(*this);
+			}
+			TSaferPtr<TRegisteredObj<_Ty, _Tn>>::operator=(_Right.m_ptr);
+			if (nullptr != (*this).m_ptr) {
+				(*((*this).m_ptr)).mseRPManager().replacePointer(_Right, *this);
+				_Right.m_ptr = nullptr;
+			}
+		}
+		return (*this);
+	}
 	/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 	template<typename _Ty, int _Tn>
 	TRegisteredPointer<_Ty, _Tn>::operator _Ty*() const {
@@ -609,12 +993,19 @@ namespace mse {
 		}
 	}
 	template<typename _Ty, int _Tn>
-	TRegisteredConstPointer<_Ty, _Tn>::TRegisteredConstPointer(const TRegisteredConstPointer& src_cref) : TSaferPtr<const TRegisteredObj<_Ty, _Tn>>(src_cref.m_ptr) {
+	TRegisteredConstPointer<_Ty, _Tn>::TRegisteredConstPointer(const TRegisteredConstPointer& src_cref) : TSaferPtr<const TRegisteredObj<_Ty, _Tn>>(src_cref.m_ptr), TRPTrackerPointerNode<_Tn>() {
 		if (nullptr != src_cref.m_ptr) {
 			(*(src_cref.m_ptr)).mseRPManager().registerPointer(*this);
 		}
 	}
 	template<typename _Ty, int _Tn>
+	TRegisteredConstPointer<_Ty, _Tn>::TRegisteredConstPointer(TRegisteredConstPointer&& src) MSE_NOEXCEPT : TSaferPtr<const TRegisteredObj<_Ty, _Tn>>(src.m_ptr) {
+		if (nullptr != (*this).m_ptr) {
+			(*((*this).m_ptr)).mseRPManager().replacePointer(src, *this);
+			src.m_ptr = nullptr;
+		}
+	}
+	template<typename _Ty, int _Tn>
 	template<class _Ty2, class>
 	TRegisteredConstPointer<_Ty, _Tn>::TRegisteredConstPointer(const TRegisteredConstPointer<_Ty2, _Tn>& src_cref) : TSaferPtr<TRegisteredObj<_Ty, _Tn>>(src_cref.m_ptr) {
 		if (nullptr != (*this).m_ptr) {
@@ -665,6 +1056,20 @@ namespace mse {
 	TRegisteredConstPointer<_Ty, _Tn>& TRegisteredConstPointer<_Ty, _Tn>::operator=(const TRegisteredConstPointer<_Ty, _Tn>& _Right_cref) {
 		return operator=(_Right_cref.m_ptr);
 	}
+	template<typename _Ty, int _Tn>
+	TRegisteredConstPointer<_Ty, _Tn>& TRegisteredConstPointer<_Ty, _Tn>::operator=(TRegisteredConstPointer<_Ty, _Tn>&& _Right) MSE_NOEXCEPT {
+		if (this != std::addressof(_Right)) {
+			if (nullptr != (*this).m_ptr) {
+				(*((*this).m_ptr)).mseRPManager().unregisterPointer(*this);
+			}
+			TSaferPtr<const TRegisteredObj<_Ty, _Tn>>::operator=(_Right.m_ptr);
+			if (nullptr != (*this).m_ptr) {
+				(*((*this).m_ptr)).mseRPManager().replacePointer(_Right, *this);
+				_Right.m_ptr = nullptr;
+			}
+		}
+		return (*this);
+	}
 	/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 	template<typename _Ty, int _Tn>
 	TRegisteredConstPointer<_Ty, _Tn>::operator const _Ty*() const {
@@ -684,18 +1089,42 @@ namespace mse {
 
 #endif /*MSE_REGISTEREDPOINTER_DISABLED*/
 
+	namespace impl {
+		template<class _TCheckingPolicy> class TPolicyRegistered;
+		template<> class TPolicyRegistered<CCheckedPolicy> {
+		public:
+			template<typename _Ty, int _Tn> using pointer_type = TRegisteredPointer<_Ty, _Tn>;
+			template<typename _Ty, int _Tn> using const_pointer_type = TRegisteredConstPointer<_Ty, _Tn>;
+			template<typename _Ty, int _Tn> using obj_type = TRegisteredObj<_Ty, _Tn>;
+		};
+		template<> class TPolicyRegistered<CUncheckedPolicy> {
+		public:
+			template<typename _Ty, int _Tn> using pointer_type = _Ty*;
+			template<typename _Ty, int _Tn> using const_pointer_type = const _Ty*;
+			template<typename _Ty, int _Tn> using obj_type = _Ty;
+		};
+	}
+	/* See the comment on CCheckedPolicy. A TRegisteredObj<_Ty> is a _Ty, and a registered pointer can be explicitly
+	converted to a native pointer, so a checked module can pass its registered objects to an unchecked one. */
+	template<typename _Ty, class _TCheckingPolicy = CCheckedPolicy, int _Tn = TRegisteredTrackerParam<_Ty>::value>
+	using TPolicyRegisteredPointer = typename impl::TPolicyRegistered<_TCheckingPolicy>::template pointer_type<_Ty, _Tn>;
+	template<typename _Ty, class _TCheckingPolicy = CCheckedPolicy, int _Tn = TRegisteredTrackerParam<_Ty>::value>
+	using TPolicyRegisteredConstPointer = typename impl::TPolicyRegistered<_TCheckingPolicy>::template const_pointer_type<_Ty, _Tn>;
+	template<typename _Ty, class _TCheckingPolicy = CCheckedPolicy, int _Tn = TRegisteredTrackerParam<_Ty>::value>
+	using TPolicyRegisteredObj = typename impl::TPolicyRegistered<_TCheckingPolicy>::template obj_type<_Ty, _Tn>;
+
 	/* registered_new is intended to be analogous to std::make_shared */
-	template <class _Ty, int _Tn = sc_default_cache_size, class... Args>
+	template <class _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value, class... Args>
 	TRegisteredPointer<_Ty, _Tn> registered_new(Args&&... args) {
 		return new TRegisteredObj<_Ty, _Tn>(std::forward<Args>(args)...);
 	}
-	template <class _Ty, int _Tn = sc_default_cache_size>
+	template <class _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value>
 	void registered_delete(const TRegisteredPointer<_Ty, _Tn>& regPtrRef) {
 		//auto a = dynamic_cast<TRegisteredObj<_Ty, _Tn> *>((_Ty*)regPtrRef);
 		auto a = (TRegisteredObj<_Ty, _Tn>*)regPtrRef;
 		delete a;
 	}
-	template <class _Ty, int _Tn = sc_default_cache_size>
+	template <class _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value>
 	void registered_delete(const TRegisteredConstPointer<_Ty, _Tn>& regPtrRef) {
 		//auto a = dynamic_cast<TRegisteredObj<_Ty, _Tn> *>((_Ty*)regPtrRef);
 		auto a = (const TRegisteredObj<_Ty, _Tn>*)regPtrRef;
@@ -721,7 +1150,7 @@ namespace mse {
 #endif /*_MSC_VER*/
 
 #ifdef MSEREGISTEREDREFWRAPPER
-	template <class _TRRWy, int _TRRWn = sc_default_cache_size>
+	template <class _TRRWy, int _TRRWn = TRegisteredTrackerParam<_TRRWy>::value>
 	class TRegisteredRefWrapper {
 	public:
 		// types
@@ -757,16 +1186,16 @@ namespace mse {
 #endif /*MSE_REGISTEREDPOINTER_DISABLED*/
 
 	/* shorter aliases */
-	template<typename _Ty, int _Tn = sc_default_cache_size> using rp = TRegisteredPointer<_Ty, _Tn>;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using rcp = TRegisteredConstPointer<_Ty, _Tn>;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using rnnp = TRegisteredNotNullPointer<_Ty, _Tn>;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using rnncp = TRegisteredNotNullConstPointer<_Ty, _Tn>;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using rfp = TRegisteredFixedPointer<_Ty, _Tn>;
-	template<typename _Ty, int _Tn = sc_default_cache_size> using rfcp = TRegisteredFixedConstPointer<_Ty, _Tn>;
-	template<typename _TROy, int _Tn = sc_default_cache_size> using ro = TRegisteredObj<_TROy, _Tn>;
-	template <class _Ty, int _Tn = sc_default_cache_size, class... Args>
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using rp = TRegisteredPointer<_Ty, _Tn>;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using rcp = TRegisteredConstPointer<_Ty, _Tn>;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using rnnp = TRegisteredNotNullPointer<_Ty, _Tn>;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using rnncp = TRegisteredNotNullConstPointer<_Ty, _Tn>;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using rfp = TRegisteredFixedPointer<_Ty, _Tn>;
+	template<typename _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value> using rfcp = TRegisteredFixedConstPointer<_Ty, _Tn>;
+	template<typename _TROy, int _Tn = TRegisteredTrackerParam<_TROy>::value> using ro = TRegisteredObj<_TROy, _Tn>;
+	template <class _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value, class... Args>
 	TRegisteredPointer<_Ty, _Tn> rnew(Args&&... args) { return registered_new<_Ty, _Tn>(std::forward<Args>(args)...); }
-	template <class _Ty, int _Tn = sc_default_cache_size>
+	template <class _Ty, int _Tn = TRegisteredTrackerParam<_Ty>::value>
 	void rdelete(const TRegisteredPointer<_Ty, _Tn>& regPtrRef) { registered_delete<_Ty, _Tn>(regPtrRef); }
 
 	/* deprecated aliases */
@@ -775,37 +1204,37 @@ namespace mse {
 
 
 #ifdef MSEREGISTEREDREFWRAPPER
-	template <class _TRRWy, int _TRRWn = sc_default_cache_size> using rrw = TRegisteredRefWrapper<_TRRWy, _TRRWn>;
+	template <class _TRRWy, int _TRRWn = TRegisteredTrackerParam<_TRRWy>::value> using rrw = TRegisteredRefWrapper<_TRRWy, _TRRWn>;
 
 	// TEMPLATE FUNCTIONS ref AND cref
-	template<class _TRRy, int _TRRn = sc_default_cache_size> inline
+	template<class _TRRy, int _TRRn = TRegisteredTrackerParam<_TRRy>::value> inline
 		TRegisteredRefWrapper<_TRRy, _TRRn>
 		registered_ref(TRegisteredObj<_TRRy, _TRRn>& _Val)
 	{	// create TRegisteredRefWrapper<_TRRy, _TRRn> object
 		return (TRegisteredRefWrapper<_TRRy, _TRRn>(_Val));
 	}
 
-	template<class _TRRy, int _TRRn = sc_default_cache_size>
+	template<class _TRRy, int _TRRn = TRegisteredTrackerParam<_TRRy>::value>
 	void registered_ref(const TRegisteredObj<_TRRy, _TRRn>&&) = delete;
 
-	template<class _TRRy, int _TRRn = sc_default_cache_size> inline
+	template<class _TRRy, int _TRRn = TRegisteredTrackerParam<_TRRy>::value> inline
 		TRegisteredRefWrapper<_TRRy, _TRRn>
 		registered_ref(TRegisteredRefWrapper<_TRRy, _TRRn> _Val)
 	{	// create TRegisteredRefWrapper<_TRRy, _TRRn> object
 		return (registered_ref(_Val.get()));
 	}
 
-	template<class _TRCRy, int _TRCRn = sc_default_cache_size> inline
+	template<class _TRCRy, int _TRCRn = TRegisteredTrackerParam<_TRCRy>::value> inline
 		TRegisteredRefWrapper<const _TRCRy, _TRCRn>
 		registered_cref(const TRegisteredObj<_TRCRy, _TRCRn>& _Val)
 	{	// create TRegisteredRefWrapper<const _TRCRy, _TRCRn> object
 		return (TRegisteredRefWrapper<const _TRCRy, _TRCRn>(_Val));
 	}
 
-	template<class _TRCRy, int _TRCRn = sc_default_cache_size>
+	template<class _TRCRy, int _TRCRn = TRegisteredTrackerParam<_TRCRy>::value>
 	void registered_cref(const TRegisteredObj<_TRCRy, _TRCRn>&&) = delete;
 
-	template<class _TRCRy, int _TRCRn = sc_default_cache_size> inline
+	template<class _TRCRy, int _TRCRn = TRegisteredTrackerParam<_TRCRy>::value> inline
 		TRegisteredRefWrapper<const _TRCRy, _TRCRn>
 		registered_cref(TRegisteredRefWrapper<_TRCRy, _TRCRn> _Val)
 	{	// create TRegisteredRefWrapper<const _TRCRy, _TRCRn> object
@@ -939,6 +1368,34 @@ namespace mse {
 			mse::TRegisteredFixedConstPointer<A> A_registered_fcptr1 = &registered_da;
 		}
 
+		{
+			/* Registered objects (and pointers) can use an intrusive linked list (instead of an array) to keep track of
+			the pointers targeting them. */
+			mse::TRegisteredPointer<A, mse::sc_intrusive_list_tracker> A_ilrp1;
+			mse::TRegisteredPointer<A, mse::sc_intrusive_list_tracker> A_ilrp2;
+			mse::TRegisteredConstPointer<A, mse::sc_intrusive_list_tracker> A_ilrcp1;
+			{
+				mse::TRegisteredObj<A, mse::sc_intrusive_list_tracker> ilregistered_a;
+				A_ilrp1 = &ilregistered_a;
+				mse::TRegisteredPointer<A, mse::sc_intrusive_list_tracker> A_ilrp3 = A_ilrp1;
+				A_ilrp2 = A_ilrp3;
+				A_ilrcp1 = A_ilrp3;
+				{
+					mse::TRegisteredFixedPointer<A, mse::sc_intrusive_list_tracker> A_ilrfp1 = &ilregistered_a;
+					assert(3 == A_ilrfp1->b);
+				}
+				A_ilrp3 = nullptr;
+				assert(3 == A_ilrp2->b);
+				assert(3 == A_ilrcp1->b);
+			}
+#ifndef MSE_REGISTEREDPOINTER_DISABLED
+			/* The pointers still registered when the object was destroyed should now be null. */
+			assert(!A_ilrp1);
+			assert(!A_ilrp2);
+			assert(!A_ilrcp1);
+#endif // !MSE_REGISTEREDPOINTER_DISABLED
+		}
+
 		{
 			/* Obtaining safe pointers to members of registered objects: */
 			class E {
@@ -5,6 +5,7 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 
 #include "mserelaxedregistered.h"
+#include <cstdint>
 
 #ifdef _MSC_VER
 #include "windows.h"
@@ -13,21 +14,207 @@
 
 namespace mse {
 
+	CSPTrackerObjectPointerTable::~CSPTrackerObjectPointerTable() {
+		for (size_t i = 0; i < m_capacity; i += 1) {
+			m_entries[i].clear();
+		}
+		delete[] m_entries;
+	}
+
+	void CSPTrackerObjectPointerTable::CEntry::push_back(const CSaferPtrBase* sp_ptr) {
+		const int capacity = (nullptr != m_heap_pointer_ptrs) ? m_heap_capacity : sc_num_inline_pointers;
+		if (capacity == m_num_pointers) {
+			const int new_capacity = 2 * capacity;
+			auto new_pointer_ptrs = new const CSaferPtrBase*[new_capacity];
+			auto old_pointer_ptrs = pointer_ptrs();
+			for (int i = 0; i < m_num_pointers; i += 1) {
+				new_pointer_ptrs[i] = old_pointer_ptrs[i];
+			}
+			delete[] m_heap_pointer_ptrs;
+			m_heap_pointer_ptrs = new_pointer_ptrs;
+			m_heap_capacity = new_capacity;
+		}
+		pointer_ptrs()[m_num_pointers] = sp_ptr;
+		m_num_pointers += 1;
+	}
+
+	bool CSPTrackerObjectPointerTable::CEntry::erase(const CSaferPtrBase* sp_ptr) {
+		auto pointer_ptrs1 = pointer_ptrs();
+		/* The most recently registered pointers are the most likely to be unregistered first, so we search from the back. */
+		for (int i = (m_num_pointers - 1); i >= 0; i -= 1) {
+			if (sp_ptr == pointer_ptrs1[i]) {
+				/* The order of the pointers doesn't matter, so we just move the last one into the vacated spot. */
+				pointer_ptrs1[i] = pointer_ptrs1[m_num_pointers - 1];
+				m_num_pointers -= 1;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CSPTrackerObjectPointerTable::CEntry::clear() {
+		delete[] m_heap_pointer_ptrs;
+		m_heap_pointer_ptrs = nullptr;
+		m_heap_capacity = 0;
+		m_num_pointers = 0;
+		m_object_ptr = nullptr;
+	}
+
+	size_t CSPTrackerObjectPointerTable::home_index(void *obj_ptr) const {
+		/* Object addresses are aligned and often allocated close together, so we mix the bits before masking. */
+		size_t hash = size_t(reinterpret_cast<std::uintptr_t>(obj_ptr));
+		hash ^= (hash >> 17);
+		hash *= size_t(0x9E3779B97F4A7C15ULL);
+		hash ^= (hash >> 29);
+		return (hash & (m_capacity - 1));
+	}
+
+	size_t CSPTrackerObjectPointerTable::find_index(void *obj_ptr) const {
+		if (0 == m_num_entries) { return m_capacity; }
+		for (size_t i = home_index(obj_ptr); ; i = ((i + 1) & (m_capacity - 1))) {
+			auto entry_obj_ptr = m_entries[i].m_object_ptr;
+			if (obj_ptr == entry_obj_ptr) {
+				return i;
+			}
+			else if (nullptr == entry_obj_ptr) {
+				return m_capacity;
+			}
+		}
+	}
+
+	void CSPTrackerObjectPointerTable::rehash(size_t new_capacity) {
+		auto old_entries = m_entries;
+		auto old_capacity = m_capacity;
+		m_entries = new CEntry[new_capacity];
+		m_capacity = new_capacity;
+		for (size_t i = 0; i < old_capacity; i += 1) {
+			if (nullptr != old_entries[i].m_object_ptr) {
+				size_t j = home_index(old_entries[i].m_object_ptr);
+				while (nullptr != m_entries[j].m_object_ptr) {
+					j = ((j + 1) & (m_capacity - 1));
+				}
+				/* The entry (including ownership of its heap allocated pointer list, if any) is moved bitwise. */
+				m_entries[j] = old_entries[i];
+			}
+		}
+		delete[] old_entries;
+	}
+
+	void CSPTrackerObjectPointerTable::reserve(size_t num_objects) {
+		/* We keep the load factor at or below one half. */
+		size_t required_capacity = 2 * num_objects;
+		if (m_capacity < required_capacity) {
+			size_t new_capacity = (16 > m_capacity) ? 16 : m_capacity;
+			while (new_capacity < required_capacity) {
+				new_capacity *= 2;
+			}
+			rehash(new_capacity);
+		}
+	}
+
+	void CSPTrackerObjectPointerTable::remove_entry_at(size_t index) {
+		m_entries[index].clear();
+		/* "Backward shift" deletion. Subsequent entries in the probe sequence are moved back so that lookups don't need
+		"tombstones". */
+		size_t i = index;
+		size_t j = index;
+		while (true) {
+			j = ((j + 1) & (m_capacity - 1));
+			if (nullptr == m_entries[j].m_object_ptr) {
+				break;
+			}
+			size_t k = home_index(m_entries[j].m_object_ptr);
+			/* The entry at j can be moved to i only if its home index does not lie (cyclically) in (i, j]. */
+			bool home_is_in_range = (i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j));
+			if (!home_is_in_range) {
+				m_entries[i] = m_entries[j];
+				m_entries[j] = CEntry();
+				i = j;
+			}
+		}
+		m_num_entries -= 1;
+	}
+
+	void CSPTrackerObjectPointerTable::insert(void *obj_ptr, const CSaferPtrBase* sp_ptr) {
+		reserve(m_num_entries + 1);
+		size_t i = home_index(obj_ptr);
+		while (true) {
+			auto& entry_ref = m_entries[i];
+			if (obj_ptr == entry_ref.m_object_ptr) {
+				entry_ref.push_back(sp_ptr);
+				return;
+			}
+			else if (nullptr == entry_ref.m_object_ptr) {
+				entry_ref.m_object_ptr = obj_ptr;
+				entry_ref.push_back(sp_ptr);
+				m_num_entries += 1;
+				return;
+			}
+			i = ((i + 1) & (m_capacity - 1));
+		}
+	}
+
+	bool CSPTrackerObjectPointerTable::erase(void *obj_ptr, const CSaferPtrBase* sp_ptr) {
+		auto index = find_index(obj_ptr);
+		if (m_capacity == index) { return false; }
+		auto& entry_ref = m_entries[index];
+		bool retval = entry_ref.erase(sp_ptr);
+		if (0 == entry_ref.m_num_pointers) {
+			remove_entry_at(index);
+		}
+		return retval;
+	}
+
+	void CSPTrackerObjectPointerTable::onObjectDestruction(void *obj_ptr) {
+		auto index = find_index(obj_ptr);
+		if (m_capacity == index) { return; }
+		auto& entry_ref = m_entries[index];
+		auto pointer_ptrs = entry_ref.pointer_ptrs();
+		for (int i = 0; i < entry_ref.m_num_pointers; i += 1) {
+			(*(pointer_ptrs[i])).setToNull();
+		}
+		remove_entry_at(index);
+	}
+
+	void CSPTrackerObjectPointerTable::onObjectRangeDestruction(const void *begin, const void *end) {
+		const auto begin_address = reinterpret_cast<std::uintptr_t>(begin);
+		const auto end_address = reinterpret_cast<std::uintptr_t>(end);
+		size_t i = 0;
+		while ((0 < m_num_entries) && (i < m_capacity)) {
+			auto& entry_ref = m_entries[i];
+			const auto address = reinterpret_cast<std::uintptr_t>(entry_ref.m_object_ptr);
+			if ((nullptr != entry_ref.m_object_ptr) && (begin_address <= address) && (address < end_address)) {
+				auto pointer_ptrs = entry_ref.pointer_ptrs();
+				for (int j = 0; j < entry_ref.m_num_pointers; j += 1) {
+					(*(pointer_ptrs[j])).setToNull();
+				}
+				/* The removal may shift a subsequent (not yet examined) entry into this slot, so we don't advance. */
+				remove_entry_at(i);
+			}
+			else {
+				i += 1;
+			}
+		}
+	}
+
 	bool CSPTracker::registerPointer(const CSaferPtrBase& sp_ref, void *obj_ptr) {
 		if (nullptr == obj_ptr) { return true; }
+		if (isInDyingRange(obj_ptr)) { m_num_registrations_in_dying_range += 1; }
 		{
 			//std::lock_guard<std::mutex> lock(m_mutex);
 
 			/* check if the object is in "fast storage 1" first */
 			for (int i = (m_num_fs1_objects - 1); i >= 0; i -= 1) {
 				if (obj_ptr == m_fs1_objects[i].m_object_ptr) {
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+					m_instrumentation.m_num_fs1_hits += 1;
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 					auto& fs1_object_ref = m_fs1_objects[i];
 					if (sc_fs1_max_pointers == fs1_object_ref.m_num_pointers) {
 						/* Too many pointers. We're gonna move this object to slow storage. */
 						moveObjectFromFastStorage1ToSlowStorage(i);
 						/* Then add the new object-pointer mapping to slow storage. */
-						std::unordered_multimap<void*, const CSaferPtrBase*>::value_type item(obj_ptr, &sp_ref);
-						m_obj_pointer_map.insert(item);
+						m_obj_pointer_map.insert(obj_ptr, &sp_ref);
 						return true;
 					}
 					else {
@@ -40,13 +227,7 @@ namespace mse {
 			}
 
 			/* The object was not in "fast storage 1". Check if it's in "slow storage". */
-			bool object_is_in_slow_storage = false;
-			if (1 <= m_obj_pointer_map.size()) {
-				auto found_it = m_obj_pointer_map.find(obj_ptr);
-				if (m_obj_pointer_map.end() != found_it) {
-					object_is_in_slow_storage = true;
-				}
-			}
+			bool object_is_in_slow_storage = m_obj_pointer_map.contains(obj_ptr);
 
 			if ((!object_is_in_slow_storage) && (1 <= sc_fs1_max_objects) && (1 <= sc_fs1_max_pointers)) {
 				/* We'll add this object to fast storage. */
@@ -59,12 +240,20 @@ namespace mse {
 				fs1_object_ref.m_pointer_ptrs[0] = &sp_ref;
 				fs1_object_ref.m_num_pointers = 1;
 				m_num_fs1_objects += 1;
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+				note_fs1_size();
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 				return true;
 			}
 			else {
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+				if (object_is_in_slow_storage) { m_instrumentation.m_num_ss_hits += 1; }
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 				/* Add the mapping to slow storage. */
-				std::unordered_multimap<void*, const CSaferPtrBase*>::value_type item(obj_ptr, &sp_ref);
-				m_obj_pointer_map.insert(item);
+				m_obj_pointer_map.insert(obj_ptr, &sp_ref);
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+				note_ss_size();
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 			}
 		}
 		return true;
@@ -79,6 +268,9 @@ namespace mse {
 			/* check if the object is in "fast storage 1" first */
 			for (int i = (m_num_fs1_objects - 1); i >= 0; i -= 1) {
 				if (obj_ptr == m_fs1_objects[i].m_object_ptr) {
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+					m_instrumentation.m_num_fs1_hits += 1;
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 					auto& fs1_object_ref = m_fs1_objects[i];
 					if (1 == fs1_object_ref.m_num_pointers) {
 						/* Special case code just for speed. */
@@ -117,28 +309,29 @@ namespace mse {
 			}
 
 			/* The object was not in "fast storage 1". It's proably in "slow storage". */
-			auto range = m_obj_pointer_map.equal_range(obj_ptr);
-			if (true) {
-				for (auto& it = range.first; range.second != it; it++) {
-					if (((*it).second) == &sp_ref)/*we're comparing "native pointers pointing to smart pointers" here*/ {
-						m_obj_pointer_map.erase(it);
-						retval = true;
-						break;
-					}
-				}
-			}
+			retval = m_obj_pointer_map.erase(obj_ptr, &sp_ref);
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+			if (retval) { m_instrumentation.m_num_ss_hits += 1; }
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 		}
 		return retval;
 	}
 
 	void CSPTracker::onObjectDestruction(void *obj_ptr) {
 		if (nullptr == obj_ptr) { assert(false); return; }
+		if ((0 == m_num_registrations_in_dying_range) && isInDyingRange(obj_ptr)) {
+			/* The pointers targeting this object were already nulled by beginObjectRangeDestruction(). */
+			return;
+		}
 		{
 			//std::lock_guard<std::mutex> lock(m_mutex);
 
 			/* check if the object is in "fast storage 1" first */
 			for (int i = (m_num_fs1_objects - 1); i >= 0; i -= 1) {
 				if (obj_ptr == m_fs1_objects[i].m_object_ptr) {
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+					m_instrumentation.m_num_fs1_hits += 1;
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 					auto& fs1_object_ref = m_fs1_objects[i];
 					for (int j = 0; j < fs1_object_ref.m_num_pointers; j += 1) {
 						(*(fs1_object_ref.m_pointer_ptrs[j])).setToNull();
@@ -149,11 +342,10 @@ namespace mse {
 			}
 
 			/* The object was not in "fast storage 1". It's proably in "slow storage". */
-			auto range = m_obj_pointer_map.equal_range(obj_ptr);
-			for (auto it = range.first; range.second != it; it++) {
-				(*((*it).second)).setToNull();
-			}
-			m_obj_pointer_map.erase(obj_ptr);
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+			if (m_obj_pointer_map.contains(obj_ptr)) { m_instrumentation.m_num_ss_hits += 1; }
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+			m_obj_pointer_map.onObjectDestruction(obj_ptr);
 		}
 	}
 
@@ -169,10 +361,45 @@ namespace mse {
 			fs1_object_ref.m_object_ptr = obj_ptr;
 			fs1_object_ref.m_num_pointers = 0;
 			m_num_fs1_objects += 1;
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+			note_fs1_size();
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 			return;
 		}
 	}
 
+	bool CSPTracker::beginObjectRangeDestruction(const void *begin, const void *end) {
+		const auto begin_address = reinterpret_cast<std::uintptr_t>(begin);
+		const auto end_address = reinterpret_cast<std::uintptr_t>(end);
+		for (int i = (m_num_fs1_objects - 1); i >= 0; i -= 1) {
+			const auto address = reinterpret_cast<std::uintptr_t>(m_fs1_objects[i].m_object_ptr);
+			if ((begin_address <= address) && (address < end_address)) {
+				auto& fs1_object_ref = m_fs1_objects[i];
+				for (int j = 0; j < fs1_object_ref.m_num_pointers; j += 1) {
+					(*(fs1_object_ref.m_pointer_ptrs[j])).setToNull();
+				}
+				removeObjectFromFastStorage1(i);
+			}
+		}
+		m_obj_pointer_map.onObjectRangeDestruction(begin, end);
+
+		if (nullptr != m_dying_range_begin) {
+			/* The destruction of another range is in progress (presumably the elements being destroyed are themselves
+			containers). */
+			return false;
+		}
+		m_dying_range_begin = begin;
+		m_dying_range_end = end;
+		m_num_registrations_in_dying_range = 0;
+		return true;
+	}
+
+	void CSPTracker::endObjectRangeDestruction() {
+		m_dying_range_begin = nullptr;
+		m_dying_range_end = nullptr;
+		m_num_registrations_in_dying_range = 0;
+	}
+
 	void CSPTracker::removeObjectFromFastStorage1(int fs1_obj_index) {
 		for (int j = fs1_obj_index; j < (m_num_fs1_objects - 1); j += 1) {
 			m_fs1_objects[j] = m_fs1_objects[j + 1];
@@ -184,13 +411,68 @@ namespace mse {
 		auto& fs1_object_ref = m_fs1_objects[fs1_obj_index];
 		/* First we're gonna copy this object to slow storage. */
 		for (int j = 0; j < fs1_object_ref.m_num_pointers; j += 1) {
-			std::unordered_multimap<void*, const CSaferPtrBase*>::value_type item(fs1_object_ref.m_object_ptr, fs1_object_ref.m_pointer_ptrs[j]);
-			m_obj_pointer_map.insert(item);
+			m_obj_pointer_map.insert(fs1_object_ref.m_object_ptr, fs1_object_ref.m_pointer_ptrs[j]);
 		}
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+		m_instrumentation.m_num_fs1_to_ss_moves += 1;
+		note_ss_size();
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 		/* Then we're gonna remove the object from fast storage */
 		removeObjectFromFastStorage1(fs1_obj_index);
 	}
 
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+	CSPTracker::CInstrumentation& CSPTracker::CInstrumentation::operator+=(const CInstrumentation& rhs) {
+		m_num_fs1_hits += rhs.m_num_fs1_hits;
+		m_num_ss_hits += rhs.m_num_ss_hits;
+		m_num_fs1_to_ss_moves += rhs.m_num_fs1_to_ss_moves;
+		if (rhs.m_highest_num_fs1_objects > m_highest_num_fs1_objects) { m_highest_num_fs1_objects = rhs.m_highest_num_fs1_objects; }
+		if (rhs.m_highest_num_ss_objects > m_highest_num_ss_objects) { m_highest_num_ss_objects = rhs.m_highest_num_ss_objects; }
+		return (*this);
+	}
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+
+#ifndef MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+	/* The destructor of this (thread_local) object notifies the tracker map when the thread exits. */
+	class CSPTrackerThreadExitNotifier {
+	public:
+		~CSPTrackerThreadExitNotifier();
+		bool m_is_registered = false;
+	};
+	static thread_local CSPTrackerThreadExitNotifier tl_thread_exit_notifier;
+	/* Unlike tl_thread_exit_notifier, this flag remains accessible while the thread's thread_local objects are being
+	destroyed. */
+	static thread_local bool tl_thread_is_exiting = false;
+
+	CSPTrackerThreadExitNotifier::~CSPTrackerThreadExitNotifier() {
+		tl_thread_is_exiting = true;
+		/* Any (relaxed registered) objects or pointers destroyed after this point will look up the tracker the slow way. */
+		CSPTrackerMap::tl_sp_tracker_ptr_ref() = nullptr;
+		if (m_is_registered) {
+			gSPTrackerMap.onThreadExit(MSE_GET_CURRENT_THREAD_ID);
+		}
+	}
+
+	CSPTracker& CSPTrackerMap::CurrentThreadSPTrackerRefSlowPath() {
+		auto& sp_tracker_ref = SPTrackerRef(MSE_GET_CURRENT_THREAD_ID);
+		if (!tl_thread_is_exiting) {
+			tl_sp_tracker_ptr_ref() = &sp_tracker_ref;
+			tl_thread_exit_notifier.m_is_registered = true;
+		}
+		return sp_tracker_ref;
+	}
+
+	void CSPTrackerMap::onThreadExit(const MSE_THREAD_ID_TYPE &thread_id_cref) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto found_it = m_tracker_map.find(thread_id_cref);
+		if (m_tracker_map.end() != found_it) {
+			/* Objects and pointers created by this thread may outlive it (and may still be referencing its tracker), so
+			rather than deleting the tracker here we just mark it as a candidate for removal once it's empty. */
+			(*((*found_it).second)).m_owning_thread_has_exited = true;
+		}
+	}
+#endif // !MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+
 #ifdef _MSC_VER
 	MSE_THREAD_ID_TYPE CSPTrackerMap::mseWindowsGetCurrentThreadId() {
 		return GetCurrentThreadId();
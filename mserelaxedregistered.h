@@ -23,6 +23,7 @@ former purpose could be satisfied with a faster, safer, "header file only" set o
 //include "mseprimitives.h"
 #include "msepointerbasics.h"
 #include <utility>
+#include <functional>
 #include <unordered_map>
 #include <mutex>
 #include <cassert>
@@ -83,6 +84,68 @@ namespace mse {
 		using std::logic_error::logic_error;
 	};
 
+#ifndef MSE_RELAXEDREGISTERED_FS1_MAX_POINTERS
+#define MSE_RELAXEDREGISTERED_FS1_MAX_POINTERS 3/* must be at least 1 */
+#endif // !MSE_RELAXEDREGISTERED_FS1_MAX_POINTERS
+#ifndef MSE_RELAXEDREGISTERED_FS1_MAX_OBJECTS
+#define MSE_RELAXEDREGISTERED_FS1_MAX_OBJECTS 8/* Arbitrary. The optimal number depends on how slow "slow storage" is. */
+#endif // !MSE_RELAXEDREGISTERED_FS1_MAX_OBJECTS
+	/* Note that, like the other settings that affect the layout of the tracker, these need to be the same for every
+	translation unit, including mserelaxedregistered.cpp. */
+
+	/* CSPTrackerObjectPointerTable is the "slow storage" used by CSPTracker. It's an open addressing (linear probing) hash
+	table keyed by object address. Each entry holds the list of (pointers to) the pointers targeting the object, stored inline
+	unless there are more than a handful of them. So (unlike with an unordered_multimap) all the pointers targeting an object
+	are found with a single lookup, and registering a pointer generally doesn't allocate. */
+	class CSPTrackerObjectPointerTable {
+	public:
+		CSPTrackerObjectPointerTable() {}
+		~CSPTrackerObjectPointerTable();
+		CSPTrackerObjectPointerTable(const CSPTrackerObjectPointerTable& src_cref) = delete;
+		CSPTrackerObjectPointerTable& operator=(const CSPTrackerObjectPointerTable& src_cref) = delete;
+
+		void insert(void *obj_ptr, const CSaferPtrBase* sp_ptr);
+		/* Returns false if the given mapping was not found. */
+		bool erase(void *obj_ptr, const CSaferPtrBase* sp_ptr);
+		bool contains(void *obj_ptr) const { return (m_capacity != find_index(obj_ptr)); }
+		/* Calls setToNull() on all the pointers targeting the given object and removes the object from the table. */
+		void onObjectDestruction(void *obj_ptr);
+		/* Does the same for every object in the address range [begin, end) in a single sweep of the table. */
+		void onObjectRangeDestruction(const void *begin, const void *end);
+		/* Ensures that the (table) storage for the given number of objects is allocated. */
+		void reserve(size_t num_objects);
+		/* The number of objects in the table. */
+		size_t size() const { return m_num_entries; }
+
+		MSE_CONSTEXPR static const int sc_num_inline_pointers = 4;
+		class CEntry {
+		public:
+			const CSaferPtrBase** pointer_ptrs() { return (nullptr != m_heap_pointer_ptrs) ? m_heap_pointer_ptrs : m_inline_pointer_ptrs; }
+			void push_back(const CSaferPtrBase* sp_ptr);
+			bool erase(const CSaferPtrBase* sp_ptr);
+			void clear();
+
+			/* A null object pointer indicates an unoccupied slot. */
+			void* m_object_ptr = nullptr;
+			int m_num_pointers = 0;
+			int m_heap_capacity = 0;
+			const CSaferPtrBase** m_heap_pointer_ptrs = nullptr;
+			const CSaferPtrBase* m_inline_pointer_ptrs[sc_num_inline_pointers];
+		};
+
+	private:
+		size_t home_index(void *obj_ptr) const;
+		/* Returns m_capacity if the object is not in the table. */
+		size_t find_index(void *obj_ptr) const;
+		void remove_entry_at(size_t index);
+		void rehash(size_t new_capacity);
+
+		/* Entries are moved around (bitwise) by the table. Ownership of any heap allocated pointer list goes with them. */
+		CEntry* m_entries = nullptr;
+		size_t m_capacity = 0;/* always zero or a power of two */
+		size_t m_num_entries = 0;
+	};
+
 	/* CSPTracker is intended to keep track of all pointers, objects and their lifespans in order to ensure that pointers don't
 	end up pointing to deallocated objects. */
 	class CSPTracker {
@@ -97,6 +160,17 @@ namespace mse {
 		bool unregisterPointer(const CSaferPtrBase& sp_ref, const void *obj_ptr) { return (*this).unregisterPointer(sp_ref, (void *)obj_ptr); }
 		void onObjectDestruction(const void *obj_ptr) { (*this).onObjectDestruction((void *)obj_ptr); }
 		void onObjectConstruction(const void *obj_ptr) { (*this).onObjectConstruction((void *)obj_ptr); }
+		/* Nulls all the pointers targeting any object in the address range [begin, end) in a single sweep of the storage
+		(rather than one search per object) and, for the duration of the range's destruction, lets the individual
+		onObjectDestruction() calls for those objects return without searching. Returns false if the destruction of
+		another range is already in progress, in which case only the sweep is done. (Containers use this via
+		CSPTrackerRangeDestructionNotifier.) */
+		bool beginObjectRangeDestruction(const void *begin, const void *end);
+		void endObjectRangeDestruction();
+		bool isInDyingRange(const void *obj_ptr) const {
+			return (nullptr != m_dying_range_begin) && (std::less_equal<const void *>()(m_dying_range_begin, obj_ptr))
+				&& (std::less<const void *>()(obj_ptr, m_dying_range_end));
+		}
 		void reserve_space_for_one_more() {
 			/* The purpose of this function is to ensure that the next call to registerPointer() won't
 			need to allocate more memory, and thus won't have any chance of throwing an exception due to
@@ -110,69 +184,118 @@ namespace mse {
 		"fast storage1" is ugly. The code for "slow storage" is more readable. */
 		void removeObjectFromFastStorage1(int fs1_obj_index);
 		void moveObjectFromFastStorage1ToSlowStorage(int fs1_obj_index);
-		MSE_CONSTEXPR static const int sc_fs1_max_pointers = 3/* must be at least 1 */;
+		MSE_CONSTEXPR static const int sc_fs1_max_pointers = MSE_RELAXEDREGISTERED_FS1_MAX_POINTERS;
 		class CFS1Object {
 		public:
 			void* m_object_ptr;
 			const CSaferPtrBase* m_pointer_ptrs[sc_fs1_max_pointers];
 			int m_num_pointers = 0;
 		};
-		MSE_CONSTEXPR static const int sc_fs1_max_objects = 8/* Arbitrary. The optimal number depends on how slow "slow storage" is. */;
+		MSE_CONSTEXPR static const int sc_fs1_max_objects = MSE_RELAXEDREGISTERED_FS1_MAX_OBJECTS;
 		CFS1Object m_fs1_objects[sc_fs1_max_objects];
 		int m_num_fs1_objects = 0;
 
 		/* "slow storage" */
-		std::unordered_multimap<void*, const CSaferPtrBase*> m_obj_pointer_map;
+		CSPTrackerObjectPointerTable m_obj_pointer_map;
+
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+		/* These counters are intended to help with tuning the sc_fs1_* constants against real workloads. */
+		class CInstrumentation {
+		public:
+			CInstrumentation& operator+=(const CInstrumentation& rhs);
+			/* The number of register/unregister/destruction operations whose target object was found in "fast storage1". */
+			size_t m_num_fs1_hits = 0;
+			/* The number of register/unregister/destruction operations whose target object was found in "slow storage". */
+			size_t m_num_ss_hits = 0;
+			/* The number of objects moved from "fast storage1" to "slow storage" (due to either too many objects or too
+			many pointers). */
+			size_t m_num_fs1_to_ss_moves = 0;
+			size_t m_highest_num_fs1_objects = 0;
+			size_t m_highest_num_ss_objects = 0;
+		};
+		void note_fs1_size() {
+			if (size_t(m_num_fs1_objects) > m_instrumentation.m_highest_num_fs1_objects) {
+				m_instrumentation.m_highest_num_fs1_objects = size_t(m_num_fs1_objects);
+			}
+		}
+		void note_ss_size() {
+			if (m_obj_pointer_map.size() > m_instrumentation.m_highest_num_ss_objects) {
+				m_instrumentation.m_highest_num_ss_objects = m_obj_pointer_map.size();
+			}
+		}
+		CInstrumentation m_instrumentation;
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+
+		/* Set (by CSPTrackerMap) once the thread associated with this tracker has exited. */
+		bool m_owning_thread_has_exited = false;
+
+		/* The address range of the objects currently being destroyed in bulk (if any). Pointers targeting objects in the
+		range that are registered after the sweep (which shouldn't normally happen) are counted so that the individual
+		destruction notifications can revert to searching the storage when necessary. */
+		const void* m_dying_range_begin = nullptr;
+		const void* m_dying_range_end = nullptr;
+		size_t m_num_registrations_in_dying_range = 0;
 
 		//std::mutex m_mutex;
 	};
 
+#if defined(MSVC2013_COMPATIBLE) || defined(MSVC2010_COMPATIBLE)
+	/* These compilers don't support thread_local. */
+#define MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+#endif // defined(MSVC2013_COMPATIBLE) || defined(MSVC2010_COMPATIBLE)
+
 	class CSPTrackerMap {
 	public:
-		CSPTrackerMap() {
-			m_first_thread_id = MSE_GET_CURRENT_THREAD_ID;
-			m_first_sp_tracker_pointer = new CSPTracker();
-			//std::unordered_map<MSE_THREAD_ID_TYPE, CSPTracker*>::value_type item(m_first_thread_id, m_first_sp_tracker_pointer);
-			//auto insert_retval = m_tracker_map.insert(item);
-		}
+		CSPTrackerMap() {}
 		~CSPTrackerMap() {
-			delete m_first_sp_tracker_pointer; m_first_sp_tracker_pointer = nullptr;
 			for (auto it = m_tracker_map.begin(); m_tracker_map.end() != it; it++) {
 				delete (*it).second; (*it).second = nullptr;
 			}
 		}
-		CSPTracker& SPTrackerRef(const MSE_THREAD_ID_TYPE &thread_id_cref) {
-			if (thread_id_cref == m_first_thread_id) {
-				return (*m_first_sp_tracker_pointer);
+		/* Returns the tracker associated with the current thread. Once a thread has obtained its tracker, subsequent calls
+		just return a (thread_local) cached pointer to it, without taking the lock or doing a hash lookup. */
+		CSPTracker& CurrentThreadSPTrackerRef() {
+#ifndef MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+			auto tl_sp_tracker_ptr = tl_sp_tracker_ptr_ref();
+			if (nullptr != tl_sp_tracker_ptr) {
+				return (*tl_sp_tracker_ptr);
 			}
-			else {
-				std::lock_guard<std::mutex> lock(m_mutex);
-
-				auto found_it = m_tracker_map.find(thread_id_cref);
-				if (m_tracker_map.end() == found_it) {
-					auto new_sp_tracker_ptr = new CSPTracker();
-					std::unordered_map<MSE_THREAD_ID_TYPE, CSPTracker*>::value_type item(thread_id_cref, new_sp_tracker_ptr);
-					auto insert_retval = m_tracker_map.insert(item);
-					number_of_added_trackers_since_last_pruning += 1;
-					if (10000/*arbitrary*/ < number_of_added_trackers_since_last_pruning) {
-						remove_empty_trackers();
-						number_of_added_trackers_since_last_pruning = 0;
-					}
-
-					found_it = insert_retval.first;
+			return CurrentThreadSPTrackerRefSlowPath();
+#else // !MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+			return SPTrackerRef(MSE_GET_CURRENT_THREAD_ID);
+#endif // !MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+		}
+		CSPTracker& SPTrackerRef(const MSE_THREAD_ID_TYPE &thread_id_cref) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			auto found_it = m_tracker_map.find(thread_id_cref);
+			if (m_tracker_map.end() == found_it) {
+				auto new_sp_tracker_ptr = new CSPTracker();
+				std::unordered_map<MSE_THREAD_ID_TYPE, CSPTracker*>::value_type item(thread_id_cref, new_sp_tracker_ptr);
+				auto insert_retval = m_tracker_map.insert(item);
+				number_of_added_trackers_since_last_pruning += 1;
+				if (10000/*arbitrary*/ < number_of_added_trackers_since_last_pruning) {
+					remove_empty_trackers();
+					number_of_added_trackers_since_last_pruning = 0;
 				}
 
-				m_first_thread_id = thread_id_cref;
-				m_first_sp_tracker_pointer = ((*found_it).second);
-
-				return (*((*found_it).second));
+				found_it = insert_retval.first;
 			}
+			/* The tracker may have been left behind by a deceased thread that had the same id. */
+			(*((*found_it).second)).m_owning_thread_has_exited = false;
+
+			return (*((*found_it).second));
 		}
+		/* Only the trackers of threads that have exited are candidates for removal, as the cached (thread_local) tracker
+		pointers of live threads need to remain valid. */
 		void remove_empty_trackers() {
-			for (auto it = m_tracker_map.begin(); m_tracker_map.end() != it; it++) {
-				if ((*it).second->isEmpty()) {
+			for (auto it = m_tracker_map.begin(); m_tracker_map.end() != it;) {
+				if ((*it).second->m_owning_thread_has_exited && (*it).second->isEmpty()) {
 					delete ((*it).second); (*it).second = nullptr;
-					m_tracker_map.erase(it);
+					it = m_tracker_map.erase(it);
+				}
+				else {
+					it++;
 				}
 			}
 		}
@@ -180,9 +303,28 @@ namespace mse {
 		static MSE_THREAD_ID_TYPE mseWindowsGetCurrentThreadId();
 #endif /*_MSC_VER*/
 
+#ifndef MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+		static CSPTracker*& tl_sp_tracker_ptr_ref() {
+			static thread_local CSPTracker* tl_sp_tracker_ptr = nullptr;
+			return tl_sp_tracker_ptr;
+		}
+		CSPTracker& CurrentThreadSPTrackerRefSlowPath();
+		void onThreadExit(const MSE_THREAD_ID_TYPE &thread_id_cref);
+#endif // !MSE_SPTRACKERMAP_NO_THREAD_LOCAL
+
+#ifdef MSE_RELAXEDREGISTERED_INSTRUMENTATION1
+		/* Returns the combined instrumentation counters of all the trackers (i.e. of all threads). The counters of other
+		threads are read without synchronization, so the result is only exact if those threads are idle. */
+		CSPTracker::CInstrumentation instrumentation_totals() {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			CSPTracker::CInstrumentation retval;
+			for (auto it = m_tracker_map.begin(); m_tracker_map.end() != it; it++) {
+				retval += (*((*it).second)).m_instrumentation;
+			}
+			return retval;
+		}
+#endif // MSE_RELAXEDREGISTERED_INSTRUMENTATION1
 
-		MSE_THREAD_ID_TYPE m_first_thread_id;
-		CSPTracker* m_first_sp_tracker_pointer = nullptr;
 		std::unordered_map<MSE_THREAD_ID_TYPE, CSPTracker*> m_tracker_map;
 		int number_of_added_trackers_since_last_pruning = 0;
 		std::mutex m_mutex;
@@ -201,13 +343,13 @@ namespace mse {
 	when replacing native pointers with "registered" pointers in legacy code, it may be the case that fewer code changes
 	(explicit casts) will be required when using this template. */
 	template<typename _Ty>
-	class TRelaxedRegisteredPointer : public TSaferPtrForLegacy<_Ty> {
+	class TRelaxedRegisteredPointer : public TSaferPtrForLegacy<_Ty>, public CSaferPtrBase {
 	public:
 		TRelaxedRegisteredPointer() : TSaferPtrForLegacy<_Ty>() {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.CurrentThreadSPTrackerRef());
 		}
 		TRelaxedRegisteredPointer(_Ty* ptr) : TSaferPtrForLegacy<_Ty>(ptr) {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.CurrentThreadSPTrackerRef());
 			m_might_not_point_to_a_TRelaxedRegisteredObj = true;
 			(*m_sp_tracker_ptr).registerPointer((*this), ptr);
 		}
@@ -234,6 +376,8 @@ namespace mse {
 			(*m_sp_tracker_ptr).unregisterPointer((*this), (*this).m_ptr);
 			(*m_sp_tracker_ptr).onObjectDestruction(this); /* Just in case there are pointers to this pointer out there. */
 		}
+		/* Called by the tracker when the target object is destroyed. */
+		virtual void setToNull() const { (*this).m_ptr = nullptr; }
 		TRelaxedRegisteredPointer<_Ty>& operator=(_Ty* ptr) {
 			(*m_sp_tracker_ptr).reserve_space_for_one_more();
 			(*m_sp_tracker_ptr).unregisterPointer((*this), (*this).m_ptr);
@@ -322,13 +466,13 @@ namespace mse {
 	};
 
 	template<typename _Ty>
-	class TRelaxedRegisteredConstPointer : public TSaferPtrForLegacy<const _Ty> {
+	class TRelaxedRegisteredConstPointer : public TSaferPtrForLegacy<const _Ty>, public CSaferPtrBase {
 	public:
 		TRelaxedRegisteredConstPointer() : TSaferPtrForLegacy<const _Ty>() {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.CurrentThreadSPTrackerRef());
 		}
 		TRelaxedRegisteredConstPointer(const _Ty* ptr) : TSaferPtrForLegacy<const _Ty>(ptr) {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
+			m_sp_tracker_ptr = &(gSPTrackerMap.CurrentThreadSPTrackerRef());
 			m_might_not_point_to_a_TRelaxedRegisteredObj = true;
 			(*m_sp_tracker_ptr).registerPointer((*this), ptr);
 		}
@@ -368,6 +512,8 @@ namespace mse {
 			(*m_sp_tracker_ptr).unregisterPointer((*this), (*this).m_ptr);
 			(*m_sp_tracker_ptr).onObjectDestruction(this); /* Just in case there are pointers to this pointer out there. */
 		}
+		/* Called by the tracker when the target object is destroyed. */
+		virtual void setToNull() const { (*this).m_ptr = nullptr; }
 		TRelaxedRegisteredConstPointer<_Ty>& operator=(const _Ty* ptr) {
 			(*m_sp_tracker_ptr).reserve_space_for_one_more();
 			(*m_sp_tracker_ptr).unregisterPointer((*this), (*this).m_ptr);
@@ -578,20 +724,66 @@ namespace mse {
 		friend class TRelaxedRegisteredObj<_Ty>;
 	};
 
+	/* Notifies the tracker of the construction and destruction of the (TRelaxedRegisteredObj) object whose address is given.
+	Note that this is the address pointers targeting the object are registered with, not the address of the notifier itself
+	(which is a member of the object). */
 	class CTrackerNotifier {
 	public:
-		CTrackerNotifier() {
-			m_sp_tracker_ptr = &(gSPTrackerMap.SPTrackerRef(MSE_GET_CURRENT_THREAD_ID));
-			(*m_sp_tracker_ptr).onObjectConstruction(this);
+		/* base_notifier_ptr is the notifier of the object's TRelaxedRegisteredObj base class, if it has one (i.e. for a
+		TRelaxedRegisteredObj of a type derived from a TRelaxedRegisteredObj). If that notifier is already reporting the
+		same address, this one reports nothing, so the tracker never holds more than one entry for the same object. */
+		CTrackerNotifier(const void* obj_ptr, const CTrackerNotifier* base_notifier_ptr) {
+			m_sp_tracker_ptr = &(gSPTrackerMap.CurrentThreadSPTrackerRef());
+			if ((nullptr == base_notifier_ptr) || (obj_ptr != (*base_notifier_ptr).m_obj_ptr)) {
+				m_obj_ptr = obj_ptr;
+				(*m_sp_tracker_ptr).onObjectConstruction(m_obj_ptr);
+			}
 		}
 		~CTrackerNotifier() {
-			(*m_sp_tracker_ptr).onObjectDestruction(this);
+			if (nullptr != m_obj_ptr) {
+				(*m_sp_tracker_ptr).onObjectDestruction(m_obj_ptr);
+			}
 		}
 		CSPTracker* trackerPtr() const { return m_sp_tracker_ptr; }
 
 		CSPTracker* m_sp_tracker_ptr = nullptr;
+		const void* m_obj_ptr = nullptr;
+
+	private:
+		CTrackerNotifier(const CTrackerNotifier&) = delete;
+		CTrackerNotifier& operator=(const CTrackerNotifier&) = delete;
+	};
+
+	/* Notifies a tracker, in bulk, of the impending destruction of the objects in a contiguous address range. The notifier
+	should be constructed before the objects are destroyed and destroyed after them. (See
+	CSPTracker::beginObjectRangeDestruction().) */
+	class CSPTrackerRangeDestructionNotifier {
+	public:
+		CSPTrackerRangeDestructionNotifier() {}
+		/* A copy is not notifying anything. */
+		CSPTrackerRangeDestructionNotifier(const CSPTrackerRangeDestructionNotifier&) {}
+		~CSPTrackerRangeDestructionNotifier() {
+			if (m_is_active) { (*m_sp_tracker_ptr).endObjectRangeDestruction(); }
+		}
+		CSPTrackerRangeDestructionNotifier& operator=(const CSPTrackerRangeDestructionNotifier&) { return (*this); }
+		void notify_range_destruction(CSPTracker& sp_tracker_ref, const void* begin, const void* end) {
+			assert(!m_is_active);
+			m_sp_tracker_ptr = &sp_tracker_ref;
+			m_is_active = sp_tracker_ref.beginObjectRangeDestruction(begin, end);
+		}
+
+	private:
+		CSPTracker* m_sp_tracker_ptr = nullptr;
+		bool m_is_active = false;
 	};
 
+	namespace impl {
+		/* Returns the tracker notifier of the given object's TRelaxedRegisteredObj base class, if it has one. */
+		template<typename _Ty>
+		const CTrackerNotifier* base_tracker_notifier_ptr(const TRelaxedRegisteredObj<_Ty>* obj_ptr) { return &((*obj_ptr).m_tracker_notifier); }
+		inline const CTrackerNotifier* base_tracker_notifier_ptr(const void*) { return nullptr; }
+	}
+
 	/* TRelaxedRegisteredObj is intended as a transparent wrapper for other classes/objects. The purpose is to register the object's
 	destruction so that TRelaxedRegisteredPointers will avoid referencing destroyed objects. Note that TRelaxedRegisteredObj can be used with
 	objects allocated on the stack. */
@@ -621,7 +813,20 @@ namespace mse {
 		}
 		CSPTracker* trackerPtr() const { return m_tracker_notifier.trackerPtr(); }
 
-		CTrackerNotifier m_tracker_notifier;
+		/* Containers (like msevector) that destroy a contiguous range of elements at once use this type (when the element
+		type provides it) to have the pointers targeting any of the elements nulled in a single sweep of the tracker,
+		rather than one search per element. */
+		class range_destruction_notifier_type : public CSPTrackerRangeDestructionNotifier {
+		public:
+			template<class _TElement>
+			void notify_range_destruction(const _TElement* first, const _TElement* last) {
+				if (first != last) {
+					CSPTrackerRangeDestructionNotifier::notify_range_destruction(*((*first).trackerPtr()), first, last);
+				}
+			}
+		};
+
+		CTrackerNotifier m_tracker_notifier{ static_cast<const _TROFLy*>(this), impl::base_tracker_notifier_ptr(static_cast<const _TROFLy*>(this)) };
 	};
 
 	/* See registered_new(). */
@@ -721,6 +926,95 @@ namespace mse {
 			mse::TRelaxedRegisteredFixedPointer<D> D_relaxedregistered_fptr2 = &relaxedregistered_gd;
 			mse::TRelaxedRegisteredFixedConstPointer<D> D_relaxedregistered_fcptr2 = &relaxedregistered_gd;
 		}
+
+		{
+			/* Pointers targeting a relaxed registered object are nulled when the object is destroyed. */
+			class FD : public mse::TRelaxedRegisteredObj<D> {};
+			mse::TRelaxedRegisteredPointer<C> c_ptr;
+			mse::TRelaxedRegisteredConstPointer<C> c_cptr;
+			mse::TRelaxedRegisteredPointer<FD> fd_ptr;
+			mse::TRelaxedRegisteredPointer<D> d_ptr2;
+			{
+				mse::TRelaxedRegisteredObj<C> regobjfl_c2;
+				c_ptr = &regobjfl_c2;
+				c_cptr = &regobjfl_c2;
+				/* The TRelaxedRegisteredObj<FD> and its TRelaxedRegisteredObj<D> base class share an address (and a
+				tracker entry). */
+				mse::TRelaxedRegisteredObj<FD> relaxedregistered_fd;
+				fd_ptr = &relaxedregistered_fd;
+				d_ptr2 = fd_ptr;
+				assert(c_ptr && c_cptr && fd_ptr && d_ptr2);
+			}
+			assert((!c_ptr) && (!c_cptr) && (!fd_ptr) && (!d_ptr2));
+		}
+
+#if !defined(MSE_REGISTEREDPOINTER_DISABLED) && !defined(MSE_SAFERPTR_DISABLED)
+		{
+			/* Exercising the tracker with enough objects and pointers to overflow "fast storage1". */
+			class CTestPtr : public mse::CSaferPtrBase {
+			public:
+				void setToNull() const { m_is_null = true; }
+				mutable bool m_is_null = false;
+			};
+			static const int num_objects = 3 * mse::CSPTracker::sc_fs1_max_objects;
+			static const int num_pointers_per_object = 4 * mse::CSPTracker::sc_fs1_max_pointers + 1;
+			int objects[num_objects];
+			CTestPtr pointers[num_objects][num_pointers_per_object];
+			mse::CSPTracker tracker;
+			for (int j = 0; j < num_pointers_per_object; j += 1) {
+				for (int i = 0; i < num_objects; i += 1) {
+					tracker.registerPointer(pointers[i][j], &(objects[i]));
+				}
+			}
+			for (int i = 0; i < num_objects; i += 1) {
+				for (int j = 0; j < num_pointers_per_object; j += 2) {
+					const bool unregistered = tracker.unregisterPointer(pointers[i][j], &(objects[i]));
+					assert(unregistered);
+					(void)unregistered;
+				}
+			}
+			for (int i = 0; i < num_objects; i += 1) {
+				tracker.onObjectDestruction(&(objects[i]));
+				for (int j = 0; j < num_pointers_per_object; j += 1) {
+					/* Only the pointers that were still registered should have been nulled. */
+					assert((1 == (j % 2)) == pointers[i][j].m_is_null);
+				}
+			}
+			assert(tracker.isEmpty());
+
+			/* Now the same objects destroyed in bulk (as a contiguous range, as a container would). */
+			for (int j = 0; j < num_pointers_per_object; j += 1) {
+				for (int i = 0; i < num_objects; i += 1) {
+					pointers[i][j].m_is_null = false;
+					tracker.registerPointer(pointers[i][j], &(objects[i]));
+				}
+			}
+			CTestPtr outside_pointer;
+			int outside_object = 0;
+			tracker.registerPointer(outside_pointer, &outside_object);
+			/* All but the first and last objects. */
+			const bool range_destruction_begun = tracker.beginObjectRangeDestruction(&(objects[1]), &(objects[num_objects - 1]));
+			assert(range_destruction_begun);
+			(void)range_destruction_begun;
+			for (int i = 1; i < (num_objects - 1); i += 1) {
+				tracker.onObjectDestruction(&(objects[i]));
+			}
+			tracker.endObjectRangeDestruction();
+			for (int i = 0; i < num_objects; i += 1) {
+				const bool in_range = ((1 <= i) && ((num_objects - 1) > i));
+				for (int j = 0; j < num_pointers_per_object; j += 1) {
+					assert(in_range == pointers[i][j].m_is_null);
+				}
+				(void)in_range;
+			}
+			assert(!outside_pointer.m_is_null);
+			tracker.onObjectDestruction(&(objects[0]));
+			tracker.onObjectDestruction(&(objects[num_objects - 1]));
+			tracker.onObjectDestruction(&outside_object);
+			assert(outside_pointer.m_is_null);
+			assert(tracker.isEmpty());
+		}
+#endif // !defined(MSE_REGISTEREDPOINTER_DISABLED) && !defined(MSE_SAFERPTR_DISABLED)
 #endif // MSE_SELF_TESTS
 	}
 }
@@ -14,6 +14,11 @@
 #include <unordered_set>
 #include <functional>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <exception>
 
 /* Defining MSE_SCOPEPOINTER_USE_RELAXED_REGISTERED will cause relaxed registered pointers to be used to help catch
 misuse of scope pointers in debug mode. Additionally defining MSE_SCOPEPOINTER_RUNTIME_CHECKS_ENABLED will cause
@@ -22,6 +27,13 @@ mse::TRelaxedRegisteredObj to be used in non-debug modes as well. */
 #include "mserelaxedregistered.h"
 #endif // MSE_SCOPEPOINTER_USE_RELAXED_REGISTERED
 
+#ifdef MSE_CUSTOM_THROW_DEFINITION
+#include <iostream>
+#define MSE_THROW(x) MSE_CUSTOM_THROW_DEFINITION(x)
+#else // MSE_CUSTOM_THROW_DEFINITION
+#define MSE_THROW(x) throw(x)
+#endif // MSE_CUSTOM_THROW_DEFINITION
+
 
 #if defined(MSE_SAFER_SUBSTITUTES_DISABLED) || defined(MSE_SAFERPTR_DISABLED)
 #define MSE_SCOPEPOINTER_DISABLED
@@ -90,6 +102,10 @@ namespace mse {
 	template<typename _Ty> class TXScopeFixedConstPointer;
 	template<typename _Ty> class TXScopeOwnerPointer;
 
+	/* The scope pointers have no virtual functions and trivial (defaulted) copy operations and destructors. So when they
+	are based on TPointerForLegacy<> (i.e. when MSE_SCOPEPOINTER_USE_RELAXED_REGISTERED isn't defined) they are trivially
+	copyable, have no vptr, and in non-debug builds are the size of, and passed in registers just like, a native pointer. */
+
 	/* Use TXScopeFixedPointer instead. */
 	template<typename _Ty>
 	class TXScopePointer : public TXScopePointerBase<_Ty> {
@@ -97,16 +113,13 @@ namespace mse {
 	private:
 		TXScopePointer() : TXScopePointerBase<_Ty>() {}
 		TXScopePointer(TXScopeObj<_Ty>* ptr) : TXScopePointerBase<_Ty>(ptr) {}
-		TXScopePointer(const TXScopePointer& src_cref) : TXScopePointerBase<_Ty>(src_cref) {}
+		TXScopePointer(const TXScopePointer& src_cref) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopePointer(const TXScopePointer<_Ty2>& src_cref) : TXScopePointerBase<_Ty>(TXScopePointerBase<_Ty2>(src_cref)) {}
-		virtual ~TXScopePointer() {}
 		TXScopePointer<_Ty>& operator=(TXScopeObj<_Ty>* ptr) {
 			return TXScopePointerBase<_Ty>::operator=(ptr);
 		}
-		TXScopePointer<_Ty>& operator=(const TXScopePointer<_Ty>& _Right_cref) {
-			return TXScopePointerBase<_Ty>::operator=(_Right_cref);
-		}
+		TXScopePointer<_Ty>& operator=(const TXScopePointer<_Ty>& _Right_cref) = default;
 		operator bool() const {
 			bool retval = ((*static_cast<const TXScopePointerBase<_Ty>*>(this)) != nullptr);
 			return retval;
@@ -134,19 +147,16 @@ namespace mse {
 	private:
 		TXScopeConstPointer() : TXScopeConstPointerBase<const _Ty>() {}
 		TXScopeConstPointer(const TXScopeObj<_Ty>* ptr) : TXScopeConstPointerBase<const _Ty>(ptr) {}
-		TXScopeConstPointer(const TXScopeConstPointer& src_cref) : TXScopeConstPointerBase<const _Ty>(src_cref) {}
+		TXScopeConstPointer(const TXScopeConstPointer& src_cref) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeConstPointer(const TXScopeConstPointer<_Ty2>& src_cref) : TXScopeConstPointerBase<const _Ty>(src_cref) {}
 		TXScopeConstPointer(const TXScopePointer<_Ty>& src_cref) : TXScopeConstPointerBase<const _Ty>(src_cref) {}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeConstPointer(const TXScopePointer<_Ty2>& src_cref) : TXScopeConstPointerBase<const _Ty>(TXScopeConstPointerBase<_Ty2>(src_cref)) {}
-		virtual ~TXScopeConstPointer() {}
 		TXScopeConstPointer<_Ty>& operator=(const TXScopeObj<_Ty>* ptr) {
 			return TXScopeConstPointerBase<_Ty>::operator=(ptr);
 		}
-		TXScopeConstPointer<_Ty>& operator=(const TXScopeConstPointer<_Ty>& _Right_cref) {
-			return TXScopeConstPointerBase<_Ty>::operator=(_Right_cref);
-		}
+		TXScopeConstPointer<_Ty>& operator=(const TXScopeConstPointer<_Ty>& _Right_cref) = default;
 		TXScopeConstPointer<_Ty>& operator=(const TXScopePointer<_Ty>& _Right_cref) { return (*this).operator=(TXScopeConstPointer(_Right_cref)); }
 		operator bool() const {
 			bool retval = (*static_cast<const TXScopeConstPointerBase<_Ty>*>(this));
@@ -174,10 +184,9 @@ namespace mse {
 	public:
 	private:
 		TXScopeNotNullPointer(TXScopeObj<_Ty>* ptr) : TXScopePointer<_Ty>(ptr) {}
-		TXScopeNotNullPointer(const TXScopeNotNullPointer& src_cref) : TXScopePointer<_Ty>(src_cref) {}
+		TXScopeNotNullPointer(const TXScopeNotNullPointer& src_cref) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeNotNullPointer(const TXScopeNotNullPointer<_Ty2>& src_cref) : TXScopePointer<_Ty>(src_cref) {}
-		virtual ~TXScopeNotNullPointer() {}
 		TXScopeNotNullPointer<_Ty>& operator=(const TXScopePointer<_Ty>& _Right_cref) {
 			TXScopePointer<_Ty>::operator=(_Right_cref);
 			return (*this);
@@ -198,13 +207,12 @@ namespace mse {
 	class TXScopeNotNullConstPointer : public TXScopeConstPointer<_Ty> {
 	public:
 	private:
-		TXScopeNotNullConstPointer(const TXScopeNotNullConstPointer<_Ty>& src_cref) : TXScopeConstPointer<_Ty>(src_cref) {}
+		TXScopeNotNullConstPointer(const TXScopeNotNullConstPointer<_Ty>& src_cref) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeNotNullConstPointer(const TXScopeNotNullConstPointer<_Ty2>& src_cref) : TXScopeConstPointer<_Ty>(src_cref) {}
 		TXScopeNotNullConstPointer(const TXScopeNotNullPointer<_Ty>& src_cref) : TXScopeConstPointer<_Ty>(src_cref) {}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeNotNullConstPointer(const TXScopeNotNullPointer<_Ty2>& src_cref) : TXScopeConstPointer<_Ty>(src_cref) {}
-		virtual ~TXScopeNotNullConstPointer() {}
 		operator bool() const { return (*static_cast<const TXScopeConstPointer<_Ty>*>(this)); }
 		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 		explicit operator const _Ty*() const { return TXScopeConstPointer<_Ty>::operator const _Ty*(); }
@@ -222,10 +230,9 @@ namespace mse {
 	template<typename _Ty>
 	class TXScopeFixedPointer : public TXScopeNotNullPointer<_Ty> {
 	public:
-		TXScopeFixedPointer(const TXScopeFixedPointer& src_cref) : TXScopeNotNullPointer<_Ty>(src_cref) {}
+		TXScopeFixedPointer(const TXScopeFixedPointer& src_cref) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeFixedPointer(const TXScopeFixedPointer<_Ty2>& src_cref) : TXScopeNotNullPointer<_Ty>(src_cref) {}
-		virtual ~TXScopeFixedPointer() {}
 		operator bool() const { return (*static_cast<const TXScopeNotNullPointer<_Ty>*>(this)); }
 		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 		explicit operator _Ty*() const { return TXScopeNotNullPointer<_Ty>::operator _Ty*(); }
@@ -245,13 +252,12 @@ namespace mse {
 	template<typename _Ty>
 	class TXScopeFixedConstPointer : public TXScopeNotNullConstPointer<_Ty> {
 	public:
-		TXScopeFixedConstPointer(const TXScopeFixedConstPointer<_Ty>& src_cref) : TXScopeNotNullConstPointer<_Ty>(src_cref) {}
+		TXScopeFixedConstPointer(const TXScopeFixedConstPointer<_Ty>& src_cref) = default;
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeFixedConstPointer(const TXScopeFixedConstPointer<_Ty2>& src_cref) : TXScopeNotNullConstPointer<_Ty>(src_cref) {}
 		TXScopeFixedConstPointer(const TXScopeFixedPointer<_Ty>& src_cref) : TXScopeNotNullConstPointer<_Ty>(src_cref) {}
 		template<class _Ty2, class = typename std::enable_if<std::is_convertible<_Ty2 *, _Ty *>::value, void>::type>
 		TXScopeFixedConstPointer(const TXScopeFixedPointer<_Ty2>& src_cref) : TXScopeNotNullConstPointer<_Ty>(src_cref) {}
-		virtual ~TXScopeFixedConstPointer() {}
 		operator bool() const { return (*static_cast<const TXScopeNotNullConstPointer<_Ty>*>(this)); }
 		/* This native pointer cast operator is just for compatibility with existing/legacy code and ideally should never be used. */
 		explicit operator const _Ty*() const { return TXScopeNotNullConstPointer<_Ty>::operator const _Ty*(); }
@@ -300,10 +306,121 @@ namespace mse {
 
 #endif /*MSE_SCOPEPOINTER_DISABLED*/
 
+	template<typename _Ty> class TXScopeOwnerPointer;
+
+	namespace impl {
+		/* The part of TXScopeArena<> that doesn't depend on the size of its inline storage. Allocation just bumps a pointer
+		within the current chunk of storage. When the current chunk is exhausted a new (larger) chunk is obtained from the
+		heap. Chunks are only released (all at once) when the arena is destroyed. */
+		class CXScopeArenaBase {
+		public:
+			void* allocate(size_t size, size_t alignment) {
+				const auto aligned_address = align_up(m_next_address, alignment);
+				if ((aligned_address < m_next_address) || (aligned_address > m_end_address) || (m_end_address - aligned_address < size)) {
+					return allocate_from_new_chunk(size, alignment);
+				}
+				m_next_address = aligned_address + size;
+				return reinterpret_cast<void*>(aligned_address);
+			}
+
+		protected:
+			CXScopeArenaBase(void* inline_storage_ptr, size_t inline_storage_size)
+				: m_next_address(reinterpret_cast<uintptr_t>(inline_storage_ptr))
+				, m_end_address(reinterpret_cast<uintptr_t>(inline_storage_ptr) + inline_storage_size) {}
+			~CXScopeArenaBase() {
+				/* Objects allocated in the arena must be destroyed (by their owner pointers) before the arena is. An owner
+				pointer that has been moved out of the arena's scope would otherwise be left referring to released memory.
+				This check is not limited to debug builds, and since we're in a destructor, the failure is fatal. */
+				if (0 != m_num_outstanding_objects) {
+					std::terminate();
+				}
+				while (m_last_chunk_ptr) {
+					auto prev_chunk_ptr = m_last_chunk_ptr->m_prev_chunk_ptr;
+					::operator delete(m_last_chunk_ptr);
+					m_last_chunk_ptr = prev_chunk_ptr;
+				}
+			}
+
+		private:
+			CXScopeArenaBase(const CXScopeArenaBase&) = delete;
+			CXScopeArenaBase& operator=(const CXScopeArenaBase&) = delete;
+
+			static uintptr_t align_up(uintptr_t address, size_t alignment) {
+				return (address + (alignment - 1)) & ~uintptr_t(alignment - 1);
+			}
+			void* allocate_from_new_chunk(size_t size, size_t alignment) {
+				auto chunk_size = m_next_chunk_size;
+				const auto min_chunk_size = sizeof(CChunkHeader) + size + alignment;
+				if (min_chunk_size > chunk_size) {
+					/* An oversized allocation gets a chunk of its own. */
+					chunk_size = min_chunk_size;
+				}
+				else {
+					m_next_chunk_size *= 2;
+				}
+				auto chunk_ptr = static_cast<CChunkHeader*>(::operator new(chunk_size));
+				chunk_ptr->m_prev_chunk_ptr = m_last_chunk_ptr;
+				m_last_chunk_ptr = chunk_ptr;
+
+				/* The remainder of the previous chunk is abandoned. */
+				m_next_address = reinterpret_cast<uintptr_t>(chunk_ptr) + sizeof(CChunkHeader);
+				m_end_address = reinterpret_cast<uintptr_t>(chunk_ptr) + chunk_size;
+				const auto aligned_address = align_up(m_next_address, alignment);
+				m_next_address = aligned_address + size;
+				return reinterpret_cast<void*>(aligned_address);
+			}
+
+			void note_object_constructed() {
+				m_num_outstanding_objects += 1;
+			}
+			void note_object_destroyed() {
+				assert(1 <= m_num_outstanding_objects);
+				m_num_outstanding_objects -= 1;
+			}
+
+			struct CChunkHeader {
+				CChunkHeader* m_prev_chunk_ptr;
+			};
+			static const size_t sc_initial_chunk_size = 4096/*arbitrary*/;
+
+			uintptr_t m_next_address;
+			uintptr_t m_end_address;
+			CChunkHeader* m_last_chunk_ptr = nullptr;
+			size_t m_next_chunk_size = sc_initial_chunk_size;
+			size_t m_num_outstanding_objects = 0;
+
+			template<typename _Ty> friend class mse::TXScopeOwnerPointer;
+		};
+	}
+
+	/* TXScopeArena is a (stack allocated) "bump" allocator for scope objects. Objects are allocated in it via
+	make_xscope_owner_in(). Allocations are served from its inline storage first, then from (progressively larger) heap
+	chunks. The objects are destroyed by their (scope) owner pointers as usual, but their memory is only released, all at
+	once, when the arena goes out of scope. Like TXScopeOwnerPointers, TXScopeArenas are meant to be allocated on the
+	stack only. Note that an arena must outlive the owner pointers of the objects allocated in it, so the arena should
+	be declared in the same (or an enclosing) scope. */
+	template<size_t _InlineStorageSize = 1024/*arbitrary*/>
+	class TXScopeArena : public impl::CXScopeArenaBase {
+	public:
+		TXScopeArena() : impl::CXScopeArenaBase(&m_inline_storage, _InlineStorageSize) {}
+
+	private:
+		TXScopeArena(const TXScopeArena&) = delete;
+		TXScopeArena& operator=(const TXScopeArena&) = delete;
+		void* operator new(size_t size) { return ::operator new(size); }
+
+		typename std::aligned_storage<(0 < _InlineStorageSize) ? _InlineStorageSize : 1, alignof(std::max_align_t)>::type m_inline_storage;
+	};
+
+	template<typename _Ty, size_t _InlineStorageSize, class... Args>
+	TXScopeOwnerPointer<_Ty> make_xscope_owner_in(TXScopeArena<_InlineStorageSize>& arena, Args&&... args);
+
 	/* TXScopeOwnerPointer is meant to be much like boost::scoped_ptr<>. Instead of taking a native pointer,
 	TXScopeOwnerPointer just forwards it's constructor arguments to the constructor of the TXScopeObj<_Ty>.
 	TXScopeOwnerPointers are meant to be allocated on the stack only. Unfortunately there's really no way to
 	enforce this, which makes this data type less intrinsically safe than say, "reference counting" pointers.
+	TXScopeOwnerPointers obtained from make_xscope_owner_in() own an object allocated in a TXScopeArena rather than on
+	the heap.
 	*/
 	template<typename _Ty>
 	class TXScopeOwnerPointer {
@@ -313,26 +430,63 @@ namespace mse {
 			TXScopeObj<_Ty>* new_ptr = new TXScopeObj<_Ty>(std::forward<Args>(args)...);
 			m_ptr = new_ptr;
 		}
+		/* The moved-from owner pointer is left null, and dereferencing it throws. (The move constructor is needed for
+		make_xscope_owner_in() to return an owner pointer.) An arena allocated object's owner pointer must not be moved
+		out of the arena's scope. If the arena is destroyed while any of its objects remain, the program is terminated. */
+		TXScopeOwnerPointer(TXScopeOwnerPointer<_Ty>&& src_ref) : m_ptr(src_ref.m_ptr), m_arena_ptr(src_ref.m_arena_ptr) {
+			src_ref.m_ptr = nullptr;
+		}
 		virtual ~TXScopeOwnerPointer() {
-			assert(m_ptr);
-			delete m_ptr;
+			if (m_arena_ptr) {
+				if (m_ptr) {
+					/* The memory is released by the arena. */
+					m_ptr->~TXScopeObj<_Ty>();
+					m_arena_ptr->note_object_destroyed();
+				}
+			}
+			else if (m_ptr) {
+				delete m_ptr;
+			}
 		}
 
 		TXScopeObj<_Ty>& operator*() const {
+			if (nullptr == m_ptr) {
+				MSE_THROW(primitives_null_dereference_error("attempt to dereference null pointer - mse::TXScopeOwnerPointer"));
+			}
 			return (*m_ptr);
 		}
 		TXScopeObj<_Ty>* operator->() const {
+			if (nullptr == m_ptr) {
+				MSE_THROW(primitives_null_dereference_error("attempt to dereference null pointer - mse::TXScopeOwnerPointer"));
+			}
 			return m_ptr;
 		}
 
 	private:
+		TXScopeOwnerPointer(TXScopeObj<_Ty>* arena_allocated_ptr, impl::CXScopeArenaBase* arena_ptr) : m_ptr(arena_allocated_ptr), m_arena_ptr(arena_ptr) {
+			(*m_arena_ptr).note_object_constructed();
+		}
+
 		TXScopeOwnerPointer(TXScopeOwnerPointer<_Ty>& src_cref) = delete;
 		TXScopeOwnerPointer<_Ty>& operator=(const TXScopeOwnerPointer<_Ty>& _Right_cref) = delete;
 		void* operator new(size_t size) { return ::operator new(size); }
 
 		TXScopeObj<_Ty>* m_ptr = nullptr;
+		impl::CXScopeArenaBase* m_arena_ptr = nullptr;
+
+		template<typename _Ty2, size_t _InlineStorageSize, class... Args>
+		friend TXScopeOwnerPointer<_Ty2> make_xscope_owner_in(TXScopeArena<_InlineStorageSize>& arena, Args&&... args);
 	};
 
+	/* Constructs a scope object in the given arena and returns its owner pointer. */
+	template<typename _Ty, size_t _InlineStorageSize, class... Args>
+	TXScopeOwnerPointer<_Ty> make_xscope_owner_in(TXScopeArena<_InlineStorageSize>& arena, Args&&... args) {
+		void* storage_ptr = arena.allocate(sizeof(TXScopeObj<_Ty>), alignof(TXScopeObj<_Ty>));
+		/* If the constructor throws, the (unused) storage is simply released with the rest of the arena. */
+		auto new_ptr = ::new (storage_ptr) TXScopeObj<_Ty>(std::forward<Args>(args)...);
+		return TXScopeOwnerPointer<_Ty>(new_ptr, static_cast<impl::CXScopeArenaBase*>(&arena));
+	}
+
 	template <class _TTargetType, class _TLeasePointerType> class TXScopeWeakFixedConstPointer;
 
 	/* If, for example, you want a safe pointer to a member of a scope pointer target, you can use a
@@ -536,6 +690,8 @@ namespace mse {
 			mse::TXScopeFixedConstPointer<A> rcp2 = rcp;
 			const mse::TXScopeObj<A> cscope_a(11);
 			mse::TXScopeFixedConstPointer<A> rfcp = &cscope_a;
+			(void)rcp2;
+			(void)rfcp;
 
 			mse::TXScopeOwnerPointer<A> A_scpoptr(11);
 			B::foo2(&*A_scpoptr);
@@ -557,6 +713,9 @@ namespace mse {
 			mse::TXScopeFixedPointer<E> E_scope_ptr5 = GE_scope_fptr1;
 			mse::TXScopeFixedPointer<E> E_scope_fptr2 = &scope_gd;
 			mse::TXScopeFixedConstPointer<E> E_scope_fcptr2 = &scope_gd;
+			(void)E_scope_ptr5;
+			(void)E_scope_fptr2;
+			(void)E_scope_fcptr2;
 		}
 
 		{
@@ -589,6 +748,7 @@ namespace mse {
 			auto s_safe_ptr1 = mse::make_pointer_to_member((a_scpobj.s), (&a_scpobj));
 			(*s_safe_ptr1) = "some new text";
 			auto s_safe_const_ptr1 = mse::make_const_pointer_to_member((a_scpobj.s), (&a_scpobj));
+			(void)s_safe_const_ptr1;
 
 			/* Just testing the convertibility of mse::TXScopeWeakFixedPointers. */
 			auto A_xscope_fixed_ptr1 = &a_scpobj;
@@ -596,6 +756,8 @@ namespace mse {
 			mse::TXScopeWeakFixedPointer<std::string, mse::TXScopeFixedConstPointer<A>> xscpwfptr2 = xscpwfptr1;
 			mse::TXScopeWeakFixedConstPointer<std::string, mse::TXScopeFixedPointer<A>> xscpwfcptr1 = xscpwfptr1;
 			mse::TXScopeWeakFixedConstPointer<std::string, mse::TXScopeFixedConstPointer<A>> xscpwfcptr2 = xscpwfcptr1;
+			(void)xscpwfptr2;
+			(void)xscpwfcptr2;
 			if (xscpwfcptr1 == xscpwfptr1) {
 				int q = 7;
 			}
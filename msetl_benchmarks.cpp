@@ -0,0 +1,841 @@
+
+// Copyright (c) 2015 Noah Lopez
+// Use, modification, and distribution is subject to the Boost Software
+// License, Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+/* A (micro)benchmark suite for the library's elements. Each benchmark case belongs to a group, and each group contains
+a "baseline" case that uses the native or standard library counterpart of the library elements being measured, so that
+results can be compared across platforms and releases. Each case is run once (unmeasured) to warm up, then run a
+number of times (the "repetitions"), and the min, median, mean and standard deviation of the per-operation times are
+reported.
+
+usage: msetl_benchmarks [--repetitions=<n>] [--scale=<x>] [--filter=<substring>] [--format=text|csv|json]
+
+--repetitions  how many measured runs of each case (default 11)
+--scale        multiplies the (default) number of operations per run
+--filter       only run the cases whose "group/name" contains the given substring
+--format       "csv" and "json" produce machine-readable output (on stdout)
+
+Like msetl_example.cpp, this file should be compiled (with compiler optimizations enabled) together with
+mserelaxedregistered.cpp. With g++ and clang++ you'll need to link to the pthread library (-lpthread). */
+
+#include "mseregistered.h"
+#include "mserelaxedregistered.h"
+#include "mserefcounting.h"
+#include "msescope.h"
+#include "mseasyncshared.h"
+#include "msepoly.h"
+#include "msemsearray.h"
+#include "msemstdarray.h"
+#include "msemsevector.h"
+#include "msemstdvector.h"
+#include "mseivector.h"
+#include "mseparallel.h"
+#include <array>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+
+namespace msetl_benchmarks {
+
+	/* Results are accumulated into this (volatile) sink so that the optimizer can't discard the benchmarked code. */
+	static volatile long long s_sink = 0;
+	inline void consume(long long x) { s_sink = s_sink + x; }
+	/* Storing (native) pointers here prevents the optimizer from eliding the allocations. */
+	static void* volatile s_pointer_sink = nullptr;
+
+	class CBenchmarkCase {
+	public:
+		/* The function performs the given number of operations and returns a value that depends on the work done. */
+		typedef std::function<long long(size_t)> fn_t;
+
+		CBenchmarkCase(const std::string& group, const std::string& name, bool is_baseline, size_t default_num_ops, fn_t fn)
+			: m_group(group), m_name(name), m_is_baseline(is_baseline), m_default_num_ops(default_num_ops), m_fn(fn) {}
+
+		std::string m_group;
+		std::string m_name;
+		bool m_is_baseline = false;
+		size_t m_default_num_ops = 0;
+		fn_t m_fn;
+	};
+
+	class CBenchmarkResult {
+	public:
+		std::string m_group;
+		std::string m_name;
+		bool m_is_baseline = false;
+		size_t m_num_ops = 0;
+		size_t m_num_repetitions = 0;
+		/* nanoseconds per operation */
+		double m_min_ns = 0.0;
+		double m_median_ns = 0.0;
+		double m_mean_ns = 0.0;
+		double m_stddev_ns = 0.0;
+		/* The ratio of this case's median to the median of its group's baseline case (0.0 if there's no baseline). */
+		double m_relative_to_baseline = 0.0;
+	};
+
+	class CBenchmarkOptions {
+	public:
+		size_t m_num_repetitions = 11;
+		double m_scale = 1.0;
+		std::string m_filter;
+		std::string m_format = "text";
+	};
+
+	static CBenchmarkResult run_case(const CBenchmarkCase& bcase, const CBenchmarkOptions& options) {
+		CBenchmarkResult result;
+		result.m_group = bcase.m_group;
+		result.m_name = bcase.m_name;
+		result.m_is_baseline = bcase.m_is_baseline;
+		result.m_num_ops = std::max(size_t(1), size_t(double(bcase.m_default_num_ops) * options.m_scale));
+		result.m_num_repetitions = std::max(size_t(1), options.m_num_repetitions);
+
+		/* warm up */
+		consume(bcase.m_fn(result.m_num_ops));
+
+		std::vector<double> ns_per_op;
+		ns_per_op.reserve(result.m_num_repetitions);
+		for (size_t i = 0; i < result.m_num_repetitions; i += 1) {
+			auto t1 = std::chrono::steady_clock::now();
+			consume(bcase.m_fn(result.m_num_ops));
+			auto t2 = std::chrono::steady_clock::now();
+			auto elapsed_ns = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(t2 - t1).count();
+			ns_per_op.push_back(elapsed_ns / double(result.m_num_ops));
+		}
+
+		std::sort(ns_per_op.begin(), ns_per_op.end());
+		const auto n = ns_per_op.size();
+		result.m_min_ns = ns_per_op.front();
+		result.m_median_ns = (n % 2) ? ns_per_op[n / 2] : ((ns_per_op[n / 2 - 1] + ns_per_op[n / 2]) / 2.0);
+		result.m_mean_ns = std::accumulate(ns_per_op.begin(), ns_per_op.end(), 0.0) / double(n);
+		double sum_of_squares = 0.0;
+		for (const auto& x : ns_per_op) {
+			sum_of_squares += (x - result.m_mean_ns) * (x - result.m_mean_ns);
+		}
+		result.m_stddev_ns = (1 < n) ? std::sqrt(sum_of_squares / double(n - 1)) : 0.0;
+		return result;
+	}
+
+	static void set_relative_to_baseline(std::vector<CBenchmarkResult>& results) {
+		for (auto& result : results) {
+			for (const auto& baseline : results) {
+				if (baseline.m_is_baseline && (baseline.m_group == result.m_group) && (0.0 < baseline.m_median_ns)) {
+					result.m_relative_to_baseline = result.m_median_ns / baseline.m_median_ns;
+					break;
+				}
+			}
+		}
+	}
+
+	static std::string json_escaped(const std::string& str) {
+		std::string retval;
+		for (const auto& ch : str) {
+			if (('"' == ch) || ('\\' == ch)) {
+				retval += '\\';
+			}
+			retval += ch;
+		}
+		return retval;
+	}
+
+	static void output_results(const std::vector<CBenchmarkResult>& results, const CBenchmarkOptions& options) {
+		if ("csv" == options.m_format) {
+			std::cout << "group,name,is_baseline,ops,repetitions,min_ns,median_ns,mean_ns,stddev_ns,relative_to_baseline\n";
+			for (const auto& result : results) {
+				std::cout << result.m_group << "," << result.m_name << "," << (result.m_is_baseline ? 1 : 0) << ","
+					<< result.m_num_ops << "," << result.m_num_repetitions << "," << result.m_min_ns << ","
+					<< result.m_median_ns << "," << result.m_mean_ns << "," << result.m_stddev_ns << ","
+					<< result.m_relative_to_baseline << "\n";
+			}
+		}
+		else if ("json" == options.m_format) {
+			std::cout << "{\n  \"results\": [\n";
+			for (size_t i = 0; i < results.size(); i += 1) {
+				const auto& result = results[i];
+				std::cout << "    { \"group\": \"" << json_escaped(result.m_group) << "\", \"name\": \"" << json_escaped(result.m_name)
+					<< "\", \"is_baseline\": " << (result.m_is_baseline ? "true" : "false")
+					<< ", \"ops\": " << result.m_num_ops << ", \"repetitions\": " << result.m_num_repetitions
+					<< ", \"min_ns\": " << result.m_min_ns << ", \"median_ns\": " << result.m_median_ns
+					<< ", \"mean_ns\": " << result.m_mean_ns << ", \"stddev_ns\": " << result.m_stddev_ns
+					<< ", \"relative_to_baseline\": " << result.m_relative_to_baseline << " }"
+					<< (((i + 1) < results.size()) ? ",\n" : "\n");
+			}
+			std::cout << "  ]\n}\n";
+		}
+		else {
+			std::string current_group;
+			for (const auto& result : results) {
+				if (result.m_group != current_group) {
+					current_group = result.m_group;
+					std::cout << "\n" << current_group << "\n";
+				}
+				std::cout << "  " << std::left << std::setw(60) << (result.m_name + (result.m_is_baseline ? " (baseline)" : ""))
+					<< std::right << std::fixed << std::setprecision(2)
+					<< " median: " << std::setw(9) << result.m_median_ns << " ns"
+					<< "  min: " << std::setw(9) << result.m_min_ns << " ns"
+					<< "  stddev: " << std::setw(8) << result.m_stddev_ns << " ns";
+				if (0.0 < result.m_relative_to_baseline) {
+					std::cout << "  x" << std::setprecision(2) << result.m_relative_to_baseline;
+				}
+				std::cout << "\n";
+			}
+			std::cout << std::endl;
+		}
+	}
+
+	/* The number of operations per run (before scaling). */
+	static const size_t sc_num_alloc_ops = 200000/*arbitrary*/;
+	static const size_t sc_num_copy_ops = 2000000/*arbitrary*/;
+	static const size_t sc_num_deref_ops = 10000000/*arbitrary*/;
+	static const size_t sc_num_container_ops = 1000000/*arbitrary*/;
+	static const size_t sc_num_insert_ops = 2000/*arbitrary*/;
+	static const size_t sc_num_lock_ops = 200000/*arbitrary*/;
+
+	class CE {
+	public:
+		CE(int x = 0) : m_x(x) {}
+		virtual ~CE() {}
+		int m_x = 0;
+	};
+
+	/* Constructs (and destroys) the given number of objects. */
+	template<typename _TFunction>
+	static long long alloc_loop(size_t num_ops, _TFunction fn) {
+		long long sum = 0;
+		for (size_t i = 0; i < num_ops; i += 1) {
+			sum += fn(int(i));
+		}
+		return sum;
+	}
+
+	/* Copies the given pointer the given number of times. A copy is kept alive for each iteration to prevent the
+	optimizer from discarding the copy (and, for reference counting pointers, the reference count updates). */
+	template<typename _TPointer>
+	static long long copy_loop(size_t num_ops, const _TPointer& ptr) {
+		long long sum = 0;
+		std::array<_TPointer, 4> copies = { ptr, ptr, ptr, ptr };
+		for (size_t i = 0; i < num_ops; i += 1) {
+			copies[i % 4] = copies[(i + 1) % 4];
+			sum += (*(copies[i % 4])).m_x;
+		}
+		return sum;
+	}
+
+	/* Appends copies of the given pointer to an std::vector (without reserving space), so the existing elements are moved
+	each time the vector grows. */
+	template<typename _TPointer>
+	static long long vector_growth_loop(size_t num_ops, const _TPointer& ptr) {
+		std::vector<_TPointer> ptrs;
+		for (size_t i = 0; i < num_ops; i += 1) {
+			ptrs.push_back(ptr);
+		}
+		return (long long)(ptrs.size()) + (*(ptrs.back())).m_x;
+	}
+
+	/* Populates a vector with the given number of (relaxed registered) objects, some of which are targeted by pointers,
+	then destroys the vector and checks that those pointers have been nulled. */
+	template<typename _TVector>
+	static long long relaxed_registered_teardown_loop(size_t num_ops) {
+		std::vector<mse::TRelaxedRegisteredPointer<CE>> ptrs;
+		long long sum = 0;
+		{
+			_TVector objects;
+			for (size_t i = 0; i < num_ops; i += 1) {
+				objects.emplace_back(int(i));
+			}
+			for (size_t i = 0; i < num_ops; i += 10) {
+				ptrs.push_back(&(objects[i]));
+				sum += ptrs.back()->m_x;
+			}
+		}
+		for (const auto& ptr : ptrs) {
+			if (ptr) { sum += 1; }
+		}
+		return sum;
+	}
+
+	/* Traverses a (cyclic) linked list whose links are of the given (pointer) type. */
+	template<typename _TLink>
+	static long long traverse_loop(size_t num_ops, const _TLink* first_link_ptr) {
+		const _TLink* link_ptr = first_link_ptr;
+		for (size_t i = 0; i < num_ops; i += 1) {
+			link_ptr = std::addressof((*link_ptr)->m_next_item_ptr);
+		}
+		return (*link_ptr)->m_x;
+	}
+
+	static void add_pointer_cases(std::vector<CBenchmarkCase>& cases) {
+		/* allocation (and deallocation) */
+		{
+			const std::string group = "pointer allocation";
+			cases.emplace_back(group, "native pointer", true, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) { auto ptr = new CE(i); s_pointer_sink = ptr; int x = ptr->m_x; delete ptr; return x; });
+			});
+			cases.emplace_back(group, "std::shared_ptr", false, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) { auto ptr = std::make_shared<CE>(i); return ptr->m_x; });
+			});
+			cases.emplace_back(group, "mse::TRegisteredPointer", false, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) {
+					mse::TRegisteredPointer<CE> ptr = mse::registered_new<CE>(i); int x = ptr->m_x; mse::registered_delete<CE>(ptr); return x;
+				});
+			});
+			cases.emplace_back(group, "mse::TRelaxedRegisteredPointer", false, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) {
+					mse::TRelaxedRegisteredPointer<CE> ptr = mse::relaxed_registered_new<CE>(i); int x = ptr->m_x; mse::relaxed_registered_delete<CE>(ptr); return x;
+				});
+			});
+			cases.emplace_back(group, "mse::TRefCountingPointer", false, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) { auto ptr = mse::make_refcounting<CE>(i); return ptr->m_x; });
+			});
+			cases.emplace_back(group, "mse::TXScopeOwnerPointer", false, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) { mse::TXScopeOwnerPointer<CE> ptr(i); return ptr->m_x; });
+			});
+			cases.emplace_back(group, "mse::TXScopeOwnerPointer (in mse::TXScopeArena)", false, sc_num_alloc_ops, [](size_t num_ops) {
+				/* An arena is torn down every 100 allocations. */
+				long long sum = 0;
+				for (size_t i = 0; i < num_ops; i += 100) {
+					mse::TXScopeArena<> arena;
+					sum += alloc_loop(std::min(size_t(100), num_ops - i), [&arena](int i) { auto ptr = mse::make_xscope_owner_in<CE>(arena, i); return ptr->m_x; });
+				}
+				return sum;
+			});
+		}
+		{
+			/* The tracker is notified of the construction and destruction of every relaxed registered object, whether
+			or not it's ever targeted. The "(with targeted objects)" case first fills the tracker's "fast storage1" and
+			"slow storage" with objects that are targeted by pointers. */
+			const std::string group = "relaxed registered object construction";
+			cases.emplace_back(group, "native object", true, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) { CE obj(i); s_pointer_sink = &obj; return obj.m_x; });
+			});
+			cases.emplace_back(group, "mse::TRelaxedRegisteredObj", false, sc_num_alloc_ops, [](size_t num_ops) {
+				return alloc_loop(num_ops, [](int i) { mse::TRelaxedRegisteredObj<CE> obj(i); s_pointer_sink = std::addressof(obj); return obj.m_x; });
+			});
+			cases.emplace_back(group, "mse::TRelaxedRegisteredObj (with targeted objects)", false, sc_num_alloc_ops, [](size_t num_ops) {
+				std::vector<mse::TRelaxedRegisteredObj<CE>> targeted_objects(64, CE(1));
+				std::vector<mse::TRelaxedRegisteredPointer<CE>> ptrs;
+				for (auto& targeted_object : targeted_objects) {
+					ptrs.push_back(&targeted_object);
+				}
+				return alloc_loop(num_ops, [](int i) { mse::TRelaxedRegisteredObj<CE> obj(i); s_pointer_sink = std::addressof(obj); return obj.m_x; });
+			});
+		}
+		/* copying */
+		{
+			const std::string group = "pointer copying";
+			cases.emplace_back(group, "native pointer", true, sc_num_copy_ops, [](size_t num_ops) {
+				CE obj(1);
+				return copy_loop(num_ops, &obj);
+			});
+			cases.emplace_back(group, "std::shared_ptr", false, sc_num_copy_ops, [](size_t num_ops) {
+				return copy_loop(num_ops, std::make_shared<CE>(1));
+			});
+			cases.emplace_back(group, "mse::TRegisteredPointer", false, sc_num_copy_ops, [](size_t num_ops) {
+				mse::TRegisteredObj<CE> obj(1);
+				return copy_loop(num_ops, mse::TRegisteredPointer<CE>(&obj));
+			});
+			cases.emplace_back(group, "mse::TRelaxedRegisteredPointer", false, sc_num_copy_ops, [](size_t num_ops) {
+				mse::TRelaxedRegisteredObj<CE> obj(1);
+				return copy_loop(num_ops, mse::TRelaxedRegisteredPointer<CE>(&obj));
+			});
+			cases.emplace_back(group, "mse::TRefCountingPointer", false, sc_num_copy_ops, [](size_t num_ops) {
+				return copy_loop(num_ops, mse::TRefCountingPointer<CE>(mse::make_refcounting<CE>(1)));
+			});
+			cases.emplace_back(group, "mse::TPolyPointer (holding mse::TRefCountingPointer)", false, sc_num_copy_ops, [](size_t num_ops) {
+				return copy_loop(num_ops, mse::TPolyPointer<CE>(mse::make_refcounting<CE>(1)));
+			});
+			cases.emplace_back(group, "mse::TXScopeFixedPointer", false, sc_num_copy_ops, [](size_t num_ops) {
+				/* Scope pointers can't be copy assigned, so each one is just (copy) constructed and dereferenced. */
+				mse::TXScopeObj<CE> obj1(1);
+				mse::TXScopeObj<CE> obj2(2);
+				const mse::TXScopeFixedPointer<CE> ptr1 = &obj1;
+				const mse::TXScopeFixedPointer<CE> ptr2 = &obj2;
+				long long sum = 0;
+				for (size_t i = 0; i < num_ops; i += 1) {
+					mse::TXScopeFixedPointer<CE> ptr = (i % 2) ? ptr2 : ptr1;
+					sum += ptr->m_x;
+				}
+				return sum;
+			});
+		}
+		{
+			const std::string group = "pointer vector growth";
+			cases.emplace_back(group, "native pointer", true, sc_num_alloc_ops, [](size_t num_ops) {
+				CE obj(1);
+				return vector_growth_loop(num_ops, &obj);
+			});
+			cases.emplace_back(group, "mse::TRegisteredPointer", false, sc_num_alloc_ops, [](size_t num_ops) {
+				mse::TRegisteredObj<CE> obj(1);
+				return vector_growth_loop(num_ops, mse::TRegisteredPointer<CE>(&obj));
+			});
+			cases.emplace_back(group, "mse::TRegisteredPointer (intrusive list tracker)", false, sc_num_alloc_ops, [](size_t num_ops) {
+				mse::TRegisteredObj<CE, mse::sc_intrusive_list_tracker> obj(1);
+				return vector_growth_loop(num_ops, mse::TRegisteredPointer<CE, mse::sc_intrusive_list_tracker>(&obj));
+			});
+		}
+		{
+			/* std::vector destroys its elements one at a time (so the tracker is searched once per element), whereas
+			msevector has the tracker null the pointers targeting any of the elements in a single sweep. */
+			const std::string group = "relaxed registered object vector teardown";
+			cases.emplace_back(group, "std::vector", true, sc_num_alloc_ops, [](size_t num_ops) {
+				return relaxed_registered_teardown_loop<std::vector<mse::TRelaxedRegisteredObj<CE>>>(num_ops);
+			});
+			cases.emplace_back(group, "mse::msevector", false, sc_num_alloc_ops, [](size_t num_ops) {
+				return relaxed_registered_teardown_loop<mse::msevector<mse::TRelaxedRegisteredObj<CE>>>(num_ops);
+			});
+		}
+		/* dereferencing */
+		{
+			const std::string group = "pointer dereferencing";
+			cases.emplace_back(group, "native pointer", true, sc_num_deref_ops, [](size_t num_ops) {
+				class CF {
+				public:
+					CF(int x = 0) : m_x(x) {}
+					CF* m_next_item_ptr = nullptr;
+					int m_x = 0;
+				};
+				CF item1(1); CF item2(2); CF item3(3);
+				item1.m_next_item_ptr = &item2; item2.m_next_item_ptr = &item3; item3.m_next_item_ptr = &item1;
+				const CF* link_ptr = &item1;
+				for (size_t i = 0; i < num_ops; i += 1) {
+					link_ptr = link_ptr->m_next_item_ptr;
+				}
+				return (long long)(link_ptr->m_x);
+			});
+			cases.emplace_back(group, "std::weak_ptr", false, sc_num_deref_ops / 10, [](size_t num_ops) {
+				class CF {
+				public:
+					CF(int x = 0) : m_x(x) {}
+					std::weak_ptr<CF> m_next_item_ptr;
+					int m_x = 0;
+				};
+				auto item1_ptr = std::make_shared<CF>(1); auto item2_ptr = std::make_shared<CF>(2); auto item3_ptr = std::make_shared<CF>(3);
+				item1_ptr->m_next_item_ptr = item2_ptr; item2_ptr->m_next_item_ptr = item3_ptr; item3_ptr->m_next_item_ptr = item1_ptr;
+				const std::weak_ptr<CF>* link_ptr = &(item1_ptr->m_next_item_ptr);
+				for (size_t i = 0; i < num_ops; i += 1) {
+					link_ptr = &((*link_ptr).lock()->m_next_item_ptr);
+				}
+				return (long long)((*link_ptr).lock()->m_x);
+			});
+			cases.emplace_back(group, "mse::TRegisteredPointer", false, sc_num_deref_ops, [](size_t num_ops) {
+				class CF {
+				public:
+					CF(int x = 0) : m_x(x) {}
+					mse::TRegisteredPointer<CF> m_next_item_ptr;
+					int m_x = 0;
+				};
+				mse::TRegisteredObj<CF> item1(1); mse::TRegisteredObj<CF> item2(2); mse::TRegisteredObj<CF> item3(3);
+				item1.m_next_item_ptr = &item2; item2.m_next_item_ptr = &item3; item3.m_next_item_ptr = &item1;
+				return traverse_loop(num_ops, std::addressof(item1.m_next_item_ptr));
+			});
+			cases.emplace_back(group, "mse::TRelaxedRegisteredPointer", false, sc_num_deref_ops, [](size_t num_ops) {
+				class CF {
+				public:
+					CF(int x = 0) : m_x(x) {}
+					mse::TRelaxedRegisteredPointer<CF> m_next_item_ptr;
+					int m_x = 0;
+				};
+				mse::TRelaxedRegisteredObj<CF> item1(1); mse::TRelaxedRegisteredObj<CF> item2(2); mse::TRelaxedRegisteredObj<CF> item3(3);
+				item1.m_next_item_ptr = &item2; item2.m_next_item_ptr = &item3; item3.m_next_item_ptr = &item1;
+				return traverse_loop(num_ops, std::addressof(item1.m_next_item_ptr));
+			});
+			cases.emplace_back(group, "mse::TRefCountingPointer", false, sc_num_deref_ops, [](size_t num_ops) {
+				class CF {
+				public:
+					CF(int x = 0) : m_x(x) {}
+					mse::TRefCountingPointer<CF> m_next_item_ptr;
+					int m_x = 0;
+				};
+				auto item1_ptr = mse::make_refcounting<CF>(1); auto item2_ptr = mse::make_refcounting<CF>(2); auto item3_ptr = mse::make_refcounting<CF>(3);
+				item1_ptr->m_next_item_ptr = item2_ptr; item2_ptr->m_next_item_ptr = item3_ptr; item3_ptr->m_next_item_ptr = item1_ptr;
+				auto retval = traverse_loop(num_ops, &(item1_ptr->m_next_item_ptr));
+				item1_ptr->m_next_item_ptr = nullptr; /* to break the reference cycle */
+				return retval;
+			});
+			cases.emplace_back(group, "mse::TRefCountingPointer (base class target)", false, sc_num_deref_ops, [](size_t num_ops) {
+				/* Here the pointers target a (non-first) base class subobject. */
+				class CPadding {
+				public:
+					long long m_padding = 0;
+				};
+				class CFBase {
+				public:
+					CFBase(int x = 0) : m_x(x) {}
+					mse::TRefCountingPointer<CFBase> m_next_item_ptr;
+					int m_x = 0;
+				};
+				class CF : public CPadding, public CFBase {
+				public:
+					CF(int x = 0) : CFBase(x) {}
+				};
+				mse::TRefCountingPointer<CFBase> item1_ptr = mse::make_refcounting<CF>(1);
+				mse::TRefCountingPointer<CFBase> item2_ptr = mse::make_refcounting<CF>(2);
+				mse::TRefCountingPointer<CFBase> item3_ptr = mse::make_refcounting<CF>(3);
+				item1_ptr->m_next_item_ptr = item2_ptr; item2_ptr->m_next_item_ptr = item3_ptr; item3_ptr->m_next_item_ptr = item1_ptr;
+				auto retval = traverse_loop(num_ops, &(item1_ptr->m_next_item_ptr));
+				item1_ptr->m_next_item_ptr = nullptr; /* to break the reference cycle */
+				return retval;
+			});
+			cases.emplace_back(group, "mse::TPolyPointer (holding mse::TRefCountingPointer)", false, sc_num_deref_ops, [](size_t num_ops) {
+				class CF {
+				public:
+					CF(int x = 0) : m_x(x) {}
+					mse::TPolyPointer<CF> m_next_item_ptr = static_cast<CF*>(nullptr);
+					int m_x = 0;
+				};
+				auto item1_ptr = mse::make_refcounting<CF>(1); auto item2_ptr = mse::make_refcounting<CF>(2); auto item3_ptr = mse::make_refcounting<CF>(3);
+				item1_ptr->m_next_item_ptr = mse::TPolyPointer<CF>(item2_ptr);
+				item2_ptr->m_next_item_ptr = mse::TPolyPointer<CF>(item3_ptr);
+				item3_ptr->m_next_item_ptr = mse::TPolyPointer<CF>(item1_ptr);
+				auto retval = traverse_loop(num_ops, std::addressof(item1_ptr->m_next_item_ptr));
+				item1_ptr->m_next_item_ptr = mse::TPolyPointer<CF>(static_cast<CF*>(nullptr)); /* to break the reference cycle */
+				return retval;
+			});
+			cases.emplace_back(group, "mse::TXScopeFixedPointer", false, sc_num_deref_ops, [](size_t num_ops) {
+				/* Scope pointers can't be stored in objects, so here the links are native pointers to scope objects, and each
+				step goes through a (temporary) scope pointer. */
+				class CF {
+				public:
+					CF(int x = 0) : m_x(x) {}
+					mse::TXScopeObj<CF>* m_next_item_ptr = nullptr;
+					int m_x = 0;
+				};
+				mse::TXScopeObj<CF> item1(1); mse::TXScopeObj<CF> item2(2); mse::TXScopeObj<CF> item3(3);
+				item1.m_next_item_ptr = std::addressof(item2); item2.m_next_item_ptr = std::addressof(item3); item3.m_next_item_ptr = std::addressof(item1);
+				mse::TXScopeObj<CF>* link_ptr = std::addressof(item1);
+				for (size_t i = 0; i < num_ops; i += 1) {
+					mse::TXScopeFixedPointer<CF> xscope_ptr = &(*link_ptr);
+					link_ptr = xscope_ptr->m_next_item_ptr;
+				}
+				return (long long)(link_ptr->m_x);
+			});
+		}
+	}
+
+	template<typename _TVector>
+	static long long push_back_loop(size_t num_ops) {
+		_TVector v;
+		for (size_t i = 0; i < num_ops; i += 1) {
+			v.push_back(int(i));
+		}
+		return (long long)(v.size());
+	}
+
+	template<typename _TVector, typename _TInsertFunction>
+	static long long insert_loop(size_t num_ops, _TInsertFunction insert_fn) {
+		/* Each insertion is into the middle of the vector. */
+		_TVector v;
+		for (size_t i = 0; i < num_ops; i += 1) {
+			insert_fn(v, size_t(v.size() / 2), int(i));
+		}
+		return (long long)(v.size());
+	}
+
+	template<typename _TEraseFunction>
+	static long long scattered_erase_loop(size_t num_ops, _TEraseFunction erase_fn) {
+		/* Erases every other element of a vector that has a few ipointers into it. */
+		mse::msevector<int> v(num_ops);
+		std::iota(v.begin(), v.end(), 0);
+		std::vector<mse::msevector<int>::ipointer> ipointers;
+		for (size_t i = 0; i < 8; i += 1) {
+			ipointers.emplace_back(v.ibegin() + (i * (num_ops / 8)));
+		}
+		erase_fn(v);
+		return (long long)(v.size()) + (*(ipointers.front()));
+	}
+
+	template<typename _TVector>
+	static long long iteration_loop(size_t num_ops) {
+		static const size_t sc_size = 1000;
+		_TVector v(sc_size);
+		std::iota(v.begin(), v.end(), 0);
+		long long sum = 0;
+		size_t count = 0;
+		while (count < num_ops) {
+			for (auto& x : v) {
+				sum += x;
+			}
+			count += sc_size;
+		}
+		return sum;
+	}
+
+	template<typename _TArray>
+	static long long indexed_access_loop(size_t num_ops, _TArray& a) {
+		for (size_t i = 0; i < a.size(); i += 1) {
+			a[i] = int(i);
+		}
+		long long sum = 0;
+		size_t count = 0;
+		while (count < num_ops) {
+			for (size_t i = 0; i < a.size(); i += 1) {
+				sum += a[i];
+			}
+			count += a.size();
+		}
+		return sum;
+	}
+
+	/* Fills a vector of the given size with (deterministic) pseudo-random values, then sorts it with the given function. */
+	template<typename _TVector, typename _TSortFunction>
+	static long long sort_loop(size_t num_ops, _TSortFunction sort_fn) {
+		_TVector v(num_ops);
+		unsigned int x = 12345;
+		for (size_t i = 0; i < num_ops; i += 1) {
+			x = x * 1103515245 + 12345;
+			v[i] = int(x >> 8);
+		}
+		sort_fn(v);
+		return (long long)(v[0]) + v[num_ops / 2];
+	}
+
+	static void add_container_cases(std::vector<CBenchmarkCase>& cases) {
+		{
+			const std::string group = "vector push_back";
+			cases.emplace_back(group, "std::vector", true, sc_num_container_ops, [](size_t num_ops) { return push_back_loop<std::vector<int>>(num_ops); });
+			cases.emplace_back(group, "mse::msevector", false, sc_num_container_ops, [](size_t num_ops) { return push_back_loop<mse::msevector<int>>(num_ops); });
+			cases.emplace_back(group, "mse::mstd::vector", false, sc_num_container_ops, [](size_t num_ops) { return push_back_loop<mse::mstd::vector<int>>(num_ops); });
+			cases.emplace_back(group, "mse::ivector", false, sc_num_container_ops, [](size_t num_ops) { return push_back_loop<mse::ivector<int>>(num_ops); });
+		}
+		{
+			const std::string group = "vector insert";
+			cases.emplace_back(group, "std::vector", true, sc_num_insert_ops, [](size_t num_ops) {
+				return insert_loop<std::vector<int>>(num_ops, [](std::vector<int>& v, size_t pos, int x) { v.insert(v.begin() + pos, x); });
+			});
+			cases.emplace_back(group, "mse::msevector", false, sc_num_insert_ops, [](size_t num_ops) {
+				return insert_loop<mse::msevector<int>>(num_ops, [](mse::msevector<int>& v, size_t pos, int x) { v.insert(v.begin() + pos, x); });
+			});
+			cases.emplace_back(group, "mse::mstd::vector", false, sc_num_insert_ops, [](size_t num_ops) {
+				return insert_loop<mse::mstd::vector<int>>(num_ops, [](mse::mstd::vector<int>& v, size_t pos, int x) { v.insert(v.begin() + pos, x); });
+			});
+			cases.emplace_back(group, "mse::ivector", false, sc_num_insert_ops, [](size_t num_ops) {
+				return insert_loop<mse::ivector<int>>(num_ops, [](mse::ivector<int>& v, size_t pos, int x) { v.insert_before(pos, x); });
+			});
+		}
+		{
+			const std::string group = "vector scattered erase";
+			cases.emplace_back(group, "mse::msevector erase()", true, 10 * sc_num_insert_ops, [](size_t num_ops) {
+				return scattered_erase_loop(num_ops, [](mse::msevector<int>& v) {
+					for (size_t i = 1; i < v.size(); i += 1) { v.erase(v.begin() + i); }
+				});
+			});
+			cases.emplace_back(group, "mse::msevector erase_if()", false, 10 * sc_num_insert_ops, [](size_t num_ops) {
+				return scattered_erase_loop(num_ops, [](mse::msevector<int>& v) {
+					v.erase_if([](int x) { return (0 != (x % 2)); });
+				});
+			});
+		}
+		{
+			const std::string group = "vector iteration";
+			cases.emplace_back(group, "std::vector", true, sc_num_container_ops, [](size_t num_ops) { return iteration_loop<std::vector<int>>(num_ops); });
+			cases.emplace_back(group, "mse::msevector", false, sc_num_container_ops, [](size_t num_ops) { return iteration_loop<mse::msevector<int>>(num_ops); });
+			cases.emplace_back(group, "mse::mstd::vector", false, sc_num_container_ops, [](size_t num_ops) { return iteration_loop<mse::mstd::vector<int>>(num_ops); });
+			cases.emplace_back(group, "mse::ivector", false, sc_num_container_ops, [](size_t num_ops) { return iteration_loop<mse::ivector<int>>(num_ops); });
+		}
+		{
+			const std::string group = "array indexed access";
+			cases.emplace_back(group, "std::array", true, sc_num_container_ops, [](size_t num_ops) {
+				std::array<int, 1000> a; return indexed_access_loop(num_ops, a);
+			});
+			cases.emplace_back(group, "mse::msearray", false, sc_num_container_ops, [](size_t num_ops) {
+				mse::msearray<int, 1000> a; return indexed_access_loop(num_ops, a);
+			});
+			cases.emplace_back(group, "mse::mstd::array", false, sc_num_container_ops, [](size_t num_ops) {
+				mse::mstd::array<int, 1000> a; return indexed_access_loop(num_ops, a);
+			});
+		}
+		{
+			/* The mse::par algorithms use all available hardware threads (see MSE_PAR_NUM_WORKER_THREADS). */
+			const std::string group = "vector sort";
+			cases.emplace_back(group, "std::sort (std::vector)", true, sc_num_container_ops, [](size_t num_ops) {
+				return sort_loop<std::vector<int>>(num_ops, [](std::vector<int>& v) { std::sort(v.begin(), v.end()); });
+			});
+			cases.emplace_back(group, "std::sort (mse::mstd::vector)", false, sc_num_container_ops, [](size_t num_ops) {
+				return sort_loop<mse::mstd::vector<int>>(num_ops, [](mse::mstd::vector<int>& v) { std::sort(v.begin(), v.end()); });
+			});
+			cases.emplace_back(group, "mse::par::sort (mse::mstd::vector)", false, sc_num_container_ops, [](size_t num_ops) {
+				return sort_loop<mse::mstd::vector<int>>(num_ops, [](mse::mstd::vector<int>& v) { mse::par::sort(v); });
+			});
+		}
+		{
+			const std::string group = "vector reduce";
+			cases.emplace_back(group, "std::accumulate (std::vector)", true, sc_num_container_ops, [](size_t num_ops) {
+				std::vector<int> v(num_ops, 1); return std::accumulate(v.begin(), v.end(), 0LL);
+			});
+			cases.emplace_back(group, "std::accumulate (mse::mstd::vector)", false, sc_num_container_ops, [](size_t num_ops) {
+				mse::mstd::vector<int> v(num_ops, 1); return std::accumulate(v.begin(), v.end(), 0LL);
+			});
+			cases.emplace_back(group, "mse::par::reduce (mse::mstd::vector)", false, sc_num_container_ops, [](size_t num_ops) {
+				mse::mstd::vector<int> v(num_ops, 1); return mse::par::reduce(v, 0LL);
+			});
+		}
+	}
+
+	/* Runs the given number of (locked) operations divided among the given number of threads. */
+	template<typename _TFunction>
+	static long long threaded_loop(size_t num_ops, size_t num_threads, _TFunction thread_fn) {
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < num_threads; i += 1) {
+			threads.emplace_back(thread_fn, num_ops / num_threads);
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+		return (long long)(num_threads);
+	}
+
+	static void add_asyncshared_cases(std::vector<CBenchmarkCase>& cases) {
+		static const size_t sc_thread_counts[] = { 1, 2, 4, 8 };
+		for (const auto num_threads : sc_thread_counts) {
+			std::ostringstream group_stream;
+			group_stream << "lock throughput (" << num_threads << " thread" << ((1 == num_threads) ? "" : "s") << ")";
+			const std::string group = group_stream.str();
+
+			cases.emplace_back(group, "std::mutex", true, sc_num_lock_ops, [num_threads](size_t num_ops) {
+				std::mutex mutex1;
+				long long count = 0;
+				threaded_loop(num_ops, num_threads, [&mutex1, &count](size_t num_thread_ops) {
+					for (size_t i = 0; i < num_thread_ops; i += 1) {
+						std::lock_guard<std::mutex> lock(mutex1);
+						count += 1;
+					}
+				});
+				return count;
+			});
+			cases.emplace_back(group, "mse::TAsyncSharedReadWriteAccessRequester (writelock_ptr)", false, sc_num_lock_ops, [num_threads](size_t num_ops) {
+				auto access_requester = mse::make_asyncsharedreadwrite<CE>(0);
+				threaded_loop(num_ops, num_threads, [access_requester](size_t num_thread_ops) mutable {
+					for (size_t i = 0; i < num_thread_ops; i += 1) {
+						access_requester.writelock_ptr()->m_x += 1;
+					}
+				});
+				return (long long)(access_requester.readlock_ptr()->m_x);
+			});
+			cases.emplace_back(group, "mse::TAsyncSharedReadWriteAccessRequester (readlock_ptr)", false, sc_num_lock_ops, [num_threads](size_t num_ops) {
+				auto access_requester = mse::make_asyncsharedreadwrite<CE>(1);
+				threaded_loop(num_ops, num_threads, [access_requester](size_t num_thread_ops) mutable {
+					long long sum = 0;
+					for (size_t i = 0; i < num_thread_ops; i += 1) {
+						sum += access_requester.readlock_ptr()->m_x;
+					}
+					consume(sum);
+				});
+				return (long long)(num_threads);
+			});
+			cases.emplace_back(group, "mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester (readlock_ptr)", false, sc_num_lock_ops, [num_threads](size_t num_ops) {
+				auto access_requester = mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<CE>(1);
+				threaded_loop(num_ops, num_threads, [access_requester](size_t num_thread_ops) mutable {
+					long long sum = 0;
+					for (size_t i = 0; i < num_thread_ops; i += 1) {
+						sum += access_requester.readlock_ptr()->m_x;
+					}
+					consume(sum);
+				});
+				return (long long)(num_threads);
+			});
+			cases.emplace_back(group, "mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester (striped, readlock_ptr)", false, sc_num_lock_ops, [num_threads](size_t num_ops) {
+				auto access_requester = mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<CE, mse::async_shared_striped_timed_mutex_type>(1);
+				threaded_loop(num_ops, num_threads, [access_requester](size_t num_thread_ops) mutable {
+					long long sum = 0;
+					for (size_t i = 0; i < num_thread_ops; i += 1) {
+						sum += access_requester.readlock_ptr()->m_x;
+					}
+					consume(sum);
+				});
+				return (long long)(num_threads);
+			});
+			cases.emplace_back(group, "mse::TAsyncSharedSnapshotReader (snapshot)", false, sc_num_lock_ops, [num_threads](size_t num_ops) {
+				auto publisher = mse::make_asyncsharedsnapshotpublisher<CE>(1);
+				threaded_loop(num_ops, num_threads, [publisher](size_t num_thread_ops) {
+					auto reader = publisher.reader();
+					long long sum = 0;
+					for (size_t i = 0; i < num_thread_ops; i += 1) {
+						sum += reader.snapshot()->m_x;
+					}
+					consume(sum);
+				});
+				return (long long)(num_threads);
+			});
+			cases.emplace_back(group, "mse::TAsyncSharedSnapshotReader (snapshot_ref)", false, sc_num_lock_ops, [num_threads](size_t num_ops) {
+				auto publisher = mse::make_asyncsharedsnapshotpublisher<CE>(1);
+				threaded_loop(num_ops, num_threads, [publisher](size_t num_thread_ops) {
+					auto reader = publisher.reader();
+					long long sum = 0;
+					for (size_t i = 0; i < num_thread_ops; i += 1) {
+						sum += reader.snapshot_ref().m_x;
+					}
+					consume(sum);
+				});
+				return (long long)(num_threads);
+			});
+		}
+	}
+
+	static bool parse_options(int argc, char* argv[], CBenchmarkOptions& options) {
+		for (int i = 1; i < argc; i += 1) {
+			const std::string arg = argv[i];
+			const auto eq_pos = arg.find('=');
+			const std::string key = arg.substr(0, eq_pos);
+			const std::string value = (std::string::npos == eq_pos) ? std::string() : arg.substr(eq_pos + 1);
+			if ("--repetitions" == key) {
+				options.m_num_repetitions = size_t(std::strtoul(value.c_str(), nullptr, 10));
+			}
+			else if ("--scale" == key) {
+				options.m_scale = std::strtod(value.c_str(), nullptr);
+			}
+			else if ("--filter" == key) {
+				options.m_filter = value;
+			}
+			else if (("--format" == key) && (("text" == value) || ("csv" == value) || ("json" == value))) {
+				options.m_format = value;
+			}
+			else {
+				std::cerr << "usage: " << argv[0] << " [--repetitions=<n>] [--scale=<x>] [--filter=<substring>] [--format=text|csv|json]" << std::endl;
+				return false;
+			}
+		}
+		return ((1 <= options.m_num_repetitions) && (0.0 < options.m_scale));
+	}
+}
+
+int main(int argc, char* argv[]) {
+	using namespace msetl_benchmarks;
+
+	CBenchmarkOptions options;
+	if (!parse_options(argc, argv, options)) {
+		return 1;
+	}
+
+	std::vector<CBenchmarkCase> cases;
+	add_pointer_cases(cases);
+	add_container_cases(cases);
+	add_asyncshared_cases(cases);
+
+	std::vector<CBenchmarkResult> results;
+	for (const auto& bcase : cases) {
+		const auto full_name = bcase.m_group + "/" + bcase.m_name;
+		if ((!options.m_filter.empty()) && (std::string::npos == full_name.find(options.m_filter))) {
+			continue;
+		}
+		if ("text" == options.m_format) {
+			std::cerr << "running: " << full_name << std::endl;
+		}
+		results.push_back(run_case(bcase, options));
+	}
+	set_relative_to_baseline(results);
+	output_results(results, options);
+	return 0;
+}
@@ -57,6 +57,7 @@ them to be enabled. */
 #include "mseivector.h"
 #include "msevector_test.h"
 #include "mseprimitives.h"
+#include "mseparallel.h"
 #include <algorithm>
 #include <iostream>
 #include <ctime>
@@ -69,12 +70,23 @@ them to be enabled. */
 /* This block of includes is required for the mse::TRegisteredRefWrapper example */
 #include <algorithm>
 #include <list>
+#include <deque>
 #include <vector>
 #include <iostream>
 #include <numeric>
 #include <random>
 #include <functional>
 
+/* Registered objects (and pointers) of a type that's expected to be targeted by a lot of pointers at once can be given a
+larger cache size, or a different tracker, by default by specializing mse::registered_tracker_traits<>. */
+class CWidelySharedNode {
+public:
+	int m_value = 7;
+};
+namespace mse {
+	template<> class registered_tracker_traits<CWidelySharedNode> : public CRegisteredIntrusiveListTrackerTraits {};
+}
+
 class H {
 public:
 	/* Just an example of a templated member function. In this case it's a static one, but it doesn't have to be.
@@ -183,8 +195,8 @@ int main(int argc, char* argv[])
 		vvi.clear();
 		try {
 			/* At this point, the vint_type object is cleared from vvi, but it has not been deallocated/destructed yet because it
-			"knows" that there is an iterator, namely vi_it, that is still referencing it. At the moment, std::shared_ptrs are being
-			used to achieve this. */
+			"knows" that there is an iterator, namely vi_it, that is still referencing it. At the moment, (non-atomic) reference
+			counting pointers are being used to achieve this. */
 			auto value = (*vi_it); /* So this is actually ok. vi_it still points to a valid item. */
 			assert(5 == value);
 			vint_type vi2;
@@ -195,6 +207,23 @@ int main(int argc, char* argv[])
 		catch (...) {
 			/* At present, no exception will be thrown. We're still debating whether it'd be better to throw an exception though. */
 		}
+
+		/* Moving a vector just transfers ownership of its contents. Iterators continue to be valid and refer to the
+		contents in their new vector. The moved-from vector is left empty and usable. */
+		vint_type vi3 = { 1, 2, 3 };
+		auto vi3_it = vi3.begin();
+		vint_type vi4(std::move(vi3));
+		assert(3 == vi4.size());
+		assert(1 == (*vi3_it));
+		vi3_it++;
+		assert(2 == (*vi3_it));
+		assert(vi4.end() != vi3_it + 1);
+		assert(vi4.end() == vi3_it + 2);
+		assert(0 == vi3.size());
+		vi3.push_back(4);
+		vi3 = std::move(vi4);
+		assert(3 == vi3.size());
+		assert(0 == vi4.size());
 	}
 #endif // !MSE_MSTDVECTOR_DISABLED
 
@@ -203,6 +232,8 @@ int main(int argc, char* argv[])
 		/*   msevector<>::ipointer   */
 		/*****************************/
 
+		mse::s_msevector_iterator_pool_test1();
+
 		/* mse::msevector<> is another vector that is highly compatible with std::vector<>. But mse::msevector<> also
 		supports a new type of iterator called "ipointer". ipointers make more (intuitive) sense than standard vector
 		iterators. Upon insert or delete, ipointers continue to point to the same item, not (necessarily) the same
@@ -249,6 +280,93 @@ int main(int argc, char* argv[])
 				v.insert_before(v.ibegin(), (*cip));
 			}
 		}
+		{
+			/* When there are many ipointers, inserts and erases are recorded in a log that each ipointer catches up
+			with the next time it's used, rather than each insert and erase having to adjust every ipointer. */
+			mse::msevector<int> v2;
+			for (int i = 0; i < 100; i += 1) { v2.push_back(i); }
+			std::vector<mse::msevector<int>::ipointer> ipointers;
+			for (int i = 0; i < 100; i += 1) {
+				ipointers.emplace_back(v2.ibegin() + i);
+			}
+			mse::msevector<int>::cipointer end_cip = v2.ciend();
+			for (int i = 0; i < 1000; i += 1) {
+				v2.insert(v2.ibegin() + 50, -1);
+			}
+			assert(v2.ciend() == end_cip);
+			for (int i = 0; i < 100; i += 1) {
+				assert(i == (*(ipointers[i])));
+			}
+			for (int i = 0; i < 500; i += 1) {
+				v2.erase(v2.ibegin() + 50);
+			}
+			assert(49 == (*(ipointers[49])));
+			assert(v2.ciend() == end_cip);
+			for (int i = 0; i < 100; i += 1) {
+				assert(i == (*(ipointers[i])));
+			}
+			assert(550 == (ipointers[50] - ipointers[0]));
+		}
+		{
+			/* When inserting or erasing many elements at once, the "bulk" operations move the elements only once and
+			adjust each ipointer only once, rather than once per inserted or erased element. */
+			mse::msevector<int> v3;
+			for (int i = 0; i < 20; i += 1) { v3.push_back(i); }
+			auto ip_5 = v3.ibegin() + 5;
+			auto ip_6 = v3.ibegin() + 6;
+			auto ip_end = v3.iend();
+
+			assert(10 == v3.erase_if([](int x) { return (0 == (x % 2)); }));
+			assert(10 == v3.size());
+			assert(5 == (*ip_5));
+			assert(2 == ip_5.position());
+			assert(ip_6.points_to_end_marker());
+			assert(v3.iend() == ip_end);
+
+			v3.erase_positions(std::vector<size_t>{ 0, 2, 9 });
+			assert(7 == v3.size());
+			assert(ip_5.points_to_end_marker());
+
+			std::vector<int> many_ints = { 100, 101, 102 };
+			v3.insert_many(1, many_ints);
+			assert(10 == v3.size());
+			assert(100 == v3[1]);
+			auto ip_101 = v3.ibegin() + 2;
+			v3.insert_many(0, { -2, -1 });
+			assert(101 == (*ip_101));
+			assert(v3.iend() == ip_end);
+
+			v3.assign_from_range(std::move(many_ints));
+			assert(3 == v3.size());
+			assert(ip_101.points_to_end_marker());
+
+			/* The bulk operations also work when there are enough ipointers that modifications are being logged. */
+			mse::msevector<int> v4;
+			for (int i = 0; i < 100; i += 1) { v4.push_back(i); }
+			std::vector<mse::msevector<int>::ipointer> ipointers;
+			for (int i = 0; i < 100; i += 1) {
+				ipointers.emplace_back(v4.ibegin() + i);
+			}
+			v4.insert(v4.ibegin(), -1);
+			v4.erase_if([](int x) { return (0 != (x % 3)); });
+			assert(34 == v4.size());
+			for (int i = 0; i < 100; i += 1) {
+				if (0 == (i % 3)) {
+					assert(i == (*(ipointers[i])));
+					assert(mse::msev_size_t(i / 3) == ipointers[i].position());
+				}
+				else {
+					assert(ipointers[i].points_to_end_marker());
+				}
+			}
+			try {
+				v4.erase_positions({ 3, 1 });
+				assert(false);
+			}
+			catch (mse::msevector_range_error&) {
+				assert(34 == v4.size());
+			}
+		}
 
 		/* Btw, ipointers are compatible with stl algorithms, like any other stl iterators. */
 		std::sort(v.ibegin(), v.iend());
@@ -265,6 +383,10 @@ int main(int argc, char* argv[])
 		mse::ivector<int> iv = { 1, 2, 3, 4 };
 		std::sort(iv.begin(), iv.end());
 		mse::ivector<int>::ipointer ivip = iv.begin();
+		mse::ivector<int> iv2(std::move(iv));
+		assert(4 == iv2.size());
+		assert(1 == (*ivip));
+		assert(iv.empty());
 	}
 
 #ifndef MSE_MSTDARRAY_DISABLED
@@ -505,6 +627,78 @@ int main(int argc, char* argv[])
 			std::cerr << "expected exception" << std::endl;
 			/* The exception is triggered by an attempt to set an mse::CSize_t to an "out of range" value. */
 		}
+
+		{
+			/* Operations on (contiguous) ranges of CInts or CSize_ts can be done with the "bulk" functions, which, rather than
+			checking each element (or each step) individually, do a single (overflow or range) check for the whole range. */
+			std::vector<int> native_ints = { 1, -2, 3, 4 };
+			std::vector<mse::CInt> cints(native_ints.size());
+			mse::bulk_copy_from_native(native_ints.data(), native_ints.data() + native_ints.size(), cints.data());
+			const auto cints_begin = cints.data();
+			const auto cints_end = cints.data() + cints.size();
+
+			mse::CInt sum1 = mse::bulk_sum(cints_begin, cints_end);
+			assert(6 == sum1);
+
+			std::vector<mse::CInt> sums(cints.size());
+			mse::bulk_add(cints_begin, cints_end, cints_begin, sums.data());
+			std::vector<mse::CInt> products(cints.size());
+			mse::bulk_multiply(cints_begin, cints_end, cints_begin, products.data());
+			bool sums_are_less[4];
+			mse::bulk_less(sums.data(), sums.data() + sums.size(), products.data(), sums_are_less);
+			assert((!sums_are_less[0]) && sums_are_less[1] && sums_are_less[2] && sums_are_less[3]);
+
+			std::vector<short> native_shorts(cints.size());
+			mse::bulk_copy_to_native(cints_begin, cints_end, native_shorts.data());
+			assert(-2 == native_shorts[1]);
+
+#ifndef MSE_PRIMITIVES_DISABLED
+			try {
+				std::vector<mse::CSize_t> cszts(native_ints.size());
+				/* native_ints contains a negative value, so this is gonna throw an exception (before any values are copied). */
+				mse::bulk_copy_from_native(native_ints.data(), native_ints.data() + native_ints.size(), cszts.data());
+				assert(false);
+			}
+			catch (...) {
+				std::cerr << "expected exception" << std::endl;
+			}
+
+			try {
+				cints[0] = std::numeric_limits<mse::CInt>::max();
+				/* The sum of the (first) two elements overflows, so this is gonna throw an exception. */
+				mse::bulk_add(cints_begin, cints_end, cints_begin, sums.data());
+				assert(false);
+			}
+			catch (...) {
+				std::cerr << "expected exception" << std::endl;
+			}
+#endif // !MSE_PRIMITIVES_DISABLED
+		}
+
+#ifndef MSE_PRIMITIVES_DISABLED
+		{
+			/* Arithmetic operations on CInts and CSize_ts are checked for overflow (using the compiler's overflow detecting
+			intrinsics where available). */
+			try {
+				mse::CInt cint_max = std::numeric_limits<mse::CInt>::max();
+				mse::CInt cint2 = cint_max - 1; /* this is fine */
+				cint2 = cint_max + 1; /* this is gonna throw an exception */
+				assert(false);
+			}
+			catch (...) {
+				std::cerr << "expected exception" << std::endl;
+			}
+
+#if !defined(MSVC2015_COMPATIBLE) && !defined(MSVC2013_COMPATIBLE) && !defined(MSVC2010_COMPATIBLE) && (!defined(__cplusplus) || (__cplusplus >= 201402L) || defined(_MSC_VER))
+			/* And (in C++14 and later) they can be evaluated at compile-time, in which case an overflow results in a compile
+			error. */
+			constexpr mse::CInt cint3 = mse::CInt(6) * 7;
+			static_assert(42 == cint3, "");
+			constexpr mse::CSize_t cszt3 = mse::CSize_t(3) + mse::CSize_t(4);
+			static_assert(7 == cszt3, "");
+#endif // !defined(MSVC2015_COMPATIBLE) && ...
+		}
+#endif // !MSE_PRIMITIVES_DISABLED
 	}
 
 	{
@@ -663,6 +857,55 @@ int main(int argc, char* argv[])
 			std::string res1 = H::foo6(s2_safe_ptr1, s2_safe_const_ptr1);
 		}
 
+		{
+			/* The default tracker for CWidelySharedNode has been specified via mse::registered_tracker_traits<> (above). */
+			static_assert(mse::sc_intrusive_list_tracker == mse::TRegisteredTrackerParam<CWidelySharedNode>::value, "");
+			mse::TRegisteredObj<CWidelySharedNode> registered_node;
+			std::vector<mse::TRegisteredPointer<CWidelySharedNode>> node_ptrs(100, &registered_node);
+			mse::TRegisteredConstPointer<CWidelySharedNode> node_cptr = node_ptrs.back();
+			assert(7 == node_cptr->m_value);
+		}
+
+		{
+			/* Moving a registered pointer transfers the source pointer's registration to the new pointer (leaving the source
+			null), rather than registering the new pointer and unregistering the source. So, for example, an std::vector of
+			registered pointers doesn't have to re-register its elements when it grows. */
+#if !defined(MSVC2013_COMPATIBLE) && !defined(MSVC2010_COMPATIBLE)
+			static_assert(std::is_nothrow_move_constructible<mse::TRegisteredPointer<A> >::value, "");
+#endif // !defined(MSVC2013_COMPATIBLE) && !defined(MSVC2010_COMPATIBLE)
+			mse::TRegisteredPointer<A> a_ptr1;
+			std::vector<mse::TRegisteredPointer<A>> a_ptrs;
+			std::vector<mse::TRegisteredPointer<CWidelySharedNode>> node_ptrs;
+			{
+				mse::TRegisteredObj<A> registered_a;
+				mse::TRegisteredPointer<A> a_ptr2 = &registered_a;
+				a_ptr1 = std::move(a_ptr2);
+				assert(!a_ptr2);
+				assert(a_ptr1 == &registered_a);
+				for (int i = 0; i < 100; i += 1) {
+					a_ptrs.push_back(a_ptr1);
+				}
+				mse::TRegisteredPointer<A> a_ptr3(std::move(a_ptrs.back()));
+				a_ptrs.back() = std::move(a_ptr3);
+
+				mse::TRegisteredObj<CWidelySharedNode> registered_node;
+				for (int i = 0; i < 100; i += 1) {
+					node_ptrs.push_back(&registered_node);
+				}
+				node_ptrs.erase(node_ptrs.begin() + 10, node_ptrs.begin() + 20);
+				assert(7 == node_ptrs.front()->m_value);
+
+				/* Not null pointers are never left null, so "moving" one just copies it. */
+				auto a_fixed_ptr = &registered_a;
+				mse::TRegisteredPointer<A> a_ptr4 = std::move(a_fixed_ptr);
+				assert(a_fixed_ptr == &registered_a);
+			}
+			/* The moved pointers were all properly tracked, so they've all been nulled upon the targets' destruction. */
+			assert(!a_ptr1);
+			for (const auto& a_ptr : a_ptrs) { assert(!a_ptr); }
+			for (const auto& node_ptr : node_ptrs) { assert(!node_ptr); }
+		}
+
 		{
 			/***********************************/
 			/*   TRelaxedRegisteredPointer   */
@@ -719,285 +962,106 @@ int main(int argc, char* argv[])
 				mse::TRelaxedRegisteredFixedPointer<D> D_relaxedregistered_fptr2 = &relaxedregistered_gd;
 				mse::TRelaxedRegisteredFixedConstPointer<D> D_relaxedregistered_fcptr2 = &relaxedregistered_gd;
 			}
-		}
 
-		mse::s_regptr_test1();
-		mse::s_relaxedregptr_test1();
-
-		{
-			/*************************/
-			/*   Simple Benchmarks   */
-			/*************************/
-
-			/* Just some simple speed tests. */
-			class CE {
-			public:
-				CE() {}
-				CE(int& count_ref) : m_count_ptr(&count_ref) { (*m_count_ptr) += 1; }
-				virtual ~CE() { (*m_count_ptr) -= 1; }
-				int m_x;
-				int *m_count_ptr;
-			};
-#ifndef NDEBUG
-			static const int number_of_loops = 10/*arbitrary*/;
-#else // !NDEBUG
-			static const int number_of_loops = 1000000/*arbitrary*/;
-#endif // !NDEBUG
-			std::cout << std::endl;
-			std::cout << "Some simple benchmarks: \n";
-			std::cout << "number of loops: " << number_of_loops << " \n" << " \n";
 			{
-				int count = 0;
-				auto item_ptr2 = new CE(count);
-				delete item_ptr2; item_ptr2 = nullptr;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					auto item_ptr = new CE(count);
-					item_ptr2 = item_ptr;
-					delete item_ptr;
-					item_ptr = nullptr;
+				/* Relaxed registered objects and pointers are tracked on a per-thread basis. Here, a few threads each use
+				their own (cached) tracker. */
+				auto thread_function = [](int count) {
+					int sum = 0;
+					for (int i = 0; i < count; i += 1) {
+						mse::TRelaxedRegisteredObj<C> relaxedregistered_c;
+						mse::TRelaxedRegisteredPointer<C> C_relaxedregistered_ptr1 = &relaxedregistered_c;
+						mse::TRelaxedRegisteredPointer<C> C_relaxedregistered_ptr2 = C_relaxedregistered_ptr1;
+						auto D_relaxedregistered_ptr1 = mse::relaxed_registered_new<D>();
+						C_relaxedregistered_ptr2->m_d_ptr = D_relaxedregistered_ptr1;
+						D_relaxedregistered_ptr1->m_c_ptr = C_relaxedregistered_ptr1;
+						if (std::addressof(relaxedregistered_c) == (C*)(C_relaxedregistered_ptr2->m_d_ptr->m_c_ptr)) {
+							sum += 1;
+						}
+						mse::relaxed_registered_delete<D>(D_relaxedregistered_ptr1);
+					}
+					return sum;
+				};
+				std::list<std::future<int>> futures;
+				for (size_t i = 0; i < 3; i += 1) {
+					futures.emplace_back(std::async(std::launch::async, thread_function, 100));
 				}
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "native pointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
+				int sum = 0;
+				for (auto it = futures.begin(); futures.end() != it; it++) {
+					sum += (*it).get();
 				}
-				std::cout << std::endl;
+				assert(3 * 100 == sum);
 			}
-			{
-				int count = 0;
-				mse::TRegisteredPointer<CE> item_ptr2 = mse::registered_new<CE>(count);
-				mse::registered_delete<CE>(item_ptr2);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					mse::TRegisteredPointer<CE> item_ptr = mse::registered_new<CE>(count);
-					item_ptr2 = item_ptr;
-					mse::registered_delete<CE>(item_ptr);
-				}
 
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRegisteredPointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
 			{
-				int count = 0;
-				mse::TRelaxedRegisteredPointer<CE> item_ptr2 = mse::relaxed_registered_new<CE>(count);
-				mse::relaxed_registered_delete<CE>(item_ptr2);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					mse::TRelaxedRegisteredPointer<CE> item_ptr = mse::relaxed_registered_new<CE>(count);
-					item_ptr2 = item_ptr;
-					mse::relaxed_registered_delete<CE>(item_ptr);
+				/* When the library's vectors and arrays of relaxed registered objects are cleared, shrunk or destroyed, the
+				pointers targeting the destroyed elements are nulled in a single sweep of the tracker rather than the tracker
+				being searched once per element. */
+				typedef mse::TRelaxedRegisteredObj<std::string> relaxedregistered_string_type;
+				mse::TRelaxedRegisteredPointer<std::string> string_ptr1;
+				mse::TRelaxedRegisteredPointer<std::string> string_ptr2;
+				mse::TRelaxedRegisteredPointer<std::string> string_ptr3;
+				mse::TRelaxedRegisteredObj<std::string> survivor("survivor");
+				mse::TRelaxedRegisteredPointer<std::string> survivor_ptr = &survivor;
+				{
+					mse::msevector<relaxedregistered_string_type> vec1(10);
+					string_ptr1 = &(vec1[2]);
+					string_ptr2 = &(vec1[8]);
+					string_ptr3 = &(vec1[9]);
+					vec1.resize(9);
+					assert(string_ptr1 && string_ptr2 && (!string_ptr3));
+					vec1.clear();
+					assert((!string_ptr1) && (!string_ptr2));
+
+					vec1.resize(5);
+					string_ptr1 = &(vec1[4]);
 				}
-
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRelaxedRegisteredPointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
+				assert(!string_ptr1);
+				{
+					mse::mstd::array<relaxedregistered_string_type, 3> array1;
+					string_ptr2 = &(array1[0]);
 				}
-				std::cout << std::endl;
+				assert(!string_ptr2);
+				assert(survivor_ptr && ("survivor" == (*survivor_ptr)));
 			}
-			{
-				int count = 0;
-				auto item_ptr2 = std::make_shared<CE>(count);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					auto item_ptr = std::make_shared<CE>(count);
-					item_ptr2 = item_ptr;
-					item_ptr = nullptr;
-				}
-				item_ptr2 = nullptr;
+		}
 
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "std::shared_ptr: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				int count = 0;
-				mse::TRegisteredObj<CE> place_holder1(count);
-				mse::TRegisteredPointer<CE> item_ptr2 = &place_holder1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				{
-					for (int i = 0; i < number_of_loops; i += 1) {
-						mse::TRegisteredObj<CE> object(count);
-						mse::TRegisteredPointer<CE> item_ptr = &object;
-						item_ptr2 = item_ptr;
-					}
-				}
+		mse::s_regptr_test1();
+		mse::s_relaxedregptr_test1();
 
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRegisteredPointer targeting the stack: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				int count = 0;
-				mse::TRefCountingPointer<CE> item_ptr2 = mse::make_refcounting<CE>(count);
-				auto t1 = std::chrono::high_resolution_clock::now();
-				for (int i = 0; i < number_of_loops; i += 1) {
-					mse::TRefCountingPointer<CE> item_ptr = mse::make_refcounting<CE>(count);
-					item_ptr2 = item_ptr;
-					item_ptr = nullptr;
-				}
-				item_ptr2 = nullptr;
+		/* The (micro)benchmarks of the library's pointers (and other elements) can be found in msetl_benchmarks.cpp. */
+	}
 
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRefCountingPointer: " << time_span.count() << " seconds.";
-				if (0 != count) {
-					std::cout << " destructions pending: " << count << "."; /* Using the count variable for (potential) output should prevent the optimizer from discarding it. */
-				}
-				std::cout << std::endl;
-			}
+	{
+		/*************************/
+		/*   Checking policies   */
+		/*************************/
 
-			std::cout << std::endl;
-			static const int number_of_loops2 = (10/*arbitrary*/)*number_of_loops;
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					CF* m_next_item_ptr;
-					int m_a = 3;
-				};
-				CF item1(1);
-				CF item2(2);
-				CF item3(3);
-				item1.m_next_item_ptr = &item2;
-				item2.m_next_item_ptr = &item3;
-				item3.m_next_item_ptr = &item1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				CF* cf_ptr = item1.m_next_item_ptr;
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					cf_ptr = cf_ptr->m_next_item_ptr;
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "native pointer dereferencing: " << time_span.count() << " seconds.";
-				if (3 == cf_ptr->m_a) {
-					std::cout << " "; /* Using cf_ptr->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					mse::TRelaxedRegisteredPointer<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				mse::TRelaxedRegisteredObj<CF> item1(1);
-				mse::TRelaxedRegisteredObj<CF> item2(2);
-				mse::TRelaxedRegisteredObj<CF> item3(3);
-				item1.m_next_item_ptr = &item2;
-				item2.m_next_item_ptr = &item3;
-				item3.m_next_item_ptr = &item1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				mse::TRelaxedRegisteredPointer<CF>* rpfl_ptr = std::addressof(item1.m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					rpfl_ptr = std::addressof((*rpfl_ptr)->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRelaxedRegisteredPointer (checked) dereferencing: " << time_span.count() << " seconds.";
-				if (3 == (*rpfl_ptr)->m_a) {
-					std::cout << " "; /* Using rpfl_ref->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					mse::TRelaxedRegisteredPointer<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				mse::TRelaxedRegisteredObj<CF> item1(1);
-				mse::TRelaxedRegisteredObj<CF> item2(2);
-				mse::TRelaxedRegisteredObj<CF> item3(3);
-				item1.m_next_item_ptr = &item2;
-				item2.m_next_item_ptr = &item3;
-				item3.m_next_item_ptr = &item1;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				CF* cf_ptr = (item1.m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					cf_ptr = (cf_ptr->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRelaxedRegisteredPointer unchecked dereferencing: " << time_span.count() << " seconds.";
-				if (3 == cf_ptr->m_a) {
-					std::cout << " "; /* Using rpfl_ref->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					std::weak_ptr<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				auto item1_ptr = std::make_shared<CF>(1);
-				auto item2_ptr = std::make_shared<CF>(2);
-				auto item3_ptr = std::make_shared<CF>(3);
-				item1_ptr->m_next_item_ptr = item2_ptr;
-				item2_ptr->m_next_item_ptr = item3_ptr;
-				item3_ptr->m_next_item_ptr = item1_ptr;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				std::weak_ptr<CF>* wp_ptr = &(item1_ptr->m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					wp_ptr = &((*wp_ptr).lock()->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "std::weak_ptr dereferencing: " << time_span.count() << " seconds.";
-				if (3 == (*wp_ptr).lock()->m_a) {
-					std::cout << " "; /* Using wp_ref.lock()->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
-			{
-				class CF {
-				public:
-					CF(int a = 0) : m_a(a) {}
-					mse::TRefCountingPointer<CF> m_next_item_ptr;
-					int m_a = 3;
-				};
-				auto item1_ptr = mse::make_refcounting<CF>(1);
-				auto item2_ptr = mse::make_refcounting<CF>(2);
-				auto item3_ptr = mse::make_refcounting<CF>(3);
-				item1_ptr->m_next_item_ptr = item2_ptr;
-				item2_ptr->m_next_item_ptr = item3_ptr;
-				item3_ptr->m_next_item_ptr = item1_ptr;
-				auto t1 = std::chrono::high_resolution_clock::now();
-				mse::TRefCountingPointer<CF>* refc_ptr = &(item1_ptr->m_next_item_ptr);
-				for (int i = 0; i < number_of_loops2; i += 1) {
-					refc_ptr = &((*refc_ptr)->m_next_item_ptr);
-				}
-				auto t2 = std::chrono::high_resolution_clock::now();
-				auto time_span = std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1);
-				std::cout << "mse::TRefCountingPointer (checked) dereferencing: " << time_span.count() << " seconds.";
-				item1_ptr->m_next_item_ptr = nullptr; /* to break the reference cycle */
-				if (3 == (*refc_ptr)->m_a) {
-					std::cout << " "; /* Using refc_ref->m_a for (potential) output should prevent the optimizer from discarding too much. */
-				}
-				std::cout << std::endl;
-			}
+		/* The MSE_..._DISABLED macros replace the library's safe types with their native/standard counterparts for the whole
+		program. Alternatively, a performance critical module can use the "policy selected" types with CUncheckedPolicy to get
+		the native/standard types, while the rest of the program continues to use the safe types. */
+		typedef mse::CUncheckedPolicy hot_module_policy;
+		static_assert(std::is_same<std::vector<int>, mse::TPolicyVector<int, hot_module_policy> >::value, "");
+		static_assert(std::is_same<mse::msevector<int>, mse::TPolicyVector<int> >::value, "");
+		static_assert(std::is_same<std::string*, mse::TPolicyRegisteredPointer<std::string, hot_module_policy> >::value, "");
+
+		mse::TPolicyVector<int> checked_vector = { 1, 2, 3 };
+		mse::TPolicyVector<int, hot_module_policy> unchecked_vector;
+		/* Moving the contents across the boundary doesn't copy any elements. */
+		checked_vector.swap(unchecked_vector);
+		mse::TPolicyInt<hot_module_policy> unchecked_sum = 0;
+		for (const auto& item : unchecked_vector) {
+			unchecked_sum += item;
 		}
+		mse::TPolicyInt<> checked_sum = unchecked_sum;
+		assert(6 == checked_sum);
+		checked_vector.assign_from_range(std::move(unchecked_vector));
+		assert(3 == checked_vector.size());
+
+		mse::TPolicyRegisteredObj<std::string> registered_string("some text");
+		mse::TPolicyRegisteredPointer<std::string> registered_ptr = &registered_string;
+		mse::TPolicyRegisteredPointer<std::string, hot_module_policy> native_ptr = static_cast<std::string*>(registered_ptr);
+		assert(9 == native_ptr->size());
 	}
 
 #if defined(MSEREGISTEREDREFWRAPPER) && !defined(MSE_PRIMITIVES_DISABLED)
@@ -1136,9 +1200,110 @@ int main(int argc, char* argv[])
 			std::string res1 = H::foo6(s_safe_ptr1, s_safe_const_ptr1);
 		}
 
+		{
+			/* When you're creating and destroying lots of (small) objects, you can have them allocated with an allocator
+			of your choice. mse::TRefCountingPoolAllocator<> is a ready-made one that uses a per-thread pool of memory
+			blocks, segregated by size. */
+			mse::TRefCountingPoolAllocator<A> pool_allocator;
+			const void* first_address = nullptr;
+			{
+				auto A_refcountingfixed_ptr1 = mse::allocate_refcounting<A>(pool_allocator);
+				first_address = std::addressof(*A_refcountingfixed_ptr1);
+				mse::TRefCountingPointer<A> A_refcounting_ptr2 = A_refcountingfixed_ptr1;
+				assert(3 == A_refcounting_ptr2->b);
+			}
+			{
+				/* The memory released by the first object is reused. */
+				auto A_refcountingfixed_ptr3 = mse::allocate_refcounting<A>(pool_allocator);
+				assert(std::addressof(*A_refcountingfixed_ptr3) == first_address);
+			}
+
+			/* Objects may be released by a thread other than the one that allocated them. */
+			auto A_refcountingfixed_ptr4 = std::async(std::launch::async, []() {
+				return mse::TRefCountingPointer<A>(mse::allocate_refcounting<A>(mse::TRefCountingPoolAllocator<A>()));
+			}).get();
+			A_refcountingfixed_ptr4 = nullptr;
+
+			/* Any standard conforming allocator will do. */
+			auto A_refcountingfixed_ptr5 = mse::allocate_refcounting<A>(std::allocator<A>());
+			auto A_refcountingofregisteredfixed_ptr1 = mse::allocate_refcountingofregistered<A>(pool_allocator);
+			assert(3 == A_refcountingofregisteredfixed_ptr1->b);
+		}
+
+		{
+			/* A pointer to a (non-first) base class targets the base class subobject. */
+			class CPadding {
+			public:
+				long long m_padding = 0;
+			};
+			class CBase {
+			public:
+				int m_a = 2;
+			};
+			class CDerived : public CPadding, public CBase {};
+			mse::TRefCountingPointer<CBase> base_refcptr = mse::make_refcounting<CDerived>();
+			assert(2 == base_refcptr->m_a);
+			mse::TRefCountingConstPointer<CBase> base_refccptr = base_refcptr;
+			assert(std::addressof(*base_refccptr) == std::addressof(*base_refcptr));
+		}
+
+		{
+			/* mse::TRefCountingPointer<>s are not thread safe. mse::TAtomicRefCountingPointer<>s can be copied and released
+			on different threads. Copying and releasing them on the thread that created the target object is almost as cheap as
+			with mse::TRefCountingPointer<>s. Only the other threads pay for atomic operations. Note that the target object
+			itself is not protected from concurrent access. */
+			class CCounted {
+			public:
+				CCounted(std::atomic<int>& num_destructions_ref) : m_num_destructions_ref(num_destructions_ref) {}
+				~CCounted() { m_num_destructions_ref += 1; }
+				std::atomic<int>& m_num_destructions_ref;
+				int m_value = 5;
+			};
+			std::atomic<int> num_destructions(0);
+			{
+				auto counted_fixed_ptr1 = mse::make_atomic_refcounting<CCounted>(num_destructions);
+				mse::TAtomicRefCountingConstPointer<CCounted> counted_const_ptr1 = counted_fixed_ptr1;
+
+				std::vector<std::thread> threads;
+				for (size_t i = 0; i < 4; i += 1) {
+					/* Copies made on this thread are counted (non-atomically) on this thread, and released on another. */
+					mse::TAtomicRefCountingPointer<CCounted> counted_ptr2 = counted_fixed_ptr1;
+					threads.emplace_back([counted_ptr2]() {
+						for (size_t j = 0; j < 1000; j += 1) {
+							/* Copies made on other threads are counted atomically. */
+							mse::TAtomicRefCountingConstPointer<CCounted> counted_const_ptr2 = counted_ptr2;
+							assert(5 == counted_const_ptr2->m_value);
+						}
+					});
+				}
+				for (auto& thread : threads) {
+					thread.join();
+				}
+				assert(0 == num_destructions);
+				assert(5 == counted_const_ptr1->m_value);
+			}
+			assert(1 == num_destructions);
+
+			{
+				/* The last reference may be released by a thread other than the one that created the target object. */
+				mse::TAtomicRefCountingPointer<CCounted> counted_ptr3 = mse::make_atomic_refcounting<CCounted>(num_destructions);
+				std::thread thread1([](mse::TAtomicRefCountingPointer<CCounted> counted_ptr) {
+					counted_ptr = nullptr;
+				}, std::move(counted_ptr3));
+				thread1.join();
+				/* But if the reference was counted on the creating thread, it may be that only the creating thread can
+				determine that it was the last one. In that case, the release is deferred until the creating thread next
+				creates or releases one of its (atomic refcounting) objects, or explicitly merges deferred releases. */
+				mse::merge_deferred_atomic_refcounting_releases();
+				assert(2 == num_destructions);
+			}
+		}
+
 		mse::TRefCountingPointer_test TRefCountingPointer_test1;
 		bool TRefCountingPointer_test1_res = TRefCountingPointer_test1.testBehaviour();
 		TRefCountingPointer_test1_res &= TRefCountingPointer_test1.testLinked();
+		TRefCountingPointer_test1_res &= TRefCountingPointer_test1.testPoolAllocatorCrossThread();
+		assert(TRefCountingPointer_test1_res);
 		TRefCountingPointer_test1.test1();
 	}
 
@@ -1299,6 +1464,62 @@ int main(int argc, char* argv[])
 		mse::TXScopeOwnerPointer<A> a_scpoptr(7);
 		int res4 = B::foo2(&(*a_scpoptr));
 
+#ifndef MSE_SCOPEPOINTER_USE_RELAXED_REGISTERED
+		/* Scope pointers (and TSaferPtr<>s and TPointer<>s) have no vtable pointer and are trivially copyable, so they can
+		be passed by value (in registers) just like native pointers. */
+		static_assert(std::is_trivially_copyable<mse::TXScopeFixedPointer<A> >::value, "");
+		static_assert(std::is_trivially_copyable<mse::TXScopeFixedConstPointer<A> >::value, "");
+		static_assert(std::is_trivially_copyable<mse::TSaferPtr<A> >::value, "");
+		static_assert(std::is_trivially_copyable<mse::TPointer<A> >::value, "");
+#ifndef MSE_TSAFERPTR_CHECK_USE_BEFORE_SET
+		static_assert(sizeof(void*) == sizeof(mse::TXScopeFixedPointer<A>), "");
+#endif // !MSE_TSAFERPTR_CHECK_USE_BEFORE_SET
+#endif // !MSE_SCOPEPOINTER_USE_RELAXED_REGISTERED
+
+		{
+			/* If you're going to create lots of (temporary) scope objects that all go away at the same time, you can
+			allocate them in an mse::TXScopeArena<>, which just bumps a pointer for each allocation and releases all its
+			memory at once when it goes out of scope. */
+			mse::TXScopeArena<> arena;
+			auto a_scpoptr2 = mse::make_xscope_owner_in<A>(arena, 11);
+			int res4b = B::foo2(&(*a_scpoptr2));
+			assert(11 == res4b);
+			for (int i = 0; i < 100; i += 1) {
+				auto a_scpoptr3 = mse::make_xscope_owner_in<A>(arena, i);
+				assert(i == B::foo3(&(*a_scpoptr3)));
+			}
+			/* Ownership can be transferred by moving. Dereferencing the moved-from owner pointer throws. */
+			auto a_scpoptr4 = std::move(a_scpoptr2);
+			assert(11 == B::foo2(&(*a_scpoptr4)));
+			bool threw = false;
+			try {
+				(void)a_scpoptr2->b;
+			}
+			catch (const mse::primitives_null_dereference_error&) {
+				threw = true;
+			}
+			assert(threw);
+			/* The objects are destroyed by their owner pointers, and the arena (declared first) is destroyed last. */
+		}
+		{
+			/* An over-aligned allocation following one that (exactly) filled its own oversized chunk, and following
+			inline storage whose size isn't a multiple of the alignment. */
+			struct CBig { char m_bytes[5016]; };
+			struct alignas(32) CAligned { int m_x = 3; };
+			mse::TXScopeArena<> arena;
+			auto big_scpoptr = mse::make_xscope_owner_in<CBig>(arena);
+			auto aligned_scpoptr = mse::make_xscope_owner_in<CAligned>(arena);
+			assert(0 == (reinterpret_cast<uintptr_t>(std::addressof(*aligned_scpoptr)) % 32));
+			aligned_scpoptr->m_x = 5;
+
+			mse::TXScopeArena<40> arena2;
+			auto aligned_scpoptr2 = mse::make_xscope_owner_in<CAligned>(arena2);
+			auto aligned_scpoptr3 = mse::make_xscope_owner_in<CAligned>(arena2);
+			assert(0 == (reinterpret_cast<uintptr_t>(std::addressof(*aligned_scpoptr3)) % 32));
+			aligned_scpoptr2->m_x = 5;
+			aligned_scpoptr3->m_x = 7;
+		}
+
 		/* You can use the "mse::make_pointer_to_member()" function to obtain a safe pointer to a member of
 		an xscope object. */
 		auto s_safe_ptr1 = mse::make_pointer_to_member((a_scpobj.s), (&a_scpobj));
@@ -1348,6 +1569,7 @@ int main(int argc, char* argv[])
 			auto h_string1_scpptr = mse::make_pointer_to_member(h_scpobj.m_string1, &h_scpobj);
 			(*h_string1_scpptr) = "some new text";
 			auto h_string1_scp_const_ptr = mse::make_const_pointer_to_member(h_scpobj.m_string1, &h_scpobj);
+			(void)h_string1_scp_const_ptr;
 
 			auto h_string1_refcptr = mse::make_pointer_to_member(h_refcptr->m_string1, h_refcptr);
 			(*h_string1_refcptr) = "some new text";
@@ -1518,7 +1740,52 @@ int main(int argc, char* argv[])
 		nanyptr1 = mse::TNullableAnyPointer<A>(&a_regobj);
 		nanyptr1 = mse::TNullableAnyPointer<A>(a_refcptr);
 		auto res_nap1 = *nanyptr1;
-		
+
+		{
+			/* The "any" pointers hold their target pointer in an mse::basic_any<> with enough inline storage for any of the
+			library's pointer (and iterator) types, so constructing or copying them doesn't allocate. basic_any<> can also
+			be used directly when you want an "any" with more inline storage than the standard 2 words. */
+			mse::basic_any<4 * sizeof(void*)> any1 = std::array<int, 4>{ { 1, 2, 3, 4 } };
+			auto any2 = any1;
+			assert((3 == mse::any_cast<std::array<int, 4>>(any2)[2]));
+			mse::any any3 = 5;
+			assert(5 == mse::any_cast<int>(any3));
+
+			/* When the inline storage doesn't require a nothrow move, (swapping and) moving a basic_any<> can throw. If it
+			does, the basic_any<>s are left in valid (but unspecified) states. */
+			class CThrowingCopy {
+			public:
+				CThrowingCopy(int x) : m_x(x) {}
+				CThrowingCopy(const CThrowingCopy& src) : m_x(src.m_x), m_throw_on_copy(src.m_throw_on_copy) {
+					if (m_throw_on_copy) { throw std::runtime_error("copy failed"); }
+				}
+				int m_x = 0;
+				bool m_throw_on_copy = false;
+			};
+			mse::basic_any<4 * sizeof(void*), false> any4 = CThrowingCopy(6);
+			mse::basic_any<4 * sizeof(void*), false> any5 = 7;
+			mse::any_cast<CThrowingCopy>(&any4)->m_throw_on_copy = true;
+			try {
+				any4.swap(any5);
+				assert(false);
+			}
+			catch (const std::runtime_error&) {}
+			assert((6 == mse::any_cast<CThrowingCopy>(&any4)->m_x) && (any5.empty() || (7 == mse::any_cast<int>(any5))));
+
+			/* Types without move assignment are swapped by (move) construction. basic_any<>'s swap() is found by argument
+			dependent lookup. */
+			class CNotAssignable {
+			public:
+				CNotAssignable(int x) : m_x(x) {}
+				const int m_x;
+			};
+			mse::basic_any<4 * sizeof(void*), false> any6 = CNotAssignable(8);
+			mse::basic_any<4 * sizeof(void*), false> any7 = CNotAssignable(9);
+			using std::swap;
+			swap(any6, any7);
+			assert((9 == mse::any_cast<CNotAssignable>(&any6)->m_x) && (8 == mse::any_cast<CNotAssignable>(&any7)->m_x));
+		}
+
 		mse::s_poly_test1();
 		int q = 3;
 	}
@@ -1609,6 +1876,153 @@ int main(int argc, char* argv[])
 		auto res8 = ra_section1_iter2 - ra_section1_iter1;
 		bool res9 = (ra_section1_iter1 < ra_section1_iter2);
 
+		{
+			/* When a section is constructed from a scope iterator of a fixed size contiguous container (like mstd::array),
+			it accesses the elements directly rather than through the (type-erased) iterator. A section constructed from an
+			ordinary mstd::array iterator keeps using the iterator, which checks that the array still exists. */
+			mse::TXScopeRandomAccessSection<int> ra_section1b(mstd_array_scpiter3, 2);
+			assert(nullptr != ra_section1b.contiguous_data_ptr());
+			assert(nullptr == ra_section1.contiguous_data_ptr());
+			{
+				mse::TRefCountingPointer<mse::mstd::array<int, 4>> mstd_array_refcptr = mse::make_refcounting<mse::mstd::array<int, 4>>(mse::mstd::array<int, 4>{ 1, 2, 3, 4 });
+				mse::TXScopeRandomAccessSection<int> ra_section1c(mstd_array_refcptr->begin(), 3);
+				mstd_array_refcptr = nullptr;
+				bool threw = false;
+				try {
+					(void)ra_section1c[1];
+				}
+				catch (...) {
+					threw = true;
+				}
+				assert(threw);
+			}
+			/* A section of a vector does so only if you pass mse::pin_container_size, in which case the vector can't be
+			resized while the section exists. */
+			mse::mstd::vector<int> mstd_vec2 { 10, 11, 12, 13, 14 };
+			{
+				mse::TXScopeRandomAccessSection<int> ra_section3b(++mstd_vec2.begin(), 3);
+				assert(nullptr == ra_section3b.contiguous_data_ptr());
+				mstd_vec2.push_back(15);
+				mstd_vec2.pop_back();
+			}
+			{
+				mse::TXScopeRandomAccessSection<int> ra_section3(mse::pin_container_size, ++mstd_vec2.begin(), 3);
+				assert(nullptr != ra_section3.contiguous_data_ptr());
+				B::foo3(ra_section3);
+				assert((0 == mstd_vec2[1]) && (0 == mstd_vec2[3]) && (14 == mstd_vec2[4]));
+				assert(0 == B::foo5(ra_section3));
+
+				bool resize_threw = false;
+				try {
+					mstd_vec2.push_back(15);
+				}
+				catch (mse::msevector_size_pinned_error&) {
+					resize_threw = true;
+				}
+				assert(resize_threw);
+			}
+			mstd_vec2.push_back(15);
+
+			int native_array1[3] = { 1, 2, 3 };
+			mse::TXScopeRandomAccessConstSection<int> ra_const_section1(native_array1, 3);
+			assert(6 == B::foo4(ra_const_section1));
+		}
+
+		{
+			/* A "checked span" validates its range once, when it's created, and then prevents the container's size from
+			changing for as long as it exists. So element access through the span doesn't need to be (re)checked. A span is
+			obtained from a scope pointer to the container, which ensures the container outlives the span. */
+			mse::TXScopeObj<mse::mstd::vector<int>> mstd_vec2(mse::mstd::vector<int>{ 10, 11, 12, 13, 14 });
+			mse::TXScopeObj<mse::msearray<int, 3>> msearray2(mse::msearray<int, 3>{ 1, 2, 3 });
+			{
+				auto checked_span1 = mse::make_xscope_checked_span(&mstd_vec2, 1, 3);
+				int sum1 = 0;
+				for (mse::TXScopeCheckedSpan<int>::size_type i = 0; i < checked_span1.size(); i += 1) {
+					sum1 += checked_span1.unchecked_at(i);
+				}
+				assert((11 + 12 + 13) == sum1);
+
+				/* Any attempt to resize the vector while the span exists will throw an exception. */
+				bool resize_threw = false;
+				try {
+					mstd_vec2.push_back(15);
+				}
+				catch (mse::msevector_size_pinned_error&) {
+					resize_threw = true;
+				}
+				assert(resize_threw);
+
+				mse::TXScopeCheckedSpan<const int> const_checked_span1 = checked_span1.subspan(1, 2);
+				int sum2 = 0;
+				for (const auto& item : const_checked_span1) {
+					sum2 += item;
+				}
+				assert((12 + 13) == sum2);
+
+				bool out_of_bounds_threw = false;
+				try {
+					auto checked_span2 = mse::make_xscope_checked_span(&mstd_vec2, 3, 3);
+				}
+				catch (mse::msearray_range_error&) {
+					out_of_bounds_threw = true;
+				}
+				assert(out_of_bounds_threw);
+			}
+			/* Once the span is gone, resizing is allowed again. */
+			mstd_vec2.push_back(15);
+			assert(6 == mstd_vec2.size());
+			mstd_vec2.pop_back();
+
+			auto checked_span3 = mse::make_xscope_checked_span(&msearray2);
+			checked_span3[0] += 1;
+			assert(2 == msearray2[0]);
+			checked_span3.unchecked_at(0) -= 1;
+		}
+
+		{
+			/* The mse::par algorithms validate the given range once, pin the container's size for the duration, and process
+			chunks of the range concurrently, directly on the underlying storage. */
+			const int num_items = 100000;
+			mse::mstd::vector<int> mstd_vec3(num_items);
+			for (int i = 0; i < num_items; i += 1) {
+				mstd_vec3[i] = num_items - i;
+			}
+			mse::par::for_each(mstd_vec3, [](int& item) { item *= 2; });
+			assert((2 * num_items) == mstd_vec3[0]);
+
+			mse::msevector<long long> msevec3(mstd_vec3.size());
+			mse::par::transform(mstd_vec3, msevec3, [](int item) { return (long long)(item) / 2; });
+			const auto sum1 = mse::par::reduce(msevec3, 0LL);
+			assert(((long long)(num_items) * (num_items + 1) / 2) == sum1);
+			auto max1 = mse::par::reduce(msevec3, 0LL, [](long long a, long long b) { return std::max(a, b); });
+			assert(num_items == max1);
+
+			mse::par::sort(msevec3);
+			assert(std::is_sorted(msevec3.cbegin(), msevec3.cend()) && (1 == msevec3.front()) && (num_items == msevec3.back()));
+			mse::par::sort(mstd_vec3, std::greater<int>());
+			assert((2 * num_items) == mstd_vec3.front());
+
+			/* Sections (and checked spans) that access their elements directly are processed the same way. */
+			mse::TXScopeRandomAccessSection<int> ra_section4(mse::pin_container_size, mstd_vec3.begin() + 10, num_items - 20);
+			mse::par::sort(ra_section4);
+			assert((22 == ra_section4[0]) && ((2 * (num_items - 10)) == ra_section4[ra_section4.size() - 1]));
+			mse::TXScopeObj<mse::mstd::array<int, 5>> mstd_array4(mse::mstd::array<int, 5>{ 5, 3, 4, 1, 2 });
+			mse::par::sort(mstd_array4);
+			assert((1 == mstd_array4[0]) && (5 == mstd_array4[4]));
+			auto checked_span4 = mse::make_xscope_checked_span(&mstd_array4, 1, 3);
+			assert((2 + 3 + 4) == mse::par::reduce(checked_span4, 0));
+
+			/* The vector can't be resized while an algorithm is operating on it. The exception is propagated to the caller. */
+			bool resize_threw = false;
+			try {
+				mse::par::for_each(mstd_vec3, [&mstd_vec3](int& item) { if (2 == item) { mstd_vec3.push_back(0); } });
+			}
+			catch (mse::msevector_size_pinned_error&) {
+				resize_threw = true;
+			}
+			assert(resize_threw && (num_items == mstd_vec3.size()));
+		}
+
 		{
 			mse::TIPointerWithBundledVector<int> iptrwbv1 = { 1, 2 };
 			iptrwbv1.resize(5);
@@ -1766,6 +2180,335 @@ int main(int argc, char* argv[])
 			}
 			std::cout << std::endl;
 		}
+		{
+			/* The "ObjectThatYouAreSureHasNoUnprotectedMutables" types take the type of mutex as an (optional) second
+			template parameter. For objects that are read (concurrently) by many threads, mse::async_shared_striped_timed_mutex_type
+			generally scales better than the default, at the cost of a (much) larger object. */
+			typedef mse::async_shared_striped_timed_mutex_type striped_mutex_t;
+			typedef mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteAccessRequester<A, striped_mutex_t> striped_access_requester_t;
+			auto ash_access_requester = mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<A, striped_mutex_t>(7);
+
+			auto reader = [](striped_access_requester_t access_requester) {
+				int last_b = 0;
+				for (size_t i = 0; i < 1000; i += 1) {
+					auto readlock_ptr1 = access_requester.readlock_ptr();
+					assert(last_b <= readlock_ptr1->b);
+					last_b = readlock_ptr1->b;
+				}
+			};
+			auto writer = [](striped_access_requester_t access_requester) {
+				for (size_t i = 0; i < 100; i += 1) {
+					access_requester.writelock_ptr()->b += 1;
+				}
+			};
+			std::list<std::future<void>> futures;
+			futures.emplace_back(std::async(std::launch::async, writer, ash_access_requester));
+			for (size_t i = 0; i < 3; i += 1) {
+				futures.emplace_back(std::async(std::launch::async, reader, ash_access_requester));
+			}
+			for (auto it = futures.begin(); futures.end() != it; it++) {
+				(*it).get();
+			}
+			assert(107 == ash_access_requester.readlock_ptr()->b);
+
+			std::future<void> future1;
+			{
+				/* Like the default, the striped mutex's read locks are recursive. A thread already holding a read lock
+				can obtain another one even while a writer is waiting (which would otherwise block new readers). */
+				auto readlock_ptr1 = ash_access_requester.readlock_ptr();
+				future1 = std::async(std::launch::async, [ash_access_requester]() mutable {
+					ash_access_requester.writelock_ptr()->b += 1;
+				});
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				auto readlock_ptr2 = ash_access_requester.readlock_ptr();
+				assert(107 == readlock_ptr2->b);
+			}
+			future1.get();
+			{
+				/* A reader can't get in while another thread holds the write lock. */
+				std::promise<void> release_promise;
+				std::promise<void> locked_promise;
+				auto holder_future = std::async(std::launch::async, [ash_access_requester, &release_promise, &locked_promise]() mutable {
+					auto writelock_ptr1 = ash_access_requester.writelock_ptr();
+					locked_promise.set_value();
+					release_promise.get_future().wait();
+				});
+				locked_promise.get_future().wait();
+				auto maybe_readlock_ptr = ash_access_requester.try_readlock_ptr();
+				assert(!maybe_readlock_ptr);
+				release_promise.set_value();
+				holder_future.get();
+				assert(108 == ash_access_requester.try_readlock_ptr().value()->b);
+			}
+			{
+				/* A thread can hold read locks on any number of objects at once. */
+				std::vector<striped_access_requester_t> access_requesters;
+				std::vector<mse::TAsyncSharedObjectThatYouAreSureHasNoUnprotectedMutablesReadWriteConstPointer<A, striped_mutex_t> > readlock_ptrs;
+				for (int i = 0; i < 40; i += 1) {
+					access_requesters.push_back(mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<A, striped_mutex_t>(i));
+				}
+				readlock_ptrs.reserve(2 * access_requesters.size());
+				for (auto& access_requester : access_requesters) {
+					readlock_ptrs.push_back(access_requester.readlock_ptr());
+				}
+				for (auto& access_requester : access_requesters) {
+					readlock_ptrs.push_back(access_requester.readlock_ptr());
+				}
+				for (int i = 0; i < 40; i += 1) {
+					assert((i == readlock_ptrs.at(i)->b) && (i == readlock_ptrs.at(40 + i)->b));
+				}
+				readlock_ptrs.clear();
+				for (auto& access_requester : access_requesters) {
+					auto maybe_writelock_ptr = access_requester.try_writelock_ptr();
+					assert(maybe_writelock_ptr);
+				}
+			}
+			{
+				/* Objects with different types of mutex can be locked together. */
+				auto ash_access_requester2 = mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadwrite<A>(3);
+				auto lock_ptrs = mse::lock_all(mse::readlock_request(ash_access_requester), ash_access_requester2);
+				std::get<1>(lock_ptrs)->b += std::get<0>(lock_ptrs)->b;
+				assert(111 == std::get<1>(lock_ptrs)->b);
+			}
+		}
+		{
+			/* For small trivially copyable objects that are read much more often than they're written, there's
+			mse::TAsyncSharedTriviallyCopyableReadWriteAccessRequester. Writers use writelock_ptr() as usual, but readers
+			don't take any lock. optimistic_read() just returns a (consistent) copy of the object. */
+			struct CTick {
+				long long m_bid;
+				long long m_ask;
+			};
+			auto tick_access_requester = mse::make_asyncsharedtriviallycopyablereadwrite<CTick>(CTick{ 100, 101 });
+
+			auto writer = [](mse::TAsyncSharedTriviallyCopyableReadWriteAccessRequester<CTick> access_requester) {
+				for (long long i = 0; i < 1000; i += 1) {
+					auto writelock_ptr = access_requester.writelock_ptr();
+					writelock_ptr->m_bid += 1;
+					/* Readers won't see this modification until the write lock is released. */
+					writelock_ptr->m_ask = writelock_ptr->m_bid + 1;
+				}
+			};
+			auto reader = [](mse::TAsyncSharedTriviallyCopyableReadWriteAccessRequester<CTick> access_requester) {
+				long long last_bid = 0;
+				for (size_t i = 0; i < 10000; i += 1) {
+					auto tick = access_requester.optimistic_read();
+					/* The invariant holds in every copy we get. */
+					assert(tick.m_bid + 1 == tick.m_ask);
+					assert(last_bid <= tick.m_bid);
+					last_bid = tick.m_bid;
+				}
+			};
+
+			std::list<std::future<void>> futures;
+			futures.emplace_back(std::async(std::launch::async, writer, tick_access_requester));
+			for (size_t i = 0; i < 3; i += 1) {
+				futures.emplace_back(std::async(std::launch::async, reader, tick_access_requester));
+			}
+			for (auto it = futures.begin(); futures.end() != it; it++) {
+				(*it).get();
+			}
+			assert(1100 == tick_access_requester.optimistic_read().m_bid);
+
+			auto maybe_writelock_ptr = tick_access_requester.try_writelock_ptr_for(std::chrono::seconds(1));
+			if (maybe_writelock_ptr) {
+				(*maybe_writelock_ptr)->m_ask += 1;
+			}
+		}
+		{
+			/* When you need locks on more than one shared object at a time, acquiring them one at a time risks deadlock
+			(if another thread acquires them in a different order). mse::lock_all() acquires them all at once, without
+			risk of deadlock. */
+			auto ash_access_requester1 = mse::make_asyncsharedreadwrite<A>(3);
+			auto ash_access_requester2 = mse::make_asyncsharedreadwrite<A>(5);
+			auto ash_access_requester3 = mse::make_asyncsharedobjectthatyouaresurehasnounprotectedmutablesreadonly<A>(7);
+
+			auto transfer = [](mse::TAsyncSharedReadWriteAccessRequester<A> from_ar, mse::TAsyncSharedReadWriteAccessRequester<A> to_ar) {
+				for (size_t i = 0; i < 1000; i += 1) {
+					auto lock_ptrs = mse::lock_all(from_ar, to_ar);
+					std::get<0>(lock_ptrs)->b -= 1;
+					std::get<1>(lock_ptrs)->b += 1;
+				}
+			};
+			/* These two threads request the same locks in opposite orders. */
+			auto future1 = std::async(std::launch::async, transfer, ash_access_requester1, ash_access_requester2);
+			auto future2 = std::async(std::launch::async, transfer, ash_access_requester2, ash_access_requester1);
+			future1.get();
+			future2.get();
+
+			{
+				/* Read and write locks can be mixed. Use mse::readlock_request() to obtain a readlock pointer from an
+				access requester that also supports write access. */
+				auto lock_ptrs = mse::lock_all(ash_access_requester1, mse::readlock_request(ash_access_requester2), ash_access_requester3);
+				std::get<0>(lock_ptrs)->b += std::get<1>(lock_ptrs)->b + std::get<2>(lock_ptrs)->b;
+				assert(15 == std::get<0>(lock_ptrs)->b);
+
+				/* The other objects are still locked, so the "try" version (from a different thread) would fail here. */
+				auto maybe_lock_ptrs = std::async(std::launch::async, [&]() {
+					return bool(mse::try_lock_all(ash_access_requester2, ash_access_requester1));
+				}).get();
+				assert(!maybe_lock_ptrs);
+			}
+			auto maybe_lock_ptrs = mse::try_lock_all_for(std::chrono::seconds(1), ash_access_requester2, ash_access_requester1);
+			assert(maybe_lock_ptrs);
+			assert((5 == std::get<0>(*maybe_lock_ptrs)->b) && (15 == std::get<1>(*maybe_lock_ptrs)->b));
+		}
+		{
+			/* Threads that mustn't block (like the threads of an event loop) can request locks asynchronously. You supply
+			an "executor" (a callable object taking a std::function<void()>) that will run the request's task, and a function
+			that will be called with the lock pointer once the lock is obtained. You get back a std::future<> of the
+			function's return value. The tasks submitted to the executor never block waiting for a lock, so even an executor
+			with a single thread can service any number of asynchronous requests. Here the "executor" just queues the tasks,
+			and we run them on this thread. (In practice, it'd generally be a thread pool or an event loop's task queue.) */
+			std::mutex tasks_mutex;
+			std::deque<std::function<void()>> tasks;
+			auto queueing_executor = [&tasks_mutex, &tasks](std::function<void()> task) {
+				std::lock_guard<std::mutex> lock1(tasks_mutex);
+				tasks.push_back(std::move(task));
+			};
+			auto run_queued_tasks = [&tasks_mutex, &tasks]() {
+				while (true) {
+					std::function<void()> task;
+					{
+						std::lock_guard<std::mutex> lock1(tasks_mutex);
+						if (tasks.empty()) {
+							break;
+						}
+						task = std::move(tasks.front());
+						tasks.pop_front();
+					}
+					task();
+				}
+			};
+
+			{
+				auto ash_access_requester = mse::make_asyncsharedreadwrite<A>(7);
+
+				std::future<void> future1;
+				std::future<int> future2;
+				std::future<void> future3;
+				{
+					auto writelock_ptr1 = ash_access_requester.writelock_ptr();
+
+					/* None of these calls block, even though we're holding a write lock. */
+					future1 = ash_access_requester.async_writelock_ptr(queueing_executor, [](mse::TAsyncSharedReadWritePointer<A>& ptr) { ptr->s += "a"; });
+					future2 = ash_access_requester.async_readlock_ptr(queueing_executor, [](mse::TAsyncSharedReadWriteConstPointer<A>& ptr) { return ptr->b; });
+					future3 = ash_access_requester.async_writelock_ptr(queueing_executor, [](mse::TAsyncSharedReadWritePointer<A>& ptr) { ptr->s += "b"; });
+
+					writelock_ptr1->b = 11;
+				}
+				/* Releasing the lock resubmitted the first request, and each request's release submits the next one. */
+				run_queued_tasks();
+				future1.get();
+				assert(11 == future2.get());
+				future3.get();
+				/* Asynchronous lock requests are granted in the order they were made. */
+				assert("some text ab" == ash_access_requester.readlock_ptr()->s);
+			}
+			{
+				auto ash_access_requester = mse::make_asyncsharedreadwrite<A>(7);
+				std::promise<void> release_promise;
+				std::promise<void> locked_promise;
+				/* Another thread holds the lock until we tell it to let go. */
+				auto holder_future = std::async(std::launch::async, [ash_access_requester, &release_promise, &locked_promise]() mutable {
+					auto writelock_ptr1 = ash_access_requester.writelock_ptr();
+					locked_promise.set_value();
+					release_promise.get_future().wait();
+					writelock_ptr1->s = "";
+				});
+				locked_promise.get_future().wait();
+
+				auto future1 = ash_access_requester.async_writelock_ptr(queueing_executor, [](mse::TAsyncSharedReadWritePointer<A>& ptr) { ptr->s += "1"; });
+				auto future2 = ash_access_requester.async_readlock_ptr(queueing_executor, [](mse::TAsyncSharedReadWriteConstPointer<A>& ptr) { return ptr->s; });
+				auto future3 = ash_access_requester.async_writelock_ptr(queueing_executor, [](mse::TAsyncSharedReadWritePointer<A>& ptr) { ptr->s += "3"; });
+				/* The lock isn't available, so the first request's task just returns (without blocking this thread). */
+				run_queued_tasks();
+				assert(std::future_status::timeout == future1.wait_for(std::chrono::seconds(0)));
+
+				/* The other thread's release of the lock resubmits the first request (from that thread). */
+				release_promise.set_value();
+				holder_future.get();
+				run_queued_tasks();
+				future1.get();
+				assert("1" == future2.get());
+				future3.get();
+				assert("13" == ash_access_requester.readlock_ptr()->s);
+			}
+			{
+				auto ash_access_requester = mse::make_asyncsharedreadwrite<A>(7);
+				std::atomic<bool> stop_reading{ false };
+				std::promise<void> reading_promise;
+				auto reading_future = reading_promise.get_future().share();
+				/* Several threads take turns reading the object, so that there's (almost) always someone holding, or blocked
+				waiting for, the lock. */
+				std::vector<std::future<void>> reader_futures;
+				for (size_t i = 0; i < 3; i += 1) {
+					reader_futures.push_back(std::async(std::launch::async, [ash_access_requester, &stop_reading, reading_future]() mutable {
+						reading_future.wait();
+						while (!stop_reading.load()) {
+							auto readlock_ptr1 = ash_access_requester.readlock_ptr();
+							std::this_thread::sleep_for(std::chrono::milliseconds(2));
+						}
+					}));
+				}
+				reading_promise.set_value();
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+				/* Once the request has failed to obtain the lock, new (synchronous) lock acquisitions give way to it. So
+				the readers can't starve it. */
+				auto future1 = ash_access_requester.async_writelock_ptr(queueing_executor, [](mse::TAsyncSharedReadWritePointer<A>& ptr) { ptr->s = "written"; });
+				const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+				while ((std::future_status::ready != future1.wait_for(std::chrono::milliseconds(1))) && (std::chrono::steady_clock::now() < deadline)) {
+					run_queued_tasks();
+				}
+				const bool writer_completed = (std::future_status::ready == future1.wait_for(std::chrono::seconds(0)));
+				stop_reading.store(true);
+				for (auto& reader_future : reader_futures) {
+					reader_future.get();
+				}
+				assert(writer_completed);
+				future1.get();
+				assert("written" == ash_access_requester.readlock_ptr()->s);
+			}
+		}
+#ifdef MSE_ASYNCSHARED_INSTRUMENTATION1
+		{
+			/* With MSE_ASYNCSHARED_INSTRUMENTATION1 defined, each shared object records (per read and write) the number of
+			lock acquisitions, how many of them were contended, and the wait and hold times. Objects can be given names
+			under which their stats are listed in the instrumentation registry. */
+			auto ash_access_requester = mse::make_asyncsharedreadwrite<A>(7);
+			mse::set_asyncshared_instrumentation_name(ash_access_requester, "example object");
+
+			ash_access_requester.writelock_ptr()->b += 1;
+			std::future<void> future1;
+			{
+				auto readlock_ptr1 = ash_access_requester.readlock_ptr();
+				future1 = std::async(std::launch::async, [ash_access_requester]() mutable {
+					/* This one will (almost certainly) be contended. */
+					ash_access_requester.writelock_ptr()->b += 1;
+				});
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			}
+			future1.get();
+
+			/* Note that TAsyncSharedReadWriteAccessRequester<>::readlock_ptr() obtains an exclusive lock (because the object
+			might have unprotected mutable members), so it's counted as a write lock acquisition. */
+			auto stats = mse::asyncshared_instrumentation_stats(ash_access_requester);
+			assert(3 == stats.m_write.m_num_acquisitions);
+
+			/* Giving an object the name it already has has no effect, and giving it a new name moves it. */
+			mse::set_asyncshared_instrumentation_name(ash_access_requester, "example object");
+			auto stats_by_name = mse::asyncshared_instrumentation_registry().stats_by_name();
+			assert(stats_by_name.end() != stats_by_name.find("example object"));
+			assert(1 == stats_by_name.at("example object").m_num_objects);
+			mse::set_asyncshared_instrumentation_name(ash_access_requester, "renamed example object");
+			mse::set_asyncshared_instrumentation_name(ash_access_requester, "example object");
+			stats_by_name = mse::asyncshared_instrumentation_registry().stats_by_name();
+			assert(stats_by_name.end() == stats_by_name.find("renamed example object"));
+			assert(1 == stats_by_name.at("example object").m_num_objects);
+			mse::asyncshared_instrumentation_registry().dump(std::cout);
+		}
+#endif // MSE_ASYNCSHARED_INSTRUMENTATION1
 		{
 			/* Just demonstrating the existence of the "try" versions. */
 			auto access_requester = mse::make_asyncsharedreadwrite<std::string>("some text");
@@ -1793,6 +2536,67 @@ int main(int argc, char* argv[])
 				int res2 = (*it).get();
 			}
 		}
+		{
+			/* For read-mostly data (like configuration) that is replaced as a whole rather than modified in place, a
+			TAsyncSharedSnapshotPublisher lets writers publish new (immutable) versions while readers obtain the current
+			version as a TStdSharedImmutableFixedPointer "snapshot". A snapshot remains valid and unchanged regardless of
+			subsequent publications. */
+			auto publisher = mse::make_asyncsharedsnapshotpublisher<A>(1);
+			auto snapshot1 = publisher.snapshot();
+			assert(1 == snapshot1->b);
+
+			/* Each reading thread should use its own "reader", which, unless a new version has been published, obtains
+			the current snapshot without taking a lock. */
+			std::list<std::future<int>> futures;
+			for (size_t i = 0; i < 3; i += 1) {
+				futures.emplace_back(std::async(std::launch::async, [publisher]() {
+					auto reader = publisher.reader();
+					int max_b = 0;
+					for (int j = 0; j < 1000; j += 1) {
+						auto snapshot = reader.snapshot();
+						/* Versions are only ever published in increasing order of b. */
+						assert(max_b <= snapshot->b);
+						max_b = snapshot->b;
+
+						/* snapshot_ref() returns a reference (valid until the reader's next refresh) instead of a (shared)
+						pointer, and so doesn't even touch the version's reference count. */
+						const A& current_ref = reader.snapshot_ref();
+						assert(max_b <= current_ref.b);
+						max_b = current_ref.b;
+					}
+					return max_b;
+				}));
+			}
+			for (int j = 2; j <= 20; j += 1) {
+				publisher.publish(j);
+			}
+			for (auto& future : futures) {
+				int res2 = future.get();
+				assert((1 <= res2) && (20 >= res2));
+			}
+			assert(1 == snapshot1->b);
+			assert(20 == publisher.snapshot()->b);
+			assert(19 == publisher.generation());
+
+			/* update() publishes a version derived from the current one. Concurrent update()s don't clobber each other. */
+			auto future3 = std::async(std::launch::async, [publisher]() mutable {
+				for (int j = 0; j < 100; j += 1) {
+					publisher.update([](const A& current) { return A(current.b + 1); });
+				}
+			});
+			for (int j = 0; j < 100; j += 1) {
+				publisher.update([](const A& current) { return A(current.b + 1); });
+			}
+			future3.get();
+			auto reader1 = publisher.reader();
+			assert(220 == reader1.snapshot()->b);
+			assert(reader1.is_current());
+
+			/* An already constructed version can be published as is. */
+			auto snapshot2 = mse::make_stdsharedimmutable<A>(300);
+			publisher.publish(snapshot2);
+			assert(std::addressof(*snapshot2) == std::addressof(reader1.snapshot_ref()));
+		}
 	}
 
 	return 0;